@@ -0,0 +1,16 @@
+#version 450
+
+// 调试线段：世界空间位置 + RGBA8 颜色（VK_FORMAT_R8G8B8A8_UNORM 读取为 [0, 1]）
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec4 inColor;
+
+layout(push_constant) uniform PushConstants {
+    mat4 viewProjection;
+} pc;
+
+layout(location = 0) out vec4 fragColor;
+
+void main() {
+    gl_Position = pc.viewProjection * vec4(inPosition, 1.0);
+    fragColor   = inColor;
+}
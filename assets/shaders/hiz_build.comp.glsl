@@ -0,0 +1,33 @@
+#version 450
+
+// Hi-Z 金字塔构建：每次调度生成一级 mip，每个 texel 保存上一级对应区域的最大深度（最远处）
+layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(set = 0, binding = 0) uniform sampler2D srcImage; // 第 0 级为深度附件，其余为上一级 mip
+layout(set = 0, binding = 1, r32f) uniform writeonly image2D dstImage;
+
+void main() {
+    ivec2 dstSize = imageSize(dstImage);
+    ivec2 coord   = ivec2(gl_GlobalInvocationID.xy);
+    if (coord.x >= dstSize.x || coord.y >= dstSize.y) return;
+
+    // 第 0 级与深度附件同尺寸，直接复制
+    ivec2 srcSize = textureSize(srcImage, 0);
+    if (srcSize == dstSize) {
+        imageStore(dstImage, coord, vec4(texelFetch(srcImage, coord, 0).r));
+        return;
+    }
+
+    // 上一级尺寸为奇数时，本级最后一行/列额外覆盖剩下的一行/列，保证金字塔是保守的
+    ivec2 begin = min(coord * 2, srcSize - 1);
+    ivec2 end   = min(begin + 1, srcSize - 1);
+    if (coord.x == dstSize.x - 1) end.x = srcSize.x - 1;
+    if (coord.y == dstSize.y - 1) end.y = srcSize.y - 1;
+    float maxDepth = 0.0;
+    for (int y = begin.y; y <= end.y; y++) {
+        for (int x = begin.x; x <= end.x; x++) {
+            maxDepth = max(maxDepth, texelFetch(srcImage, ivec2(x, y), 0).r);
+        }
+    }
+    imageStore(dstImage, coord, vec4(maxDepth));
+}
@@ -0,0 +1,40 @@
+#version 450
+
+// 与 MeshObjectData 布局一致
+struct LodData {
+    uint firstIndex;
+    uint indexCount;
+    float error;
+    uint padding;
+};
+
+struct ObjectData {
+    mat4 model;
+    vec4 boundsMin;
+    vec4 boundsMax;
+    int vertexOffset;
+    uint lodCount;
+    float lodScale;
+    uint padding;
+    LodData lods[4];
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Objects {
+    ObjectData objects[];
+};
+
+layout(push_constant) uniform PushConstants {
+    mat4 viewProjection;
+    uint objectIndex; // 0xFFFFFFFF 表示物体索引来自间接绘制命令的 firstInstance
+} pc;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+
+layout(location = 0) out vec3 fragColor;
+
+void main() {
+    uint index  = pc.objectIndex == 0xFFFFFFFFu ? uint(gl_InstanceIndex) : pc.objectIndex;
+    gl_Position = pc.viewProjection * objects[index].model * vec4(inPosition, 1.0);
+    fragColor   = inColor;
+}
@@ -0,0 +1,68 @@
+#version 450
+#extension GL_EXT_mesh_shader : require
+
+// 簇绘制（网格着色器路径）：每个工作组输出任务着色器保留的一个簇
+layout(local_size_x = 32) in;
+layout(triangles, max_vertices = 64, max_primitives = 124) out; // 与 MESHLET_MAX_VERTICES / MESHLET_MAX_TRIANGLES 一致
+
+struct Meshlet {
+    vec4 sphere;
+    vec4 coneAxis;
+    vec4 coneApex;
+    uint vertexOffset;
+    uint vertexCount;
+    uint triangleOffset;
+    uint triangleCount;
+};
+
+struct TaskPayload {
+    uint clusterIndices[32];
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Vertices {
+    float vertices[]; // 与 MeshVertex 一致：位置 xyz + 颜色 rgb
+};
+layout(std430, set = 0, binding = 1) readonly buffer Meshlets {
+    Meshlet meshlets[];
+};
+layout(std430, set = 0, binding = 2) readonly buffer MeshletVertices {
+    uint meshletVertices[]; // 簇的局部顶点 -> 全局顶点索引
+};
+layout(std430, set = 0, binding = 3) readonly buffer MeshletTriangles {
+    uint meshletTriangles[]; // 8 位打包的局部顶点编号
+};
+layout(std430, set = 0, binding = 4) readonly buffer Instances {
+    mat4 instances[];
+};
+layout(std430, set = 0, binding = 5) readonly buffer Clusters {
+    uvec2 clusters[];
+};
+
+layout(push_constant) uniform PushConstants {
+    mat4 viewProjection;
+    vec4 camera;
+    uint clusterCount;
+    uint flags;
+} pc;
+
+taskPayloadSharedEXT TaskPayload payload;
+
+layout(location = 0) out vec3 fragColor[];
+
+void main() {
+    uvec2 cluster            = clusters[payload.clusterIndices[gl_WorkGroupID.x]];
+    Meshlet meshlet          = meshlets[cluster.y];
+    mat4 modelViewProjection = pc.viewProjection * instances[cluster.x];
+    SetMeshOutputsEXT(meshlet.vertexCount, meshlet.triangleCount);
+
+    for (uint i = gl_LocalInvocationIndex; i < meshlet.vertexCount; i += gl_WorkGroupSize.x) {
+        uint vertex                       = meshletVertices[meshlet.vertexOffset + i] * 6u;
+        vec3 position                     = vec3(vertices[vertex], vertices[vertex + 1u], vertices[vertex + 2u]);
+        gl_MeshVerticesEXT[i].gl_Position = modelViewProjection * vec4(position, 1.0);
+        fragColor[i]                      = vec3(vertices[vertex + 3u], vertices[vertex + 4u], vertices[vertex + 5u]);
+    }
+    for (uint i = gl_LocalInvocationIndex; i < meshlet.triangleCount; i += gl_WorkGroupSize.x) {
+        uint triangle                     = meshletTriangles[meshlet.triangleOffset + i];
+        gl_PrimitiveTriangleIndicesEXT[i] = uvec3(triangle & 0xFFu, (triangle >> 8) & 0xFFu, (triangle >> 16) & 0xFFu);
+    }
+}
@@ -0,0 +1,108 @@
+#version 450
+#extension GL_EXT_mesh_shader : require
+
+// 簇剔除（网格着色器路径）：每个线程测试一个簇，可见簇压缩到负载中，每个可见簇启动一个网格着色器工作组
+layout(local_size_x = 32) in;
+
+// 与 MeshletRenderer.cpp 中的 GpuMeshlet 布局一致
+struct Meshlet {
+    vec4 sphere;   // xyz 为模型空间球心，w 为半径
+    vec4 coneAxis; // xyz 为锥轴，w 为 cutoff，为 1 时不做背面剔除
+    vec4 coneApex;
+    uint vertexOffset;
+    uint vertexCount;
+    uint triangleOffset;
+    uint triangleCount;
+};
+
+struct TaskPayload {
+    uint clusterIndices[32]; // 可见簇在簇列表中的下标
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer Meshlets {
+    Meshlet meshlets[];
+};
+layout(std430, set = 0, binding = 4) readonly buffer Instances {
+    mat4 instances[];
+};
+layout(std430, set = 0, binding = 5) readonly buffer Clusters {
+    uvec2 clusters[]; // (物体, 簇)
+};
+layout(std430, set = 0, binding = 9) buffer Stats {
+    uint visible;
+    uint frustumCulled;
+    uint coneCulled;
+    uint dropped;
+    uint triangles;
+} stats;
+
+const uint FLAG_FRUSTUM = 1u;
+const uint FLAG_CONE    = 2u;
+const uint FLAG_STATS   = 4u;
+
+layout(push_constant) uniform PushConstants {
+    mat4 viewProjection;
+    vec4 camera; // xyz 为观察点
+    uint clusterCount;
+    uint flags;
+} pc;
+
+taskPayloadSharedEXT TaskPayload payload;
+shared uint visibleCount;
+
+const uint CLUSTER_VISIBLE        = 0u;
+const uint CLUSTER_FRUSTUM_CULLED = 1u;
+const uint CLUSTER_CONE_CULLED    = 2u;
+
+// 与 meshlet_cull.comp.glsl 中的测试一致
+uint cullCluster(uvec2 cluster) {
+    Meshlet meshlet = meshlets[cluster.y];
+    mat4 model      = instances[cluster.x];
+    if ((pc.flags & FLAG_FRUSTUM) != 0u) {
+        vec3 center    = (model * vec4(meshlet.sphere.xyz, 1.0)).xyz;
+        float scale    = max(length(model[0].xyz), max(length(model[1].xyz), length(model[2].xyz)));
+        float radius   = meshlet.sphere.w * scale;
+        mat4 rows      = transpose(pc.viewProjection);
+        vec4 planes[6] = vec4[6](rows[3] + rows[0], rows[3] - rows[0], rows[3] + rows[1], rows[3] - rows[1], rows[2], rows[3] - rows[2]);
+        for (int i = 0; i < 6; i++) {
+            if (dot(planes[i].xyz, center) + planes[i].w < -radius * length(planes[i].xyz)) return CLUSTER_FRUSTUM_CULLED;
+        }
+    }
+    if ((pc.flags & FLAG_CONE) != 0u && meshlet.coneAxis.w < 1.0) {
+        vec3 apex = (model * vec4(meshlet.coneApex.xyz, 1.0)).xyz;
+        vec3 axis = normalize(mat3(model) * meshlet.coneAxis.xyz);
+        if (dot(normalize(apex - pc.camera.xyz), axis) >= meshlet.coneAxis.w) return CLUSTER_CONE_CULLED;
+    }
+    return CLUSTER_VISIBLE;
+}
+
+void main() {
+    if (gl_LocalInvocationIndex == 0u) visibleCount = 0u;
+    memoryBarrierShared();
+    barrier();
+
+    uint index      = gl_GlobalInvocationID.x;
+    bool countStats = (pc.flags & FLAG_STATS) != 0u;
+    if (index < pc.clusterCount) {
+        uvec2 cluster = clusters[index];
+        uint result   = cullCluster(cluster);
+        if (result == CLUSTER_VISIBLE) {
+            uint slot                    = atomicAdd(visibleCount, 1u);
+            payload.clusterIndices[slot] = index;
+            if (countStats) {
+                atomicAdd(stats.visible, 1u);
+                atomicAdd(stats.triangles, meshlets[cluster.y].triangleCount);
+            }
+        } else if (countStats) {
+            if (result == CLUSTER_FRUSTUM_CULLED) {
+                atomicAdd(stats.frustumCulled, 1u);
+            } else {
+                atomicAdd(stats.coneCulled, 1u);
+            }
+        }
+    }
+
+    memoryBarrierShared();
+    barrier();
+    EmitMeshTasksEXT(visibleCount, 1, 1);
+}
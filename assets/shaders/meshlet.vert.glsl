@@ -0,0 +1,49 @@
+#version 450
+
+// 簇绘制（计算回退路径）：索引编码为 (可见簇槽位 << 6) | 簇内顶点编号，从存储缓冲区取顶点
+struct Meshlet {
+    vec4 sphere;
+    vec4 coneAxis;
+    vec4 coneApex;
+    uint vertexOffset;
+    uint vertexCount;
+    uint triangleOffset;
+    uint triangleCount;
+};
+
+const uint INDEX_SHIFT = 6;
+
+layout(std430, set = 0, binding = 0) readonly buffer Vertices {
+    float vertices[]; // 与 MeshVertex 一致：位置 xyz + 颜色 rgb
+};
+layout(std430, set = 0, binding = 1) readonly buffer Meshlets {
+    Meshlet meshlets[];
+};
+layout(std430, set = 0, binding = 2) readonly buffer MeshletVertices {
+    uint meshletVertices[]; // 簇的局部顶点 -> 全局顶点索引
+};
+layout(std430, set = 0, binding = 4) readonly buffer Instances {
+    mat4 instances[];
+};
+layout(std430, set = 0, binding = 6) readonly buffer VisibleClusters {
+    uvec2 visibleClusters[]; // (物体, 簇)
+};
+
+layout(push_constant) uniform PushConstants {
+    mat4 viewProjection;
+    vec4 camera;
+    uint clusterCount;
+    uint flags;
+} pc;
+
+layout(location = 0) out vec3 fragColor;
+
+void main() {
+    uint index      = uint(gl_VertexIndex);
+    uvec2 cluster   = visibleClusters[index >> INDEX_SHIFT];
+    Meshlet meshlet = meshlets[cluster.y];
+    uint vertex     = meshletVertices[meshlet.vertexOffset + (index & ((1u << INDEX_SHIFT) - 1u))] * 6u;
+    vec3 position   = vec3(vertices[vertex], vertices[vertex + 1u], vertices[vertex + 2u]);
+    gl_Position     = pc.viewProjection * instances[cluster.x] * vec4(position, 1.0);
+    fragColor       = vec3(vertices[vertex + 3u], vertices[vertex + 4u], vertices[vertex + 5u]);
+}
@@ -0,0 +1,128 @@
+#version 450
+
+// 簇剔除（计算回退路径）：每个线程测试一个簇，可见簇的三角形写入压缩后的索引缓冲区，由一次间接绘制完成
+layout(local_size_x = 64) in;
+
+// 与 MeshletRenderer.cpp 中的 GpuMeshlet 布局一致
+struct Meshlet {
+    vec4 sphere;   // xyz 为模型空间球心，w 为半径
+    vec4 coneAxis; // xyz 为锥轴，w 为 cutoff，为 1 时不做背面剔除
+    vec4 coneApex;
+    uint vertexOffset;
+    uint vertexCount;
+    uint triangleOffset;
+    uint triangleCount;
+};
+
+const uint MAX_VISIBLE_MESHLETS = 8192; // 与 MeshletRenderer.hpp 中的 MAX_VISIBLE_MESHLETS 一致
+const uint INDEX_SHIFT          = 6;    // 索引编码为 (槽位 << 6) | 簇内顶点编号
+
+layout(std430, set = 0, binding = 1) readonly buffer Meshlets {
+    Meshlet meshlets[];
+};
+layout(std430, set = 0, binding = 3) readonly buffer MeshletTriangles {
+    uint meshletTriangles[]; // 8 位打包的局部顶点编号
+};
+layout(std430, set = 0, binding = 4) readonly buffer Instances {
+    mat4 instances[];
+};
+layout(std430, set = 0, binding = 5) readonly buffer Clusters {
+    uvec2 clusters[]; // (物体, 簇)
+};
+layout(std430, set = 0, binding = 6) writeonly buffer VisibleClusters {
+    uvec2 visibleClusters[];
+};
+layout(std430, set = 0, binding = 7) writeonly buffer DrawIndices {
+    uint drawIndices[];
+};
+// 与 VkDrawIndexedIndirectCommand 布局一致，最后追加可见簇槽位计数
+layout(std430, set = 0, binding = 8) buffer DrawCommand {
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+    uint visibleCount;
+} draw;
+layout(std430, set = 0, binding = 9) buffer Stats {
+    uint visible;
+    uint frustumCulled;
+    uint coneCulled;
+    uint dropped;
+    uint triangles;
+} stats;
+
+const uint FLAG_FRUSTUM = 1u;
+const uint FLAG_CONE    = 2u;
+const uint FLAG_STATS   = 4u;
+
+layout(push_constant) uniform PushConstants {
+    mat4 viewProjection;
+    vec4 camera; // xyz 为观察点
+    uint clusterCount;
+    uint flags;
+} pc;
+
+const uint CLUSTER_VISIBLE        = 0u;
+const uint CLUSTER_FRUSTUM_CULLED = 1u;
+const uint CLUSTER_CONE_CULLED    = 2u;
+
+// 包围球在任一视锥平面之外时不可见；背面锥包含观察方向时簇内所有三角形都是背面
+uint cullCluster(uvec2 cluster) {
+    Meshlet meshlet = meshlets[cluster.y];
+    mat4 model      = instances[cluster.x];
+    if ((pc.flags & FLAG_FRUSTUM) != 0u) {
+        vec3 center  = (model * vec4(meshlet.sphere.xyz, 1.0)).xyz;
+        float scale  = max(length(model[0].xyz), max(length(model[1].xyz), length(model[2].xyz)));
+        float radius = meshlet.sphere.w * scale;
+        // 平面从观察投影矩阵的行提取，深度范围 [0, 1]
+        mat4 rows      = transpose(pc.viewProjection);
+        vec4 planes[6] = vec4[6](rows[3] + rows[0], rows[3] - rows[0], rows[3] + rows[1], rows[3] - rows[1], rows[2], rows[3] - rows[2]);
+        for (int i = 0; i < 6; i++) {
+            if (dot(planes[i].xyz, center) + planes[i].w < -radius * length(planes[i].xyz)) return CLUSTER_FRUSTUM_CULLED;
+        }
+    }
+    if ((pc.flags & FLAG_CONE) != 0u && meshlet.coneAxis.w < 1.0) {
+        vec3 apex = (model * vec4(meshlet.coneApex.xyz, 1.0)).xyz;
+        vec3 axis = normalize(mat3(model) * meshlet.coneAxis.xyz);
+        if (dot(normalize(apex - pc.camera.xyz), axis) >= meshlet.coneAxis.w) return CLUSTER_CONE_CULLED;
+    }
+    return CLUSTER_VISIBLE;
+}
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= pc.clusterCount) return;
+
+    bool countStats = (pc.flags & FLAG_STATS) != 0u;
+    uvec2 cluster   = clusters[index];
+    uint result     = cullCluster(cluster);
+    if (result == CLUSTER_FRUSTUM_CULLED) {
+        if (countStats) atomicAdd(stats.frustumCulled, 1u);
+        return;
+    }
+    if (result == CLUSTER_CONE_CULLED) {
+        if (countStats) atomicAdd(stats.coneCulled, 1u);
+        return;
+    }
+
+    uint slot = atomicAdd(draw.visibleCount, 1u);
+    if (slot >= MAX_VISIBLE_MESHLETS) {
+        if (countStats) atomicAdd(stats.dropped, 1u);
+        return;
+    }
+    Meshlet meshlet       = meshlets[cluster.y];
+    uint first            = atomicAdd(draw.indexCount, meshlet.triangleCount * 3u);
+    visibleClusters[slot] = cluster;
+    uint base             = slot << INDEX_SHIFT;
+    for (uint t = 0u; t < meshlet.triangleCount; t++) {
+        uint triangle                    = meshletTriangles[meshlet.triangleOffset + t];
+        drawIndices[first + t * 3u]      = base | (triangle & 0xFFu);
+        drawIndices[first + t * 3u + 1u] = base | ((triangle >> 8) & 0xFFu);
+        drawIndices[first + t * 3u + 2u] = base | ((triangle >> 16) & 0xFFu);
+    }
+    if (countStats) {
+        atomicAdd(stats.visible, 1u);
+        atomicAdd(stats.triangles, meshlet.triangleCount);
+    }
+}
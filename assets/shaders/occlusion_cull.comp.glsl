@@ -0,0 +1,179 @@
+#version 450
+
+// 两阶段遮挡剔除：第一阶段用上一帧的 Hi-Z 测试所有物体，第二阶段用本帧重建的 Hi-Z 重新测试第一阶段被剔除的物体
+layout(local_size_x = 64) in;
+
+// 与 MeshObjectData 布局一致
+struct LodData {
+    uint firstIndex;
+    uint indexCount;
+    float error; // 模型空间几何误差
+    uint padding;
+};
+
+const uint MAX_MESH_LODS = 4;
+
+struct ObjectData {
+    mat4 model;
+    vec4 boundsMin; // 世界空间包围盒
+    vec4 boundsMax;
+    int vertexOffset;
+    uint lodCount;
+    float lodScale; // 模型空间误差换算到世界空间的缩放
+    uint padding;
+    LodData lods[MAX_MESH_LODS];
+};
+
+// 与 VkDrawIndexedIndirectCommand 布局一致
+struct DrawCommand {
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Objects {
+    ObjectData objects[];
+};
+layout(std430, set = 0, binding = 1) writeonly buffer Draws {
+    DrawCommand draws[];
+};
+layout(std430, set = 0, binding = 2) buffer Visibility {
+    uint visibility[]; // 第 0 位为第一阶段是否绘制，其余位为选择的 LOD；第一阶段写入，第二阶段和下一帧读取
+};
+layout(set = 0, binding = 3) uniform sampler2D hiz;
+layout(std430, set = 0, binding = 4) buffer Stats {
+    uint drawnEarly;
+    uint drawnLate;
+    uint frustumCulled;
+    uint occlusionCulled;
+    uint triangles;
+    uint fullTriangles;
+} stats;
+
+const uint FLAG_ENABLED        = 1u;
+const uint FLAG_HIZ_VALID      = 2u;
+const uint FLAG_FIRST_INSTANCE = 4u;
+const uint FLAG_LOD            = 8u;
+
+layout(push_constant) uniform PushConstants {
+    mat4 viewProjection;
+    uint objectCount;
+    uint phase;              // 0 为第一阶段，1 为第二阶段
+    uint flags;
+    uint drawOffset;         // 本阶段第一条绘制命令的下标
+    vec4 camera;             // xyz 为观察点，w 为投影矩阵的垂直缩放
+    float lodErrorThreshold; // 允许的屏幕空间误差（像素）
+    float lodHysteresis;     // 切换到更粗一级时阈值缩小的比例
+} pc;
+
+// 8 个角点都在同一个裁剪平面之外时包围盒在视锥外；裁剪空间中比较，不受 w <= 0 的影响
+bool frustumVisible(vec3 bmin, vec3 bmax) {
+    uint outside = 0x3Fu;
+    for (int i = 0; i < 8; i++) {
+        vec3 corner = vec3((i & 1) != 0 ? bmax.x : bmin.x, (i & 2) != 0 ? bmax.y : bmin.y, (i & 4) != 0 ? bmax.z : bmin.z);
+        vec4 clip   = pc.viewProjection * vec4(corner, 1.0);
+        uint mask   = 0u;
+        mask |= clip.x < -clip.w ? 0x01u : 0u;
+        mask |= clip.x > clip.w ? 0x02u : 0u;
+        mask |= clip.y < -clip.w ? 0x04u : 0u;
+        mask |= clip.y > clip.w ? 0x08u : 0u;
+        mask |= clip.z < 0.0 ? 0x10u : 0u;
+        mask |= clip.z > clip.w ? 0x20u : 0u;
+        outside &= mask;
+    }
+    return outside == 0u;
+}
+
+// 包围盒最近的深度比覆盖区域内 Hi-Z 的最大深度还远时被遮挡
+bool occlusionVisible(vec3 bmin, vec3 bmax) {
+    vec3 ndcMin = vec3(1.0e30);
+    vec3 ndcMax = vec3(-1.0e30);
+    for (int i = 0; i < 8; i++) {
+        vec3 corner = vec3((i & 1) != 0 ? bmax.x : bmin.x, (i & 2) != 0 ? bmax.y : bmin.y, (i & 4) != 0 ? bmax.z : bmin.z);
+        vec4 clip   = pc.viewProjection * vec4(corner, 1.0);
+        if (clip.w <= 1.0e-5) return true; // 与近平面相交，无法投影，保守认为可见
+        vec3 ndc = clip.xyz / clip.w;
+        ndcMin   = min(ndcMin, ndc);
+        ndcMax   = max(ndcMax, ndc);
+    }
+    if (ndcMin.z <= 0.0) return true;
+
+    // 选择使包围矩形最多覆盖 2x2 个 texel 的 mip 级别
+    ivec2 size0 = textureSize(hiz, 0);
+    vec2 uvMin  = clamp(ndcMin.xy * 0.5 + 0.5, 0.0, 1.0);
+    vec2 uvMax  = clamp(ndcMax.xy * 0.5 + 0.5, 0.0, 1.0);
+    ivec2 pMin  = min(ivec2(uvMin * vec2(size0)), size0 - 1);
+    ivec2 pMax  = min(ivec2(uvMax * vec2(size0)), size0 - 1);
+    int levels  = textureQueryLevels(hiz);
+    int level   = 0;
+    while (level < levels - 1 && any(greaterThan((pMax >> level) - (pMin >> level), ivec2(1)))) {
+        level++;
+    }
+    ivec2 levelSize = textureSize(hiz, level);
+    ivec2 t0        = min(pMin >> level, levelSize - 1);
+    ivec2 t1        = min(pMax >> level, levelSize - 1);
+    float maxDepth  = max(max(texelFetch(hiz, t0, level).r, texelFetch(hiz, ivec2(t1.x, t0.y), level).r),
+                          max(texelFetch(hiz, ivec2(t0.x, t1.y), level).r, texelFetch(hiz, t1, level).r));
+    return ndcMin.z <= maxDepth;
+}
+
+// 选择投影到屏幕上的误差不超过阈值的最粗一级；比上一帧更粗时使用更严格的阈值，避免在临界距离来回切换
+uint selectLod(ObjectData object, uint previousLod) {
+    if ((pc.flags & FLAG_LOD) == 0u || object.lodCount <= 1u) return 0u;
+    vec3 center    = (object.boundsMin.xyz + object.boundsMax.xyz) * 0.5;
+    float radius   = length(object.boundsMax.xyz - object.boundsMin.xyz) * 0.5;
+    float distance = max(length(center - pc.camera.xyz) - radius, 1.0e-3); // 包围球上最近的点
+    // 屏幕空间误差（像素）= 世界空间误差 / 距离 * 视口高度 / 2 * 投影缩放
+    float pixelsPerUnit = float(textureSize(hiz, 0).y) * 0.5 * pc.camera.w / distance;
+    uint lod            = 0u;
+    for (uint level = 1u; level < min(object.lodCount, MAX_MESH_LODS); level++) {
+        float threshold = level > previousLod ? pc.lodErrorThreshold * (1.0 - pc.lodHysteresis) : pc.lodErrorThreshold;
+        if (object.lods[level].error * object.lodScale * pixelsPerUnit > threshold) break;
+        lod = level;
+    }
+    return lod;
+}
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= pc.objectCount) return;
+
+    ObjectData object = objects[index];
+    bool enabled      = (pc.flags & FLAG_ENABLED) != 0u;
+    bool inFrustum    = !enabled || frustumVisible(object.boundsMin.xyz, object.boundsMax.xyz);
+    bool visible      = false;
+    uint state        = visibility[index];
+    uint lod          = 0u;
+    if (pc.phase == 0u) {
+        bool testOcclusion = enabled && (pc.flags & FLAG_HIZ_VALID) != 0u;
+        visible            = inFrustum && (!testOcclusion || occlusionVisible(object.boundsMin.xyz, object.boundsMax.xyz));
+        lod                = selectLod(object, state >> 1); // 缓冲区刚创建时内容未定义，selectLod() 只用它比较大小
+        visibility[index]  = (lod << 1) | (visible ? 1u : 0u);
+        if (!inFrustum) atomicAdd(stats.frustumCulled, 1u);
+        if (visible) atomicAdd(stats.drawnEarly, 1u);
+    } else if (inFrustum && (state & 1u) == 0u) {
+        lod = min(state >> 1, MAX_MESH_LODS - 1u); // 与第一阶段选择的 LOD 一致
+        // 只重新测试第一阶段被遮挡剔除的物体，已经绘制过的不再绘制
+        visible = occlusionVisible(object.boundsMin.xyz, object.boundsMax.xyz);
+        if (visible) {
+            atomicAdd(stats.drawnLate, 1u);
+        } else {
+            atomicAdd(stats.occlusionCulled, 1u);
+        }
+    }
+
+    if (visible) {
+        atomicAdd(stats.triangles, object.lods[lod].indexCount / 3u);
+        atomicAdd(stats.fullTriangles, object.lods[0].indexCount / 3u);
+    }
+
+    DrawCommand draw;
+    draw.indexCount              = object.lods[lod].indexCount;
+    draw.instanceCount           = visible ? 1u : 0u; // 被剔除的物体保留命令，实例数为 0
+    draw.firstIndex              = object.lods[lod].firstIndex;
+    draw.vertexOffset            = object.vertexOffset;
+    draw.firstInstance           = (pc.flags & FLAG_FIRST_INSTANCE) != 0u ? index : 0u;
+    draws[pc.drawOffset + index] = draw;
+}
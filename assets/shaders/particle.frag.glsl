@@ -0,0 +1,13 @@
+#version 450
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 fragOffset;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    // 圆形软边，透明度从中心向边缘衰减
+    float distance2 = dot(fragOffset, fragOffset);
+    if (distance2 > 1.0) discard;
+    outColor = vec4(fragColor.rgb, fragColor.a * (1.0 - distance2));
+}
@@ -0,0 +1,40 @@
+#version 450
+
+// 粒子公告板：每个实例是一个压缩后存活的粒子，4 个顶点组成面向相机的三角形带
+struct Particle {
+    vec4 position; // xyz 为位置，w 为已存活的时间
+    vec4 velocity; // xyz 为速度，w 为寿命
+    uint startColor;
+    uint endColor;
+    float startSize;
+    float endSize;
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer CompactedParticles {
+    Particle particles[];
+};
+
+layout(push_constant) uniform PushConstants {
+    mat4 viewProjection;
+    vec4 cameraRight; // xyz 为观察空间 x 轴在世界空间中的方向
+    vec4 cameraUp;    // xyz 为观察空间 y 轴在世界空间中的方向
+    vec4 gravity;
+    float deltaTime;
+    uint emitterCount;
+    uint emitCount;
+    uint seed;
+} pc;
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 fragOffset; // 公告板内的坐标，[-1, 1]
+
+void main() {
+    Particle particle = particles[gl_InstanceIndex];
+    float t           = clamp(particle.position.w / max(particle.velocity.w, 1e-6), 0.0, 1.0);
+    float size        = mix(particle.startSize, particle.endSize, t);
+    vec2 corner       = vec2((gl_VertexIndex & 1) != 0 ? 1.0 : -1.0, (gl_VertexIndex & 2) != 0 ? 1.0 : -1.0);
+    vec3 world        = particle.position.xyz + (pc.cameraRight.xyz * corner.x + pc.cameraUp.xyz * corner.y) * (size * 0.5);
+    gl_Position       = pc.viewProjection * vec4(world, 1.0);
+    fragColor         = mix(unpackUnorm4x8(particle.startColor), unpackUnorm4x8(particle.endColor), t);
+    fragOffset        = corner;
+}
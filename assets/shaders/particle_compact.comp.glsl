@@ -0,0 +1,65 @@
+#version 450
+
+// 粒子压缩：重新判断存活并在工作组内做前缀和，存活粒子按原顺序写入另一个缓冲区的连续位置
+layout(local_size_x = 256) in;
+
+// 与 ParticleSystem.cpp 中的 GpuParticle 布局一致
+struct Particle {
+    vec4 position; // xyz 为位置，w 为已存活的时间
+    vec4 velocity; // xyz 为速度，w 为寿命
+    uint startColor;
+    uint endColor;
+    float startSize;
+    float endSize;
+};
+
+const uint GROUP_SIZE = 256;
+
+layout(std430, set = 0, binding = 0) readonly buffer Particles {
+    Particle particles[];
+};
+layout(std430, set = 0, binding = 1) writeonly buffer CompactedParticles {
+    Particle compacted[];
+};
+layout(std430, set = 0, binding = 2) readonly buffer Counters {
+    uint dispatchX;
+    uint dispatchY;
+    uint dispatchZ;
+    uint vertexCount;
+    uint instanceCount;
+    uint firstVertex;
+    uint firstInstance;
+    uint alive;
+    uint emitted;
+    uint dropped;
+    uint total;
+} counters;
+layout(std430, set = 0, binding = 3) readonly buffer BlockOffsets {
+    uint blockOffsets[]; // 每个工作组的写入位置
+};
+
+shared uint localSums[GROUP_SIZE];
+
+void main() {
+    uint thread = gl_LocalInvocationIndex;
+    uint index  = gl_GlobalInvocationID.x;
+    bool alive  = false;
+    Particle particle;
+    if (index < counters.total) {
+        particle = particles[index];
+        alive    = particle.position.w < particle.velocity.w;
+    }
+
+    // Hillis-Steele 包含式扫描，所有线程都要到达屏障
+    uint flag         = alive ? 1u : 0u;
+    localSums[thread] = flag;
+    barrier();
+    for (uint offset = 1u; offset < GROUP_SIZE; offset <<= 1u) {
+        uint add = thread >= offset ? localSums[thread - offset] : 0u;
+        barrier();
+        localSums[thread] += add;
+        barrier();
+    }
+
+    if (alive) compacted[blockOffsets[gl_WorkGroupID.x] + localSums[thread] - flag] = particle;
+}
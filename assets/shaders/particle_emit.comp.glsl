@@ -0,0 +1,111 @@
+#version 450
+
+// 粒子发射：新粒子追加到上一帧存活粒子之后，第一个线程写入本帧模拟和压缩的间接调度参数
+layout(local_size_x = 256) in;
+
+// 与 ParticleSystem.cpp 中的 GpuParticle 布局一致
+struct Particle {
+    vec4 position; // xyz 为位置，w 为已存活的时间
+    vec4 velocity; // xyz 为速度，w 为寿命
+    uint startColor;
+    uint endColor;
+    float startSize;
+    float endSize;
+};
+
+// 与 ParticleSystem.cpp 中的 GpuEmitter 布局一致
+struct Emitter {
+    vec4 position; // xyz 为发射中心，w 为出生球半径
+    vec4 velocity; // xyz 为初速度，w 为随机扰动半径
+    vec4 startColor;
+    vec4 endColor;
+    float startSize;
+    float endSize;
+    float minLifetime;
+    float maxLifetime;
+    uint first;
+    uint count;
+};
+
+const uint MAX_PARTICLES = 1048576; // 与 ParticleSystem.hpp 中的 MAX_PARTICLES 一致
+const uint GROUP_SIZE    = 256;
+
+layout(std430, set = 0, binding = 0) writeonly buffer Particles {
+    Particle particles[];
+};
+// 前 3 项与 VkDispatchIndirectCommand 一致，之后 4 项与 VkDrawIndirectCommand 一致
+layout(std430, set = 0, binding = 2) buffer Counters {
+    uint dispatchX;
+    uint dispatchY;
+    uint dispatchZ;
+    uint vertexCount;
+    uint instanceCount;
+    uint firstVertex;
+    uint firstInstance;
+    uint alive;   // 上一帧压缩后存活的粒子数量
+    uint emitted; // 本帧实际发射的粒子数量
+    uint dropped; // 超出 MAX_PARTICLES 而未发射的粒子数量
+    uint total;   // 本帧参与模拟的粒子数量
+} counters;
+layout(std430, set = 0, binding = 4) readonly buffer Emitters {
+    Emitter emitters[];
+};
+
+layout(push_constant) uniform PushConstants {
+    mat4 viewProjection;
+    vec4 cameraRight;
+    vec4 cameraUp;
+    vec4 gravity; // xyz 为加速度，w 为阻力
+    float deltaTime;
+    uint emitterCount;
+    uint emitCount;
+    uint seed;
+} pc;
+
+// PCG 哈希，每次调用推进状态并返回 [0, 1) 的随机数
+float random(inout uint state) {
+    state     = state * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return float((word >> 22u) ^ word) * (1.0 / 4294967296.0);
+}
+
+vec3 randomInSphere(inout uint state) {
+    // 均匀方向 + 立方根半径，单位球内均匀分布
+    float z   = random(state) * 2.0 - 1.0;
+    float phi = random(state) * 6.28318530718;
+    float r   = sqrt(max(1.0 - z * z, 0.0));
+    return vec3(r * cos(phi), r * sin(phi), z) * pow(random(state), 1.0 / 3.0);
+}
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    uint base  = counters.alive;
+    uint total = min(base + pc.emitCount, MAX_PARTICLES);
+    if (index == 0u) {
+        // 其余线程只读取 alive，不读取这里写入的字段
+        counters.total     = total;
+        counters.emitted   = total - base;
+        counters.dropped   = pc.emitCount - (total - base);
+        counters.dispatchX = (total + GROUP_SIZE - 1u) / GROUP_SIZE;
+        counters.dispatchY = 1u;
+        counters.dispatchZ = 1u;
+    }
+    if (index >= pc.emitCount || base + index >= MAX_PARTICLES) return;
+
+    // 发射器按 first 递增排列，数量很少，顺序查找即可
+    uint e = 0u;
+    while (e + 1u < pc.emitterCount && index >= emitters[e + 1u].first) e++;
+    Emitter emitter = emitters[e];
+
+    uint state = pc.seed * 1664525u + index * 2654435769u;
+    random(state);
+    Particle particle;
+    particle.position       = vec4(emitter.position.xyz + randomInSphere(state) * emitter.position.w, 0.0);
+    particle.velocity       = vec4(emitter.velocity.xyz + randomInSphere(state) * emitter.velocity.w,
+                                   mix(emitter.minLifetime, emitter.maxLifetime, random(state)));
+    particle.startColor     = packUnorm4x8(emitter.startColor);
+    particle.endColor       = packUnorm4x8(emitter.endColor);
+    particle.startSize      = emitter.startSize;
+    particle.endSize        = emitter.endSize;
+    particles[base + index] = particle;
+}
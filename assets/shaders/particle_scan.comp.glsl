@@ -0,0 +1,65 @@
+#version 450
+
+// 工作组计数的前缀和：一个工作组完成，每个线程串行处理连续的 ITEMS 个计数，再在共享内存中扫描线程的部分和
+// 结果为每个工作组在压缩后缓冲区中的起始位置，总数写入存活数量和间接绘制的实例数量
+layout(local_size_x = 256) in;
+
+const uint GROUP_SIZE = 256;
+const uint ITEMS      = 16; // MAX_PARTICLES / (GROUP_SIZE * GROUP_SIZE)
+
+layout(std430, set = 0, binding = 2) buffer Counters {
+    uint dispatchX;
+    uint dispatchY;
+    uint dispatchZ;
+    uint vertexCount;
+    uint instanceCount;
+    uint firstVertex;
+    uint firstInstance;
+    uint alive;
+    uint emitted;
+    uint dropped;
+    uint total;
+} counters;
+layout(std430, set = 0, binding = 3) buffer BlockCounts {
+    uint blockCounts[]; // 输入为每个工作组的存活数量，输出为写入位置
+};
+
+shared uint partialSums[GROUP_SIZE];
+
+void main() {
+    uint thread     = gl_LocalInvocationIndex;
+    uint blockCount = (counters.total + GROUP_SIZE - 1u) / GROUP_SIZE;
+    uint first      = thread * ITEMS;
+    uint last       = min(first + ITEMS, blockCount);
+
+    uint sum = 0u;
+    for (uint i = first; i < last; i++) {
+        sum += blockCounts[i];
+    }
+
+    // Hillis-Steele 包含式扫描
+    partialSums[thread] = sum;
+    barrier();
+    for (uint offset = 1u; offset < GROUP_SIZE; offset <<= 1u) {
+        uint add = thread >= offset ? partialSums[thread - offset] : 0u;
+        barrier();
+        partialSums[thread] += add;
+        barrier();
+    }
+
+    uint position = partialSums[thread] - sum;
+    for (uint i = first; i < last; i++) {
+        uint count     = blockCounts[i];
+        blockCounts[i] = position;
+        position += count;
+    }
+
+    if (thread == GROUP_SIZE - 1u) {
+        uint alive             = partialSums[thread];
+        counters.alive         = alive;
+        counters.vertexCount   = 4u; // 三角形带公告板
+        counters.instanceCount = alive;
+        counters.firstVertex   = 0u;
+        counters.firstInstance = 0u;
+    }
+}
@@ -0,0 +1,66 @@
+#version 450
+
+// 粒子模拟：积分速度和位置，每个工作组统计存活的粒子数量供扫描着色器做前缀和
+layout(local_size_x = 256) in;
+
+// 与 ParticleSystem.cpp 中的 GpuParticle 布局一致
+struct Particle {
+    vec4 position; // xyz 为位置，w 为已存活的时间
+    vec4 velocity; // xyz 为速度，w 为寿命
+    uint startColor;
+    uint endColor;
+    float startSize;
+    float endSize;
+};
+
+layout(std430, set = 0, binding = 0) buffer Particles {
+    Particle particles[];
+};
+layout(std430, set = 0, binding = 2) readonly buffer Counters {
+    uint dispatchX;
+    uint dispatchY;
+    uint dispatchZ;
+    uint vertexCount;
+    uint instanceCount;
+    uint firstVertex;
+    uint firstInstance;
+    uint alive;
+    uint emitted;
+    uint dropped;
+    uint total; // 本帧参与模拟的粒子数量
+} counters;
+layout(std430, set = 0, binding = 3) writeonly buffer BlockCounts {
+    uint blockCounts[]; // 每个工作组存活的粒子数量
+};
+
+layout(push_constant) uniform PushConstants {
+    mat4 viewProjection;
+    vec4 cameraRight;
+    vec4 cameraUp;
+    vec4 gravity; // xyz 为加速度，w 为阻力
+    float deltaTime;
+    uint emitterCount;
+    uint emitCount;
+    uint seed;
+} pc;
+
+shared uint groupAlive;
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (gl_LocalInvocationIndex == 0u) groupAlive = 0u;
+    barrier();
+
+    if (index < counters.total) {
+        Particle particle = particles[index];
+        vec3 velocity     = (particle.velocity.xyz + pc.gravity.xyz * pc.deltaTime) * max(1.0 - pc.gravity.w * pc.deltaTime, 0.0);
+        particle.position = vec4(particle.position.xyz + velocity * pc.deltaTime, particle.position.w + pc.deltaTime);
+        particle.velocity = vec4(velocity, particle.velocity.w);
+        particles[index]  = particle;
+        if (particle.position.w < particle.velocity.w) atomicAdd(groupAlive, 1u);
+    }
+
+    // 所有线程都要到达屏障，越界的线程不能提前返回
+    barrier();
+    if (gl_LocalInvocationIndex == 0u) blockCounts[gl_WorkGroupID.x] = groupAlive;
+}
@@ -0,0 +1,50 @@
+#version 450
+
+// 可分离高斯模糊：每个工作组把图块及其边缘读入共享内存，只访问一次显存
+layout(local_size_x = 16, local_size_y = 16) in;
+
+const int TILE_SIZE  = 16;
+const int MAX_RADIUS = 16;
+const int CACHE_SIZE = TILE_SIZE + 2 * MAX_RADIUS;
+
+layout(set = 0, binding = 0, rgba16f) uniform readonly image2D inputImage;
+layout(set = 0, binding = 1, rgba16f) uniform writeonly image2D outputImage;
+
+layout(push_constant) uniform PushConstants {
+    ivec2 direction; // (1, 0) 为水平方向，(0, 1) 为垂直方向
+    int radius;      // 模糊半径，不超过 MAX_RADIUS
+    float sigma;     // 高斯标准差
+} pc;
+
+shared vec4 tile[TILE_SIZE][CACHE_SIZE];
+
+void main() {
+    ivec2 size  = imageSize(inputImage);
+    ivec2 local = ivec2(gl_LocalInvocationID.xy);
+    ivec2 group = ivec2(gl_WorkGroupID.xy) * TILE_SIZE;
+    int radius  = min(pc.radius, MAX_RADIUS);
+
+    // 沿模糊方向把 TILE_SIZE + 2 * radius 个像素读入共享内存，越界时钳制到边缘
+    bool horizontal = pc.direction.x != 0;
+    int lane        = horizontal ? local.x : local.y;
+    int row         = horizontal ? local.y : local.x;
+    for (int i = lane; i < TILE_SIZE + 2 * radius; i += TILE_SIZE) {
+        ivec2 offset = horizontal ? ivec2(i - radius, row) : ivec2(row, i - radius);
+        ivec2 coord  = clamp(group + offset, ivec2(0), size - 1);
+        tile[row][i] = imageLoad(inputImage, coord);
+    }
+    barrier();
+
+    ivec2 coord = group + local;
+    if (coord.x >= size.x || coord.y >= size.y) return;
+
+    vec4 sum     = vec4(0.0);
+    float weight = 0.0;
+    float denom  = 2.0 * pc.sigma * pc.sigma;
+    for (int k = -radius; k <= radius; k++) {
+        float w = exp(-float(k * k) / denom);
+        sum += tile[row][lane + radius + k] * w;
+        weight += w;
+    }
+    imageStore(outputImage, coord, sum / weight);
+}
@@ -0,0 +1,55 @@
+#version 450
+
+// 逐像素后处理：一次调度可以融合多个逐像素阶段，避免中间结果写回显存
+layout(local_size_x = 16, local_size_y = 16) in;
+
+layout(set = 0, binding = 0, rgba16f) uniform readonly image2D inputImage;
+layout(set = 0, binding = 1, rgba16f) uniform writeonly image2D outputImage;
+
+const uint OP_EXPOSURE = 0;
+const uint OP_TONE_MAP = 1;
+const uint OP_VIGNETTE = 2;
+const uint OP_GAMMA    = 3;
+
+layout(push_constant) uniform PushConstants {
+    uvec4 ops;       // 按顺序执行的操作类型
+    vec4 params[4];  // 每个操作的参数
+    uint opCount;    // 有效操作数量
+} pc;
+
+vec3 toneMapACES(vec3 x) {
+    const float a = 2.51;
+    const float b = 0.03;
+    const float c = 2.43;
+    const float d = 0.59;
+    const float e = 0.14;
+    return clamp((x * (a * x + b)) / (x * (c * x + d) + e), 0.0, 1.0);
+}
+
+void main() {
+    ivec2 size  = imageSize(inputImage);
+    ivec2 coord = ivec2(gl_GlobalInvocationID.xy);
+    if (coord.x >= size.x || coord.y >= size.y) return;
+
+    vec4 color = imageLoad(inputImage, coord);
+    for (uint i = 0; i < pc.opCount; i++) {
+        vec4 p = pc.params[i];
+        switch (pc.ops[i]) {
+        case OP_EXPOSURE:
+            color.rgb *= p.x;
+            break;
+        case OP_TONE_MAP:
+            color.rgb = toneMapACES(color.rgb);
+            break;
+        case OP_VIGNETTE: {
+            vec2 uv = (vec2(coord) + 0.5) / vec2(size) - 0.5;
+            color.rgb *= 1.0 - p.x * smoothstep(p.y, p.z, length(uv));
+            break;
+        }
+        case OP_GAMMA:
+            color.rgb = pow(max(color.rgb, vec3(0.0)), vec3(p.x));
+            break;
+        }
+    }
+    imageStore(outputImage, coord, color);
+}
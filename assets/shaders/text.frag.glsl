@@ -0,0 +1,14 @@
+#version 450
+
+// 字形图集是单通道覆盖率
+layout(set = 0, binding = 0) uniform sampler2D glyphAtlas;
+
+layout(location = 0) in vec2 fragUV;
+layout(location = 1) in vec4 fragColor;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    float coverage = texture(glyphAtlas, fragUV).r;
+    outColor       = vec4(fragColor.rgb, fragColor.a * coverage);
+}
@@ -0,0 +1,23 @@
+#version 450
+
+// 屏幕文字：每个实例是一个字形四边形，顶点由 gl_VertexIndex 生成
+layout(location = 0) in vec4 inRect;  // 左上角 x, y 和宽高，像素
+layout(location = 1) in vec4 inUV;    // u0, v0, u1, v1
+layout(location = 2) in vec4 inColor; // VK_FORMAT_R8G8B8A8_UNORM 读取为 [0, 1]
+
+layout(push_constant) uniform PushConstants {
+    vec2 viewportSize; // 像素
+} pc;
+
+layout(location = 0) out vec2 fragUV;
+layout(location = 1) out vec4 fragColor;
+
+const vec2 CORNERS[6] = vec2[](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0));
+
+void main() {
+    vec2 corner = CORNERS[gl_VertexIndex];
+    vec2 pixel  = inRect.xy + corner * inRect.zw;
+    gl_Position = vec4(pixel / pc.viewportSize * 2.0 - 1.0, 0.0, 1.0);
+    fragUV      = mix(inUV.xy, inUV.zw, corner);
+    fragColor   = inColor;
+}
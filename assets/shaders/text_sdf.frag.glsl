@@ -0,0 +1,16 @@
+#version 450
+
+// SDF 字形图集：0.5 对应轮廓，按屏幕空间导数在一个像素内做抗锯齿，任意缩放都保持清晰
+layout(set = 0, binding = 0) uniform sampler2D glyphAtlas;
+
+layout(location = 0) in vec2 fragUV;
+layout(location = 1) in vec4 fragColor;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    float distance = texture(glyphAtlas, fragUV).r;
+    float width    = max(fwidth(distance) * 0.5, 1e-4);
+    float coverage = smoothstep(0.5 - width, 0.5 + width, distance);
+    outColor       = vec4(fragColor.rgb, fragColor.a * coverage);
+}
@@ -0,0 +1,40 @@
+#version 450
+
+// 图块地图：按区块内坐标查找图块编号，从图集中对应的格子取色；编号 0 为空图块
+const uint CHUNK_SIZE = 32;
+
+layout(std430, set = 0, binding = 0) readonly buffer Tiles {
+    uint tiles[]; // 按区块连续存放，每个区块 CHUNK_SIZE * CHUNK_SIZE 个图块，行优先
+};
+layout(set = 0, binding = 1) uniform sampler2D atlas;
+
+layout(push_constant) uniform PushConstants {
+    vec2 cameraCenter;
+    vec2 viewportSize;
+    float pixelsPerTile;
+    uint firstChunk;
+    uint layerChunksX;
+    uint atlasColumns;
+    ivec2 chunkOrigin;
+    uint visibleChunksX;
+} pc;
+
+layout(location = 0) in vec2 fragTile;
+layout(location = 1) flat in uint fragChunk;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    ivec2 tile = clamp(ivec2(floor(fragTile)), ivec2(0), ivec2(CHUNK_SIZE - 1));
+    uint id    = tiles[fragChunk * CHUNK_SIZE * CHUNK_SIZE + uint(tile.y) * CHUNK_SIZE + uint(tile.x)];
+    if (id == 0u) discard;
+
+    // 格子边长由图集宽度和列数得出，texelFetch 保证像素风格图块不会串色
+    uint cell    = id - 1u;
+    int tileSize = textureSize(atlas, 0).x / int(pc.atlasColumns);
+    ivec2 inner  = clamp(ivec2(fract(fragTile) * float(tileSize)), ivec2(0), ivec2(tileSize - 1));
+    ivec2 texel  = ivec2(cell % pc.atlasColumns, cell / pc.atlasColumns) * tileSize + inner;
+    vec4 color   = texelFetch(atlas, texel, 0);
+    if (color.a <= 0.0) discard;
+    outColor = color;
+}
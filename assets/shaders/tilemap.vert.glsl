@@ -0,0 +1,31 @@
+#version 450
+
+// 图块地图：每个实例是一个可见区块的四边形，顶点由 gl_VertexIndex 生成，没有顶点输入
+const uint CHUNK_SIZE = 32;
+
+layout(push_constant) uniform PushConstants {
+    vec2 cameraCenter;   // 视口中心对应的图块坐标
+    vec2 viewportSize;   // 像素
+    float pixelsPerTile;
+    uint firstChunk;     // 图层第一个区块在图块缓冲区中的编号
+    uint layerChunksX;   // 图层每行的区块数
+    uint atlasColumns;
+    ivec2 chunkOrigin;   // 可见区块矩形的左上角
+    uint visibleChunksX; // 可见区块矩形的宽度
+} pc;
+
+layout(location = 0) out vec2 fragTile;       // 区块内的图块坐标 [0, CHUNK_SIZE)
+layout(location = 1) flat out uint fragChunk; // 区块在图块缓冲区中的编号
+
+const vec2 CORNERS[6] = vec2[](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0));
+
+void main() {
+    uint instance = uint(gl_InstanceIndex);
+    ivec2 chunk   = pc.chunkOrigin + ivec2(instance % pc.visibleChunksX, instance / pc.visibleChunksX);
+    vec2 corner   = CORNERS[gl_VertexIndex];
+    vec2 tile     = (vec2(chunk) + corner) * float(CHUNK_SIZE);
+    vec2 pixel    = (tile - pc.cameraCenter) * pc.pixelsPerTile + pc.viewportSize * 0.5;
+    gl_Position   = vec4(pixel / pc.viewportSize * 2.0 - 1.0, 0.0, 1.0);
+    fragTile      = corner * float(CHUNK_SIZE);
+    fragChunk     = pc.firstChunk + uint(chunk.y) * pc.layerChunksX + uint(chunk.x);
+}
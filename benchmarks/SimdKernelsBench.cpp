@@ -0,0 +1,223 @@
+// 批量数学内核的正确性与吞吐量对比：
+// 每个当前 CPU 支持的 SIMD 路径先在多种长度（覆盖不足一组的尾部）上与标量参考实现逐位比较，
+// 再对同一份数据计时，输出每个内核的吞吐量和相对标量路径的加速比。有结果不一致时返回 1。
+#include "engine/utils/SimdKernels.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace engine::utils;
+
+namespace {
+#pragma region Constants
+const uint32_t BENCH_ELEMENT_COUNT = 4096;                                        // 计时用的元素数量，输入输出都能放进 L2
+const double BENCH_MIN_SECONDS     = 0.2;                                         // 每个内核至少计时的秒数
+const uint32_t CHECK_COUNTS[]      = {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 1000}; // 校验用的长度，覆盖不足一组的尾部
+#pragma endregion
+
+/**
+ * @struct Inputs
+ * @brief 一组随机输入，四元数已归一化，包围盒的 min 不大于 max
+ */
+struct Inputs {
+    uint32_t count = 0;
+    std::vector<float> px, py, pz;       // 点、包围球中心、平移
+    std::vector<float> qx, qy, qz, qw;   // 旋转
+    std::vector<float> sx, sy, sz;       // 缩放
+    std::vector<float> radii;            // 包围球半径
+    std::vector<float> minX, minY, minZ; // 包围盒
+    std::vector<float> maxX, maxY, maxZ;
+    glm::mat4 matrix{1.0f};
+    FrustumPlanes planes{};
+
+    ConstVec3Soa points() const { return {px.data(), py.data(), pz.data()}; }
+    ConstQuatSoa rotations() const { return {qx.data(), qy.data(), qz.data(), qw.data()}; }
+    ConstVec3Soa scales() const { return {sx.data(), sy.data(), sz.data()}; }
+    ConstAabbSoa boxes() const { return {{minX.data(), minY.data(), minZ.data()}, {maxX.data(), maxY.data(), maxZ.data()}}; }
+};
+
+/**
+ * @struct Outputs
+ * @brief 所有内核的输出，按字节比较
+ */
+struct Outputs {
+    std::vector<float> x, y, z;
+    std::vector<glm::mat4> matrices;
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+    Aabb merged;
+    std::vector<uint8_t> sphereVisible, boxVisible;
+
+    explicit Outputs(uint32_t count)
+        : x(count), y(count), z(count), matrices(count), minX(count), minY(count), minZ(count), maxX(count), maxY(count), maxZ(count),
+          sphereVisible(count), boxVisible(count) {}
+
+    Vec3Soa points() { return {x.data(), y.data(), z.data()}; }
+    AabbSoa boxes() { return {{minX.data(), minY.data(), minZ.data()}, {maxX.data(), maxY.data(), maxZ.data()}}; }
+};
+
+Inputs makeInputs(uint32_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> value(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> positive(0.1f, 5.0f);
+
+    Inputs in;
+    in.count = count;
+    for (auto *array : {&in.px, &in.py, &in.pz, &in.qx, &in.qy, &in.qz, &in.qw, &in.sx, &in.sy, &in.sz, &in.radii,
+                        &in.minX, &in.minY, &in.minZ, &in.maxX, &in.maxY, &in.maxZ}) {
+        array->resize(count);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        in.px[i] = value(rng);
+        in.py[i] = value(rng);
+        in.pz[i] = value(rng);
+        float qx = unit(rng), qy = unit(rng), qz = unit(rng), qw = unit(rng);
+        float length = std::sqrt(qx * qx + qy * qy + qz * qz + qw * qw) + 1e-6f;
+        in.qx[i]     = qx / length;
+        in.qy[i]     = qy / length;
+        in.qz[i]     = qz / length;
+        in.qw[i]     = qw / length;
+        in.sx[i]     = positive(rng);
+        in.sy[i]     = positive(rng);
+        in.sz[i]     = positive(rng);
+        in.radii[i]  = positive(rng);
+        in.minX[i]   = in.px[i] - positive(rng);
+        in.minY[i]   = in.py[i] - positive(rng);
+        in.minZ[i]   = in.pz[i] - positive(rng);
+        in.maxX[i]   = in.px[i] + positive(rng);
+        in.maxY[i]   = in.py[i] + positive(rng);
+        in.maxZ[i]   = in.pz[i] + positive(rng);
+    }
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 3; row++) {
+            in.matrix[column][row] = unit(rng) * (column == 3 ? 10.0f : 1.0f);
+        }
+    }
+    // 一部分包围体在视锥内，一部分在视锥外
+    glm::mat4 viewProjection(1.0f);
+    viewProjection[0][0] = 0.03f;
+    viewProjection[1][1] = 0.03f;
+    viewProjection[2][2] = 0.01f;
+    viewProjection[3][2] = 0.5f;
+    in.planes            = extractFrustumPlanes(viewProjection);
+    return in;
+}
+
+/**
+ * @struct Kernel
+ * @brief 一个待比较的内核：run 把结果写入 Outputs，compare 比较两份结果
+ */
+struct Kernel {
+    const char *name;
+    std::function<void(const Inputs &, Outputs &)> run;
+    std::function<bool(const Outputs &, const Outputs &, uint32_t)> compare;
+};
+
+template <typename T>
+bool sameBytes(const std::vector<T> &a, const std::vector<T> &b, uint32_t count) {
+    return count == 0 || std::memcmp(a.data(), b.data(), count * sizeof(T)) == 0;
+}
+
+std::vector<Kernel> makeKernels() {
+    return {
+        {"transformPoints",
+         [](const Inputs &in, Outputs &out) { transformPoints(in.matrix, in.points(), out.points(), in.count); },
+         [](const Outputs &a, const Outputs &b, uint32_t n) { return sameBytes(a.x, b.x, n) && sameBytes(a.y, b.y, n) && sameBytes(a.z, b.z, n); }},
+        {"composeTrs",
+         [](const Inputs &in, Outputs &out) { composeTrs(in.points(), in.rotations(), in.scales(), out.matrices.data(), in.count); },
+         [](const Outputs &a, const Outputs &b, uint32_t n) { return sameBytes(a.matrices, b.matrices, n); }},
+        {"transformAabbs",
+         [](const Inputs &in, Outputs &out) { transformAabbs(in.matrix, in.boxes(), out.boxes(), in.count); },
+         [](const Outputs &a, const Outputs &b, uint32_t n) {
+             return sameBytes(a.minX, b.minX, n) && sameBytes(a.minY, b.minY, n) && sameBytes(a.minZ, b.minZ, n) &&
+                    sameBytes(a.maxX, b.maxX, n) && sameBytes(a.maxY, b.maxY, n) && sameBytes(a.maxZ, b.maxZ, n);
+         }},
+        {"mergeAabbs",
+         [](const Inputs &in, Outputs &out) { out.merged = mergeAabbs(in.boxes(), in.count); },
+         [](const Outputs &a, const Outputs &b, uint32_t) { return std::memcmp(&a.merged, &b.merged, sizeof(Aabb)) == 0; }},
+        {"cullSpheres",
+         [](const Inputs &in, Outputs &out) { cullSpheres(in.planes, in.points(), in.radii.data(), out.sphereVisible.data(), in.count); },
+         [](const Outputs &a, const Outputs &b, uint32_t n) { return sameBytes(a.sphereVisible, b.sphereVisible, n); }},
+        {"cullAabbs",
+         [](const Inputs &in, Outputs &out) { cullAabbs(in.planes, in.boxes(), out.boxVisible.data(), in.count); },
+         [](const Outputs &a, const Outputs &b, uint32_t n) { return sameBytes(a.boxVisible, b.boxVisible, n); }},
+    };
+}
+
+// 返回每秒处理的元素数量
+double measure(const Kernel &kernel, const Inputs &in, Outputs &out) {
+    using Clock = std::chrono::steady_clock;
+    kernel.run(in, out); // 预热
+    uint64_t iterations = 0;
+    auto start          = Clock::now();
+    double elapsed      = 0.0;
+    do {
+        for (int i = 0; i < 64; i++) {
+            kernel.run(in, out);
+        }
+        iterations += 64;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < BENCH_MIN_SECONDS);
+    return static_cast<double>(iterations) * in.count / elapsed;
+}
+} // namespace
+
+int main() {
+    spdlog::set_level(spdlog::level::warn);
+    const std::vector<Kernel> kernels = makeKernels();
+    std::vector<SimdIsa> isas;
+    for (SimdIsa isa : {SimdIsa::Scalar, SimdIsa::Sse2, SimdIsa::Avx2, SimdIsa::Neon}) {
+        if (isSimdIsaSupported(isa)) isas.push_back(isa);
+    }
+
+    // 正确性：各路径与标量参考实现逐位比较
+    uint32_t mismatches = 0;
+    for (uint32_t count : CHECK_COUNTS) {
+        Inputs in = makeInputs(count, count + 1);
+        for (const Kernel &kernel : kernels) {
+            Outputs reference(count);
+            setSimdIsa(SimdIsa::Scalar);
+            kernel.run(in, reference);
+            for (SimdIsa isa : isas) {
+                if (isa == SimdIsa::Scalar) continue;
+                Outputs result(count);
+                setSimdIsa(isa);
+                kernel.run(in, result);
+                if (!kernel.compare(reference, result, count)) {
+                    std::printf("不一致: %s %s 长度 %u\n", getSimdIsaName(isa), kernel.name, count);
+                    mismatches++;
+                }
+            }
+        }
+    }
+    std::printf("正确性: %u 个路径与标量路径比较, %u 处不一致\n", static_cast<uint32_t>(isas.size()) - 1, mismatches);
+
+    // 吞吐量：百万元素每秒，括号内为相对标量路径的加速比
+    Inputs in = makeInputs(BENCH_ELEMENT_COUNT, 42);
+    Outputs out(BENCH_ELEMENT_COUNT);
+    std::printf("%-16s", "内核");
+    for (SimdIsa isa : isas) {
+        std::printf("%20s", getSimdIsaName(isa));
+    }
+    std::printf("\n");
+    for (const Kernel &kernel : kernels) {
+        std::printf("%-16s", kernel.name);
+        double scalar = 0.0;
+        for (SimdIsa isa : isas) {
+            setSimdIsa(isa);
+            double rate = measure(kernel, in, out);
+            if (isa == SimdIsa::Scalar) scalar = rate;
+            std::printf("%12.1f (%4.1fx)", rate / 1e6, rate / scalar);
+        }
+        std::printf("\n");
+    }
+    return mismatches == 0 ? 0 : 1;
+}
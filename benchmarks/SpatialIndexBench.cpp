@@ -0,0 +1,210 @@
+// 动态 AABB 树的正确性与性能对比：
+// 对每种代理数量建两棵相同的树，同一批移动分别用逐个 update() 和批量 update() 应用并计时；
+// 之后在两棵树上执行 AABB、半径、射线和视锥查询，结果与遍历全部代理的暴力查询逐一比较，同时计时。
+// 有结果不一致时返回 1。
+#include "engine/core/SpatialIndex.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace engine::core;
+using engine::utils::Aabb;
+
+namespace {
+#pragma region Constants
+const uint32_t PROXY_COUNTS[]    = {10000, 100000, 1000000}; // 对比的代理数量
+const uint32_t QUERY_COUNT       = 200;                      // 每棵树的查询次数，四种查询轮流进行
+const uint32_t MOVE_STRIDE       = 10;                       // 每 MOVE_STRIDE 个代理移动一个
+const uint32_t TELEPORT_STRIDE   = 100;                      // 每 TELEPORT_STRIDE 个代理瞬移到随机位置，其余只小幅移动
+const float QUERY_RADIUS         = 5.0f;                     // AABB 查询的半边长和半径查询的半径
+const float QUERY_RAY_LENGTH     = 50.0f;                    // 射线查询的长度
+const float WORLD_SIZE_PER_PROXY = 4.0f;                     // 世界边长为 代理数量的立方根 * 该值，密度与代理数量无关
+#pragma endregion
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * @struct Query
+ * @brief 一次查询的参数，kind 为 0 AABB、1 半径、2 射线、3 视锥
+ */
+struct Query {
+    uint32_t kind = 0;
+    glm::vec3 center{0.0f};
+    glm::vec3 direction{1.0f, 0.0f, 0.0f};
+    engine::utils::FrustumPlanes planes{};
+};
+
+void runTreeQuery(const SpatialIndex &index, const Query &query, std::vector<uint32_t> &out) {
+    switch (query.kind) {
+    case 0: index.queryAabb({query.center - glm::vec3(QUERY_RADIUS), query.center + glm::vec3(QUERY_RADIUS)}, out); break;
+    case 1: index.queryRadius(query.center, QUERY_RADIUS, out); break;
+    case 2: index.queryRay(query.center, query.direction, QUERY_RAY_LENGTH, out); break;
+    default: index.queryFrustum(query.planes, out); break;
+    }
+}
+
+// 射线进入包围盒的参数，不相交时返回 -1
+float rayEntry(const Aabb &box, const glm::vec3 &origin, const glm::vec3 &direction) {
+    glm::vec3 inverse = 1.0f / direction;
+    glm::vec3 t0      = (box.min - origin) * inverse;
+    glm::vec3 t1      = (box.max - origin) * inverse;
+    glm::vec3 tNear   = glm::min(t0, t1);
+    glm::vec3 tFar    = glm::max(t0, t1);
+    float entry       = std::max({tNear.x, tNear.y, tNear.z, 0.0f});
+    float exit        = std::min({tFar.x, tFar.y, tFar.z, QUERY_RAY_LENGTH});
+    return entry <= exit ? entry : -1.0f;
+}
+
+// 遍历全部代理的参考实现，判定条件与 SpatialIndex 对精确包围盒的判定相同
+bool bruteForceHit(const Aabb &box, const Query &query) {
+    switch (query.kind) {
+    case 0: {
+        glm::vec3 min = query.center - glm::vec3(QUERY_RADIUS);
+        glm::vec3 max = query.center + glm::vec3(QUERY_RADIUS);
+        return glm::all(glm::lessThanEqual(box.min, max)) && glm::all(glm::greaterThanEqual(box.max, min));
+    }
+    case 1: {
+        glm::vec3 delta = glm::max(glm::max(box.min - query.center, query.center - box.max), glm::vec3(0.0f));
+        return glm::dot(delta, delta) <= QUERY_RADIUS * QUERY_RADIUS;
+    }
+    case 2: return rayEntry(box, query.center, query.direction) >= 0.0f;
+    default: {
+        glm::vec3 center = (box.min + box.max) * 0.5f;
+        glm::vec3 extent = (box.max - box.min) * 0.5f;
+        for (const glm::vec4 &plane : query.planes) {
+            glm::vec3 normal = glm::vec3(plane);
+            if (glm::dot(normal, center) + plane.w < -glm::dot(glm::abs(normal), extent)) return false;
+        }
+        return true;
+    }
+    }
+}
+
+/**
+ * @struct QueryResult
+ * @brief 一棵树上全部查询的耗时和不一致次数
+ */
+struct QueryResult {
+    double treeMs       = 0.0;
+    double bruteMs      = 0.0;
+    uint32_t mismatches = 0;
+};
+
+// boxes 的下标即代理的 userData
+QueryResult compareQueries(const SpatialIndex &index, const std::vector<Aabb> &boxes, const std::vector<Query> &queries) {
+    QueryResult result;
+    std::vector<uint32_t> fromTree;
+    std::vector<uint32_t> fromBruteForce;
+    for (const Query &query : queries) {
+        fromTree.clear();
+        fromBruteForce.clear();
+        auto start = Clock::now();
+        runTreeQuery(index, query, fromTree);
+        result.treeMs += elapsedMs(start);
+
+        start = Clock::now();
+        for (uint32_t i = 0; i < boxes.size(); i++) {
+            if (bruteForceHit(boxes[i], query)) fromBruteForce.push_back(i);
+        }
+        result.bruteMs += elapsedMs(start);
+
+        std::sort(fromTree.begin(), fromTree.end());
+        if (fromTree != fromBruteForce) {
+            std::printf("不一致: 查询类型 %u, 树 %zu 个, 遍历 %zu 个\n", query.kind, fromTree.size(), fromBruteForce.size());
+            result.mismatches++;
+        }
+        if (query.kind != 2) continue;
+
+        // 最近相交的距离必须与遍历得到的最小进入参数相同
+        SpatialRayHit hit;
+        bool found    = index.raycast(query.center, query.direction, QUERY_RAY_LENGTH, hit);
+        float nearest = INFINITY;
+        for (uint32_t i : fromBruteForce) {
+            nearest = std::min(nearest, rayEntry(boxes[i], query.center, query.direction));
+        }
+        if (found != !fromBruteForce.empty() || (found && hit.distance != nearest)) {
+            std::printf("不一致: 最近相交\n");
+            result.mismatches++;
+        }
+    }
+    return result;
+}
+} // namespace
+
+int main() {
+    spdlog::set_level(spdlog::level::warn);
+    uint32_t mismatches = 0;
+    std::printf("%10s %12s %12s %10s %12s %12s %16s\n", "代理数", "树查询ms", "遍历查询ms", "移动数", "逐个更新ms", "批量更新ms", "树高(逐个/批量)");
+    for (uint32_t count : PROXY_COUNTS) {
+        std::mt19937 rng(count);
+        float worldSize = std::cbrt(static_cast<float>(count)) * WORLD_SIZE_PER_PROXY;
+        std::uniform_real_distribution<float> position(0.0f, worldSize);
+        std::uniform_real_distribution<float> size(0.2f, 1.5f);
+        std::uniform_real_distribution<float> offset(-0.3f, 0.3f);
+
+        std::vector<Aabb> boxes(count);
+        for (Aabb &box : boxes) {
+            glm::vec3 min(position(rng), position(rng), position(rng));
+            box = {min, min + glm::vec3(size(rng), size(rng), size(rng))};
+        }
+        SpatialIndex single;
+        SpatialIndex batched;
+        std::vector<SpatialProxyId> ids(count);
+        for (uint32_t i = 0; i < count; i++) {
+            ids[i] = single.create(boxes[i], i);
+            batched.create(boxes[i], i); // 两棵树按相同顺序创建，代理 id 相同
+        }
+
+        // 大部分移动的代理仍在宽松包围盒或父节点范围内，少数瞬移的代理需要重新插入
+        std::vector<SpatialUpdate> updates;
+        for (uint32_t i = 0; i < count; i += MOVE_STRIDE) {
+            glm::vec3 delta(offset(rng), offset(rng), offset(rng));
+            if (i % TELEPORT_STRIDE == 0) delta = glm::vec3(position(rng), position(rng), position(rng)) - boxes[i].min;
+            boxes[i] = {boxes[i].min + delta, boxes[i].max + delta};
+            updates.push_back({ids[i], boxes[i]});
+        }
+        auto start = Clock::now();
+        for (const SpatialUpdate &update : updates) {
+            single.update(update.proxy, update.bounds);
+        }
+        double singleMs = elapsedMs(start);
+        start           = Clock::now();
+        batched.update(updates);
+        double batchedMs = elapsedMs(start);
+
+        std::vector<Query> queries(QUERY_COUNT);
+        for (uint32_t i = 0; i < QUERY_COUNT; i++) {
+            Query &query    = queries[i];
+            query.kind      = i % 4;
+            query.center    = glm::vec3(position(rng), position(rng), position(rng));
+            query.direction = glm::normalize(glm::vec3(offset(rng), offset(rng), offset(rng)));
+            // 以查询中心为中心的窄视锥
+            glm::mat4 viewProjection(1.0f);
+            viewProjection[0][0] = 0.1f;
+            viewProjection[1][1] = 0.1f;
+            viewProjection[2][2] = 0.01f;
+            viewProjection[3][0] = -query.center.x * 0.1f;
+            viewProjection[3][1] = -query.center.y * 0.1f;
+            viewProjection[3][2] = -query.center.z * 0.01f + 0.5f;
+            query.planes         = engine::utils::extractFrustumPlanes(viewProjection);
+        }
+        QueryResult singleResult  = compareQueries(single, boxes, queries);
+        QueryResult batchedResult = compareQueries(batched, boxes, queries);
+        mismatches += singleResult.mismatches + batchedResult.mismatches;
+
+        std::printf("%10u %12.4f %12.3f %10zu %12.2f %12.2f %10u/%u\n", count, batchedResult.treeMs / QUERY_COUNT, batchedResult.bruteMs / QUERY_COUNT,
+                    updates.size(), singleMs, batchedMs, single.getStats().height, batched.getStats().height);
+    }
+    std::printf("正确性: %u 处不一致\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,459 @@
+#include "AudioMixer.hpp"
+#include "AudioMixerKernels.hpp"
+
+#include <SDL3/SDL.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define AUDIO_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define AUDIO_SIMD_NEON 1
+#endif
+
+namespace engine::audio {
+
+namespace {
+const float AUDIO_PI        = 3.14159265358979f;
+const float AUDIO_MIN_PITCH = 0.01f;
+const float AUDIO_MAX_PITCH = 16.0f;
+
+void enableFlushToZero() {
+#if defined(AUDIO_SIMD_SSE2)
+    _mm_setcsr(_mm_getcsr() | 0x8040); // FTZ | DAZ：音量淡出到接近 0 时避免非规格化数拖慢运算
+#endif
+}
+
+// 等功率声像：居中时左右各 -3 dB
+void panGains(float gain, float pan, float &left, float &right) {
+    float angle = (std::clamp(pan, -1.0f, 1.0f) + 1.0f) * AUDIO_PI * 0.25f;
+    left        = gain * std::cos(angle);
+    right       = gain * std::sin(angle);
+}
+
+/**
+ * 线性插值重采样交错立体声：dst[i] = src 在 position + i * step 处的值
+ * 调用方保证所有插值位置的下一帧都在 src 范围内
+ */
+void resampleLinear(float *dst, const float *src, double position, double step, uint32_t count) {
+    if (step == 1.0 && position == std::floor(position)) {
+        std::memcpy(dst, src + static_cast<size_t>(position) * AUDIO_CHANNELS, count * AUDIO_CHANNELS * sizeof(float)); // 原速播放且对齐到帧
+        return;
+    }
+    uint32_t i = 0;
+#if defined(AUDIO_SIMD_SSE2)
+    // 每次两帧：(L0 R0 L1 R1)
+    for (; i + 2 <= count; i += 2) {
+        double p0   = position + step * i;
+        double p1   = p0 + step;
+        size_t i0   = static_cast<size_t>(p0);
+        size_t i1   = static_cast<size_t>(p1);
+        float t0    = static_cast<float>(p0 - static_cast<double>(i0));
+        float t1    = static_cast<float>(p1 - static_cast<double>(i1));
+        __m128 a    = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(src + i0 * AUDIO_CHANNELS));
+        a           = _mm_loadh_pi(a, reinterpret_cast<const __m64 *>(src + i1 * AUDIO_CHANNELS));
+        __m128 b    = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(src + (i0 + 1) * AUDIO_CHANNELS));
+        b           = _mm_loadh_pi(b, reinterpret_cast<const __m64 *>(src + (i1 + 1) * AUDIO_CHANNELS));
+        __m128 frac = _mm_set_ps(t1, t1, t0, t0);
+        _mm_storeu_ps(dst + i * AUDIO_CHANNELS, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), frac)));
+    }
+#elif defined(AUDIO_SIMD_NEON)
+    for (; i + 2 <= count; i += 2) {
+        double p0        = position + step * i;
+        double p1        = p0 + step;
+        size_t i0        = static_cast<size_t>(p0);
+        size_t i1        = static_cast<size_t>(p1);
+        float t0         = static_cast<float>(p0 - static_cast<double>(i0));
+        float t1         = static_cast<float>(p1 - static_cast<double>(i1));
+        float32x4_t a    = vcombine_f32(vld1_f32(src + i0 * AUDIO_CHANNELS), vld1_f32(src + i1 * AUDIO_CHANNELS));
+        float32x4_t b    = vcombine_f32(vld1_f32(src + (i0 + 1) * AUDIO_CHANNELS), vld1_f32(src + (i1 + 1) * AUDIO_CHANNELS));
+        float32x4_t frac = vcombine_f32(vdup_n_f32(t0), vdup_n_f32(t1));
+        vst1q_f32(dst + i * AUDIO_CHANNELS, vmlaq_f32(a, vsubq_f32(b, a), frac));
+    }
+#endif
+    for (; i < count; i++) {
+        double p         = position + step * i;
+        size_t index     = static_cast<size_t>(p);
+        float t          = static_cast<float>(p - static_cast<double>(index));
+        const float *a   = src + index * AUDIO_CHANNELS;
+        dst[i * 2]       = a[0] + (a[2] - a[0]) * t;
+        dst[i * 2 + 1]   = a[1] + (a[3] - a[1]) * t;
+    }
+}
+
+/**
+ * mix += src * gain，左右声道的音量分别从 gainL / gainR 开始每帧增加 stepL / stepR
+ */
+void accumulateRamp(float *mix, const float *src, uint32_t frames, float gainL, float gainR, float stepL, float stepR) {
+    uint32_t i = 0;
+#if defined(AUDIO_SIMD_SSE2)
+    __m128 gain      = _mm_setr_ps(gainL, gainR, gainL + stepL, gainR + stepR);
+    __m128 increment = _mm_setr_ps(2.0f * stepL, 2.0f * stepR, 2.0f * stepL, 2.0f * stepR);
+    for (; i + 2 <= frames; i += 2) {
+        __m128 sum = _mm_add_ps(_mm_loadu_ps(mix + i * 2), _mm_mul_ps(_mm_loadu_ps(src + i * 2), gain));
+        _mm_storeu_ps(mix + i * 2, sum);
+        gain = _mm_add_ps(gain, increment);
+    }
+#elif defined(AUDIO_SIMD_NEON)
+    const float initial[4] = {gainL, gainR, gainL + stepL, gainR + stepR};
+    const float steps[4]   = {2.0f * stepL, 2.0f * stepR, 2.0f * stepL, 2.0f * stepR};
+    float32x4_t gain       = vld1q_f32(initial);
+    float32x4_t increment  = vld1q_f32(steps);
+    for (; i + 2 <= frames; i += 2) {
+        vst1q_f32(mix + i * 2, vmlaq_f32(vld1q_f32(mix + i * 2), vld1q_f32(src + i * 2), gain));
+        gain = vaddq_f32(gain, increment);
+    }
+#endif
+    for (; i < frames; i++) {
+        mix[i * 2] += src[i * 2] * (gainL + stepL * static_cast<float>(i));
+        mix[i * 2 + 1] += src[i * 2 + 1] * (gainR + stepR * static_cast<float>(i));
+    }
+}
+
+/**
+ * dst = clamp(mix * gain, -1, 1)，音量从 gain 开始每帧增加 step
+ */
+void applyMasterGain(float *dst, const float *mix, uint32_t frames, float gain, float step) {
+    uint32_t i = 0;
+#if defined(AUDIO_SIMD_SSE2)
+    __m128 gains     = _mm_setr_ps(gain, gain, gain + step, gain + step);
+    __m128 increment = _mm_set1_ps(2.0f * step);
+    __m128 low       = _mm_set1_ps(-1.0f);
+    __m128 high      = _mm_set1_ps(1.0f);
+    for (; i + 2 <= frames; i += 2) {
+        __m128 value = _mm_mul_ps(_mm_loadu_ps(mix + i * 2), gains);
+        _mm_storeu_ps(dst + i * 2, _mm_min_ps(_mm_max_ps(value, low), high));
+        gains = _mm_add_ps(gains, increment);
+    }
+#elif defined(AUDIO_SIMD_NEON)
+    const float initial[4] = {gain, gain, gain + step, gain + step};
+    float32x4_t gains      = vld1q_f32(initial);
+    float32x4_t increment  = vdupq_n_f32(2.0f * step);
+    float32x4_t low        = vdupq_n_f32(-1.0f);
+    float32x4_t high       = vdupq_n_f32(1.0f);
+    for (; i + 2 <= frames; i += 2) {
+        float32x4_t value = vmulq_f32(vld1q_f32(mix + i * 2), gains);
+        vst1q_f32(dst + i * 2, vminq_f32(vmaxq_f32(value, low), high));
+        gains = vaddq_f32(gains, increment);
+    }
+#endif
+    for (; i < frames; i++) {
+        float frameGain = gain + step * static_cast<float>(i);
+        dst[i * 2]      = std::clamp(mix[i * 2] * frameGain, -1.0f, 1.0f);
+        dst[i * 2 + 1]  = std::clamp(mix[i * 2 + 1] * frameGain, -1.0f, 1.0f);
+    }
+}
+
+/**
+ * 总线累加和主音量的内核，AVX 路径在单独的编译单元中，运行时根据 CPU 选择
+ */
+struct MixKernels {
+    const char *name;
+    void (*accumulateRamp)(float *mix, const float *src, uint32_t frames, float gainL, float gainR, float stepL, float stepR);
+    void (*applyMasterGain)(float *dst, const float *mix, uint32_t frames, float gain, float step);
+};
+
+const MixKernels &mixKernels() {
+    static const MixKernels kernels = []() -> MixKernels {
+#if defined(AUDIO_KERNELS_X86)
+        if (SDL_HasAVX()) return {"AVX", &accumulateRampAvx, &applyMasterGainAvx};
+#endif
+#if defined(AUDIO_SIMD_SSE2)
+        return {"SSE2", &accumulateRamp, &applyMasterGain};
+#elif defined(AUDIO_SIMD_NEON)
+        return {"NEON", &accumulateRamp, &applyMasterGain};
+#else
+        return {"Scalar", &accumulateRamp, &applyMasterGain};
+#endif
+    }();
+    return kernels;
+}
+} // namespace
+
+AudioMixer::AudioMixer() = default;
+
+AudioMixer::~AudioMixer() = default;
+
+void AudioMixer::init() {
+    // 设备缓冲区越小延迟越低，回调也越频繁；SDL 把它当作建议值
+    SDL_SetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES, std::to_string(AUDIO_DEVICE_FRAMES).c_str());
+    SDL_AudioSpec spec{SDL_AUDIO_F32, static_cast<int>(AUDIO_CHANNELS), AUDIO_SAMPLE_RATE};
+    m_stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, &AudioMixer::audioCallback, this);
+    if (m_stream == nullptr) {
+        throw std::runtime_error(std::string("AudioMixer::init()::打开音频设备失败: ") + SDL_GetError());
+    }
+    if (!SDL_ResumeAudioStreamDevice(m_stream)) {
+        throw std::runtime_error(std::string("AudioMixer::init()::启动音频设备失败: ") + SDL_GetError());
+    }
+    spdlog::trace("AudioMixer::init()::音频混音器初始化成功, 采样率: {}, 设备缓冲区: {} 帧, 混音内核: {}", AUDIO_SAMPLE_RATE, AUDIO_DEVICE_FRAMES,
+                  mixKernels().name);
+}
+
+void AudioMixer::cleanup() {
+    // 销毁音频流会关闭设备，返回后回调不会再运行
+    if (m_stream != nullptr) {
+        SDL_DestroyAudioStream(m_stream);
+        m_stream = nullptr;
+    }
+    m_voices = {};
+    m_sounds.clear();
+}
+
+SoundId AudioMixer::loadSound(const std::string &path) {
+    SDL_AudioSpec spec{};
+    Uint8 *data   = nullptr;
+    Uint32 length = 0;
+    if (!SDL_LoadWAV(path.c_str(), &spec, &data, &length)) {
+        throw std::runtime_error("AudioMixer::loadSound()::加载音频失败: " + path + ", " + SDL_GetError());
+    }
+
+    // 转换为浮点立体声，保持原采样率，重采样在混音时进行
+    SDL_AudioSpec target{SDL_AUDIO_F32, static_cast<int>(AUDIO_CHANNELS), spec.freq};
+    Uint8 *converted    = nullptr;
+    int convertedLength = 0;
+    bool success        = SDL_ConvertAudioSamples(&spec, data, static_cast<int>(length), &target, &converted, &convertedLength);
+    SDL_free(data);
+    if (!success) {
+        throw std::runtime_error("AudioMixer::loadSound()::转换音频格式失败: " + path + ", " + SDL_GetError());
+    }
+    uint32_t frames = static_cast<uint32_t>(convertedLength) / (AUDIO_CHANNELS * sizeof(float));
+    if (frames == 0) {
+        SDL_free(converted);
+        throw std::runtime_error("AudioMixer::loadSound()::音频为空: " + path);
+    }
+
+    auto sound        = std::make_unique<Sound>();
+    sound->frames     = frames;
+    sound->sampleRate = static_cast<uint32_t>(spec.freq);
+    sound->samples.assign((static_cast<size_t>(frames) + 1) * AUDIO_CHANNELS, 0.0f); // 末尾多留一帧静音，插值时可以安全读取下一帧
+    std::memcpy(sound->samples.data(), converted, static_cast<size_t>(frames) * AUDIO_CHANNELS * sizeof(float));
+    SDL_free(converted);
+    m_sounds.push_back(std::move(sound));
+    spdlog::info("AudioMixer::loadSound()::加载音频: {}, 帧数: {}, 采样率: {}", path, frames, spec.freq);
+    return static_cast<SoundId>(m_sounds.size() - 1);
+}
+
+VoiceId AudioMixer::play(SoundId sound, const PlayParams &params) {
+    if (sound >= m_sounds.size()) {
+        throw std::runtime_error("AudioMixer::play()::无效的声音编号");
+    }
+    VoiceId id = m_nextVoiceId++;
+    if (m_nextVoiceId == INVALID_VOICE) m_nextVoiceId = 1;
+
+    Command command;
+    command.type  = Command::Type::Play;
+    command.voice = id;
+    command.sound = m_sounds[sound].get();
+    command.gain  = params.gain;
+    command.pan   = params.pan;
+    command.pitch = params.pitch;
+    command.loop  = params.loop;
+    pushCommand(command);
+    return id;
+}
+
+void AudioMixer::stop(VoiceId voice) {
+    Command command;
+    command.type  = Command::Type::Stop;
+    command.voice = voice;
+    pushCommand(command);
+}
+
+void AudioMixer::setVoiceGain(VoiceId voice, float gain, float pan) {
+    Command command;
+    command.type  = Command::Type::SetGain;
+    command.voice = voice;
+    command.gain  = gain;
+    command.pan   = pan;
+    pushCommand(command);
+}
+
+void AudioMixer::setVoicePitch(VoiceId voice, float pitch) {
+    Command command;
+    command.type  = Command::Type::SetPitch;
+    command.voice = voice;
+    command.pitch = pitch;
+    pushCommand(command);
+}
+
+void AudioMixer::setMasterGain(float gain) {
+    Command command;
+    command.type = Command::Type::SetMasterGain;
+    command.gain = gain;
+    pushCommand(command);
+}
+
+void AudioMixer::pushCommand(const Command &command) {
+    if (!m_commands.push(command)) m_droppedCommands++;
+}
+
+AudioStats AudioMixer::getStats() const {
+    AudioStats stats;
+    stats.callbacks         = m_callbacks.load(std::memory_order_relaxed);
+    stats.underruns         = m_underruns.load(std::memory_order_relaxed);
+    stats.callbackOverruns  = m_callbackOverruns.load(std::memory_order_relaxed);
+    stats.lastCallbackMs    = static_cast<double>(m_lastCallbackNs.load(std::memory_order_relaxed)) / 1e6;
+    stats.maxCallbackMs     = static_cast<double>(m_maxCallbackNs.load(std::memory_order_relaxed)) / 1e6;
+    double totalCallbackNs  = static_cast<double>(m_totalCallbackNs.load(std::memory_order_relaxed));
+    double totalAudioNs     = static_cast<double>(m_totalAudioNs.load(std::memory_order_relaxed));
+    stats.averageCallbackMs = stats.callbacks > 0 ? totalCallbackNs / static_cast<double>(stats.callbacks) / 1e6 : 0.0;
+    stats.callbackLoad      = totalAudioNs > 0.0 ? totalCallbackNs / totalAudioNs : 0.0;
+    stats.activeVoices      = m_activeVoices.load(std::memory_order_relaxed);
+    stats.rejectedVoices    = m_rejectedVoices.load(std::memory_order_relaxed);
+    stats.droppedCommands   = m_droppedCommands;
+    return stats;
+}
+
+#pragma region Audio Thread
+void AudioMixer::audioCallback(void *userdata, SDL_AudioStream *stream, int additionalAmount, int) {
+    static_cast<AudioMixer *>(userdata)->render(stream, additionalAmount);
+}
+
+void AudioMixer::render(SDL_AudioStream *stream, int bytes) {
+    if (bytes <= 0) return;
+    auto start = std::chrono::steady_clock::now();
+    enableFlushToZero();
+    processCommands();
+
+    // 按块混音，SDL 请求多少就产生多少，不使用额外的缓冲；不足一帧的请求补齐到整帧，避免设备缺数据
+    const uint32_t frameBytes = AUDIO_CHANNELS * sizeof(float);
+    uint32_t totalFrames      = (static_cast<uint32_t>(bytes) + frameBytes - 1) / frameBytes;
+    int queuedBytes           = 0;
+    for (uint32_t frames = totalFrames; frames > 0;) {
+        uint32_t block = std::min(frames, AUDIO_MIX_BLOCK_FRAMES);
+        mixBlock(block);
+        int blockBytes = static_cast<int>(block * frameBytes);
+        if (SDL_PutAudioStreamData(stream, m_outputBuffer.data(), blockBytes)) queuedBytes += blockBytes;
+        frames -= block;
+    }
+
+    uint64_t elapsedNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    uint64_t audioNs   = static_cast<uint64_t>(totalFrames) * 1000000000ull / AUDIO_SAMPLE_RATE;
+    m_callbacks.fetch_add(1, std::memory_order_relaxed);
+    if (queuedBytes < bytes) m_underruns.fetch_add(1, std::memory_order_relaxed); // 设备这次实际缺数据，不足的部分由 SDL 填充静音
+    m_lastCallbackNs.store(elapsedNs, std::memory_order_relaxed);
+    if (elapsedNs > m_maxCallbackNs.load(std::memory_order_relaxed)) m_maxCallbackNs.store(elapsedNs, std::memory_order_relaxed); // 只有回调线程写入
+    m_totalCallbackNs.fetch_add(elapsedNs, std::memory_order_relaxed);
+    m_totalAudioNs.fetch_add(audioNs, std::memory_order_relaxed);
+    if (elapsedNs > audioNs) m_callbackOverruns.fetch_add(1, std::memory_order_relaxed); // 产生的音频不够播放这次回调本身花掉的时间
+}
+
+void AudioMixer::processCommands() {
+    Command command;
+    for (uint32_t i = 0; i < AUDIO_MAX_COMMANDS_PER_CALLBACK && m_commands.pop(command); i++) {
+        switch (command.type) {
+        case Command::Type::Play: {
+            Voice *voice = findVoice(INVALID_VOICE); // 空闲的声音槽
+            if (voice == nullptr) {
+                m_rejectedVoices.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            float pitch     = std::clamp(command.pitch, AUDIO_MIN_PITCH, AUDIO_MAX_PITCH);
+            voice->sound    = command.sound;
+            voice->id       = command.voice;
+            voice->position = 0.0;
+            voice->step     = static_cast<double>(pitch) * command.sound->sampleRate / AUDIO_SAMPLE_RATE;
+            voice->loop     = command.loop;
+            voice->stopping = false;
+            panGains(command.gain, command.pan, voice->targetL, voice->targetR);
+            voice->gainL = voice->targetL;
+            voice->gainR = voice->targetR;
+            break;
+        }
+        case Command::Type::Stop:
+            if (Voice *voice = findVoice(command.voice)) {
+                voice->targetL  = 0.0f;
+                voice->targetR  = 0.0f;
+                voice->stopping = true;
+            }
+            break;
+        case Command::Type::SetGain:
+            if (Voice *voice = findVoice(command.voice); voice && !voice->stopping) {
+                panGains(command.gain, command.pan, voice->targetL, voice->targetR);
+            }
+            break;
+        case Command::Type::SetPitch:
+            if (Voice *voice = findVoice(command.voice)) {
+                float pitch = std::clamp(command.pitch, AUDIO_MIN_PITCH, AUDIO_MAX_PITCH);
+                voice->step = static_cast<double>(pitch) * voice->sound->sampleRate / AUDIO_SAMPLE_RATE;
+            }
+            break;
+        case Command::Type::SetMasterGain:
+            m_masterTarget = std::max(command.gain, 0.0f);
+            break;
+        }
+    }
+}
+
+AudioMixer::Voice *AudioMixer::findVoice(VoiceId id) {
+    for (Voice &voice : m_voices) {
+        if (voice.id == id) return &voice;
+    }
+    return nullptr;
+}
+
+void AudioMixer::mixBlock(uint32_t frames) {
+    std::fill_n(m_mixBuffer.begin(), frames * AUDIO_CHANNELS, 0.0f);
+    uint32_t activeVoices = 0;
+    for (Voice &voice : m_voices) {
+        if (voice.id == INVALID_VOICE) continue;
+        mixVoice(voice, frames);
+        if (voice.id != INVALID_VOICE) activeVoices++;
+    }
+    float step = (m_masterTarget - m_masterGain) / static_cast<float>(frames);
+    mixKernels().applyMasterGain(m_outputBuffer.data(), m_mixBuffer.data(), frames, m_masterGain, step);
+    m_masterGain = m_masterTarget;
+    m_activeVoices.store(activeVoices, std::memory_order_relaxed);
+}
+
+void AudioMixer::mixVoice(Voice &voice, uint32_t frames) {
+    const Sound &sound = *voice.sound;
+    const double last  = static_cast<double>(sound.frames - 1);
+    float *out         = m_voiceBuffer.data();
+    uint32_t produced  = 0;
+    bool finished      = false;
+    while (produced < frames) {
+        if (voice.position < last) {
+            // 插值的下一帧仍在声音之内，整段交给 SIMD 内核
+            double available = std::ceil((last - voice.position) / voice.step);
+            uint32_t count   = static_cast<uint32_t>(std::min(available, static_cast<double>(frames - produced)));
+            resampleLinear(out + produced * AUDIO_CHANNELS, sound.samples.data(), voice.position, voice.step, count);
+            voice.position += voice.step * count;
+            produced += count;
+            continue;
+        }
+        if (voice.position >= static_cast<double>(sound.frames)) {
+            if (!voice.loop) {
+                finished = true;
+                break;
+            }
+            voice.position = std::fmod(voice.position, static_cast<double>(sound.frames));
+            continue;
+        }
+        // 最后一帧与下一帧之间插值：循环时是第一帧，否则是末尾的静音帧
+        float t                 = static_cast<float>(voice.position - last);
+        const float *current    = sound.samples.data() + (sound.frames - 1) * AUDIO_CHANNELS;
+        const float *next       = voice.loop ? sound.samples.data() : current + AUDIO_CHANNELS;
+        out[produced * 2]       = current[0] + (next[0] - current[0]) * t;
+        out[produced * 2 + 1]   = current[1] + (next[1] - current[1]) * t;
+        voice.position += voice.step;
+        produced++;
+    }
+
+    float invFrames = 1.0f / static_cast<float>(frames);
+    mixKernels().accumulateRamp(m_mixBuffer.data(), out, produced, voice.gainL, voice.gainR, (voice.targetL - voice.gainL) * invFrames,
+                                (voice.targetR - voice.gainR) * invFrames);
+    voice.gainL = voice.targetL;
+    voice.gainR = voice.targetR;
+    if (finished || voice.stopping) voice = Voice{}; // 淡出在本块内完成，释放声音槽
+}
+#pragma endregion
+
+} // namespace engine::audio
@@ -0,0 +1,168 @@
+#pragma once
+#include "../utils/SpscQueue.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct SDL_AudioStream;
+
+namespace engine::audio {
+
+#pragma region Constants
+const int AUDIO_SAMPLE_RATE                    = 48000; // 混音输出的采样率，SDL 负责转换到设备格式
+const uint32_t AUDIO_CHANNELS                  = 2;     // 混音固定为交错立体声
+const uint32_t AUDIO_DEVICE_FRAMES             = 256;   // 请求的设备缓冲区帧数（48 kHz 下约 5.3 ms）
+const uint32_t AUDIO_MIX_BLOCK_FRAMES          = 256;   // 每次混音的帧数，回调请求更多时分块循环
+const uint32_t AUDIO_MAX_VOICES                = 64;    // 同时播放的声音上限，决定回调的最坏耗时
+const uint32_t AUDIO_COMMAND_QUEUE_SIZE        = 1024;  // 游戏线程到回调线程的命令队列容量
+const uint32_t AUDIO_MAX_COMMANDS_PER_CALLBACK = 256;   // 每次回调最多处理的命令数，剩下的留到下一次
+#pragma endregion
+
+using SoundId = uint32_t;
+using VoiceId = uint32_t;
+
+const SoundId INVALID_SOUND = UINT32_MAX;
+const VoiceId INVALID_VOICE = 0;
+
+/**
+ * @struct PlayParams
+ * @brief 播放参数
+ */
+struct PlayParams {
+    float gain  = 1.0f; // 线性音量
+    float pan   = 0.0f; // -1 左，0 居中，1 右（等功率声像）
+    float pitch = 1.0f; // 播放速率，同时改变音高
+    bool loop   = false;
+};
+
+/**
+ * @struct AudioStats
+ * @brief 混音线程统计，累计值从 init() 开始计算
+ */
+struct AudioStats {
+    uint64_t callbacks        = 0;   // 回调次数
+    uint64_t underruns        = 0;   // 回调交给 SDL 的数据少于设备立即需要的量（additionalAmount）的次数，缺的部分设备会播放静音
+    uint64_t callbackOverruns = 0;   // 回调耗时超过它产生的音频时长的次数，即混音跟不上实时；不是设备实际缺数据的次数
+    double lastCallbackMs     = 0.0; // 最近一次回调的 CPU 时间
+    double maxCallbackMs      = 0.0; // 最长的一次回调
+    double averageCallbackMs  = 0.0; // 平均每次回调
+    double callbackLoad       = 0.0; // 回调总耗时 / 产生的音频总时长，1 表示刚好跟上实时
+    uint32_t activeVoices     = 0;   // 最近一次回调结束时正在播放的声音数
+    uint64_t rejectedVoices   = 0;   // 声音数达到 AUDIO_MAX_VOICES 而没有播放的次数
+    uint64_t droppedCommands  = 0;   // 命令队列已满而丢弃的命令数
+};
+
+/**
+ * @class AudioMixer
+ * @brief 在 SDL 音频回调线程中混音的低延迟混音器
+ *
+ * 游戏线程通过单生产者单消费者的无锁队列发送播放、停止和参数命令，回调线程在每次回调开始时处理命令，
+ * 然后按 AUDIO_MIX_BLOCK_FRAMES 分块混合所有声音：线性插值重采样、按块线性过渡的音量与声像、累加到立体声总线，
+ * 这些内核使用 SSE2 / NEON，CPU 支持时累加和主音量在运行时切换到 AVX。回调中没有内存分配和锁，声音数和每次处理的命令数都有上限，耗时有界。
+ * 声音数据在 loadSound() 时转换为 32 位浮点立体声，保持原采样率，在 cleanup() 之前不会释放。
+ * 除回调外的所有函数只能在游戏线程调用。
+ */
+class AudioMixer final {
+public:
+    AudioMixer();
+    ~AudioMixer();
+
+    AudioMixer(const AudioMixer &)            = delete;
+    AudioMixer &operator=(const AudioMixer &) = delete;
+    AudioMixer(AudioMixer &&)                 = delete;
+    AudioMixer &operator=(AudioMixer &&)      = delete;
+
+    void init(); // 打开默认播放设备并开始回调，SDL 音频子系统需要已经初始化
+    void cleanup();
+
+    SoundId loadSound(const std::string &path); // 加载 WAV 文件
+    VoiceId play(SoundId sound, const PlayParams &params = {});
+    void stop(VoiceId voice); // 在一个混音块内淡出后停止
+    void setVoiceGain(VoiceId voice, float gain, float pan);
+    void setVoicePitch(VoiceId voice, float pitch);
+    void setMasterGain(float gain);
+
+    AudioStats getStats() const;
+
+private:
+    struct Sound {
+        std::vector<float> samples; // 交错立体声
+        uint32_t frames     = 0;
+        uint32_t sampleRate = 0;
+    };
+
+    struct Command {
+        enum class Type : uint8_t {
+            Play,
+            Stop,
+            SetGain,
+            SetPitch,
+            SetMasterGain,
+        };
+        Type type          = Type::Play;
+        VoiceId voice      = INVALID_VOICE;
+        const Sound *sound = nullptr;
+        float gain         = 1.0f;
+        float pan          = 0.0f;
+        float pitch        = 1.0f;
+        bool loop          = false;
+    };
+
+    // 只由回调线程访问
+    struct Voice {
+        const Sound *sound = nullptr;
+        VoiceId id         = INVALID_VOICE;
+        double position    = 0.0;  // 在声音中的帧位置，带小数
+        double step        = 1.0;  // 每个输出帧前进的源帧数 = pitch * 源采样率 / 输出采样率
+        float gainL        = 0.0f; // 当前音量，每个混音块内线性过渡到目标值，避免爆音
+        float gainR        = 0.0f;
+        float targetL      = 0.0f;
+        float targetR      = 0.0f;
+        bool loop          = false;
+        bool stopping      = false; // 目标音量已经设为 0，本块结束后释放
+    };
+
+    static void audioCallback(void *userdata, SDL_AudioStream *stream, int additionalAmount, int totalAmount);
+    void render(SDL_AudioStream *stream, int bytes);
+    void processCommands();
+    void mixBlock(uint32_t frames);
+    void mixVoice(Voice &voice, uint32_t frames);
+    Voice *findVoice(VoiceId id);
+    void pushCommand(const Command &command);
+
+#pragma region Menber Variables
+    SDL_AudioStream *m_stream = nullptr;
+
+    // 游戏线程
+    std::vector<std::unique_ptr<Sound>> m_sounds; // 地址在 cleanup() 之前保持不变，命令中直接传指针
+    VoiceId m_nextVoiceId      = 1;
+    uint64_t m_droppedCommands = 0;
+
+    engine::utils::SpscQueue<Command, AUDIO_COMMAND_QUEUE_SIZE> m_commands;
+
+    // 回调线程，全部预先分配
+    std::array<Voice, AUDIO_MAX_VOICES> m_voices{};
+    std::array<float, AUDIO_MIX_BLOCK_FRAMES * AUDIO_CHANNELS> m_mixBuffer{};   // 总线累加
+    std::array<float, AUDIO_MIX_BLOCK_FRAMES * AUDIO_CHANNELS> m_voiceBuffer{}; // 单个声音重采样后的结果
+    std::array<float, AUDIO_MIX_BLOCK_FRAMES * AUDIO_CHANNELS> m_outputBuffer{};
+    float m_masterGain   = 1.0f;
+    float m_masterTarget = 1.0f;
+
+    // 回调线程写入、游戏线程读取的统计
+    std::atomic<uint64_t> m_callbacks{0};
+    std::atomic<uint64_t> m_underruns{0};
+    std::atomic<uint64_t> m_callbackOverruns{0};
+    std::atomic<uint64_t> m_lastCallbackNs{0};
+    std::atomic<uint64_t> m_maxCallbackNs{0};
+    std::atomic<uint64_t> m_totalCallbackNs{0};
+    std::atomic<uint64_t> m_totalAudioNs{0};
+    std::atomic<uint32_t> m_activeVoices{0};
+    std::atomic<uint64_t> m_rejectedVoices{0};
+#pragma endregion
+};
+
+} // namespace engine::audio
@@ -0,0 +1,45 @@
+#include "AudioMixerKernels.hpp"
+
+#if defined(AUDIO_KERNELS_X86)
+#include <immintrin.h>
+
+namespace engine::audio {
+
+void accumulateRampAvx(float *mix, const float *src, uint32_t frames, float gainL, float gainR, float stepL, float stepR) {
+    // 每次四帧：(L0 R0 L1 R1 L2 R2 L3 R3)
+    uint32_t i       = 0;
+    __m256 gain      = _mm256_setr_ps(gainL, gainR, gainL + stepL, gainR + stepR, gainL + 2.0f * stepL, gainR + 2.0f * stepR, gainL + 3.0f * stepL, gainR + 3.0f * stepR);
+    __m256 increment = _mm256_setr_ps(4.0f * stepL, 4.0f * stepR, 4.0f * stepL, 4.0f * stepR, 4.0f * stepL, 4.0f * stepR, 4.0f * stepL, 4.0f * stepR);
+    for (; i + 4 <= frames; i += 4) {
+        __m256 sum = _mm256_add_ps(_mm256_loadu_ps(mix + i * 2), _mm256_mul_ps(_mm256_loadu_ps(src + i * 2), gain));
+        _mm256_storeu_ps(mix + i * 2, sum);
+        gain = _mm256_add_ps(gain, increment);
+    }
+    for (; i < frames; i++) {
+        mix[i * 2] += src[i * 2] * (gainL + stepL * static_cast<float>(i));
+        mix[i * 2 + 1] += src[i * 2 + 1] * (gainR + stepR * static_cast<float>(i));
+    }
+}
+
+void applyMasterGainAvx(float *dst, const float *mix, uint32_t frames, float gain, float step) {
+    uint32_t i       = 0;
+    __m256 gains     = _mm256_setr_ps(gain, gain, gain + step, gain + step, gain + 2.0f * step, gain + 2.0f * step, gain + 3.0f * step, gain + 3.0f * step);
+    __m256 increment = _mm256_set1_ps(4.0f * step);
+    __m256 low       = _mm256_set1_ps(-1.0f);
+    __m256 high      = _mm256_set1_ps(1.0f);
+    for (; i + 4 <= frames; i += 4) {
+        __m256 value = _mm256_mul_ps(_mm256_loadu_ps(mix + i * 2), gains);
+        _mm256_storeu_ps(dst + i * 2, _mm256_min_ps(_mm256_max_ps(value, low), high));
+        gains = _mm256_add_ps(gains, increment);
+    }
+    for (; i < frames; i++) {
+        float frameGain = gain + step * static_cast<float>(i);
+        for (uint32_t channel = 0; channel < 2; channel++) {
+            float value          = mix[i * 2 + channel] * frameGain;
+            dst[i * 2 + channel] = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+        }
+    }
+}
+
+} // namespace engine::audio
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+
+// 只在 AudioMixer*.cpp 中使用。
+// AVX 内核放在单独的编译单元中，按 -mavx 编译（见 CMakeLists.txt），AudioMixer 在运行时确认 CPU 支持后才调用；
+// 基础路径（SSE2 / NEON / 标量）留在 AudioMixer.cpp 中按默认指令集编译。
+// AVX 编译单元中不调用标准库的内联函数，避免与默认指令集编译的同名实例混用。
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define AUDIO_KERNELS_X86 1
+#endif
+
+namespace engine::audio {
+
+#if defined(AUDIO_KERNELS_X86)
+/**
+ * mix += src * gain，左右声道的音量分别从 gainL / gainR 开始每帧增加 stepL / stepR
+ */
+void accumulateRampAvx(float *mix, const float *src, uint32_t frames, float gainL, float gainR, float stepL, float stepR);
+
+/**
+ * dst = clamp(mix * gain, -1, 1)，音量从 gain 开始每帧增加 step
+ */
+void applyMasterGainAvx(float *dst, const float *mix, uint32_t frames, float gain, float step);
+#endif
+
+} // namespace engine::audio
@@ -0,0 +1,316 @@
+#include "Ecs.hpp"
+#include "JobSystem.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+
+namespace engine::core {
+
+namespace {
+uint32_t alignUp(uint32_t value, uint32_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// 注册后不再修改，读取时不需要加锁
+struct ComponentRegistry {
+    std::mutex mutex;
+    std::array<ComponentInfo, ECS_MAX_COMPONENTS> infos{};
+    uint32_t count = 0;
+};
+
+ComponentRegistry &componentRegistry() {
+    static ComponentRegistry registry;
+    return registry;
+}
+} // namespace
+
+ComponentTypeId registerComponentType(uint32_t size, uint32_t alignment) {
+    ComponentRegistry &registry = componentRegistry();
+    std::lock_guard lock(registry.mutex);
+    if (registry.count >= ECS_MAX_COMPONENTS) {
+        throw std::runtime_error("registerComponentType()::组件类型数量超过上限");
+    }
+    if (alignment > ECS_COLUMN_ALIGNMENT) {
+        throw std::runtime_error("registerComponentType()::组件的对齐要求超过 chunk 列的对齐");
+    }
+    registry.infos[registry.count] = {size, alignment};
+    return registry.count++;
+}
+
+const ComponentInfo &getComponentInfo(ComponentTypeId type) {
+    return componentRegistry().infos[type];
+}
+
+#pragma region Archetype
+Archetype::Archetype(ComponentMask mask) : m_mask(mask) {
+    m_columnIndex.fill(-1);
+    uint32_t rowBytes = sizeof(Entity);
+    for (ComponentMask bits = mask; bits != 0; bits &= bits - 1) {
+        ComponentTypeId type = static_cast<ComponentTypeId>(std::countr_zero(bits));
+        m_columnIndex[type]  = static_cast<int16_t>(m_types.size());
+        m_types.push_back(type);
+        m_columnSizes.push_back(getComponentInfo(type).size);
+        rowBytes += getComponentInfo(type).size;
+    }
+
+    // 每列最多因对齐浪费 ECS_COLUMN_ALIGNMENT 字节；组件很大时一个 chunk 至少放一个实体
+    uint32_t padding = ECS_COLUMN_ALIGNMENT * static_cast<uint32_t>(m_types.size() + 1);
+    m_capacity       = ECS_CHUNK_SIZE > padding ? (ECS_CHUNK_SIZE - padding) / rowBytes : 0;
+    m_capacity       = std::max(m_capacity, 1u);
+
+    uint32_t offset = sizeof(Entity) * m_capacity; // 实体句柄列在 chunk 开头
+    for (uint32_t size : m_columnSizes) {
+        offset = alignUp(offset, ECS_COLUMN_ALIGNMENT);
+        m_columnOffsets.push_back(offset);
+        offset += size * m_capacity;
+    }
+    m_chunkBytes = alignUp(offset, ECS_COLUMN_ALIGNMENT);
+}
+
+Archetype::~Archetype() = default;
+
+void Archetype::ChunkDeleter::operator()(std::byte *chunk) const {
+    ::operator delete(chunk, std::align_val_t{ECS_COLUMN_ALIGNMENT});
+}
+
+uint32_t Archetype::getChunkEntityCount(uint32_t chunk) const {
+    return chunk + 1 < m_chunks.size() ? m_capacity : m_count - chunk * m_capacity;
+}
+
+Entity *Archetype::getEntities(uint32_t chunk) {
+    return reinterpret_cast<Entity *>(m_chunks[chunk].get() + m_entityOffset);
+}
+
+void *Archetype::getColumn(uint32_t chunk, ComponentTypeId type) {
+    int16_t column = m_columnIndex[type];
+    if (column < 0) return nullptr;
+    return m_chunks[chunk].get() + m_columnOffsets[column];
+}
+
+std::byte *Archetype::locate(uint32_t row, uint32_t &local) {
+    local = row % m_capacity;
+    return m_chunks[row / m_capacity].get();
+}
+
+void *Archetype::getComponent(uint32_t row, ComponentTypeId type) {
+    int16_t column = m_columnIndex[type];
+    if (column < 0) return nullptr;
+    uint32_t local   = 0;
+    std::byte *chunk = locate(row, local);
+    return chunk + m_columnOffsets[column] + static_cast<size_t>(local) * m_columnSizes[column];
+}
+
+Entity Archetype::getEntity(uint32_t row) {
+    uint32_t local   = 0;
+    std::byte *chunk = locate(row, local);
+    return reinterpret_cast<Entity *>(chunk + m_entityOffset)[local];
+}
+
+uint32_t Archetype::append(Entity entity) {
+    uint32_t row = m_count;
+    if (row / m_capacity == m_chunks.size()) {
+        m_chunks.emplace_back(static_cast<std::byte *>(::operator new(m_chunkBytes, std::align_val_t{ECS_COLUMN_ALIGNMENT})));
+    }
+    uint32_t local   = 0;
+    std::byte *chunk = locate(row, local);
+    reinterpret_cast<Entity *>(chunk + m_entityOffset)[local] = entity;
+    for (size_t i = 0; i < m_types.size(); i++) {
+        std::memset(chunk + m_columnOffsets[i] + static_cast<size_t>(local) * m_columnSizes[i], 0, m_columnSizes[i]);
+    }
+    m_count++;
+    return row;
+}
+
+Entity Archetype::swapRemove(uint32_t row) {
+    uint32_t last = m_count - 1;
+    Entity moved  = INVALID_ENTITY;
+    if (row != last) {
+        uint32_t dstLocal = 0;
+        uint32_t srcLocal = 0;
+        std::byte *dst    = locate(row, dstLocal);
+        std::byte *src    = locate(last, srcLocal);
+        moved             = reinterpret_cast<Entity *>(src + m_entityOffset)[srcLocal];
+        reinterpret_cast<Entity *>(dst + m_entityOffset)[dstLocal] = moved;
+        for (size_t i = 0; i < m_types.size(); i++) {
+            size_t size = m_columnSizes[i];
+            std::memcpy(dst + m_columnOffsets[i] + dstLocal * size, src + m_columnOffsets[i] + srcLocal * size, size);
+        }
+    }
+    m_count--;
+    if (m_count <= (m_chunks.size() - 1) * m_capacity) m_chunks.pop_back(); // 最后一个 chunk 已空
+    return moved;
+}
+#pragma endregion
+
+#pragma region World
+World::World() {
+    getArchetype(0); // 空 archetype：还没有任何组件的实体
+}
+
+World::~World() = default;
+
+Entity World::create() {
+    checkUnlocked("World::create()");
+    uint32_t index = 0;
+    if (!m_freeIndices.empty()) {
+        index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+    } else {
+        index = static_cast<uint32_t>(m_records.size());
+        m_records.emplace_back();
+    }
+    EntityRecord &record = m_records[index];
+    Entity entity{index, record.generation};
+    record.archetype = m_archetypeByMask.at(0);
+    record.row       = record.archetype->append(entity);
+    m_entityCount++;
+    return entity;
+}
+
+void World::destroy(Entity entity) {
+    checkUnlocked("World::destroy()");
+    if (!isAlive(entity)) return;
+    EntityRecord &record = m_records[entity.index];
+    if (Entity moved = record.archetype->swapRemove(record.row)) m_records[moved.index].row = record.row;
+    record.archetype = nullptr;
+    record.generation++;
+    m_freeIndices.push_back(entity.index);
+    m_entityCount--;
+}
+
+bool World::isAlive(Entity entity) const {
+    return entity.index < m_records.size() && m_records[entity.index].archetype != nullptr && m_records[entity.index].generation == entity.generation;
+}
+
+WorldStats World::getStats() const {
+    WorldStats stats;
+    stats.entities   = m_entityCount;
+    stats.archetypes = static_cast<uint32_t>(m_archetypes.size());
+    uint64_t rows    = 0;
+    for (const auto &archetype : m_archetypes) {
+        stats.chunks     += archetype->getChunkCount();
+        stats.chunkBytes += static_cast<uint64_t>(archetype->getChunkCount()) * archetype->getChunkBytes();
+        rows             += static_cast<uint64_t>(archetype->getChunkCount()) * archetype->getChunkCapacity();
+    }
+    stats.occupancy = rows > 0 ? static_cast<double>(m_entityCount) / static_cast<double>(rows) : 0.0;
+    return stats;
+}
+
+Archetype &World::getArchetype(ComponentMask mask) {
+    if (auto it = m_archetypeByMask.find(mask); it != m_archetypeByMask.end()) return *it->second;
+    auto archetype = std::make_unique<Archetype>(mask);
+    Archetype *ptr = archetype.get();
+    m_archetypes.push_back(std::move(archetype));
+    m_archetypeByMask.emplace(mask, ptr);
+    spdlog::trace("World::getArchetype()::创建 archetype, 组件掩码: {:#x}, 每个 chunk {} 个实体", mask, ptr->getChunkCapacity());
+    return *ptr;
+}
+
+void World::moveEntity(Entity entity, Archetype &target) {
+    EntityRecord &record = m_records[entity.index];
+    Archetype &source    = *record.archetype;
+    uint32_t row         = target.append(entity);
+    for (ComponentMask common = source.getMask() & target.getMask(); common != 0; common &= common - 1) {
+        ComponentTypeId type = static_cast<ComponentTypeId>(std::countr_zero(common));
+        std::memcpy(target.getComponent(row, type), source.getComponent(record.row, type), getComponentInfo(type).size);
+    }
+    if (Entity moved = source.swapRemove(record.row)) m_records[moved.index].row = record.row;
+    record.archetype = &target;
+    record.row       = row;
+}
+
+void *World::addComponent(Entity entity, ComponentTypeId type) {
+    checkUnlocked("World::add()");
+    if (!isAlive(entity)) {
+        throw std::runtime_error("World::add()::实体无效或已被删除");
+    }
+    EntityRecord &record = m_records[entity.index];
+    if (!record.archetype->has(type)) moveEntity(entity, getArchetype(record.archetype->getMask() | (ComponentMask{1} << type)));
+    return record.archetype->getComponent(record.row, type);
+}
+
+void World::removeComponent(Entity entity, ComponentTypeId type) {
+    checkUnlocked("World::remove()");
+    if (!isAlive(entity)) return;
+    EntityRecord &record = m_records[entity.index];
+    if (record.archetype->has(type)) moveEntity(entity, getArchetype(record.archetype->getMask() & ~(ComponentMask{1} << type)));
+}
+
+void *World::getComponent(Entity entity, ComponentTypeId type) {
+    if (!isAlive(entity)) return nullptr;
+    const EntityRecord &record = m_records[entity.index];
+    return record.archetype->getComponent(record.row, type);
+}
+
+void World::checkUnlocked(const char *function) const {
+    if (m_locked) {
+        throw std::runtime_error(std::string(function) + "::系统执行期间不能创建、删除实体或增删组件");
+    }
+}
+#pragma endregion
+
+#pragma region SystemScheduler
+SystemScheduler::SystemScheduler() = default;
+
+SystemScheduler::~SystemScheduler() = default;
+
+void SystemScheduler::addSystem(std::string name, const SystemAccess &access, ChunkFunc func) {
+    // 排在所有与它冲突的先前系统之后
+    uint32_t stage = 0;
+    for (const System &system : m_systems) {
+        if (system.access.conflictsWith(access)) stage = std::max(stage, system.stage + 1);
+    }
+    m_stageCount = std::max(m_stageCount, stage + 1);
+    spdlog::trace("SystemScheduler::addSystem()::添加系统: {}, 阶段: {}", name, stage);
+    m_systems.push_back({std::move(name), access, std::move(func), stage});
+}
+
+void SystemScheduler::run(World &world, JobSystem &jobSystem, float deltaTime) {
+    world.m_locked = true;
+    try {
+        for (uint32_t stage = 0; stage < m_stageCount; stage++) {
+            m_tasks.clear();
+            for (const System &system : m_systems) {
+                if (system.stage != stage) continue;
+                for (auto &archetype : world.m_archetypes) {
+                    if ((archetype->getMask() & system.access.reads) != system.access.reads) continue;
+                    uint32_t chunkCount = archetype->getChunkCount();
+                    for (uint32_t begin = 0; begin < chunkCount; begin += ECS_CHUNKS_PER_JOB) {
+                        m_tasks.push_back({&system, archetype.get(), begin, std::min(begin + ECS_CHUNKS_PER_JOB, chunkCount)});
+                    }
+                }
+            }
+            // 任务系统会吞掉工作线程中的异常，这里记下第一个异常，所有区间完成后在调用线程重新抛出
+            std::exception_ptr error;
+            std::mutex errorMutex;
+            jobSystem.parallelFor(static_cast<uint32_t>(m_tasks.size()), 1, [this, deltaTime, &error, &errorMutex](uint32_t begin, uint32_t end) {
+                try {
+                    for (uint32_t i = begin; i < end; i++) {
+                        const ChunkTask &task = m_tasks[i];
+                        for (uint32_t chunk = task.chunkBegin; chunk < task.chunkEnd; chunk++) {
+                            task.system->func(*task.archetype, chunk, deltaTime);
+                        }
+                    }
+                } catch (...) {
+                    std::lock_guard lock(errorMutex);
+                    if (!error) error = std::current_exception();
+                }
+            });
+            if (error) std::rethrow_exception(error); // 之后的阶段依赖本阶段的结果，不再执行
+        }
+    } catch (...) {
+        world.m_locked = false;
+        throw;
+    }
+    world.m_locked = false;
+}
+#pragma endregion
+
+} // namespace engine::core
@@ -0,0 +1,340 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace engine::core {
+class JobSystem;
+
+#pragma region Constants
+const uint32_t ECS_MAX_COMPONENTS   = 64;        // 组件类型上限，archetype 用 64 位掩码标识
+const uint32_t ECS_CHUNK_SIZE       = 16 * 1024; // 每个 chunk 的字节数，一个 chunk 的所有列能同时留在 L1/L2 中
+const uint32_t ECS_COLUMN_ALIGNMENT = 64;        // 每列按缓存行对齐，便于 SIMD 加载
+const uint32_t ECS_CHUNKS_PER_JOB   = 4;         // 并行执行系统时每个任务处理的 chunk 数
+#pragma endregion
+
+using ComponentTypeId = uint32_t;
+using ComponentMask   = uint64_t;
+
+/**
+ * @struct Entity
+ * @brief 实体句柄，index 被回收复用时 generation 加一，旧句柄随之失效
+ */
+struct Entity {
+    uint32_t index      = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool operator==(const Entity &) const = default;
+    explicit operator bool() const { return index != UINT32_MAX; }
+};
+
+const Entity INVALID_ENTITY{};
+
+/**
+ * @struct ComponentInfo
+ * @brief 组件类型的内存布局
+ */
+struct ComponentInfo {
+    uint32_t size      = 0;
+    uint32_t alignment = 0;
+};
+
+ComponentTypeId registerComponentType(uint32_t size, uint32_t alignment); // 由 componentTypeId<T>() 调用，线程安全
+const ComponentInfo &getComponentInfo(ComponentTypeId type);
+
+/**
+ * @brief 组件类型编号，每个类型第一次使用时分配
+ *
+ * 组件必须可以按字节复制：实体在 archetype 之间移动和删除时直接 memcpy。
+ */
+template <typename T>
+ComponentTypeId componentTypeId() {
+    if constexpr (!std::is_same_v<T, std::remove_cv_t<T>>) {
+        return componentTypeId<std::remove_cv_t<T>>(); // const T 与 T 共用同一个编号
+    } else {
+        static_assert(std::is_trivially_copyable_v<T>, "ECS 组件必须可以按字节复制");
+        static const ComponentTypeId type = registerComponentType(sizeof(T), alignof(T));
+        return type;
+    }
+}
+
+template <typename... Ts>
+ComponentMask componentMask() {
+    return ((ComponentMask{1} << componentTypeId<Ts>()) | ... | ComponentMask{0});
+}
+
+/**
+ * @class Archetype
+ * @brief 拥有同一组组件的所有实体，按固定大小的 chunk 以 SoA 方式存储
+ *
+ * 每个 chunk 中每种组件占一列连续数组，外加一列实体句柄；实体在 archetype 内按行紧密排列，
+ * 删除时用最后一行填补，所以除最后一个 chunk 外都是满的，遍历时每列都是线性访问。
+ */
+class Archetype final {
+public:
+    explicit Archetype(ComponentMask mask);
+    ~Archetype();
+
+    Archetype(const Archetype &)            = delete;
+    Archetype &operator=(const Archetype &) = delete;
+    Archetype(Archetype &&)                 = delete;
+    Archetype &operator=(Archetype &&)      = delete;
+
+    ComponentMask getMask() const { return m_mask; }
+    bool has(ComponentTypeId type) const { return (m_mask >> type) & 1; }
+    uint32_t getEntityCount() const { return m_count; }
+    uint32_t getChunkCapacity() const { return m_capacity; }
+    uint32_t getChunkCount() const { return static_cast<uint32_t>(m_chunks.size()); }
+    uint32_t getChunkEntityCount(uint32_t chunk) const; // 除最后一个 chunk 外都等于容量
+    uint32_t getChunkBytes() const { return m_chunkBytes; }
+
+    Entity *getEntities(uint32_t chunk);
+    void *getColumn(uint32_t chunk, ComponentTypeId type); // 没有这种组件时返回 nullptr
+    void *getComponent(uint32_t row, ComponentTypeId type);
+    Entity getEntity(uint32_t row);
+
+    uint32_t append(Entity entity);  // 新行的组件数据清零，返回行号
+    Entity swapRemove(uint32_t row); // 用最后一行填补 row，返回被移动的实体，row 本身就是最后一行时返回 INVALID_ENTITY
+
+private:
+    struct ChunkDeleter {
+        void operator()(std::byte *chunk) const;
+    };
+    using Chunk = std::unique_ptr<std::byte[], ChunkDeleter>;
+
+#pragma region Menber Variables
+    ComponentMask m_mask = 0;
+    std::vector<ComponentTypeId> m_types;                    // 按编号排序
+    std::array<int16_t, ECS_MAX_COMPONENTS> m_columnIndex{}; // 组件编号 -> m_types 中的下标，-1 表示没有
+    std::vector<uint32_t> m_columnOffsets;                   // 每列在 chunk 中的偏移，与 m_types 对应
+    std::vector<uint32_t> m_columnSizes;                     // 每列一个元素的字节数
+    uint32_t m_entityOffset = 0;                             // 实体句柄列的偏移
+    uint32_t m_capacity     = 0;                             // 每个 chunk 的实体数
+    uint32_t m_chunkBytes   = 0;
+    uint32_t m_count        = 0;
+    std::vector<Chunk> m_chunks;
+#pragma endregion
+
+    std::byte *locate(uint32_t row, uint32_t &local);
+};
+
+/**
+ * @struct WorldStats
+ * @brief World 的内存使用情况
+ */
+struct WorldStats {
+    uint32_t entities   = 0;
+    uint32_t archetypes = 0;
+    uint32_t chunks     = 0;
+    uint64_t chunkBytes = 0;   // 所有 chunk 占用的字节数
+    double occupancy    = 0.0; // 已使用的行 / chunk 总行数
+};
+
+namespace detail {
+template <typename... Ts, typename Func, size_t... I>
+void invokeChunk(Func &func, Archetype &archetype, uint32_t chunk, const std::array<ComponentTypeId, sizeof...(Ts)> &types, std::index_sequence<I...>) {
+    func(archetype.getChunkEntityCount(chunk), static_cast<Ts *>(archetype.getColumn(chunk, types[I]))...);
+}
+} // namespace detail
+
+/**
+ * @class World
+ * @brief 实体与组件的存储，按组件组合划分 archetype
+ *
+ * 查询的组件类型加 const 表示只读；eachChunk() 每次把一个 chunk 中的各列作为数组交给回调，
+ * 适合写成 SIMD 友好的循环，each() 在此基础上逐个实体调用。
+ * 创建、删除实体和增删组件会改变存储结构，在 SystemScheduler::run() 执行期间调用会抛出异常。
+ */
+class World final {
+    friend class SystemScheduler;
+
+public:
+    World();
+    ~World();
+
+    World(const World &)            = delete;
+    World &operator=(const World &) = delete;
+    World(World &&)                 = delete;
+    World &operator=(World &&)      = delete;
+
+    Entity create();
+    void destroy(Entity entity);
+    bool isAlive(Entity entity) const;
+
+    template <typename... Ts>
+    Entity create(const Ts &...components) {
+        Entity entity = create();
+        (add(entity, components), ...);
+        return entity;
+    }
+
+    template <typename T>
+    void add(Entity entity, const T &component) {
+        *static_cast<T *>(addComponent(entity, componentTypeId<T>())) = component;
+    }
+
+    template <typename T>
+    void remove(Entity entity) {
+        removeComponent(entity, componentTypeId<T>());
+    }
+
+    template <typename T>
+    T *get(Entity entity) { // 实体无效或没有该组件时返回 nullptr
+        return static_cast<T *>(getComponent(entity, componentTypeId<T>()));
+    }
+
+    template <typename T>
+    bool has(Entity entity) const {
+        return isAlive(entity) && m_records[entity.index].archetype->has(componentTypeId<T>());
+    }
+
+    /**
+     * @brief 遍历包含所有 Ts 的 chunk
+     * @param func 参数为 (uint32_t count, Ts *...columns)，每列有 count 个元素
+     */
+    template <typename... Ts, typename Func>
+    void eachChunk(Func &&func) {
+        static_assert(sizeof...(Ts) > 0, "查询至少需要一个组件");
+        const ComponentMask required = componentMask<Ts...>();
+        const std::array<ComponentTypeId, sizeof...(Ts)> types{componentTypeId<Ts>()...};
+        for (auto &archetype : m_archetypes) {
+            if ((archetype->getMask() & required) != required) continue;
+            for (uint32_t chunk = 0; chunk < archetype->getChunkCount(); chunk++) {
+                detail::invokeChunk<Ts...>(func, *archetype, chunk, types, std::index_sequence_for<Ts...>{});
+            }
+        }
+    }
+
+    /**
+     * @brief 逐个实体遍历包含所有 Ts 的实体
+     * @param func 参数为 (Ts &...components)
+     */
+    template <typename... Ts, typename Func>
+    void each(Func &&func) {
+        eachChunk<Ts...>([&func](uint32_t count, Ts *...columns) {
+            for (uint32_t i = 0; i < count; i++) {
+                func(columns[i]...);
+            }
+        });
+    }
+
+    uint32_t getEntityCount() const { return m_entityCount; }
+    WorldStats getStats() const;
+
+private:
+    struct EntityRecord {
+        Archetype *archetype = nullptr;
+        uint32_t row         = 0;
+        uint32_t generation  = 0;
+    };
+
+#pragma region Menber Variables
+    std::vector<EntityRecord> m_records;                              // 按实体 index 索引
+    std::vector<uint32_t> m_freeIndices;                              // 可复用的实体 index
+    std::vector<std::unique_ptr<Archetype>> m_archetypes;             // 按创建顺序
+    std::unordered_map<ComponentMask, Archetype *> m_archetypeByMask; // 组件组合 -> archetype
+    uint32_t m_entityCount = 0;
+    bool m_locked          = false; // SystemScheduler 正在并行执行系统
+#pragma endregion
+
+    Archetype &getArchetype(ComponentMask mask);
+    void moveEntity(Entity entity, Archetype &target); // 保留两边都有的组件
+    void *addComponent(Entity entity, ComponentTypeId type);
+    void removeComponent(Entity entity, ComponentTypeId type);
+    void *getComponent(Entity entity, ComponentTypeId type);
+    void checkUnlocked(const char *function) const;
+};
+
+/**
+ * @struct SystemAccess
+ * @brief 系统读写的组件集合
+ */
+struct SystemAccess {
+    ComponentMask reads  = 0;
+    ComponentMask writes = 0;
+
+    // 任一方写入另一方读写的组件时冲突，冲突的系统不能同时执行
+    bool conflictsWith(const SystemAccess &other) const { return (writes & (other.reads | other.writes)) != 0 || (other.writes & reads) != 0; }
+};
+
+/**
+ * @class SystemScheduler
+ * @brief 在任务系统上并行执行系统
+ *
+ * 系统按 chunk 处理一个组件查询，读写集合由查询中组件类型是否带 const 推导。
+ * 添加系统时放到与它冲突的所有先前系统之后的阶段中，同一阶段的系统互不冲突；
+ * run() 依次执行各阶段，阶段内所有系统的 chunk 分成任务交给 JobSystem 并行处理，
+ * 因此冲突的系统保持添加顺序，不冲突的系统同时执行。
+ */
+class SystemScheduler final {
+public:
+    SystemScheduler();
+    ~SystemScheduler();
+
+    SystemScheduler(const SystemScheduler &)            = delete;
+    SystemScheduler &operator=(const SystemScheduler &) = delete;
+    SystemScheduler(SystemScheduler &&)                 = delete;
+    SystemScheduler &operator=(SystemScheduler &&)      = delete;
+
+    /**
+     * @brief 添加系统
+     * @param func 参数为 (float deltaTime, uint32_t count, Ts *...columns)，会在多个线程中同时对不同 chunk 调用
+     */
+    template <typename... Ts, typename Func>
+    void addSystem(std::string name, Func func) {
+        static_assert(sizeof...(Ts) > 0, "系统至少需要一个组件");
+        SystemAccess access;
+        access.reads  = componentMask<std::remove_const_t<Ts>...>();
+        access.writes = ((std::is_const_v<Ts> ? ComponentMask{0} : componentMask<Ts>()) | ...);
+        const std::array<ComponentTypeId, sizeof...(Ts)> types{componentTypeId<Ts>()...};
+        auto chunkFunc = [func = std::move(func), types](Archetype &archetype, uint32_t chunk, float deltaTime) {
+            auto bound = [&func, deltaTime](uint32_t count, Ts *...columns) { func(deltaTime, count, columns...); };
+            detail::invokeChunk<Ts...>(bound, archetype, chunk, types, std::index_sequence_for<Ts...>{});
+        };
+        addSystem(std::move(name), access, std::move(chunkFunc));
+    }
+
+    /**
+     * @brief 按阶段执行所有系统
+     * @note 系统抛出的第一个异常在本阶段所有区间完成后于调用线程重新抛出，之后的阶段不再执行；
+     *       GameApp::update() 捕获该异常并停止主循环
+     */
+    void run(World &world, JobSystem &jobSystem, float deltaTime);
+
+    uint32_t getSystemCount() const { return static_cast<uint32_t>(m_systems.size()); }
+    uint32_t getStageCount() const { return m_stageCount; }
+
+private:
+    using ChunkFunc = std::function<void(Archetype &, uint32_t, float)>;
+
+    struct System {
+        std::string name;
+        SystemAccess access;
+        ChunkFunc func;
+        uint32_t stage = 0;
+    };
+
+    struct ChunkTask {
+        const System *system = nullptr;
+        Archetype *archetype = nullptr;
+        uint32_t chunkBegin  = 0;
+        uint32_t chunkEnd    = 0;
+    };
+
+#pragma region Menber Variables
+    std::vector<System> m_systems;
+    std::vector<ChunkTask> m_tasks; // 每个阶段重复使用，避免每帧分配
+    uint32_t m_stageCount = 0;
+#pragma endregion
+
+    void addSystem(std::string name, const SystemAccess &access, ChunkFunc func);
+};
+
+} // namespace engine::core
@@ -1,11 +1,16 @@
 #include "GameApp.hpp"
+#include "../audio/AudioMixer.hpp"
 #include "../render/VulkanRenderer.hpp"
+#include "Ecs.hpp"
+#include "JobSystem.hpp"
 #include "Time.hpp"
+#include "TransformHierarchy.hpp"
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_vulkan.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 
@@ -25,18 +30,30 @@ void GameApp::run() {
         return;
     }
     while (m_isRunning) {
+        if (m_onDemandRendering && ((!m_frameDirty && !m_renderer->hasPendingWork()) || m_isMinimized)) {
+            waitForEvents(); // 没有需要渲染的内容时阻塞等待，空闲时 CPU/GPU 占用接近于零
+        }
         m_time->update();
         float deltaTime = static_cast<float>(m_time->getDeltaTime());
         handleEvents();
         if (!m_isMinimized) {
             update(deltaTime);
-            render();
+            if (!m_isRunning) break; // 更新失败，跳过渲染直接关闭
+            // 粒子、区块加载和碎片整理在 GPU 上持续推进，不会调用 markDirty()，进行期间每帧都要渲染
+            if (!m_onDemandRendering || m_frameDirty || m_renderer->hasPendingWork()) {
+                m_frameDirty = !render(); // 有窗口没有呈现本帧画面时保持脏标记，下一轮再渲染
+            }
         }
         // spdlog::info("FPS: {}", 1.0f / deltaTime);
     }
     close();
 }
 
+void GameApp::waitForEvents() {
+    // 传入 nullptr 只等待事件到达而不从队列中取出，事件仍由 handleEvents() 处理
+    SDL_WaitEventTimeout(nullptr, ON_DEMAND_IDLE_TIMEOUT_MS);
+}
+
 void GameApp::handleEvents() {
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
@@ -44,17 +61,42 @@ void GameApp::handleEvents() {
         case SDL_EVENT_QUIT:
             m_isRunning = false;
             break;
+        case SDL_EVENT_WINDOW_CLOSE_REQUESTED:
+            // 附加窗口存在时关闭主窗口不会产生 SDL_EVENT_QUIT，主窗口关闭即退出，附加窗口单独销毁
+            if (event.window.windowID == SDL_GetWindowID(m_window)) {
+                m_isRunning = false;
+            } else if (SDL_Window *window = SDL_GetWindowFromID(event.window.windowID)) {
+                destroyWindow(window);
+            }
+            break;
         case SDL_EVENT_WINDOW_RESIZED:
-            spdlog::info("GameApp::handleEvents()::窗口大小改变");
-            m_renderer->setFramebufferResized(true);
+        case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+            spdlog::info("GameApp::handleEvents()::窗口大小改变, 窗口 ID: {}", event.window.windowID);
+            m_renderer->setFramebufferResized(event.window.windowID, true);
+            markDirty();
             break;
         case SDL_EVENT_WINDOW_MINIMIZED:
-            spdlog::info("GameApp::handleEvents()::窗口最小化");
-            m_isMinimized = true;
+            spdlog::info("GameApp::handleEvents()::窗口最小化, 窗口 ID: {}", event.window.windowID);
+            m_renderer->setMinimized(event.window.windowID, true); // 只跳过被最小化的窗口，其余窗口继续渲染
+            m_isMinimized = m_renderer->areAllWindowsMinimized();
             break;
         case SDL_EVENT_WINDOW_RESTORED:
-            spdlog::info("GameApp::handleEvents()::窗口恢复");
-            m_isMinimized = false;
+            spdlog::info("GameApp::handleEvents()::窗口恢复, 窗口 ID: {}", event.window.windowID);
+            m_renderer->setMinimized(event.window.windowID, false);
+            m_isMinimized = m_renderer->areAllWindowsMinimized();
+            markDirty();
+            break;
+        case SDL_EVENT_WINDOW_EXPOSED:
+        case SDL_EVENT_WINDOW_SHOWN:
+            markDirty(); // 窗口内容失效，需要重新绘制
+            break;
+        case SDL_EVENT_KEY_DOWN:
+        case SDL_EVENT_KEY_UP:
+        case SDL_EVENT_MOUSE_MOTION:
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+        case SDL_EVENT_MOUSE_WHEEL:
+            markDirty(); // 输入可能引起场景或 UI 变化
             break;
         default:
             break;
@@ -63,15 +105,59 @@ void GameApp::handleEvents() {
 }
 
 void GameApp::update(float deltaTime) {
+    try {
+        m_systems->run(*m_world, *m_jobSystem, deltaTime);
+        m_transforms->update();
+        m_renderer->getParticleSystem().update(deltaTime);
+    } catch (const std::exception &e) {
+        // 系统在工作线程中抛出的异常由 SystemScheduler::run() 重新抛出，此时世界状态只更新了一部分，不再继续运行
+        spdlog::error("GameApp::update()::更新失败, 停止主循环: {}", e.what());
+        m_isRunning = false;
+    } catch (...) {
+        spdlog::error("GameApp::update()::更新失败, 停止主循环: 未知异常");
+        m_isRunning = false;
+    }
 }
 
-void GameApp::render() {
-    m_renderer->render();
+bool GameApp::render() {
+    return m_renderer->render();
+}
+
+SDL_Window *GameApp::createWindow(const char *title, int width, int height) {
+    SDL_Window *window = SDL_CreateWindow(title, width, height, SDL_WINDOW_RESIZABLE | SDL_WINDOW_VULKAN);
+    if (!window) {
+        spdlog::error("GameApp::createWindow()::SDL窗口创建失败: {}", SDL_GetError());
+        return nullptr;
+    }
+    try {
+        m_renderer->addWindow(window);
+    } catch (const std::exception &e) {
+        spdlog::error("GameApp::createWindow()::窗口添加到渲染器失败: {}", e.what());
+        SDL_DestroyWindow(window);
+        return nullptr;
+    }
+    m_extraWindows.push_back(window);
+    markDirty();
+    return window;
+}
+
+void GameApp::destroyWindow(SDL_Window *window) {
+    auto it = std::find(m_extraWindows.begin(), m_extraWindows.end(), window);
+    if (it == m_extraWindows.end()) return;
+    m_renderer->removeWindow(window); // 先销毁交换链和表面，再销毁窗口
+    SDL_DestroyWindow(window);
+    m_extraWindows.erase(it);
+    m_isMinimized = m_renderer->areAllWindowsMinimized();
 }
 
 void GameApp::close() {
     spdlog::trace("GameApp::close()::关闭 GameApp...");
     m_renderer->cleanup(); // 手动清理 VulkanRenderer 因为析构函数里没有清理
+    for (SDL_Window *window : m_extraWindows) {
+        SDL_DestroyWindow(window);
+    }
+    m_extraWindows.clear();
+    if (m_audioMixer) m_audioMixer->cleanup();
     if (m_window) {
         SDL_DestroyWindow(m_window);
         m_window = nullptr;
@@ -83,6 +169,9 @@ void GameApp::close() {
 bool GameApp::init() {
     spdlog::trace("GameApp::init()::初始化 GameApp...");
     if (!initWindow()) return false;
+    if (!initJobSystem()) return false;
+    if (!initAudio()) return false;
+    if (!initWorld()) return false;
     if (!initVulkanRenderer()) return false;
     if (!initTime()) return false;
     m_isRunning = true;
@@ -109,9 +198,47 @@ bool GameApp::initWindow() {
     return true;
 }
 
+bool GameApp::initJobSystem() {
+    try {
+        m_jobSystem = std::make_unique<JobSystem>();
+    } catch (const std::exception &e) {
+        spdlog::error("GameApp::initJobSystem()::任务系统初始化失败: {}", e.what());
+        return false;
+    }
+    spdlog::trace("GameApp::initJobSystem()::任务系统初始化成功, 工作线程数量: {}", m_jobSystem->getWorkerCount());
+    return true;
+}
+
+bool GameApp::initAudio() {
+    m_audioMixer = std::make_unique<engine::audio::AudioMixer>();
+    try {
+        m_audioMixer->init();
+    } catch (const std::exception &e) {
+        // 没有可用的音频设备时继续运行，命令队列满后新的命令会被丢弃
+        spdlog::warn("GameApp::initAudio()::音频设备不可用, 游戏将没有声音: {}", e.what());
+        return true;
+    }
+    spdlog::trace("GameApp::initAudio()::音频混音器初始化成功");
+    return true;
+}
+
+bool GameApp::initWorld() {
+    try {
+        m_world      = std::make_unique<World>();
+        m_systems    = std::make_unique<SystemScheduler>();
+        m_transforms = std::make_unique<TransformHierarchy>();
+    } catch (const std::exception &e) {
+        spdlog::error("GameApp::initWorld()::ECS 初始化失败: {}", e.what());
+        return false;
+    }
+    spdlog::trace("GameApp::initWorld()::ECS 初始化成功");
+    return true;
+}
+
 bool GameApp::initVulkanRenderer() {
     try {
         m_renderer = std::make_unique<engine::render::VulkanRenderer>(m_window);
+        m_renderer->setJobSystem(m_jobSystem.get());
     } catch (const std::exception &e) {
         spdlog::error("GameApp::initVulkanRenderer()::VulkanRenderer初始化失败: {}", e.what());
         return false;
@@ -2,10 +2,13 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_mutex.h>
 #include <memory>
+#include <vector>
 
 #pragma region Constants
 const uint32_t WIDTH  = 800;
 const uint32_t HEIGHT = 600;
+
+const int32_t ON_DEMAND_IDLE_TIMEOUT_MS = 250; // 按需渲染模式下空闲时等待事件的最长时间（毫秒）
 #pragma endregion
 
 #pragma region Forward Declaration
@@ -14,10 +17,18 @@ struct SDL_Window;
 namespace engine::render {
 class VulkanRenderer;
 }
+
+namespace engine::audio {
+class AudioMixer;
+}
 #pragma endregion
 
 namespace engine::core {
 class Time;
+class JobSystem;
+class World;
+class SystemScheduler;
+class TransformHierarchy;
 
 class GameApp final {
 public:
@@ -31,24 +42,48 @@ public:
 
     void run();
 
+    void setOnDemandRendering(bool enabled) { m_onDemandRendering = enabled; } // 设置是否启用按需渲染模式
+    bool isOnDemandRendering() const { return m_onDemandRendering; }
+    void markDirty() { m_frameDirty = true; } // 标记当前帧需要重新渲染（场景、UI 或窗口发生变化）
+
+    SDL_Window *createWindow(const char *title, int width, int height); // 创建附加窗口（例如编辑器视图），与主窗口共享渲染设备
+    void destroyWindow(SDL_Window *window);                             // 销毁附加窗口
+
+    World &getWorld() { return *m_world; }                        // 场景中的实体与组件
+    SystemScheduler &getSystemScheduler() { return *m_systems; }  // 每帧在 update() 中执行的系统
+    TransformHierarchy &getTransforms() { return *m_transforms; } // 场景变换层级，每帧在系统之后更新
+
 private:
 #pragma region Menber Variables
-    SDL_Window *m_window;       // SDL windows窗口句柄
-    bool m_isMinimized = false; // 游戏是否最小化
+    SDL_Window *m_window;                     // SDL windows窗口句柄
+    std::vector<SDL_Window *> m_extraWindows; // 附加窗口句柄
+    bool m_isMinimized = false; // 是否所有窗口都已最小化
     bool m_isRunning   = false; // 游戏是否运行
 
-    std::unique_ptr<engine::render::VulkanRenderer> m_renderer; // 渲染器
-    std::unique_ptr<engine::core::Time> m_time;                 // 时间管理器
+    bool m_onDemandRendering = false; // 是否启用按需渲染模式（只有帧被标记为脏时才渲染）
+    bool m_frameDirty        = true;  // 当前帧是否需要重新渲染
+
+    std::unique_ptr<engine::render::VulkanRenderer> m_renderer;     // 渲染器
+    std::unique_ptr<engine::core::Time> m_time;                     // 时间管理器
+    std::unique_ptr<engine::core::JobSystem> m_jobSystem;           // 后台任务系统（资源流式加载等）
+    std::unique_ptr<engine::audio::AudioMixer> m_audioMixer;        // 音频混音器
+    std::unique_ptr<engine::core::World> m_world;                   // ECS 场景
+    std::unique_ptr<engine::core::SystemScheduler> m_systems;       // ECS 系统调度
+    std::unique_ptr<engine::core::TransformHierarchy> m_transforms; // 变换层级
 #pragma endregion
 
+    void waitForEvents();         // 按需渲染模式下空闲时阻塞等待事件
     void handleEvents();          // 处理 SDL 事件
     void update(float deltaTime); // 更新游戏状态
-    void render();                // 渲染游戏画面
+    bool render();                // 渲染游戏画面，返回 false 表示需要再渲染一次
     void close();                 // 关闭 SDL 窗口和渲染器，释放资源
 
 #pragma region Initialization
     [[nodiscard]] bool init();
     [[nodiscard]] bool initWindow();
+    [[nodiscard]] bool initJobSystem();
+    [[nodiscard]] bool initAudio();
+    [[nodiscard]] bool initWorld();
     [[nodiscard]] bool initVulkanRenderer();
     [[nodiscard]] bool initTime();
 #pragma endregion
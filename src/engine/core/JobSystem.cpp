@@ -0,0 +1,137 @@
+#include "JobSystem.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <exception>
+
+namespace engine::core {
+
+JobSystem::JobSystem(uint32_t workerCount) {
+    if (workerCount == 0) {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount              = hardwareThreads > 1 ? hardwareThreads - 1 : 1; // 主线程也会参与执行任务
+    }
+    m_maxBackgroundJobs = std::max(workerCount, 2u) - 1; // 至少留一个工作线程给普通任务（只有一个工作线程时无法保留）
+    m_workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; i++) {
+        m_workers.emplace_back(&JobSystem::workerLoop, this);
+    }
+    spdlog::trace("JobSystem::JobSystem()::任务系统创建成功, 工作线程数量: {}, 后台任务上限: {}", workerCount, m_maxBackgroundJobs);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    for (std::thread &worker : m_workers) {
+        worker.join(); // 工作线程会先执行完两个队列中剩余的任务再退出
+    }
+}
+
+void JobSystem::submit(Job job, JobCounter *counter, JobPriority priority) {
+    if (counter) counter->pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard lock(m_mutex);
+        if (priority == JobPriority::Background) {
+            m_backgroundTasks.push_back({std::move(job), counter, true});
+        } else {
+            m_tasks.push_back({std::move(job), counter, false});
+        }
+    }
+    m_condition.notify_one();
+    if (counter) m_waitCondition.notify_all(); // 等待这个计数的线程可以帮忙执行
+}
+
+void JobSystem::wait(JobCounter &counter) {
+    while (!counter.isDone()) {
+        Task task;
+        {
+            std::unique_lock lock(m_mutex);
+            // 只执行同一计数的任务：其他任务可能是耗时的后台任务，也可能在等待当前线程持有的结果
+            m_waitCondition.wait(lock, [this, &counter, &task]() { return counter.isDone() || popTask(counter, task); });
+            if (!task.job) return;
+        }
+        task.background = false; // 在等待线程上执行，不占用后台任务名额
+        execute(task);
+    }
+}
+
+void JobSystem::parallelFor(uint32_t count, uint32_t batchSize, const std::function<void(uint32_t, uint32_t)> &func) {
+    if (count == 0) return;
+    batchSize = std::max(batchSize, 1u);
+    if (count <= batchSize || m_workers.empty()) {
+        func(0, count); // 只有一个区间，直接在当前线程执行
+        return;
+    }
+    JobCounter counter;
+    for (uint32_t begin = 0; begin < count; begin += batchSize) {
+        uint32_t end = std::min(begin + batchSize, count);
+        submit([&func, begin, end]() { func(begin, end); }, &counter);
+    }
+    wait(counter);
+}
+
+void JobSystem::workerLoop() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock lock(m_mutex);
+            auto canRunBackground = [this]() { return !m_backgroundTasks.empty() && m_runningBackground < m_maxBackgroundJobs; };
+            m_condition.wait(lock, [this, &canRunBackground]() {
+                return !m_tasks.empty() || canRunBackground() || (m_stopping && m_backgroundTasks.empty());
+            });
+            if (!m_tasks.empty()) {
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            } else if (canRunBackground()) {
+                task = std::move(m_backgroundTasks.front());
+                m_backgroundTasks.pop_front();
+                m_runningBackground++;
+            } else {
+                return; // 正在关闭且两个队列都已空
+            }
+        }
+        execute(task);
+    }
+}
+
+bool JobSystem::popTask(const JobCounter &counter, Task &task) {
+    for (std::deque<Task> *queue : {&m_tasks, &m_backgroundTasks}) {
+        auto it = std::find_if(queue->begin(), queue->end(), [&counter](const Task &queued) { return queued.counter == &counter; });
+        if (it == queue->end()) continue;
+        task = std::move(*it);
+        queue->erase(it);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::execute(Task &task) {
+    try {
+        task.job();
+    } catch (const std::exception &e) {
+        spdlog::error("JobSystem::execute()::任务执行失败: {}", e.what());
+    } catch (...) {
+        spdlog::error("JobSystem::execute()::任务执行失败: 未知异常");
+    }
+    if (task.background) {
+        {
+            std::lock_guard lock(m_mutex);
+            m_runningBackground--;
+        }
+        m_condition.notify_one(); // 空出的后台任务名额交给下一个后台任务
+    }
+    if (task.counter && task.counter->pending.fetch_sub(1, std::memory_order_release) == 1) {
+        // 计数归零后 counter 可能立即被等待方销毁，之后不能再访问它；
+        // 先加锁再通知，保证等待方不会在检查条件和休眠之间错过通知
+        {
+            std::lock_guard lock(m_mutex);
+        }
+        m_waitCondition.notify_all();
+    }
+}
+
+} // namespace engine::core
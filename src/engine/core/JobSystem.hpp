@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::core {
+
+/**
+ * @struct JobCounter
+ * @brief 一组任务的完成计数，配合 JobSystem::wait() 等待这组任务全部完成
+ */
+struct JobCounter {
+    std::atomic<uint32_t> pending{0};
+
+    bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+};
+
+/**
+ * @enum JobPriority
+ * @brief 任务优先级
+ */
+enum class JobPriority : uint8_t {
+    Normal     = 0, // 帧内任务，优先执行
+    Background = 1, // 后台任务，只在没有普通任务时执行，且最多占用 工作线程数 - 1 个线程
+};
+
+/**
+ * @class JobSystem
+ * @brief 固定数量工作线程的任务系统
+ *
+ * 普通任务和后台任务分别排队，各自按提交顺序执行：工作线程优先取普通任务，同时执行的后台任务数量有上限，
+ * 耗时较长的后台任务（如区块加载）不会占满所有工作线程而拖慢帧内的 parallelFor()。
+ * wait() 和 parallelFor() 在等待期间只由调用线程帮忙执行同一个计数的任务，没有可执行的任务时在条件变量上休眠，
+ * 因此在任务内部再次等待也不会死锁，也不会在等待帧内任务时被无关的后台任务拖住。
+ */
+class JobSystem final {
+public:
+    using Job = std::function<void()>;
+
+    explicit JobSystem(uint32_t workerCount = 0); // 0 表示使用 硬件线程数 - 1
+    ~JobSystem();
+
+    JobSystem(const JobSystem &)            = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+    JobSystem(JobSystem &&)                 = delete;
+    JobSystem &operator=(JobSystem &&)      = delete;
+
+    void submit(Job job, JobCounter *counter = nullptr, JobPriority priority = JobPriority::Normal); // 提交任务，counter 不为空时任务完成后计数减一
+    void wait(JobCounter &counter);                                                                  // 等待 counter 归零，期间帮忙执行同一计数的任务
+
+    /**
+     * @brief 把 [0, count) 切成大小为 batchSize 的区间并行执行，返回时所有区间都已完成
+     * @param func 参数为区间的 [begin, end)
+     */
+    void parallelFor(uint32_t count, uint32_t batchSize, const std::function<void(uint32_t, uint32_t)> &func);
+
+    uint32_t getWorkerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+private:
+    struct Task {
+        Job job;
+        JobCounter *counter = nullptr;
+        bool background     = false;
+    };
+
+#pragma region Menber Variables
+    std::vector<std::thread> m_workers;      // 工作线程
+    std::deque<Task> m_tasks;                // 待执行的普通任务
+    std::deque<Task> m_backgroundTasks;      // 待执行的后台任务
+    std::mutex m_mutex;                      // 保护两个队列、m_runningBackground 和 m_stopping
+    std::condition_variable m_condition;     // 有新任务、后台任务名额空出或正在关闭时唤醒工作线程
+    std::condition_variable m_waitCondition; // 有计数归零或有带计数的任务提交时唤醒 wait()
+    uint32_t m_maxBackgroundJobs = 1;        // 同时执行的后台任务上限
+    uint32_t m_runningBackground = 0;        // 正在执行的后台任务数量
+    bool m_stopping              = false;    // 是否正在关闭
+#pragma endregion
+
+    void workerLoop();
+    bool popTask(const JobCounter &counter, Task &task); // 从两个队列中取出属于 counter 的第一个任务，调用前必须持有 m_mutex
+    void execute(Task &task);
+};
+
+} // namespace engine::core
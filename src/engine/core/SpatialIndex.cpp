@@ -0,0 +1,438 @@
+#include "SpatialIndex.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace engine::core {
+
+using engine::utils::Aabb;
+
+namespace {
+const uint32_t NULL_NODE = UINT32_MAX;
+
+Aabb combine(const Aabb &a, const Aabb &b) {
+    return {glm::min(a.min, b.min), glm::max(a.max, b.max)};
+}
+
+bool contains(const Aabb &outer, const Aabb &inner) {
+    return glm::all(glm::lessThanEqual(outer.min, inner.min)) && glm::all(glm::greaterThanEqual(outer.max, inner.max));
+}
+
+bool overlaps(const Aabb &a, const Aabb &b) {
+    return glm::all(glm::lessThanEqual(a.min, b.max)) && glm::all(glm::greaterThanEqual(a.max, b.min));
+}
+
+// 表面积的一半，插入代价只需要相对大小
+float area(const Aabb &box) {
+    glm::vec3 size = box.max - box.min;
+    return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+float distanceSquared(const Aabb &box, const glm::vec3 &point) {
+    glm::vec3 delta = glm::max(glm::max(box.min - point, point - box.max), glm::vec3(0.0f));
+    return glm::dot(delta, delta);
+}
+
+// 射线与包围盒的 slab 测试，相交时 entry 为进入包围盒的参数（起点在盒内时为 0）
+bool intersectRay(const Aabb &box, const glm::vec3 &origin, const glm::vec3 &inverseDirection, float maxDistance, float &entry) {
+    glm::vec3 t0    = (box.min - origin) * inverseDirection;
+    glm::vec3 t1    = (box.max - origin) * inverseDirection;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar  = glm::max(t0, t1);
+    entry           = std::max({tNear.x, tNear.y, tNear.z, 0.0f});
+    float exit      = std::min({tFar.x, tFar.y, tFar.z, maxDistance});
+    return entry <= exit;
+}
+
+// 返回 -1 表示在某个平面外侧，1 表示完全在视锥内，0 表示与边界相交
+int classifyFrustum(const Aabb &box, const engine::utils::FrustumPlanes &planes) {
+    glm::vec3 center = (box.min + box.max) * 0.5f;
+    glm::vec3 extent = (box.max - box.min) * 0.5f;
+    int result       = 1;
+    for (const glm::vec4 &plane : planes) {
+        glm::vec3 normal = glm::vec3(plane);
+        float distance   = glm::dot(normal, center) + plane.w;
+        float radius     = glm::dot(glm::abs(normal), extent);
+        if (distance < -radius) return -1;
+        if (distance < radius) result = 0;
+    }
+    return result;
+}
+
+// 查询使用的固定容量遍历栈，不在堆上分配
+class TraversalStack {
+public:
+    explicit TraversalStack(uint32_t root) {
+        if (root != NULL_NODE) m_items[m_size++] = root;
+    }
+    bool empty() const { return m_size == 0; }
+    uint32_t pop() { return m_items[--m_size]; }
+    void push(uint32_t index) {
+        if (m_size == m_items.size()) {
+            throw std::runtime_error("SpatialIndex::query()::遍历栈溢出");
+        }
+        m_items[m_size++] = index;
+    }
+
+private:
+    std::array<uint32_t, SPATIAL_QUERY_STACK_SIZE> m_items;
+    uint32_t m_size = 0;
+};
+} // namespace
+
+SpatialIndex::SpatialIndex(float margin) : m_margin(margin) {}
+
+SpatialIndex::~SpatialIndex() = default;
+
+SpatialProxyId SpatialIndex::create(const Aabb &bounds, uint32_t userData) {
+    uint32_t leaf = allocateNode();
+    Node &node    = m_nodes[leaf];
+    node.tight    = bounds;
+    node.bounds   = {bounds.min - glm::vec3(m_margin), bounds.max + glm::vec3(m_margin)};
+    node.userData = userData;
+    node.height   = 0;
+    insertLeaf(leaf);
+    m_proxyCount++;
+    return leaf;
+}
+
+void SpatialIndex::destroy(SpatialProxyId proxy) {
+    leafOf(proxy); // 检查代理是否有效
+    removeLeaf(proxy);
+    freeNode(proxy);
+    m_proxyCount--;
+}
+
+void SpatialIndex::update(SpatialProxyId proxy, const Aabb &bounds) {
+    if (prepareUpdate(proxy, bounds)) insertLeaf(proxy);
+}
+
+void SpatialIndex::update(const std::vector<SpatialUpdate> &updates) {
+    // 先把所有需要移动的叶子移出树，再逐个插入
+    m_pendingInserts.clear();
+    for (const SpatialUpdate &update : updates) {
+        if (prepareUpdate(update.proxy, update.bounds)) m_pendingInserts.push_back(update.proxy);
+    }
+    for (uint32_t leaf : m_pendingInserts) {
+        insertLeaf(leaf);
+    }
+}
+
+void SpatialIndex::clear() {
+    m_nodes.clear();
+    m_root       = NULL_NODE;
+    m_freeList   = NULL_NODE;
+    m_proxyCount = 0;
+}
+
+uint32_t SpatialIndex::getUserData(SpatialProxyId proxy) const {
+    return leafOf(proxy).userData;
+}
+
+const Aabb &SpatialIndex::getBounds(SpatialProxyId proxy) const {
+    return leafOf(proxy).tight;
+}
+
+const Aabb &SpatialIndex::getFatBounds(SpatialProxyId proxy) const {
+    return leafOf(proxy).bounds;
+}
+
+void SpatialIndex::queryAabb(const Aabb &bounds, std::vector<uint32_t> &out) const {
+    for (TraversalStack stack(m_root); !stack.empty();) {
+        const Node &node = m_nodes[stack.pop()];
+        if (!overlaps(node.bounds, bounds)) continue;
+        if (node.isLeaf()) {
+            if (overlaps(node.tight, bounds)) out.push_back(node.userData);
+        } else {
+            stack.push(node.child1);
+            stack.push(node.child2);
+        }
+    }
+}
+
+void SpatialIndex::queryRadius(const glm::vec3 &center, float radius, std::vector<uint32_t> &out) const {
+    float radiusSquared = radius * radius;
+    for (TraversalStack stack(m_root); !stack.empty();) {
+        const Node &node = m_nodes[stack.pop()];
+        if (distanceSquared(node.bounds, center) > radiusSquared) continue;
+        if (node.isLeaf()) {
+            if (distanceSquared(node.tight, center) <= radiusSquared) out.push_back(node.userData);
+        } else {
+            stack.push(node.child1);
+            stack.push(node.child2);
+        }
+    }
+}
+
+void SpatialIndex::queryFrustum(const engine::utils::FrustumPlanes &planes, std::vector<uint32_t> &out) const {
+    // 完全在视锥内的子树不再做平面测试，直接收集所有叶子
+    auto collect = [this, &out](uint32_t root) {
+        for (TraversalStack stack(root); !stack.empty();) {
+            const Node &node = m_nodes[stack.pop()];
+            if (node.isLeaf()) {
+                out.push_back(node.userData);
+            } else {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+    };
+
+    for (TraversalStack stack(m_root); !stack.empty();) {
+        uint32_t index   = stack.pop();
+        const Node &node = m_nodes[index];
+        int result       = classifyFrustum(node.bounds, planes);
+        if (result < 0) continue;
+        if (result > 0) {
+            collect(index);
+        } else if (node.isLeaf()) {
+            if (classifyFrustum(node.tight, planes) >= 0) out.push_back(node.userData);
+        } else {
+            stack.push(node.child1);
+            stack.push(node.child2);
+        }
+    }
+}
+
+void SpatialIndex::queryRay(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, std::vector<uint32_t> &out) const {
+    glm::vec3 inverseDirection = 1.0f / direction; // 分量为 0 时是无穷大，slab 测试仍然成立
+    float entry                = 0.0f;
+    for (TraversalStack stack(m_root); !stack.empty();) {
+        const Node &node = m_nodes[stack.pop()];
+        if (!intersectRay(node.bounds, origin, inverseDirection, maxDistance, entry)) continue;
+        if (node.isLeaf()) {
+            if (intersectRay(node.tight, origin, inverseDirection, maxDistance, entry)) out.push_back(node.userData);
+        } else {
+            stack.push(node.child1);
+            stack.push(node.child2);
+        }
+    }
+}
+
+bool SpatialIndex::raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, SpatialRayHit &hit) const {
+    glm::vec3 inverseDirection = 1.0f / direction;
+    float closest              = maxDistance; // 找到命中后缩短射线，更远的子树直接跳过
+    bool found                 = false;
+    float entry                = 0.0f;
+    for (TraversalStack stack(m_root); !stack.empty();) {
+        const Node &node = m_nodes[stack.pop()];
+        if (!intersectRay(node.bounds, origin, inverseDirection, closest, entry)) continue;
+        if (node.isLeaf()) {
+            if (intersectRay(node.tight, origin, inverseDirection, closest, entry) && (!found || entry < closest)) {
+                closest      = entry;
+                hit.userData = node.userData;
+                hit.distance = entry;
+                found        = true;
+            }
+            continue;
+        }
+
+        // 先访问入口更近的子节点
+        float entry1 = 0.0f;
+        float entry2 = 0.0f;
+        bool hit1    = intersectRay(m_nodes[node.child1].bounds, origin, inverseDirection, closest, entry1);
+        bool hit2    = intersectRay(m_nodes[node.child2].bounds, origin, inverseDirection, closest, entry2);
+        if (hit1 && hit2) {
+            stack.push(entry1 < entry2 ? node.child2 : node.child1);
+            stack.push(entry1 < entry2 ? node.child1 : node.child2);
+        } else if (hit1) {
+            stack.push(node.child1);
+        } else if (hit2) {
+            stack.push(node.child2);
+        }
+    }
+    return found;
+}
+
+SpatialIndexStats SpatialIndex::getStats() const {
+    SpatialIndexStats stats;
+    stats.proxies   = m_proxyCount;
+    stats.nodes     = m_proxyCount == 0 ? 0 : m_proxyCount * 2 - 1;
+    stats.height    = m_root == NULL_NODE ? 0 : static_cast<uint32_t>(m_nodes[m_root].height);
+    stats.updates   = m_updates;
+    stats.refits    = m_refits;
+    stats.reinserts = m_reinserts;
+    return stats;
+}
+
+uint32_t SpatialIndex::allocateNode() {
+    if (m_freeList == NULL_NODE) {
+        m_nodes.emplace_back();
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+    uint32_t index = m_freeList;
+    m_freeList     = m_nodes[index].parent;
+    m_nodes[index] = Node{};
+    return index;
+}
+
+void SpatialIndex::freeNode(uint32_t index) {
+    m_nodes[index]        = Node{};
+    m_nodes[index].parent = m_freeList;
+    m_freeList            = index;
+}
+
+void SpatialIndex::insertLeaf(uint32_t leaf) {
+    if (m_root == NULL_NODE) {
+        m_root               = leaf;
+        m_nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // 从根向下选择兄弟节点：比较“在这里新建父节点”和“继续向下”的表面积代价
+    const Aabb leafBounds = m_nodes[leaf].bounds;
+    uint32_t index        = m_root;
+    while (!m_nodes[index].isLeaf()) {
+        const Node &node      = m_nodes[index];
+        float combinedArea    = area(combine(node.bounds, leafBounds));
+        float cost            = 2.0f * combinedArea;
+        float inheritanceCost = 2.0f * (combinedArea - area(node.bounds)); // 向下走时本节点包围盒增大的代价
+        float childCosts[2];
+        for (int i = 0; i < 2; i++) {
+            const Node &child = m_nodes[i == 0 ? node.child1 : node.child2];
+            float childArea   = area(combine(leafBounds, child.bounds));
+            childCosts[i]     = (child.isLeaf() ? childArea : childArea - area(child.bounds)) + inheritanceCost;
+        }
+        if (cost < childCosts[0] && cost < childCosts[1]) break;
+        index = childCosts[0] < childCosts[1] ? node.child1 : node.child2;
+    }
+
+    uint32_t sibling   = index;
+    uint32_t oldParent = m_nodes[sibling].parent;
+    uint32_t newParent = allocateNode();
+    Node &parent       = m_nodes[newParent];
+    parent.parent      = oldParent;
+    parent.bounds      = combine(leafBounds, m_nodes[sibling].bounds);
+    parent.height      = m_nodes[sibling].height + 1;
+    parent.child1      = sibling;
+    parent.child2      = leaf;
+    if (oldParent == NULL_NODE) {
+        m_root = newParent;
+    } else if (m_nodes[oldParent].child1 == sibling) {
+        m_nodes[oldParent].child1 = newParent;
+    } else {
+        m_nodes[oldParent].child2 = newParent;
+    }
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent    = newParent;
+
+    // 沿路径向上平衡并更新包围盒和高度
+    for (index = newParent; index != NULL_NODE; index = m_nodes[index].parent) {
+        index       = balance(index);
+        Node &node  = m_nodes[index];
+        node.height = 1 + std::max(m_nodes[node.child1].height, m_nodes[node.child2].height);
+        node.bounds = combine(m_nodes[node.child1].bounds, m_nodes[node.child2].bounds);
+    }
+}
+
+void SpatialIndex::removeLeaf(uint32_t leaf) {
+    if (leaf == m_root) {
+        m_root = NULL_NODE;
+        return;
+    }
+
+    uint32_t parent      = m_nodes[leaf].parent;
+    uint32_t grandParent = m_nodes[parent].parent;
+    uint32_t sibling     = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+    freeNode(parent);
+    m_nodes[sibling].parent = grandParent;
+    m_nodes[leaf].parent    = NULL_NODE;
+    if (grandParent == NULL_NODE) {
+        m_root = sibling;
+        return;
+    }
+    if (m_nodes[grandParent].child1 == parent) {
+        m_nodes[grandParent].child1 = sibling;
+    } else {
+        m_nodes[grandParent].child2 = sibling;
+    }
+    for (uint32_t index = grandParent; index != NULL_NODE; index = m_nodes[index].parent) {
+        index       = balance(index);
+        Node &node  = m_nodes[index];
+        node.height = 1 + std::max(m_nodes[node.child1].height, m_nodes[node.child2].height);
+        node.bounds = combine(m_nodes[node.child1].bounds, m_nodes[node.child2].bounds);
+    }
+}
+
+uint32_t SpatialIndex::balance(uint32_t indexA) {
+    Node &a = m_nodes[indexA];
+    if (a.isLeaf() || a.height < 2) return indexA;
+
+    // 较高的子节点提升到 A 的位置，A 成为它的子节点，并接管它较矮的一个孩子
+    uint32_t indexB = a.child1;
+    uint32_t indexC = a.child2;
+    int32_t delta   = m_nodes[indexC].height - m_nodes[indexB].height;
+    if (delta >= -1 && delta <= 1) return indexA;
+
+    bool rotateC       = delta > 1;
+    uint32_t indexUp   = rotateC ? indexC : indexB; // 被提升的节点
+    uint32_t indexStay = rotateC ? indexB : indexC; // 留在 A 下的原有子节点
+    Node &up           = m_nodes[indexUp];
+    uint32_t indexF    = up.child1;
+    uint32_t indexG    = up.child2;
+
+    up.child1 = indexA;
+    up.parent = a.parent;
+    a.parent  = indexUp;
+    if (up.parent == NULL_NODE) {
+        m_root = indexUp;
+    } else if (m_nodes[up.parent].child1 == indexA) {
+        m_nodes[up.parent].child1 = indexUp;
+    } else {
+        m_nodes[up.parent].child2 = indexUp;
+    }
+
+    // 提升节点保留较高的孩子，较矮的孩子交给 A，替换 A 中原来指向提升节点的位置
+    bool keepF         = m_nodes[indexF].height > m_nodes[indexG].height;
+    uint32_t indexKeep = keepF ? indexF : indexG;
+    uint32_t indexGive = keepF ? indexG : indexF;
+    up.child2          = indexKeep;
+    if (rotateC) {
+        a.child2 = indexGive;
+    } else {
+        a.child1 = indexGive;
+    }
+    m_nodes[indexGive].parent = indexA;
+
+    a.bounds  = combine(m_nodes[indexStay].bounds, m_nodes[indexGive].bounds);
+    a.height  = 1 + std::max(m_nodes[indexStay].height, m_nodes[indexGive].height);
+    up.bounds = combine(a.bounds, m_nodes[indexKeep].bounds);
+    up.height = 1 + std::max(a.height, m_nodes[indexKeep].height);
+    return indexUp;
+}
+
+const SpatialIndex::Node &SpatialIndex::leafOf(SpatialProxyId proxy) const {
+    if (proxy >= m_nodes.size() || m_nodes[proxy].height != 0) {
+        throw std::runtime_error("SpatialIndex::leafOf()::无效的空间代理");
+    }
+    return m_nodes[proxy];
+}
+
+bool SpatialIndex::prepareUpdate(SpatialProxyId proxy, const Aabb &bounds) {
+    leafOf(proxy); // 检查代理是否有效
+    m_updates++;
+    Node &node = m_nodes[proxy];
+    node.tight = bounds;
+    if (contains(node.bounds, bounds)) return false;
+
+    Aabb fat = {bounds.min - glm::vec3(m_margin), bounds.max + glm::vec3(m_margin)};
+    if (node.parent == NULL_NODE && proxy != m_root) {
+        // 同一代理在一批更新中出现多次：叶子已经移出树、等待插入，只刷新包围盒，不能再次移除和排队
+        node.bounds = fat;
+        return false;
+    }
+
+    // 扩大后的包围盒仍在父节点内时，祖先的包围盒都不需要改变
+    if (node.parent != NULL_NODE && contains(m_nodes[node.parent].bounds, fat)) {
+        node.bounds = fat;
+        m_refits++;
+        return false;
+    }
+    removeLeaf(proxy);
+    m_nodes[proxy].bounds = fat;
+    m_reinserts++;
+    return true;
+}
+
+} // namespace engine::core
@@ -0,0 +1,127 @@
+#pragma once
+#include "../utils/SimdKernels.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::core {
+
+using SpatialProxyId = uint32_t;
+
+const SpatialProxyId INVALID_SPATIAL_PROXY = UINT32_MAX;
+
+#pragma region Constants
+const float SPATIAL_DEFAULT_MARGIN      = 0.1f; // 叶子包围盒向外扩大的距离，小范围移动不需要修改树
+const uint32_t SPATIAL_QUERY_STACK_SIZE = 256;  // 查询时遍历栈的容量，平衡树的高度远小于它
+#pragma endregion
+
+/**
+ * @struct SpatialUpdate
+ * @brief 批量更新中的一项：代理和它新的包围盒
+ */
+struct SpatialUpdate {
+    SpatialProxyId proxy = INVALID_SPATIAL_PROXY;
+    engine::utils::Aabb bounds;
+};
+
+/**
+ * @struct SpatialRayHit
+ * @brief 射线查询的结果，distance 是射线进入包围盒时沿方向走过的参数 t
+ */
+struct SpatialRayHit {
+    uint32_t userData = 0;
+    float distance    = 0.0f;
+};
+
+/**
+ * @struct SpatialIndexStats
+ * @brief 树的形状和累计的更新次数
+ */
+struct SpatialIndexStats {
+    uint32_t proxies   = 0; // 代理数量
+    uint32_t nodes     = 0; // 节点数量（叶子 + 内部节点）
+    uint32_t height    = 0; // 树高，叶子为 0
+    uint64_t updates   = 0; // 累计更新的代理数量
+    uint64_t refits    = 0; // 只替换叶子包围盒、不修改树结构的次数
+    uint64_t reinserts = 0; // 移出父节点范围后重新插入的次数
+};
+
+/**
+ * @class SpatialIndex
+ * @brief 动态 AABB 树，用于剔除、拾取和碰撞粗检测
+ *
+ * 每个代理是一个叶子，保存精确包围盒和向外扩大 margin 的宽松包围盒，内部节点的包围盒包含两个子节点。
+ * 插入时按表面积代价选择兄弟节点，插入和删除后沿路径向上做 AVL 式旋转，保持树的平衡。
+ * 更新时新的包围盒仍在宽松包围盒内则不修改树；超出但仍在父节点包围盒内时只原地替换叶子的宽松包围盒；
+ * 其余情况才删除后重新插入。批量更新先删除所有需要重新插入的叶子再逐个插入，插入位置不受其他移动物体的旧位置影响。
+ * 查询只读，可以在多个线程同时进行，不能与修改并发。代理 id 在销毁前保持不变。
+ */
+class SpatialIndex final {
+public:
+    explicit SpatialIndex(float margin = SPATIAL_DEFAULT_MARGIN);
+    ~SpatialIndex();
+
+    SpatialIndex(const SpatialIndex &)            = delete;
+    SpatialIndex &operator=(const SpatialIndex &) = delete;
+    SpatialIndex(SpatialIndex &&)                 = delete;
+    SpatialIndex &operator=(SpatialIndex &&)      = delete;
+
+    SpatialProxyId create(const engine::utils::Aabb &bounds, uint32_t userData); // userData 是查询返回的值
+    void destroy(SpatialProxyId proxy);
+    void update(SpatialProxyId proxy, const engine::utils::Aabb &bounds);
+    void update(const std::vector<SpatialUpdate> &updates); // 批量更新本帧移动过的物体，同一代理出现多次时以最后一次为准
+    void clear();
+
+    uint32_t getUserData(SpatialProxyId proxy) const;
+    const engine::utils::Aabb &getBounds(SpatialProxyId proxy) const;    // 精确包围盒
+    const engine::utils::Aabb &getFatBounds(SpatialProxyId proxy) const; // 树中使用的宽松包围盒
+
+    // 查询结果追加到 out 末尾，不清空 out；只返回精确包围盒满足条件的代理
+    void queryAabb(const engine::utils::Aabb &bounds, std::vector<uint32_t> &out) const;
+    void queryRadius(const glm::vec3 &center, float radius, std::vector<uint32_t> &out) const;
+    void queryFrustum(const engine::utils::FrustumPlanes &planes, std::vector<uint32_t> &out) const;
+    void queryRay(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, std::vector<uint32_t> &out) const; // 与线段 origin + t * direction（0 <= t <= maxDistance）相交的代理
+    bool raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, SpatialRayHit &hit) const;         // 最近的相交代理，没有时返回 false
+
+    uint32_t getProxyCount() const { return m_proxyCount; }
+    SpatialIndexStats getStats() const;
+
+private:
+    struct Node {
+        engine::utils::Aabb bounds;     // 叶子为宽松包围盒
+        engine::utils::Aabb tight;      // 只对叶子有效
+        uint32_t parent   = UINT32_MAX; // 空闲节点中为下一个空闲节点
+        uint32_t child1   = UINT32_MAX;
+        uint32_t child2   = UINT32_MAX;
+        int32_t height    = -1; // 叶子为 0，空闲节点为 -1
+        uint32_t userData = 0;
+
+        bool isLeaf() const { return child1 == UINT32_MAX; }
+    };
+
+#pragma region Menber Variables
+    std::vector<Node> m_nodes;
+    uint32_t m_root       = UINT32_MAX;
+    uint32_t m_freeList   = UINT32_MAX;
+    uint32_t m_proxyCount = 0;
+    float m_margin        = SPATIAL_DEFAULT_MARGIN;
+
+    uint64_t m_updates   = 0;
+    uint64_t m_refits    = 0;
+    uint64_t m_reinserts = 0;
+
+    std::vector<uint32_t> m_pendingInserts; // 批量更新中等待重新插入的叶子
+#pragma endregion
+
+    uint32_t allocateNode();
+    void freeNode(uint32_t index);
+    void insertLeaf(uint32_t leaf);
+    void removeLeaf(uint32_t leaf);
+    uint32_t balance(uint32_t index);                                            // 返回旋转后位于原位置的节点
+    const Node &leafOf(SpatialProxyId proxy) const;                              // 代理无效时抛出异常
+    bool prepareUpdate(SpatialProxyId proxy, const engine::utils::Aabb &bounds); // 返回 true 表示需要重新插入，此时叶子已从树中移除
+};
+
+} // namespace engine::core
@@ -0,0 +1,239 @@
+#include "TransformHierarchy.hpp"
+#include "../utils/SimdMath.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace engine::core {
+
+namespace {
+const uint32_t NO_PARENT = UINT32_MAX;
+
+template <typename T>
+void permuteArray(std::vector<T> &values, const std::vector<uint32_t> &order, uint32_t count) {
+    std::vector<T> result(count);
+    for (uint32_t i = 0; i < count; i++) {
+        result[i] = values[order[i]];
+    }
+    values.swap(result);
+}
+} // namespace
+
+TransformHierarchy::TransformHierarchy() = default;
+
+TransformHierarchy::~TransformHierarchy() = default;
+
+TransformId TransformHierarchy::create(TransformId parent) {
+    uint32_t parentIndex = parent == INVALID_TRANSFORM ? NO_PARENT : indexOf(parent);
+    TransformId handle   = 0;
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    } else {
+        handle = static_cast<TransformId>(m_handleToIndex.size());
+        m_handleToIndex.push_back(UINT32_MAX);
+    }
+
+    // 追加到末尾，父节点一定排在前面
+    uint32_t index          = getCount();
+    m_handleToIndex[handle] = index;
+    m_handles.push_back(handle);
+    m_parents.push_back(parentIndex);
+    m_positions.emplace_back(0.0f);
+    m_rotations.emplace_back(1.0f, 0.0f, 0.0f, 0.0f);
+    m_scales.emplace_back(1.0f);
+    m_worldMatrices.emplace_back(1.0f);
+    m_dirty.push_back(0);
+    m_updated.push_back(0);
+    markDirty(index);
+    return handle;
+}
+
+void TransformHierarchy::destroy(TransformId transform) {
+    indexOf(transform);               // 检查句柄是否有效
+    if (m_needsSort) sortHierarchy(); // 下面的子树标记依赖父节点在前的顺序
+    uint32_t root = m_handleToIndex[transform];
+
+    // 父节点在前，一遍扫描即可标记整棵子树；其余节点保持相对顺序压缩到前面
+    uint32_t count = getCount();
+    std::vector<uint8_t> removed(count, 0);
+    std::vector<uint32_t> order;
+    order.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        removed[i] = i == root || (m_parents[i] != NO_PARENT && removed[m_parents[i]]);
+        if (removed[i]) {
+            m_handleToIndex[m_handles[i]] = UINT32_MAX;
+            m_freeHandles.push_back(m_handles[i]);
+        } else {
+            order.push_back(i);
+        }
+    }
+    permute(order, static_cast<uint32_t>(order.size()));
+    m_firstDirty = std::min(m_firstDirty, root); // 根之后的脏节点位置前移了，但不会移到根之前
+}
+
+bool TransformHierarchy::isValid(TransformId transform) const {
+    return transform < m_handleToIndex.size() && m_handleToIndex[transform] != UINT32_MAX;
+}
+
+void TransformHierarchy::setParent(TransformId transform, TransformId parent) {
+    uint32_t index       = indexOf(transform);
+    uint32_t parentIndex = parent == INVALID_TRANSFORM ? NO_PARENT : indexOf(parent);
+    for (uint32_t ancestor = parentIndex; ancestor != NO_PARENT; ancestor = m_parents[ancestor]) {
+        if (ancestor == index) {
+            throw std::runtime_error("TransformHierarchy::setParent()::不能把节点挂到它自己或它的子节点下");
+        }
+    }
+    m_parents[index] = parentIndex;
+    if (parentIndex != NO_PARENT && parentIndex > index) m_needsSort = true;
+    markDirty(index);
+}
+
+TransformId TransformHierarchy::getParent(TransformId transform) const {
+    uint32_t parentIndex = m_parents[indexOf(transform)];
+    return parentIndex == NO_PARENT ? INVALID_TRANSFORM : m_handles[parentIndex];
+}
+
+void TransformHierarchy::setLocalPosition(TransformId transform, const glm::vec3 &position) {
+    uint32_t index     = indexOf(transform);
+    m_positions[index] = position;
+    markDirty(index);
+}
+
+void TransformHierarchy::setLocalRotation(TransformId transform, const glm::quat &rotation) {
+    uint32_t index     = indexOf(transform);
+    m_rotations[index] = rotation;
+    markDirty(index);
+}
+
+void TransformHierarchy::setLocalScale(TransformId transform, const glm::vec3 &scale) {
+    uint32_t index  = indexOf(transform);
+    m_scales[index] = scale;
+    markDirty(index);
+}
+
+const glm::vec3 &TransformHierarchy::getLocalPosition(TransformId transform) const {
+    return m_positions[indexOf(transform)];
+}
+
+const glm::quat &TransformHierarchy::getLocalRotation(TransformId transform) const {
+    return m_rotations[indexOf(transform)];
+}
+
+const glm::vec3 &TransformHierarchy::getLocalScale(TransformId transform) const {
+    return m_scales[indexOf(transform)];
+}
+
+const glm::mat4 &TransformHierarchy::getWorldMatrix(TransformId transform) const {
+    return m_worldMatrices[indexOf(transform)];
+}
+
+bool TransformHierarchy::wasUpdated(TransformId transform) const {
+    return m_updated[indexOf(transform)] != 0;
+}
+
+void TransformHierarchy::update() {
+    if (m_needsSort) sortHierarchy();
+    if (m_hasUpdated) std::fill(m_updated.begin(), m_updated.end(), uint8_t{0});
+
+    // 父节点在前：处理到某个节点时，它的父节点本帧是否更新已经确定
+    uint32_t updated = 0;
+    uint32_t count   = getCount();
+    for (uint32_t i = m_firstDirty; i < count; i++) {
+        uint32_t parent = m_parents[i];
+        if (!m_dirty[i] && (parent == NO_PARENT || !m_updated[parent])) continue;
+        glm::mat4 local;
+        engine::utils::composeTransform(m_positions[i], m_rotations[i], m_scales[i], local);
+        if (parent == NO_PARENT) {
+            m_worldMatrices[i] = local;
+        } else {
+            engine::utils::multiplyMat4(m_worldMatrices[parent], local, m_worldMatrices[i]);
+        }
+        m_dirty[i]   = 0;
+        m_updated[i] = 1;
+        updated++;
+    }
+    m_firstDirty  = UINT32_MAX;
+    m_hasUpdated  = updated > 0;
+    m_lastUpdated = updated;
+}
+
+TransformStats TransformHierarchy::getStats() const {
+    TransformStats stats;
+    stats.transforms = getCount();
+    stats.updated    = m_lastUpdated;
+    stats.reorders   = m_reorders;
+    return stats;
+}
+
+uint32_t TransformHierarchy::indexOf(TransformId transform) const {
+    if (!isValid(transform)) {
+        throw std::runtime_error("TransformHierarchy::indexOf()::无效的变换句柄");
+    }
+    return m_handleToIndex[transform];
+}
+
+void TransformHierarchy::markDirty(uint32_t index) {
+    m_dirty[index] = 1;
+    m_firstDirty   = std::min(m_firstDirty, index);
+}
+
+void TransformHierarchy::sortHierarchy() {
+    // 计算深度：沿父节点向上找到已知深度的祖先，再回填路径上的节点
+    uint32_t count = getCount();
+    std::vector<uint32_t> depths(count, UINT32_MAX);
+    std::vector<uint32_t> path;
+    uint32_t maxDepth = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t node = i;
+        while (depths[node] == UINT32_MAX && m_parents[node] != NO_PARENT) {
+            path.push_back(node);
+            node = m_parents[node];
+        }
+        if (depths[node] == UINT32_MAX) depths[node] = 0;
+        for (uint32_t depth = depths[node]; !path.empty(); path.pop_back()) {
+            depths[path.back()] = ++depth;
+        }
+        maxDepth = std::max(maxDepth, depths[i]);
+    }
+
+    // 按深度计数排序，同一深度保持原有顺序
+    std::vector<uint32_t> offsets(maxDepth + 2, 0);
+    for (uint32_t depth : depths) {
+        offsets[depth + 1]++;
+    }
+    for (uint32_t depth = 1; depth < offsets.size(); depth++) {
+        offsets[depth] += offsets[depth - 1];
+    }
+    std::vector<uint32_t> order(count);
+    for (uint32_t i = 0; i < count; i++) {
+        order[offsets[depths[i]]++] = i;
+    }
+    permute(order, count);
+
+    m_firstDirty = static_cast<uint32_t>(std::find(m_dirty.begin(), m_dirty.end(), uint8_t{1}) - m_dirty.begin());
+    if (m_firstDirty == count) m_firstDirty = UINT32_MAX;
+    m_needsSort = false;
+    m_reorders++;
+}
+
+void TransformHierarchy::permute(const std::vector<uint32_t> &order, uint32_t count) {
+    std::vector<uint32_t> newIndex(getCount(), NO_PARENT); // 被删除的节点没有新位置
+    for (uint32_t i = 0; i < count; i++) {
+        newIndex[order[i]] = i;
+    }
+    permuteArray(m_handles, order, count);
+    permuteArray(m_parents, order, count);
+    permuteArray(m_positions, order, count);
+    permuteArray(m_rotations, order, count);
+    permuteArray(m_scales, order, count);
+    permuteArray(m_worldMatrices, order, count);
+    permuteArray(m_dirty, order, count);
+    permuteArray(m_updated, order, count);
+    for (uint32_t i = 0; i < count; i++) {
+        if (m_parents[i] != NO_PARENT) m_parents[i] = newIndex[m_parents[i]];
+        m_handleToIndex[m_handles[i]] = i;
+    }
+}
+
+} // namespace engine::core
@@ -0,0 +1,94 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::core {
+
+using TransformId = uint32_t;
+
+const TransformId INVALID_TRANSFORM = UINT32_MAX;
+
+/**
+ * @struct TransformStats
+ * @brief 最近一次 update() 的统计
+ */
+struct TransformStats {
+    uint32_t transforms = 0; // 变换总数
+    uint32_t updated    = 0; // 重新计算了世界矩阵的变换数
+    uint32_t reorders   = 0; // 因为改变父节点而重新排序的累计次数
+};
+
+/**
+ * @class TransformHierarchy
+ * @brief 按层级排序存放在扁平数组中的变换层级
+ *
+ * 数组中父节点总在子节点之前，update() 只需从前往后扫描一遍：修改过局部变换的节点或父节点本帧更新过的节点
+ * 重新计算世界矩阵（SIMD 矩阵乘法），其余节点保持上一帧的结果，所以静态物体不产生计算。
+ * 扫描从最靠前的脏节点开始，之前的节点不会受影响。
+ * 把节点挂到数组中更靠后的父节点下会破坏顺序，此时在下一次 update() 前按深度稳定重排一次。
+ * TransformId 是稳定的句柄，销毁后会被复用。
+ */
+class TransformHierarchy final {
+public:
+    TransformHierarchy();
+    ~TransformHierarchy();
+
+    TransformHierarchy(const TransformHierarchy &)            = delete;
+    TransformHierarchy &operator=(const TransformHierarchy &) = delete;
+    TransformHierarchy(TransformHierarchy &&)                 = delete;
+    TransformHierarchy &operator=(TransformHierarchy &&)      = delete;
+
+    TransformId create(TransformId parent = INVALID_TRANSFORM);
+    void destroy(TransformId transform); // 连同所有子节点一起销毁
+    bool isValid(TransformId transform) const;
+
+    void setParent(TransformId transform, TransformId parent); // parent 为 INVALID_TRANSFORM 时成为根节点
+    TransformId getParent(TransformId transform) const;
+
+    void setLocalPosition(TransformId transform, const glm::vec3 &position);
+    void setLocalRotation(TransformId transform, const glm::quat &rotation);
+    void setLocalScale(TransformId transform, const glm::vec3 &scale);
+    const glm::vec3 &getLocalPosition(TransformId transform) const;
+    const glm::quat &getLocalRotation(TransformId transform) const;
+    const glm::vec3 &getLocalScale(TransformId transform) const;
+
+    const glm::mat4 &getWorldMatrix(TransformId transform) const; // 最近一次 update() 的结果
+    bool wasUpdated(TransformId transform) const;                  // 最近一次 update() 是否重新计算了它的世界矩阵
+
+    void update();
+
+    uint32_t getCount() const { return static_cast<uint32_t>(m_handles.size()); }
+    TransformStats getStats() const;
+
+private:
+#pragma region Menber Variables
+    // 按层级顺序排列的数据，下标即层级中的位置
+    std::vector<TransformId> m_handles;     // 位置 -> 句柄
+    std::vector<uint32_t> m_parents;        // 父节点的位置，根节点为 UINT32_MAX
+    std::vector<glm::vec3> m_positions;     // 局部平移
+    std::vector<glm::quat> m_rotations;     // 局部旋转
+    std::vector<glm::vec3> m_scales;        // 局部缩放
+    std::vector<glm::mat4> m_worldMatrices; // 世界矩阵
+    std::vector<uint8_t> m_dirty;           // 局部变换在上次 update() 后被修改
+    std::vector<uint8_t> m_updated;         // 上次 update() 重新计算过
+
+    std::vector<uint32_t> m_handleToIndex;  // 句柄 -> 位置，空闲句柄为 UINT32_MAX
+    std::vector<TransformId> m_freeHandles; // 可复用的句柄
+
+    uint32_t m_firstDirty  = UINT32_MAX; // 最靠前的脏节点位置
+    bool m_needsSort       = false;      // 有节点的父节点排在它后面
+    bool m_hasUpdated      = false;      // m_updated 中有需要清除的标记
+    uint32_t m_lastUpdated = 0;
+    uint32_t m_reorders    = 0;
+#pragma endregion
+
+    uint32_t indexOf(TransformId transform) const;                    // 句柄无效时抛出异常
+    void markDirty(uint32_t index);
+    void sortHierarchy();                                             // 按深度稳定排序，恢复父节点在前的顺序
+    void permute(const std::vector<uint32_t> &order, uint32_t count); // 按 order 重排所有数组，order[i] 是新位置 i 的旧位置
+};
+
+} // namespace engine::core
@@ -0,0 +1,484 @@
+#include "DebugDraw.hpp"
+#include "MeshRenderer.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace engine::render {
+
+namespace {
+// 与 debug 系列着色器中的 push_constant 布局一致
+struct DebugPushConstants {
+    glm::mat4 viewProjection;
+};
+
+const float DEBUG_PI      = 3.14159265358979f;
+const float GLYPH_HEIGHT  = 6.0f; // 字形网格的高度，字宽 4，字距 2
+const float GLYPH_ADVANCE = 6.0f;
+std::atomic<uint64_t> s_nextId{1}; // DebugDraw 实例编号，0 表示线程局部缓存无效
+
+/**
+ * 线段字体：每 4 个数字是一条线段 x0 y0 x1 y1，坐标在 4 x 6 的网格上，y 向上；小写字母按大写绘制
+ */
+struct Glyph {
+    char character;
+    const char *strokes;
+};
+const Glyph GLYPHS[] = {
+    {'0', "0040 4046 4606 0600 0046"},
+    {'1', "2026 2615 0040"},
+    {'2', "0646 4643 4303 0300 0040"},
+    {'3', "0646 4640 0040 0343"},
+    {'4', "0603 0343 4640"},
+    {'5', "4606 0603 0343 4340 4000"},
+    {'6', "4606 0600 0040 4043 4303"},
+    {'7', "0646 4620"},
+    {'8', "0040 4046 4606 0600 0343"},
+    {'9', "4303 0306 0646 4640 4000"},
+    {'A', "0004 0426 2644 4440 0343"},
+    {'B', "0006 0636 3645 4544 4433 0333 3342 4241 4130 3000"},
+    {'C', "4606 0600 0040"},
+    {'D', "0006 0626 2644 4442 4220 2000"},
+    {'E', "4606 0600 0040 0333"},
+    {'F', "4606 0600 0333"},
+    {'G', "4606 0600 0040 4043 4323"},
+    {'H', "0006 4046 0343"},
+    {'I', "0646 2026 0040"},
+    {'J', "1646 3631 3120 2010 1001"},
+    {'K', "0006 0246 1340"},
+    {'L', "0600 0040"},
+    {'M', "0006 0623 2346 4640"},
+    {'N', "0006 0640 4046"},
+    {'O', "0040 4046 4606 0600"},
+    {'P', "0006 0646 4643 4303"},
+    {'Q', "0040 4046 4606 0600 2240"},
+    {'R', "0006 0646 4643 4303 2340"},
+    {'S', "4606 0603 0343 4340 4000"},
+    {'T', "0646 2620"},
+    {'U', "0600 0040 4046"},
+    {'V', "0620 2046"},
+    {'W', "0610 1023 2330 3046"},
+    {'X', "0046 0640"},
+    {'Y', "0623 2346 2320"},
+    {'Z', "0646 4600 0040"},
+    {'-', "0343"},
+    {'+', "0343 2125"},
+    {'.', "2021"},
+    {',', "2110"},
+    {':', "2122 2425"},
+    {'/', "0046"},
+    {'_', "0040"},
+    {'=', "0242 0444"},
+    {'(', "3615 1511 1130"},
+    {')', "1625 2521 2110"},
+    {'[', "3616 1610 1030"},
+    {']', "1636 3630 3010"},
+    {'<', "3503 0331"},
+    {'>', "1543 4311"},
+    {'%', "0046 0516 3041"},
+    {'?', "0516 1636 3645 4544 4423 2322 2021"},
+};
+
+// ASCII -> 线段字符串，首次使用时建立
+const char *findGlyph(char character) {
+    static const std::array<const char *, 128> table = [] {
+        std::array<const char *, 128> result{};
+        for (const Glyph &glyph : GLYPHS) {
+            result[static_cast<unsigned char>(glyph.character)] = glyph.strokes;
+        }
+        return result;
+    }();
+    unsigned char index = static_cast<unsigned char>(std::toupper(static_cast<unsigned char>(character)));
+    if (index >= table.size()) return table['?'];
+    return table[index] != nullptr || index == ' ' ? table[index] : table['?'];
+}
+
+uint32_t packColor(const glm::vec4 &color) {
+    auto channel = [](float value) { return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+    return channel(color.r) | channel(color.g) << 8 | channel(color.b) << 16 | channel(color.a) << 24;
+}
+
+size_t depthIndex(DebugDepth depth) {
+    return depth == DebugDepth::Test ? 0 : 1;
+}
+} // namespace
+
+DebugDraw::DebugDraw(VulkanRenderer &renderer, MeshRenderer &meshRenderer)
+    : m_renderer(renderer), m_meshRenderer(meshRenderer), m_id(s_nextId.fetch_add(1, std::memory_order_relaxed)) {}
+
+DebugDraw::~DebugDraw() = default;
+
+void DebugDraw::init() {
+    VkPushConstantRange pushConstantRange{VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(DebugPushConstants)};
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges    = &pushConstantRange;
+    VkPipelineLayout pipelineLayout;
+    if (vkCreatePipelineLayout(m_renderer.getDevice(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("DebugDraw::init()::创建管线布局失败");
+    }
+    createPipelines(pipelineLayout);
+    spdlog::trace("DebugDraw::init()::调试图形初始化成功");
+}
+
+void DebugDraw::cleanup() {
+    m_pipelines = {}; // 管线和管线布局由资源注册表在清理时销毁
+}
+
+void DebugDraw::createPipelines(VkPipelineLayout pipelineLayout) {
+    VkDevice device                 = m_renderer.getDevice();
+    VkShaderModule vertShaderModule = m_renderer.createShaderModule(VulkanRenderer::readFile("assets/shaders/debug.vert.spv"));
+    VkShaderModule fragShaderModule = m_renderer.createShaderModule(VulkanRenderer::readFile("assets/shaders/debug.frag.spv"));
+
+    std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages{};
+    shaderStages[0].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStages[0].stage  = VK_SHADER_STAGE_VERTEX_BIT;
+    shaderStages[0].module = vertShaderModule;
+    shaderStages[0].pName  = "main";
+    shaderStages[1].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStages[1].stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
+    shaderStages[1].module = fragShaderModule;
+    shaderStages[1].pName  = "main";
+
+    auto bindingDescription    = DebugVertex::getBindingDescription();
+    auto attributeDescriptions = DebugVertex::getAttributeDescriptions();
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+    vertexInputInfo.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInputInfo.vertexBindingDescriptionCount   = 1;
+    vertexInputInfo.pVertexBindingDescriptions      = &bindingDescription;
+    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+    vertexInputInfo.pVertexAttributeDescriptions    = attributeDescriptions.data();
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewportState{};
+    viewportState.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount  = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterizer{};
+    rasterizer.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.lineWidth   = 1.0f; // 宽线需要 wideLines 特性，调试线段固定 1 像素
+    rasterizer.cullMode    = VK_CULL_MODE_NONE;
+    rasterizer.frontFace   = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+    VkPipelineMultisampleStateCreateInfo multisampling{};
+    multisampling.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+    colorBlendAttachment.colorWriteMask      = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    colorBlendAttachment.blendEnable         = VK_TRUE;
+    colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.colorBlendOp        = VK_BLEND_OP_ADD;
+    colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.alphaBlendOp        = VK_BLEND_OP_ADD;
+    VkPipelineColorBlendStateCreateInfo colorBlending{};
+    colorBlending.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlending.attachmentCount = 1;
+    colorBlending.pAttachments    = &colorBlendAttachment;
+
+    std::array<VkDynamicState, 2> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+    dynamicState.pDynamicStates    = dynamicStates.data();
+
+    // 两条管线只有深度状态不同：深度测试但不写入深度，或者完全不测试
+    std::array<VkPipeline, 2> pipelines{};
+    VkResult result = VK_SUCCESS;
+    for (size_t i = 0; i < pipelines.size() && result == VK_SUCCESS; i++) {
+        VkPipelineDepthStencilStateCreateInfo depthStencil{};
+        depthStencil.sType            = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthStencil.depthTestEnable  = i == depthIndex(DebugDepth::Test) ? VK_TRUE : VK_FALSE;
+        depthStencil.depthWriteEnable = VK_FALSE;
+        depthStencil.depthCompareOp   = VK_COMPARE_OP_LESS_OR_EQUAL;
+
+        VkGraphicsPipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineInfo.stageCount          = static_cast<uint32_t>(shaderStages.size());
+        pipelineInfo.pStages             = shaderStages.data();
+        pipelineInfo.pVertexInputState   = &vertexInputInfo;
+        pipelineInfo.pInputAssemblyState = &inputAssembly;
+        pipelineInfo.pViewportState      = &viewportState;
+        pipelineInfo.pRasterizationState = &rasterizer;
+        pipelineInfo.pMultisampleState   = &multisampling;
+        pipelineInfo.pDepthStencilState  = &depthStencil;
+        pipelineInfo.pColorBlendState    = &colorBlending;
+        pipelineInfo.pDynamicState       = &dynamicState;
+        pipelineInfo.layout              = pipelineLayout;
+        pipelineInfo.renderPass          = m_renderer.getSceneRenderPass(); // 与加载已有内容的渲染通道兼容
+        pipelineInfo.subpass             = 0;
+        result = vkCreateGraphicsPipelines(device, m_renderer.getPipelineCache(), 1, &pipelineInfo, nullptr, &pipelines[i]);
+    }
+    vkDestroyShaderModule(device, fragShaderModule, nullptr);
+    vkDestroyShaderModule(device, vertShaderModule, nullptr);
+    if (result != VK_SUCCESS) {
+        for (VkPipeline pipeline : pipelines) {
+            vkDestroyPipeline(device, pipeline, nullptr);
+        }
+        vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+        throw std::runtime_error("DebugDraw::createPipelines()::创建调试图形管线失败");
+    }
+    ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    for (size_t i = 0; i < pipelines.size(); i++) {
+        m_pipelines[i] = registry.addPipeline(pipelines[i], i == 0 ? pipelineLayout : VK_NULL_HANDLE, VK_PIPELINE_BIND_POINT_GRAPHICS); // 共用的布局只交给注册表一次
+    }
+}
+
+DebugDraw::ThreadBuffer &DebugDraw::getThreadBuffer() {
+    // 每个线程第一次提交时注册自己的缓冲区，之后直接使用线程局部缓存
+    thread_local uint64_t cachedId          = 0;
+    thread_local ThreadBuffer *cachedBuffer = nullptr;
+    if (cachedId == m_id) return *cachedBuffer;
+
+    // 缓存只记住一个实例，线程在多个实例之间交替提交时先找回本实例中已注册的缓冲区，每个线程在每个实例中只注册一次
+    std::thread::id self = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_threadBuffers.begin(), m_threadBuffers.end(), [&](const std::unique_ptr<ThreadBuffer> &buffer) { return buffer->owner == self; });
+    if (it == m_threadBuffers.end()) {
+        m_threadBuffers.push_back(std::make_unique<ThreadBuffer>());
+        m_threadBuffers.back()->owner = self;
+        it                            = std::prev(m_threadBuffers.end());
+    }
+    cachedId     = m_id;
+    cachedBuffer = it->get();
+    return *cachedBuffer;
+}
+
+void DebugDraw::markPending() {
+    // 先读再写，避免多个线程反复写同一缓存行
+    if (!m_pending.load(std::memory_order_relaxed)) m_pending.store(true, std::memory_order_relaxed);
+}
+
+#pragma region Immediate Mode
+void DebugDraw::line(const glm::vec3 &from, const glm::vec3 &to, const glm::vec4 &color, DebugDepth depth) {
+    uint32_t packed                    = packColor(color);
+    std::vector<DebugVertex> &vertices = getThreadBuffer().vertices[depthIndex(depth)];
+    vertices.push_back({from, packed});
+    vertices.push_back({to, packed});
+    markPending();
+}
+
+void DebugDraw::box(const glm::vec3 &min, const glm::vec3 &max, const glm::vec4 &color, DebugDepth depth) {
+    glm::mat4 transform(1.0f);
+    transform[0][0] = max.x - min.x;
+    transform[1][1] = max.y - min.y;
+    transform[2][2] = max.z - min.z;
+    transform[3]    = glm::vec4((min + max) * 0.5f, 1.0f);
+    box(transform, color, depth);
+}
+
+void DebugDraw::box(const glm::mat4 &transform, const glm::vec4 &color, DebugDepth depth) {
+    std::array<glm::vec3, 8> corners;
+    for (uint32_t i = 0; i < 8; i++) {
+        glm::vec3 local((i & 1) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, (i & 4) ? 0.5f : -0.5f);
+        corners[i] = glm::vec3(transform * glm::vec4(local, 1.0f));
+    }
+    // 12 条棱：相差一位的两个角相连
+    uint32_t packed                    = packColor(color);
+    std::vector<DebugVertex> &vertices = getThreadBuffer().vertices[depthIndex(depth)];
+    for (uint32_t i = 0; i < 8; i++) {
+        for (uint32_t bit = 1; bit < 8; bit <<= 1) {
+            if (i & bit) continue;
+            vertices.push_back({corners[i], packed});
+            vertices.push_back({corners[i | bit], packed});
+        }
+    }
+    markPending();
+}
+
+void DebugDraw::circle(const glm::vec3 &center, const glm::vec3 &normal, float radius, const glm::vec4 &color, DebugDepth depth, uint32_t segments) {
+    if (segments < 3 || glm::length(normal) <= 0.0f) return;
+    glm::vec3 axis      = glm::normalize(normal);
+    glm::vec3 reference = std::abs(axis.y) < 0.99f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+    glm::vec3 tangent   = glm::normalize(glm::cross(reference, axis)) * radius;
+    glm::vec3 bitangent = glm::cross(axis, tangent);
+
+    uint32_t packed                    = packColor(color);
+    std::vector<DebugVertex> &vertices = getThreadBuffer().vertices[depthIndex(depth)];
+    glm::vec3 previous                 = center + tangent;
+    for (uint32_t i = 1; i <= segments; i++) {
+        float angle     = 2.0f * DEBUG_PI * static_cast<float>(i) / static_cast<float>(segments);
+        glm::vec3 point = center + tangent * std::cos(angle) + bitangent * std::sin(angle);
+        vertices.push_back({previous, packed});
+        vertices.push_back({point, packed});
+        previous = point;
+    }
+    markPending();
+}
+
+void DebugDraw::grid(const glm::vec3 &center, float cellSize, uint32_t cells, const glm::vec4 &color, DebugDepth depth) {
+    if (cells == 0 || cellSize <= 0.0f) return;
+    float half                         = cellSize * static_cast<float>(cells) * 0.5f;
+    uint32_t packed                    = packColor(color);
+    std::vector<DebugVertex> &vertices = getThreadBuffer().vertices[depthIndex(depth)];
+    for (uint32_t i = 0; i <= cells; i++) {
+        float offset = -half + cellSize * static_cast<float>(i);
+        vertices.push_back({center + glm::vec3(offset, 0.0f, -half), packed});
+        vertices.push_back({center + glm::vec3(offset, 0.0f, half), packed});
+        vertices.push_back({center + glm::vec3(-half, 0.0f, offset), packed});
+        vertices.push_back({center + glm::vec3(half, 0.0f, offset), packed});
+    }
+    markPending();
+}
+
+void DebugDraw::path(const std::vector<glm::vec3> &points, const glm::vec4 &color, bool closed, DebugDepth depth) {
+    if (points.size() < 2) return;
+    uint32_t packed                    = packColor(color);
+    std::vector<DebugVertex> &vertices = getThreadBuffer().vertices[depthIndex(depth)];
+    for (size_t i = 0; i + 1 < points.size(); i++) {
+        vertices.push_back({points[i], packed});
+        vertices.push_back({points[i + 1], packed});
+    }
+    if (closed) {
+        vertices.push_back({points.back(), packed});
+        vertices.push_back({points.front(), packed});
+    }
+    markPending();
+}
+
+void DebugDraw::cross(const glm::vec3 &position, float size, const glm::vec4 &color, DebugDepth depth) {
+    float half                         = size * 0.5f;
+    uint32_t packed                    = packColor(color);
+    std::vector<DebugVertex> &vertices = getThreadBuffer().vertices[depthIndex(depth)];
+    for (int axis = 0; axis < 3; axis++) {
+        glm::vec3 offset(0.0f);
+        offset[axis] = half;
+        vertices.push_back({position - offset, packed});
+        vertices.push_back({position + offset, packed});
+    }
+    markPending();
+}
+
+void DebugDraw::text(const glm::vec3 &position, std::string_view text, const glm::vec4 &color, float height, DebugDepth depth) {
+    if (text.empty() || height <= 0.0f) return;
+    // 朝向相机的展开要用到最终的相机，合并时再生成线段
+    getThreadBuffer().texts[depthIndex(depth)].push_back({position, std::string(text), packColor(color), height});
+    markPending();
+}
+#pragma endregion
+
+void DebugDraw::flush() {
+    m_drawCounts = {0, 0};
+    if (!m_pending.load(std::memory_order_relaxed)) return;
+    m_pending.store(false, std::memory_order_relaxed);
+
+    // 文字用相机的右方向和屏幕上方向展开；Vulkan 裁剪空间 y 向下，所以上方向取 viewProjection 第二行的反方向
+    const glm::mat4 &viewProjection = m_meshRenderer.getViewProjection();
+    glm::vec3 right(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0]);
+    glm::vec3 up(-viewProjection[0][1], -viewProjection[1][1], -viewProjection[2][1]);
+    right = glm::length(right) > 0.0f ? glm::normalize(right) : glm::vec3(1.0f, 0.0f, 0.0f);
+    up    = glm::length(up) > 0.0f ? glm::normalize(up) : glm::vec3(0.0f, 1.0f, 0.0f);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t depth = 0; depth < m_textVertices.size(); depth++) {
+        std::vector<DebugVertex> &out = m_textVertices[depth];
+        out.clear();
+        for (const std::unique_ptr<ThreadBuffer> &buffer : m_threadBuffers) {
+            for (const TextMarker &marker : buffer->texts[depth]) {
+                float scale      = marker.height / GLYPH_HEIGHT;
+                glm::vec3 origin = marker.position;
+                for (char character : marker.text) {
+                    const char *strokes = findGlyph(character);
+                    for (const char *s = strokes; s != nullptr && s[0] != '\0'; s += s[4] == ' ' ? 5 : 4) {
+                        glm::vec3 from = origin + (right * static_cast<float>(s[0] - '0') + up * static_cast<float>(s[1] - '0')) * scale;
+                        glm::vec3 to   = origin + (right * static_cast<float>(s[2] - '0') + up * static_cast<float>(s[3] - '0')) * scale;
+                        out.push_back({from, marker.color});
+                        out.push_back({to, marker.color});
+                    }
+                    origin += right * (GLYPH_ADVANCE * scale);
+                }
+            }
+        }
+    }
+
+    // 按深度模式依次复制到一段连续的流式缓冲区空间，深度测试在前
+    std::array<uint32_t, 2> counts{};
+    uint32_t requested = 0;
+    for (size_t depth = 0; depth < counts.size(); depth++) {
+        size_t count = m_textVertices[depth].size();
+        for (const std::unique_ptr<ThreadBuffer> &buffer : m_threadBuffers) {
+            count += buffer->vertices[depth].size();
+        }
+        counts[depth] = static_cast<uint32_t>(count);
+        requested += counts[depth];
+    }
+    // 超出上限时先保证深度测试部分；上限和每个列表的长度都是偶数，截断后线段仍然成对
+    counts[0] = std::min(counts[0], DEBUG_DRAW_MAX_VERTICES);
+    counts[1] = std::min(counts[1], DEBUG_DRAW_MAX_VERTICES - counts[0]);
+    if (counts[0] + counts[1] == 0) return; // 只提交了空白文字
+
+    StreamingAllocation allocation = m_renderer.getStreamingBuffer().reserve((counts[0] + counts[1]) * sizeof(DebugVertex), sizeof(DebugVertex));
+    if (!allocation) counts = {0, 0}; // 流式缓冲区空间不足，本帧不画
+    DebugVertex *dst = allocation ? static_cast<DebugVertex *>(allocation.data) : nullptr;
+    for (size_t depth = 0; depth < counts.size(); depth++) {
+        uint32_t remaining = counts[depth];
+        auto append        = [&](const std::vector<DebugVertex> &source) {
+            size_t count = std::min<size_t>(source.size(), remaining);
+            if (count == 0) return;
+            std::memcpy(dst, source.data(), count * sizeof(DebugVertex));
+            dst += count;
+            remaining -= static_cast<uint32_t>(count);
+        };
+        for (const std::unique_ptr<ThreadBuffer> &buffer : m_threadBuffers) {
+            append(buffer->vertices[depth]);
+        }
+        append(m_textVertices[depth]);
+    }
+
+    // 清空但保留容量，下一帧提交时不再分配
+    for (const std::unique_ptr<ThreadBuffer> &buffer : m_threadBuffers) {
+        for (size_t depth = 0; depth < counts.size(); depth++) {
+            buffer->vertices[depth].clear();
+            buffer->texts[depth].clear();
+        }
+    }
+
+    m_drawBuffer            = allocation.buffer;
+    m_drawOffset            = allocation.offset;
+    m_drawCounts            = counts;
+    m_stats.vertices        = counts[0] + counts[1];
+    m_stats.droppedVertices = requested - m_stats.vertices;
+    m_stats.threads         = static_cast<uint32_t>(m_threadBuffers.size());
+    if (m_stats.droppedVertices > 0) {
+        spdlog::warn("DebugDraw::flush()::调试图形顶点过多, 丢弃: {}", m_stats.droppedVertices);
+    }
+}
+
+void DebugDraw::recordDraws(VkCommandBuffer commandBuffer, VkExtent2D extent) {
+    if (m_drawCounts[0] == 0 && m_drawCounts[1] == 0) return;
+    VkViewport viewport{0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f};
+    VkRect2D scissor{{0, 0}, extent};
+    DebugPushConstants constants{m_meshRenderer.getViewProjection()};
+    ResourceRegistry &registry      = m_renderer.getResourceRegistry();
+    VkPipelineLayout pipelineLayout = registry.get(m_pipelines[0])->layout;
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_drawBuffer, &m_drawOffset);
+
+    uint32_t firstVertex = 0;
+    for (size_t depth = 0; depth < m_pipelines.size(); depth++) {
+        if (m_drawCounts[depth] == 0) continue;
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, registry.getPipeline(m_pipelines[depth]));
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(constants), &constants);
+        vkCmdDraw(commandBuffer, m_drawCounts[depth], 1, firstVertex, 0);
+        firstVertex += m_drawCounts[depth];
+    }
+}
+
+} // namespace engine::render
@@ -0,0 +1,155 @@
+#pragma once
+#include "../utils/Math.hpp"
+#include "ResourceRegistry.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace engine::render {
+class VulkanRenderer;
+class MeshRenderer;
+
+#pragma region Constants
+const uint32_t DEBUG_DRAW_MAX_VERTICES = 131072; // 每帧最多提交的线段顶点数（2 MB 流式缓冲区空间），超出的部分丢弃
+const uint32_t DEBUG_CIRCLE_SEGMENTS   = 32;     // 圆的默认分段数
+const float DEBUG_TEXT_HEIGHT          = 0.25f;  // 文字标记的默认字高（世界单位）
+#pragma endregion
+
+/**
+ * @enum DebugDepth
+ * @brief 调试图形的深度模式
+ */
+enum class DebugDepth {
+    Test,    // 参与深度测试，会被场景遮挡
+    Overlay, // 总是画在场景之上
+};
+
+/**
+ * @struct DebugVertex
+ * @brief 调试线段顶点：世界空间位置 + RGBA8 颜色
+ */
+struct DebugVertex {
+    glm::vec3 position;
+    uint32_t color; // r | g << 8 | b << 16 | a << 24，与 VK_FORMAT_R8G8B8A8_UNORM 一致
+
+    static VkVertexInputBindingDescription getBindingDescription() {
+        VkVertexInputBindingDescription bindingDescription{};
+        bindingDescription.binding   = 0;                           // 顶点属性绑定索引
+        bindingDescription.stride    = sizeof(DebugVertex);         // 每个顶点的大小
+        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX; // 输入速率，表示每顶点输入一次数据
+        return bindingDescription;                                  // 返回顶点输入绑定描述
+    }
+
+    static std::array<VkVertexInputAttributeDescription, 2> getAttributeDescriptions() {
+        std::array<VkVertexInputAttributeDescription, 2> attributeDescriptions{};
+        attributeDescriptions[0].binding  = 0;                               // 顶点属性绑定索引
+        attributeDescriptions[0].location = 0;                               // 顶点属性位置索引
+        attributeDescriptions[0].format   = VK_FORMAT_R32G32B32_SFLOAT;      // 顶点属性格式
+        attributeDescriptions[0].offset   = offsetof(DebugVertex, position); // 顶点属性在顶点结构体中的偏移量
+        attributeDescriptions[1].binding  = 0;                               // 顶点属性绑定索引
+        attributeDescriptions[1].location = 1;                               // 顶点属性位置索引
+        attributeDescriptions[1].format   = VK_FORMAT_R8G8B8A8_UNORM;        // 着色器中读取为归一化的 vec4
+        attributeDescriptions[1].offset   = offsetof(DebugVertex, color);    // 顶点属性在顶点结构体中的偏移量
+        return attributeDescriptions;
+    }
+};
+
+/**
+ * @struct DebugDrawStats
+ * @brief 最近一次提交的统计
+ */
+struct DebugDrawStats {
+    uint32_t vertices        = 0; // 实际绘制的顶点数
+    uint32_t droppedVertices = 0; // 超出 DEBUG_DRAW_MAX_VERTICES 或流式缓冲区空间不足而丢弃的顶点数
+    uint32_t threads         = 0; // 提交过调试图形的线程数
+};
+
+/**
+ * @class DebugDraw
+ * @brief 立即模式的调试图形：线段、包围盒、圆、网格、路径和文字标记
+ *
+ * 可以在 GameApp::update() 期间从任意线程调用（包括 JobSystem 的任务），每个线程写入自己的顶点数组，不需要加锁；
+ * 提交必须在 render() 之前完成。每帧在渲染通道之外把所有线程的顶点合并到流式缓冲区，
+ * 然后每个窗口最多两次绘制调用（深度测试 + 覆盖）。图形只显示一帧，没有提交时每帧只有一次原子读取。
+ * 坐标使用网格渲染器的相机（世界空间），文字标记用内置的线段字体，在合并时朝向相机展开。
+ */
+class DebugDraw final {
+public:
+    DebugDraw(VulkanRenderer &renderer, MeshRenderer &meshRenderer);
+    ~DebugDraw();
+
+    DebugDraw(const DebugDraw &)            = delete;
+    DebugDraw &operator=(const DebugDraw &) = delete;
+    DebugDraw(DebugDraw &&)                 = delete;
+    DebugDraw &operator=(DebugDraw &&)      = delete;
+
+    void init();
+    void cleanup();
+
+#pragma region Immediate Mode
+    void line(const glm::vec3 &from, const glm::vec3 &to, const glm::vec4 &color, DebugDepth depth = DebugDepth::Test);
+    void box(const glm::vec3 &min, const glm::vec3 &max, const glm::vec4 &color, DebugDepth depth = DebugDepth::Test);
+    void box(const glm::mat4 &transform, const glm::vec4 &color, DebugDepth depth = DebugDepth::Test); // 把 [-0.5, 0.5]^3 的单位立方体变换后绘制
+    void circle(const glm::vec3 &center, const glm::vec3 &normal, float radius, const glm::vec4 &color,
+                DebugDepth depth = DebugDepth::Test, uint32_t segments = DEBUG_CIRCLE_SEGMENTS);
+    void grid(const glm::vec3 &center, float cellSize, uint32_t cells, const glm::vec4 &color, DebugDepth depth = DebugDepth::Test); // XZ 平面
+    void path(const std::vector<glm::vec3> &points, const glm::vec4 &color, bool closed = false, DebugDepth depth = DebugDepth::Test);
+    void cross(const glm::vec3 &position, float size, const glm::vec4 &color, DebugDepth depth = DebugDepth::Overlay);
+    void text(const glm::vec3 &position, std::string_view text, const glm::vec4 &color, float height = DEBUG_TEXT_HEIGHT,
+              DebugDepth depth = DebugDepth::Overlay); // 左下角对齐 position，支持 ASCII 字母、数字和常用符号
+#pragma endregion
+
+    void flush();                                                       // 每帧记录命令之前调用：把所有线程提交的图形合并到流式缓冲区并清空
+    void recordDraws(VkCommandBuffer commandBuffer, VkExtent2D extent); // 在场景最后一个渲染通道之内调用
+
+    const DebugDrawStats &getStats() const { return m_stats; }
+
+private:
+    struct TextMarker {
+        glm::vec3 position;
+        std::string text;
+        uint32_t color;
+        float height;
+    };
+
+    // 每个线程一份，只由所属线程写入、由渲染线程在合并时读取和清空
+    struct ThreadBuffer {
+        std::thread::id owner;                            // 所属线程，线程局部缓存失效时据此找回已注册的缓冲区
+        std::array<std::vector<DebugVertex>, 2> vertices; // 按 DebugDepth 分开
+        std::array<std::vector<TextMarker>, 2> texts;
+    };
+
+    ThreadBuffer &getThreadBuffer();
+    void markPending();
+    void createPipelines(VkPipelineLayout pipelineLayout); // 注册表接管管线和布局
+
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer;
+    MeshRenderer &m_meshRenderer;
+    const uint64_t m_id; // 区分实例，线程局部缓存据此判断是否属于当前实例
+
+    std::array<PipelineHandle, 2> m_pipelines{}; // 按 DebugDepth 分开，共用的管线布局由第一条管线的注册记录持有
+
+    std::mutex m_mutex;                                         // 保护 m_threadBuffers 的注册
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threadBuffers; // 线程缓冲区，地址在实例销毁前保持不变
+    std::atomic<bool> m_pending{false};                         // 本帧是否有提交
+    std::array<std::vector<DebugVertex>, 2> m_textVertices;     // 合并时展开文字标记的临时空间
+
+    VkBuffer m_drawBuffer     = VK_NULL_HANDLE; // 本帧合并结果所在的流式缓冲区
+    VkDeviceSize m_drawOffset = 0;
+    std::array<uint32_t, 2> m_drawCounts{};     // 本帧每种深度模式的顶点数，深度测试在前
+    DebugDrawStats m_stats;
+#pragma endregion
+};
+
+} // namespace engine::render
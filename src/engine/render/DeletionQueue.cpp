@@ -0,0 +1,25 @@
+#include "DeletionQueue.hpp"
+
+namespace engine::render {
+
+void DeletionQueue::push(uint64_t frameNumber, std::function<void()> deleter) {
+    m_entries.push_back({frameNumber, std::move(deleter)});
+}
+
+void DeletionQueue::flush(uint64_t completedFrameNumber) {
+    while (!m_entries.empty() && m_entries.front().frameNumber <= completedFrameNumber) {
+        std::function<void()> deleter = std::move(m_entries.front().deleter);
+        m_entries.pop_front();
+        deleter(); // 先出队再执行，销毁操作内部可以继续 push
+    }
+}
+
+void DeletionQueue::flushAll() {
+    while (!m_entries.empty()) {
+        std::function<void()> deleter = std::move(m_entries.front().deleter);
+        m_entries.pop_front();
+        deleter();
+    }
+}
+
+} // namespace engine::render
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+namespace engine::render {
+
+/**
+ * @class DeletionQueue
+ * @brief 延迟销毁队列
+ *
+ * GPU 可能仍在使用刚被释放的资源，因此销毁操作记录下提交时的帧序号，
+ * 等该帧在 GPU 上执行完成（对应的 Fence 已等待）后才真正执行。
+ */
+class DeletionQueue final {
+public:
+    DeletionQueue()  = default;
+    ~DeletionQueue() = default;
+
+    DeletionQueue(const DeletionQueue &)            = delete;
+    DeletionQueue &operator=(const DeletionQueue &) = delete;
+    DeletionQueue(DeletionQueue &&)                 = delete;
+    DeletionQueue &operator=(DeletionQueue &&)      = delete;
+
+    void push(uint64_t frameNumber, std::function<void()> deleter); // frameNumber 为可能仍在使用该资源的最后一帧
+    void flush(uint64_t completedFrameNumber);                      // 执行所有 frameNumber <= completedFrameNumber 的销毁操作
+    void flushAll();                                                // 设备空闲后执行全部销毁操作
+
+    size_t size() const { return m_entries.size(); }
+
+private:
+    struct Entry {
+        uint64_t frameNumber;
+        std::function<void()> deleter;
+    };
+    std::deque<Entry> m_entries; // 按帧序号递增排列
+};
+
+} // namespace engine::render
@@ -0,0 +1,161 @@
+#include "FrustumCuller.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace engine::render {
+
+FrustumCuller::FrustumCuller() = default;
+
+FrustumCuller::~FrustumCuller() = default;
+
+void FrustumCuller::clear() {
+    for (std::vector<float> *values : {&m_sphereX, &m_sphereY, &m_sphereZ, &m_sphereRadius,
+                                       &m_boxMinX, &m_boxMinY, &m_boxMinZ, &m_boxMaxX, &m_boxMaxY, &m_boxMaxZ}) {
+        values->clear();
+    }
+    m_sphereIds.clear();
+    m_boxIds.clear();
+    m_visible.clear();
+}
+
+uint32_t FrustumCuller::addSphere(const glm::vec3 &center, float radius, uint32_t id) {
+    m_sphereX.push_back(center.x);
+    m_sphereY.push_back(center.y);
+    m_sphereZ.push_back(center.z);
+    m_sphereRadius.push_back(radius);
+    m_sphereIds.push_back(id);
+    return getSphereCount() - 1;
+}
+
+uint32_t FrustumCuller::addAabb(const glm::vec3 &min, const glm::vec3 &max, uint32_t id) {
+    m_boxMinX.push_back(min.x);
+    m_boxMinY.push_back(min.y);
+    m_boxMinZ.push_back(min.z);
+    m_boxMaxX.push_back(max.x);
+    m_boxMaxY.push_back(max.y);
+    m_boxMaxZ.push_back(max.z);
+    m_boxIds.push_back(id);
+    return getAabbCount() - 1;
+}
+
+void FrustumCuller::setSphere(uint32_t index, const glm::vec3 &center, float radius) {
+    if (index >= getSphereCount()) {
+        throw std::runtime_error("FrustumCuller::setSphere()::包围球下标越界");
+    }
+    m_sphereX[index]      = center.x;
+    m_sphereY[index]      = center.y;
+    m_sphereZ[index]      = center.z;
+    m_sphereRadius[index] = radius;
+}
+
+void FrustumCuller::setAabb(uint32_t index, const glm::vec3 &min, const glm::vec3 &max) {
+    if (index >= getAabbCount()) {
+        throw std::runtime_error("FrustumCuller::setAabb()::包围盒下标越界");
+    }
+    m_boxMinX[index] = min.x;
+    m_boxMinY[index] = min.y;
+    m_boxMinZ[index] = min.z;
+    m_boxMaxX[index] = max.x;
+    m_boxMaxY[index] = max.y;
+    m_boxMaxZ[index] = max.z;
+}
+
+void FrustumCuller::cull(const glm::mat4 &viewProjection, engine::core::JobSystem *jobSystem) {
+    auto start       = std::chrono::steady_clock::now();
+    uint32_t total   = getSphereCount() + getAabbCount();
+    uint32_t batches = (total + FRUSTUM_CULL_BATCH_SIZE - 1) / FRUSTUM_CULL_BATCH_SIZE;
+    m_visibility.resize(total);
+    m_batchOffsets.assign(batches, 0);
+
+    // 第一遍：平面测试，每批统计自己的可见数量
+    const engine::utils::FrustumPlanes planes = engine::utils::extractFrustumPlanes(viewProjection);
+    auto test                                 = [this, &planes](uint32_t begin, uint32_t end) { testRange(planes, begin, end); };
+    if (jobSystem) {
+        jobSystem->parallelFor(total, FRUSTUM_CULL_BATCH_SIZE, test);
+    } else {
+        test(0, total);
+    }
+
+    // 前缀和得到每批在可见列表中的起始位置
+    uint32_t visible = 0;
+    for (uint32_t &offset : m_batchOffsets) {
+        uint32_t count = offset;
+        offset         = visible;
+        visible += count;
+    }
+    m_visible.resize(visible);
+
+    // 第二遍：各批并行写入互不重叠的区间，结果与串行压缩相同
+    auto compact = [this](uint32_t begin, uint32_t end) { compactRange(begin, end); };
+    if (jobSystem) {
+        jobSystem->parallelFor(total, FRUSTUM_CULL_BATCH_SIZE, compact);
+    } else {
+        compact(0, total);
+    }
+
+    m_stats.spheres    = getSphereCount();
+    m_stats.boxes      = getAabbCount();
+    m_stats.visible    = visible;
+    m_stats.batches    = batches;
+    m_stats.cullTimeNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    m_stats.isa        = engine::utils::getSimdIsaName(engine::utils::getSimdIsa());
+}
+
+void FrustumCuller::testRange(const engine::utils::FrustumPlanes &planes, uint32_t begin, uint32_t end) {
+    // parallelFor 在只有一个区间时会把整个范围交给一次调用，这里仍按批次切分，保证每批的计数独立
+    uint32_t sphereCount = getSphereCount();
+    for (uint32_t batchBegin = begin; batchBegin < end; batchBegin += FRUSTUM_CULL_BATCH_SIZE) {
+        uint32_t batchEnd = std::min(batchBegin + FRUSTUM_CULL_BATCH_SIZE, end);
+        if (batchBegin < sphereCount) {
+            uint32_t first = batchBegin;
+            uint32_t last  = std::min(batchEnd, sphereCount);
+            engine::utils::cullSpheres(planes, {m_sphereX.data() + first, m_sphereY.data() + first, m_sphereZ.data() + first},
+                                       m_sphereRadius.data() + first, m_visibility.data() + first, last - first);
+        }
+        if (batchEnd > sphereCount) {
+            uint32_t first = std::max(batchBegin, sphereCount) - sphereCount;
+            uint32_t last  = batchEnd - sphereCount;
+            engine::utils::ConstAabbSoa boxes{{m_boxMinX.data() + first, m_boxMinY.data() + first, m_boxMinZ.data() + first},
+                                              {m_boxMaxX.data() + first, m_boxMaxY.data() + first, m_boxMaxZ.data() + first}};
+            engine::utils::cullAabbs(planes, boxes, m_visibility.data() + sphereCount + first, last - first);
+        }
+
+        // 测试结果每个字节为 0 或 1，8 个字节一组求和
+        uint32_t count = 0;
+        uint32_t i     = batchBegin;
+        for (; i + 8 <= batchEnd; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, m_visibility.data() + i, sizeof(word));
+            count += static_cast<uint32_t>((word * 0x0101010101010101ull) >> 56);
+        }
+        for (; i < batchEnd; i++) {
+            count += m_visibility[i];
+        }
+        m_batchOffsets[batchBegin / FRUSTUM_CULL_BATCH_SIZE] = count;
+    }
+}
+
+void FrustumCuller::compactRange(uint32_t begin, uint32_t end) {
+    uint32_t sphereCount = getSphereCount();
+    for (uint32_t batchBegin = begin; batchBegin < end; batchBegin += FRUSTUM_CULL_BATCH_SIZE) {
+        uint32_t batchEnd = std::min(batchBegin + FRUSTUM_CULL_BATCH_SIZE, end);
+        uint32_t *out     = m_visible.data() + m_batchOffsets[batchBegin / FRUSTUM_CULL_BATCH_SIZE];
+        uint32_t i        = batchBegin;
+        for (; i + 8 <= batchEnd; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, m_visibility.data() + i, sizeof(word));
+            if (word == 0) continue; // 成片不可见的物体整组跳过
+            for (uint32_t j = i; j < i + 8; j++) {
+                if (m_visibility[j]) *out++ = j < sphereCount ? m_sphereIds[j] : m_boxIds[j - sphereCount];
+            }
+        }
+        for (; i < batchEnd; i++) {
+            if (m_visibility[i]) *out++ = i < sphereCount ? m_sphereIds[i] : m_boxIds[i - sphereCount];
+        }
+    }
+}
+
+} // namespace engine::render
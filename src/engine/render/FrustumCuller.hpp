@@ -0,0 +1,92 @@
+#pragma once
+#include "../core/JobSystem.hpp"
+#include "../utils/SimdKernels.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::render {
+
+#pragma region Constants
+const uint32_t FRUSTUM_CULL_BATCH_SIZE = 16384; // 每个工作线程任务处理的包围体数量，是 SIMD 宽度的整数倍
+#pragma endregion
+
+/**
+ * @struct FrustumCullStats
+ * @brief 最近一次 cull() 的统计
+ */
+struct FrustumCullStats {
+    uint32_t spheres    = 0;  // 参与剔除的包围球数量
+    uint32_t boxes      = 0;  // 参与剔除的包围盒数量
+    uint32_t visible    = 0;  // 与视锥相交的包围体数量
+    uint32_t batches    = 0;  // 分给工作线程的批次数量
+    uint64_t cullTimeNs = 0;  // 平面测试和压缩可见列表的总耗时
+    const char *isa     = ""; // 使用的 SIMD 指令集
+};
+
+/**
+ * @class FrustumCuller
+ * @brief CPU 上的 SIMD 视锥剔除
+ *
+ * 包围球和包围盒按分量分别存放在连续数组中（SoA），每条指令同时测试 4 个（SSE2 / NEON）或 8 个（AVX2）
+ * 包围体与六个视锥平面。cull() 把包围体切成固定大小的批次交给工作线程：第一遍测试并统计每批的可见数量，
+ * 前缀和得到每批的写入位置后，第二遍并行把可见包围体的 id 压缩到一个连续列表中，顺序与添加顺序一致。
+ */
+class FrustumCuller final {
+public:
+    FrustumCuller();
+    ~FrustumCuller();
+
+    FrustumCuller(const FrustumCuller &)            = delete;
+    FrustumCuller &operator=(const FrustumCuller &) = delete;
+    FrustumCuller(FrustumCuller &&)                 = delete;
+    FrustumCuller &operator=(FrustumCuller &&)      = delete;
+
+    void clear();                                                              // 删除所有包围体
+    uint32_t addSphere(const glm::vec3 &center, float radius, uint32_t id);    // 返回包围球的下标，id 是写入可见列表的值
+    uint32_t addAabb(const glm::vec3 &min, const glm::vec3 &max, uint32_t id); // 返回包围盒的下标
+    void setSphere(uint32_t index, const glm::vec3 &center, float radius);     // 更新运动物体的包围球
+    void setAabb(uint32_t index, const glm::vec3 &min, const glm::vec3 &max);  // 更新运动物体的包围盒
+    uint32_t getSphereCount() const { return static_cast<uint32_t>(m_sphereIds.size()); }
+    uint32_t getAabbCount() const { return static_cast<uint32_t>(m_boxIds.size()); }
+
+    /**
+     * @brief 测试所有包围体，结果写入 getVisible()
+     * @param jobSystem 为空时在当前线程执行
+     */
+    void cull(const glm::mat4 &viewProjection, engine::core::JobSystem *jobSystem);
+
+    const std::vector<uint32_t> &getVisible() const { return m_visible; } // 先包围球后包围盒，各自按添加顺序
+    const FrustumCullStats &getStats() const { return m_stats; }
+
+private:
+#pragma region Menber Variables
+    // 包围球
+    std::vector<float> m_sphereX;
+    std::vector<float> m_sphereY;
+    std::vector<float> m_sphereZ;
+    std::vector<float> m_sphereRadius;
+    std::vector<uint32_t> m_sphereIds;
+
+    // 包围盒
+    std::vector<float> m_boxMinX;
+    std::vector<float> m_boxMinY;
+    std::vector<float> m_boxMinZ;
+    std::vector<float> m_boxMaxX;
+    std::vector<float> m_boxMaxY;
+    std::vector<float> m_boxMaxZ;
+    std::vector<uint32_t> m_boxIds;
+
+    std::vector<uint8_t> m_visibility;    // 每个包围体的测试结果，包围球在前
+    std::vector<uint32_t> m_batchOffsets; // 每批可见数量，前缀和后为写入位置
+    std::vector<uint32_t> m_visible;      // 压缩后的可见 id 列表
+    FrustumCullStats m_stats;
+#pragma endregion
+
+    void testRange(const engine::utils::FrustumPlanes &planes, uint32_t begin, uint32_t end); // 测试 [begin, end) 并统计每批的可见数量
+    void compactRange(uint32_t begin, uint32_t end);                                          // 把 [begin, end) 中可见的 id 写入 m_visible
+};
+
+} // namespace engine::render
@@ -0,0 +1,42 @@
+#include "GeometryPool.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+
+GeometryPool::GeometryPool(VulkanRenderer &renderer, VkDeviceSize slotSize, uint32_t slotCount)
+    : m_renderer(renderer), m_slotSize(slotSize), m_slotCount(slotCount) {
+    m_renderer.createBuffer(m_slotSize * m_slotCount,
+                            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                            MemoryUsage::GpuOnly, m_buffer, m_memory);
+    m_freeSlots.reserve(m_slotCount);
+    for (uint32_t i = m_slotCount; i > 0; i--) {
+        m_freeSlots.push_back(i - 1); // 从 0 号槽开始分配
+    }
+    spdlog::trace("GeometryPool::GeometryPool()::创建几何池成功, 槽大小: {} 字节, 槽数量: {}", m_slotSize, m_slotCount);
+}
+
+GeometryPool::~GeometryPool() = default;
+
+void GeometryPool::cleanup() {
+    VkDevice device = m_renderer.getDevice();
+    vkDestroyBuffer(device, m_buffer, nullptr);
+    m_renderer.freeMemory(m_memory);
+    m_buffer = VK_NULL_HANDLE;
+    m_memory = VK_NULL_HANDLE;
+    m_freeSlots.clear();
+}
+
+std::optional<uint32_t> GeometryPool::allocateSlot() {
+    if (m_freeSlots.empty()) return std::nullopt;
+    uint32_t slot = m_freeSlots.back();
+    m_freeSlots.pop_back();
+    return slot;
+}
+
+void GeometryPool::freeSlot(uint32_t slot) {
+    m_freeSlots.push_back(slot);
+}
+
+} // namespace engine::render
@@ -0,0 +1,53 @@
+#pragma once
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace engine::render {
+class VulkanRenderer;
+
+/**
+ * @class GeometryPool
+ * @brief 常驻显存的固定大小几何池
+ *
+ * 一块 DEVICE_LOCAL 缓冲区被切成等大的槽，每个槽存放一个区块的顶点和索引数据。
+ * 槽大小固定，分配和释放都是 O(1)，也不会产生碎片。
+ */
+class GeometryPool final {
+public:
+    GeometryPool(VulkanRenderer &renderer, VkDeviceSize slotSize, uint32_t slotCount);
+    ~GeometryPool();
+
+    GeometryPool(const GeometryPool &)            = delete;
+    GeometryPool &operator=(const GeometryPool &) = delete;
+    GeometryPool(GeometryPool &&)                 = delete;
+    GeometryPool &operator=(GeometryPool &&)      = delete;
+
+    void cleanup();
+
+    std::optional<uint32_t> allocateSlot(); // 没有空闲槽时返回空
+    void freeSlot(uint32_t slot);           // GPU 不再使用该槽后才能调用（通过延迟销毁队列）
+
+    VkBuffer getBuffer() const { return m_buffer; }
+    VkDeviceMemory getMemory() const { return m_memory; }
+    VkDeviceSize getSlotOffset(uint32_t slot) const { return m_slotSize * slot; }
+    VkDeviceSize getSlotSize() const { return m_slotSize; }
+    uint32_t getSlotCount() const { return m_slotCount; }
+    uint32_t getFreeSlotCount() const { return static_cast<uint32_t>(m_freeSlots.size()); }
+
+private:
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer;
+
+    VkBuffer m_buffer       = VK_NULL_HANDLE; // 几何池缓冲区，同时作为顶点和索引缓冲
+    VkDeviceMemory m_memory = VK_NULL_HANDLE; // 几何池内存
+    VkDeviceSize m_slotSize = 0;              // 每个槽的字节数
+    uint32_t m_slotCount    = 0;              // 槽数量
+
+    std::vector<uint32_t> m_freeSlots; // 空闲槽栈
+#pragma endregion
+};
+
+} // namespace engine::render
@@ -0,0 +1,189 @@
+#include "GlyphCache.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace engine::render {
+
+GlyphCache::GlyphCache(VulkanRenderer &renderer, VkFormat format, uint32_t size) : m_renderer(renderer), m_format(format), m_size(size) {
+    switch (format) {
+    case VK_FORMAT_R8_UNORM:
+        m_bytesPerPixel = 1;
+        break;
+    case VK_FORMAT_R8G8B8A8_UNORM:
+        m_bytesPerPixel = 4;
+        break;
+    default:
+        throw std::runtime_error("GlyphCache::GlyphCache()::不支持的图集格式");
+    }
+}
+
+GlyphCache::~GlyphCache() = default;
+
+void GlyphCache::init() {
+    ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    m_image                    = registry.createImage(m_size, m_size, m_format, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, MemoryUsage::GpuOnly);
+    VkImage image              = registry.getImage(m_image);
+    m_imageView                = m_renderer.createImageView(image, m_format, VK_IMAGE_ASPECT_COLOR_BIT);
+
+    // 清零后转换到着色器只读布局，之后每次上传只在复制前后切换布局
+    VkCommandBuffer commandBuffer = m_renderer.beginSingleTimeCommands();
+    VulkanRenderer::recordImageBarrier(commandBuffer, image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                       VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+    VkClearColorValue clearColor{};
+    VkImageSubresourceRange range{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    vkCmdClearColorImage(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearColor, 1, &range);
+    VulkanRenderer::recordImageBarrier(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    m_renderer.endSingleTimeCommands(commandBuffer);
+    spdlog::trace("GlyphCache::init()::字形图集创建成功, 尺寸: {}x{}", m_size, m_size);
+}
+
+void GlyphCache::cleanup() {
+    if (m_imageView != VK_NULL_HANDLE) m_renderer.releaseImageView(m_imageView);
+    m_imageView = VK_NULL_HANDLE;
+    m_image     = {}; // 图像由资源注册表在清理时销毁
+    m_glyphs.clear();
+    m_shelves.clear();
+    m_pendingUploads.clear();
+    m_pendingPixels.clear();
+}
+
+const GlyphEntry *GlyphCache::find(uint64_t key) {
+    auto it = m_glyphs.find(key);
+    if (it == m_glyphs.end()) {
+        m_stats.misses++;
+        return nullptr;
+    }
+    m_stats.hits++;
+    touchShelf(it->second.shelf);
+    return &it->second;
+}
+
+void GlyphCache::touchShelf(uint32_t shelf) {
+    if (shelf < m_shelves.size()) m_shelves[shelf].lastUsedFrame = m_frameNumber;
+}
+
+const GlyphEntry *GlyphCache::insert(uint64_t key, const GlyphBitmap &bitmap) {
+    if (bitmap.pixels.size() != static_cast<size_t>(bitmap.width) * bitmap.height * m_bytesPerPixel) {
+        throw std::runtime_error("GlyphCache::insert()::字形位图大小与尺寸不符");
+    }
+    GlyphEntry entry;
+    entry.width   = bitmap.width;
+    entry.height  = bitmap.height;
+    entry.offsetX = bitmap.offsetX;
+    entry.offsetY = bitmap.offsetY;
+    entry.advance = bitmap.advance;
+
+    // 空白字形（空格等）只记录度量，不占图集空间
+    if (bitmap.width > 0 && bitmap.height > 0) {
+        uint32_t shelfIndex = allocateShelf(bitmap.width + GLYPH_ATLAS_PADDING, bitmap.height + GLYPH_ATLAS_PADDING);
+        if (shelfIndex == GLYPH_NO_SHELF) {
+            m_stats.failedInserts++;
+            return nullptr;
+        }
+        Shelf &shelf        = m_shelves[shelfIndex];
+        entry.x             = shelf.cursorX;
+        entry.y             = shelf.y;
+        entry.shelf         = shelfIndex;
+        shelf.cursorX      += bitmap.width + GLYPH_ATLAS_PADDING;
+        shelf.lastUsedFrame = m_frameNumber;
+        shelf.glyphs.push_back(key);
+
+        // 每个字形在暂存区中按 4 字节对齐，满足 bufferOffset 的对齐要求
+        size_t offset = (m_pendingPixels.size() + 3) & ~static_cast<size_t>(3);
+        m_pendingPixels.resize(offset + bitmap.pixels.size());
+        std::memcpy(m_pendingPixels.data() + offset, bitmap.pixels.data(), bitmap.pixels.size());
+        m_pendingUploads.push_back({entry.x, entry.y, entry.width, entry.height, offset});
+        m_stats.usedPixels += static_cast<uint64_t>(bitmap.width + GLYPH_ATLAS_PADDING) * (bitmap.height + GLYPH_ATLAS_PADDING);
+    }
+
+    auto [it, inserted] = m_glyphs.insert_or_assign(key, entry);
+    m_stats.residentGlyphs = static_cast<uint32_t>(m_glyphs.size());
+    return &it->second;
+}
+
+uint32_t GlyphCache::allocateShelf(uint32_t width, uint32_t height) {
+    if (width > m_size || height > m_size) return GLYPH_NO_SHELF;
+
+    // 优先放进高度最接近、还有剩余宽度的层
+    uint32_t best = GLYPH_NO_SHELF;
+    for (uint32_t i = 0; i < m_shelves.size(); i++) {
+        const Shelf &shelf = m_shelves[i];
+        if (shelf.height < height || shelf.cursorX + width > m_size) continue;
+        if (best == GLYPH_NO_SHELF || shelf.height < m_shelves[best].height) best = i;
+    }
+    if (best != GLYPH_NO_SHELF && m_shelves[best].height <= height + height / 2) return best;
+
+    // 高度差太多时开新层，避免矮字形占用高层的空间
+    uint32_t shelfHeight = (height + GLYPH_SHELF_ROUNDING - 1) / GLYPH_SHELF_ROUNDING * GLYPH_SHELF_ROUNDING;
+    if (m_nextShelfY + shelfHeight <= m_size) {
+        Shelf shelf;
+        shelf.y      = m_nextShelfY;
+        shelf.height = shelfHeight;
+        m_nextShelfY += shelfHeight;
+        m_shelves.push_back(std::move(shelf));
+        return static_cast<uint32_t>(m_shelves.size() - 1);
+    }
+    if (best != GLYPH_NO_SHELF) return best;
+
+    // 图集已满：淘汰本帧没有使用过、最久未使用的一层
+    uint32_t victim = GLYPH_NO_SHELF;
+    for (uint32_t i = 0; i < m_shelves.size(); i++) {
+        const Shelf &shelf = m_shelves[i];
+        if (shelf.height < height || shelf.lastUsedFrame >= m_frameNumber) continue;
+        if (victim == GLYPH_NO_SHELF || shelf.lastUsedFrame < m_shelves[victim].lastUsedFrame ||
+            (shelf.lastUsedFrame == m_shelves[victim].lastUsedFrame && shelf.height < m_shelves[victim].height)) {
+            victim = i;
+        }
+    }
+    if (victim == GLYPH_NO_SHELF) return GLYPH_NO_SHELF;
+    evictShelf(victim);
+    return victim;
+}
+
+void GlyphCache::evictShelf(uint32_t shelfIndex) {
+    Shelf &shelf = m_shelves[shelfIndex];
+    for (uint64_t key : shelf.glyphs) {
+        auto it = m_glyphs.find(key);
+        if (it == m_glyphs.end()) continue;
+        m_stats.usedPixels -= static_cast<uint64_t>(it->second.width + GLYPH_ATLAS_PADDING) * (it->second.height + GLYPH_ATLAS_PADDING);
+        m_glyphs.erase(it);
+        m_stats.evictedGlyphs++;
+    }
+    spdlog::trace("GlyphCache::evictShelf()::淘汰字形层, y: {}, 高度: {}, 字形数: {}", shelf.y, shelf.height, shelf.glyphs.size());
+    shelf.glyphs.clear();
+    shelf.cursorX          = 0;
+    m_stats.residentGlyphs = static_cast<uint32_t>(m_glyphs.size());
+    m_generation++;
+}
+
+void GlyphCache::recordUploads(VkCommandBuffer commandBuffer) {
+    if (m_pendingUploads.empty()) return;
+    StreamingAllocation staging = m_renderer.getStreamingBuffer().upload(m_pendingPixels.data(), m_pendingPixels.size(), 4);
+    if (!staging) return; // 暂存空间不足，下一帧再上传
+
+    std::vector<VkBufferImageCopy> regions(m_pendingUploads.size());
+    for (size_t i = 0; i < m_pendingUploads.size(); i++) {
+        const PendingUpload &upload = m_pendingUploads[i];
+        regions[i].bufferOffset     = staging.offset + upload.offset;
+        regions[i].imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        regions[i].imageOffset      = {static_cast<int32_t>(upload.x), static_cast<int32_t>(upload.y), 0};
+        regions[i].imageExtent      = {upload.width, upload.height, 1};
+    }
+
+    // 之前的帧可能仍在采样图集的其他字形，布局转换保留原有内容
+    VkImage image = m_renderer.getResourceRegistry().getImage(m_image);
+    VulkanRenderer::recordImageBarrier(commandBuffer, image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                       VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+    vkCmdCopyBufferToImage(commandBuffer, staging.buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(regions.size()), regions.data());
+    VulkanRenderer::recordImageBarrier(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    m_pendingUploads.clear();
+    m_pendingPixels.clear();
+}
+
+} // namespace engine::render
@@ -0,0 +1,133 @@
+#pragma once
+#include "ResourceRegistry.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::render {
+class VulkanRenderer;
+
+#pragma region Constants
+const uint32_t GLYPH_ATLAS_SIZE     = 1024; // 默认图集边长（像素）
+const uint32_t GLYPH_ATLAS_PADDING  = 1;    // 字形之间的空白像素，避免线性过滤时采样到相邻字形
+const uint32_t GLYPH_SHELF_ROUNDING = 4;    // 新层的高度向上取整到该值的倍数，方便高度相近的字形共用一层
+const uint32_t GLYPH_NO_SHELF       = UINT32_MAX;
+#pragma endregion
+
+/**
+ * @struct GlyphBitmap
+ * @brief 光栅化后的字形位图
+ */
+struct GlyphBitmap {
+    uint32_t width  = 0;
+    uint32_t height = 0;
+    int32_t offsetX = 0;         // 位图左上角相对笔位置（行顶部）的偏移，像素
+    int32_t offsetY = 0;
+    float advance   = 0.0f;      // 笔位置前进的距离，像素
+    std::vector<uint8_t> pixels; // width * height 个像素，行优先，格式与图集一致
+};
+
+/**
+ * @struct GlyphEntry
+ * @brief 图集中的字形
+ */
+struct GlyphEntry {
+    uint32_t x      = 0; // 在图集中的位置，像素
+    uint32_t y      = 0;
+    uint32_t width  = 0;
+    uint32_t height = 0;
+    int32_t offsetX = 0;
+    int32_t offsetY = 0;
+    float advance   = 0.0f;
+    uint32_t shelf  = GLYPH_NO_SHELF; // 所在的层，空白字形不占图集空间
+};
+
+/**
+ * @struct GlyphCacheStats
+ * @brief 字形缓存统计，累计值
+ */
+struct GlyphCacheStats {
+    uint64_t hits           = 0; // find() 命中次数
+    uint64_t misses         = 0; // find() 未命中次数（需要光栅化）
+    uint64_t evictedGlyphs  = 0; // 被淘汰的字形数量
+    uint64_t failedInserts  = 0; // 淘汰之后仍然放不下的字形数量
+    uint32_t residentGlyphs = 0; // 当前缓存中的字形数量
+    uint64_t usedPixels     = 0; // 当前字形（含空白）占用的图集像素数
+};
+
+/**
+ * @class GlyphCache
+ * @brief 按需填充的字形图集：货架（shelf）装箱 + 按层的最近最少使用淘汰
+ *
+ * 图集按行划分为高度不同的层，字形放进高度最接近且还有剩余宽度的层，没有时在底部开新层。
+ * 图集满了之后淘汰本帧没有使用过、最久未使用的一层，层内所有字形一起失效，getGeneration() 随之加一，
+ * 缓存了字形位置的调用方据此判断是否需要重新查找。本帧使用过的层不会被淘汰，因此已经提交的绘制不受影响。
+ * 新字形先写入 CPU 端暂存区，recordUploads() 时统一复制到图集；只能在渲染线程使用。
+ */
+class GlyphCache final {
+public:
+    GlyphCache(VulkanRenderer &renderer, VkFormat format = VK_FORMAT_R8_UNORM, uint32_t size = GLYPH_ATLAS_SIZE);
+    ~GlyphCache();
+
+    GlyphCache(const GlyphCache &)            = delete;
+    GlyphCache &operator=(const GlyphCache &) = delete;
+    GlyphCache(GlyphCache &&)                 = delete;
+    GlyphCache &operator=(GlyphCache &&)      = delete;
+
+    void init();
+    void cleanup();
+
+    void beginFrame(uint64_t frameNumber) { m_frameNumber = frameNumber; }
+    const GlyphEntry *find(uint64_t key);                              // 命中时把所在层标记为本帧使用
+    const GlyphEntry *insert(uint64_t key, const GlyphBitmap &bitmap); // 放不下时返回 nullptr
+    void touchShelf(uint32_t shelf);                                   // 缓存了字形位置的调用方每帧标记自己用到的层
+    void recordUploads(VkCommandBuffer commandBuffer);                 // 在渲染通道之外调用：把新字形复制到图集
+
+    VkImageView getImageView() const { return m_imageView; }
+    uint32_t getSize() const { return m_size; }
+    uint32_t getGeneration() const { return m_generation; }
+    uint64_t getAtlasBytes() const { return static_cast<uint64_t>(m_size) * m_size * m_bytesPerPixel; }
+    const GlyphCacheStats &getStats() const { return m_stats; }
+
+private:
+    struct Shelf {
+        uint32_t y             = 0;
+        uint32_t height        = 0;
+        uint32_t cursorX       = 0;   // 下一个字形的位置
+        uint64_t lastUsedFrame = 0;
+        std::vector<uint64_t> glyphs; // 层内的字形，淘汰时一起删除
+    };
+
+    struct PendingUpload {
+        uint32_t x, y, width, height;
+        size_t offset; // 在 m_pendingPixels 中的位置
+    };
+
+    uint32_t allocateShelf(uint32_t width, uint32_t height); // 返回可以放下字形的层，失败返回 GLYPH_NO_SHELF
+    void evictShelf(uint32_t shelf);
+
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer;
+    const VkFormat m_format;
+    const uint32_t m_size;
+    uint32_t m_bytesPerPixel = 1;
+
+    ImageHandle m_image;                      // 视图在创建时固定，不参与碎片整理
+    VkImageView m_imageView = VK_NULL_HANDLE;
+
+    std::unordered_map<uint64_t, GlyphEntry> m_glyphs;
+    std::vector<Shelf> m_shelves;
+    uint32_t m_nextShelfY  = 0; // 尚未划分为层的区域起点
+    uint32_t m_generation  = 0; // 每次淘汰加一
+    uint64_t m_frameNumber = 0;
+
+    std::vector<PendingUpload> m_pendingUploads;
+    std::vector<uint8_t> m_pendingPixels;
+    GlyphCacheStats m_stats;
+#pragma endregion
+};
+
+} // namespace engine::render
@@ -0,0 +1,246 @@
+#include "MemoryBlockAllocator.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+namespace engine::render {
+
+MemoryBlockAllocator::MemoryBlockAllocator(VulkanRenderer &renderer) : m_renderer(renderer) {}
+
+MemoryBlockAllocator::~MemoryBlockAllocator() = default;
+
+MemoryBlockAllocation MemoryBlockAllocator::allocate(const VkMemoryRequirements &requirements, MemoryUsage usage, MemoryCategory category, bool movable) {
+    MemoryBlockAllocation allocation;
+    allocation.size    = requirements.size;
+    allocation.movable = movable;
+    bool dedicated     = requirements.size > MEMORY_BLOCK_DEDICATED_THRESHOLD;
+
+    // 依次尝试按偏好排序的内存类型：先在已有的内存块中查找，放不下时创建新的内存块，所在堆耗尽时换下一个类型
+    uint32_t typeFilter = requirements.memoryTypeBits;
+    while (allocation.block == UINT32_MAX) {
+        uint32_t memoryTypeIndex = m_renderer.getMemoryTypePolicy().selectMemoryType(typeFilter, usage);
+        if (memoryTypeIndex == UINT32_MAX) return {};
+        if (!dedicated) {
+            for (uint32_t i = 0; i < m_blocks.size(); i++) {
+                Block &block = m_blocks[i];
+                if (block.memory == VK_NULL_HANDLE || block.dedicated || block.excluded) continue;
+                if (block.memoryTypeIndex != memoryTypeIndex || block.category != category) continue;
+                if (allocateFromRanges(block.freeRanges, requirements, allocation.offset)) {
+                    allocation.block = i;
+                    break;
+                }
+            }
+            if (allocation.block != UINT32_MAX) break;
+        }
+        uint32_t block = createBlock(dedicated ? requirements.size : MEMORY_BLOCK_SIZE, memoryTypeIndex, category, dedicated);
+        if (block == UINT32_MAX) {
+            spdlog::warn("MemoryBlockAllocator::allocate()::内存类型 {} 无法创建内存块, 尝试下一个内存类型", memoryTypeIndex);
+            typeFilter &= ~(1u << memoryTypeIndex);
+            continue;
+        }
+        allocation.offset = 0;
+        if (!dedicated) allocateFromRanges(m_blocks[block].freeRanges, requirements, allocation.offset); // 新内存块一定放得下
+        allocation.block = block;
+    }
+
+    Block &block      = m_blocks[allocation.block];
+    block.usedBytes  += requirements.size;
+    block.allocations++;
+    if (!movable) block.pinned++;
+    auto position = std::lower_bound(block.subAllocations.begin(), block.subAllocations.end(), allocation.offset,
+                                     [](const SubAllocation &sub, VkDeviceSize offset) { return sub.offset < offset; });
+    block.subAllocations.insert(position, {allocation.offset, requirements.size, std::max<VkDeviceSize>(requirements.alignment, 1)});
+    allocation.memory = block.memory;
+    return allocation;
+}
+
+void MemoryBlockAllocator::free(const MemoryBlockAllocation &allocation) {
+    if (!allocation || allocation.block >= m_blocks.size()) return;
+    Block &block     = m_blocks[allocation.block];
+    block.usedBytes -= allocation.size;
+    block.allocations--;
+    if (!allocation.movable) block.pinned--;
+    if (block.allocations == 0) {
+        releaseBlock(allocation.block);
+        return;
+    }
+    auto sub = std::lower_bound(block.subAllocations.begin(), block.subAllocations.end(), allocation.offset,
+                                [](const SubAllocation &sub, VkDeviceSize offset) { return sub.offset < offset; });
+    if (sub != block.subAllocations.end() && sub->offset == allocation.offset) block.subAllocations.erase(sub);
+
+    // 插入空闲区间，与前后相邻的区间合并
+    Range range{allocation.offset, allocation.size};
+    auto next = std::lower_bound(block.freeRanges.begin(), block.freeRanges.end(), range.offset,
+                                 [](const Range &free, VkDeviceSize offset) { return free.offset < offset; });
+    if (next != block.freeRanges.end() && range.offset + range.size == next->offset) {
+        range.size += next->size;
+        next        = block.freeRanges.erase(next);
+    }
+    if (next != block.freeRanges.begin()) {
+        Range &previous = *std::prev(next);
+        if (previous.offset + previous.size == range.offset) {
+            previous.size += range.size;
+            return;
+        }
+    }
+    block.freeRanges.insert(next, range);
+}
+
+void MemoryBlockAllocator::cleanup() {
+    uint32_t leaked = 0;
+    for (uint32_t i = 0; i < m_blocks.size(); i++) {
+        if (m_blocks[i].memory == VK_NULL_HANDLE) continue;
+        leaked += m_blocks[i].allocations;
+        m_renderer.freeMemory(m_blocks[i].memory);
+    }
+    if (leaked > 0) spdlog::warn("MemoryBlockAllocator::cleanup()::仍有 {} 个子分配未释放", leaked);
+    m_blocks.clear();
+    m_freeBlockIds.clear();
+}
+
+std::vector<uint32_t> MemoryBlockAllocator::selectSparseBlocks(float maxOccupancy) const {
+    std::vector<uint32_t> candidates;
+    for (uint32_t i = 0; i < m_blocks.size(); i++) {
+        const Block &block = m_blocks[i];
+        if (block.memory != VK_NULL_HANDLE && !block.dedicated && !block.excluded) candidates.push_back(i);
+    }
+    // 同类内存块排在一起，组内按占用从低到高
+    std::sort(candidates.begin(), candidates.end(), [this](uint32_t a, uint32_t b) {
+        const Block &blockA = m_blocks[a];
+        const Block &blockB = m_blocks[b];
+        if (blockA.memoryTypeIndex != blockB.memoryTypeIndex) return blockA.memoryTypeIndex < blockB.memoryTypeIndex;
+        if (blockA.category != blockB.category) return blockA.category < blockB.category;
+        return blockA.usedBytes < blockB.usedBytes;
+    });
+
+    std::vector<uint32_t> selected;
+    for (size_t groupBegin = 0; groupBegin < candidates.size();) {
+        const Block &first = m_blocks[candidates[groupBegin]];
+        size_t groupEnd    = groupBegin;
+        while (groupEnd < candidates.size() && m_blocks[candidates[groupEnd]].memoryTypeIndex == first.memoryTypeIndex &&
+               m_blocks[candidates[groupEnd]].category == first.category) {
+            groupEnd++;
+        }
+
+        // 组内内存块按编号排序，与 allocate() 查找目标内存块的顺序一致；模拟在空闲区间的副本上进行
+        std::vector<uint32_t> targets(candidates.begin() + static_cast<std::ptrdiff_t>(groupBegin), candidates.begin() + static_cast<std::ptrdiff_t>(groupEnd));
+        std::sort(targets.begin(), targets.end());
+        std::vector<std::vector<Range>> simulated(targets.size());
+        for (size_t t = 0; t < targets.size(); t++) {
+            simulated[t] = m_blocks[targets[t]].freeRanges;
+        }
+        std::vector<bool> emptied(targets.size(), false);  // 已选中、资源会被搬走的内存块
+        std::vector<bool> received(targets.size(), false); // 模拟中接收了搬来的资源，不能再被清空
+
+        for (size_t i = groupBegin; i < groupEnd; i++) {
+            const Block &block = m_blocks[candidates[i]];
+            if (static_cast<float>(block.usedBytes) >= maxOccupancy * static_cast<float>(block.size)) break;
+            size_t self = static_cast<size_t>(std::lower_bound(targets.begin(), targets.end(), candidates[i]) - targets.begin());
+            if (block.pinned > 0 || received[self]) continue;
+
+            // 每个子分配按原来的大小和对齐首次适配到其余内存块，有一个放不下就需要新的内存块，跳过这个内存块
+            std::vector<std::vector<Range>> trial = simulated;
+            std::vector<bool> trialReceived       = received;
+            bool fits                             = true;
+            for (const SubAllocation &sub : block.subAllocations) {
+                VkMemoryRequirements requirements{sub.size, sub.alignment, 0};
+                VkDeviceSize offset = 0;
+                bool placed         = false;
+                for (size_t t = 0; t < targets.size() && !placed; t++) {
+                    if (t == self || emptied[t]) continue;
+                    placed = allocateFromRanges(trial[t], requirements, offset);
+                    if (placed) trialReceived[t] = true;
+                }
+                if (!placed) {
+                    fits = false;
+                    break;
+                }
+            }
+            if (!fits) continue;
+            simulated     = std::move(trial);
+            received      = std::move(trialReceived);
+            emptied[self] = true;
+            selected.push_back(candidates[i]);
+        }
+        groupBegin = groupEnd;
+    }
+    return selected;
+}
+
+void MemoryBlockAllocator::setExcluded(uint32_t block, bool excluded) {
+    if (block < m_blocks.size() && m_blocks[block].memory != VK_NULL_HANDLE) m_blocks[block].excluded = excluded;
+}
+
+MemoryBlockStats MemoryBlockAllocator::getStats() const {
+    MemoryBlockStats stats;
+    for (const Block &block : m_blocks) {
+        if (block.memory == VK_NULL_HANDLE) continue;
+        stats.blocks++;
+        stats.allocations += block.allocations;
+        stats.blockBytes  += block.size;
+        stats.usedBytes   += block.usedBytes;
+        for (const Range &range : block.freeRanges) {
+            stats.largestFreeRange = std::max(stats.largestFreeRange, range.size);
+        }
+    }
+    stats.freeBytes     = stats.blockBytes - stats.usedBytes;
+    stats.fragmentation = stats.freeBytes > 0 ? 1.0f - static_cast<float>(stats.largestFreeRange) / static_cast<float>(stats.freeBytes) : 0.0f;
+    return stats;
+}
+
+bool MemoryBlockAllocator::allocateFromRanges(std::vector<Range> &freeRanges, const VkMemoryRequirements &requirements, VkDeviceSize &offset) {
+    VkDeviceSize alignment = std::max<VkDeviceSize>(requirements.alignment, 1);
+    for (size_t i = 0; i < freeRanges.size(); i++) {
+        Range range                = freeRanges[i];
+        VkDeviceSize alignedOffset = (range.offset + alignment - 1) / alignment * alignment;
+        VkDeviceSize rangeEnd      = range.offset + range.size;
+        if (alignedOffset + requirements.size > rangeEnd) continue;
+
+        // 对齐留下的前部空隙和剩余的后部仍是空闲区间
+        Range front{range.offset, alignedOffset - range.offset};
+        Range back{alignedOffset + requirements.size, rangeEnd - alignedOffset - requirements.size};
+        auto it = freeRanges.erase(freeRanges.begin() + static_cast<std::ptrdiff_t>(i));
+        if (back.size > 0) it = freeRanges.insert(it, back);
+        if (front.size > 0) freeRanges.insert(it, front);
+        offset = alignedOffset;
+        return true;
+    }
+    return false;
+}
+
+uint32_t MemoryBlockAllocator::createBlock(VkDeviceSize size, uint32_t memoryTypeIndex, MemoryCategory category, bool dedicated) {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    if (m_renderer.allocateMemory(size, memoryTypeIndex, category, memory) != VK_SUCCESS) return UINT32_MAX;
+
+    uint32_t id = 0;
+    if (!m_freeBlockIds.empty()) {
+        id = m_freeBlockIds.back();
+        m_freeBlockIds.pop_back();
+    } else {
+        id = static_cast<uint32_t>(m_blocks.size());
+        m_blocks.emplace_back();
+    }
+    Block &block          = m_blocks[id];
+    block                 = Block{};
+    block.memory          = memory;
+    block.memoryTypeIndex = memoryTypeIndex;
+    block.category        = category;
+    block.size            = size;
+    block.dedicated       = dedicated;
+    if (!dedicated) block.freeRanges.push_back({0, size});
+    spdlog::trace("MemoryBlockAllocator::createBlock()::创建内存块 {}, 大小: {}, 内存类型: {}, 分类: {}", id, size, memoryTypeIndex, toString(category));
+    return id;
+}
+
+void MemoryBlockAllocator::releaseBlock(uint32_t block) {
+    m_renderer.freeMemory(m_blocks[block].memory);
+    m_blocks[block] = Block{};
+    m_freeBlockIds.push_back(block);
+    spdlog::trace("MemoryBlockAllocator::releaseBlock()::释放内存块 {}", block);
+}
+
+} // namespace engine::render
@@ -0,0 +1,118 @@
+#pragma once
+#include "MemoryBudget.hpp"
+#include "MemoryTypePolicy.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::render {
+class VulkanRenderer;
+
+#pragma region Constants
+const VkDeviceSize MEMORY_BLOCK_SIZE                = 64ull * 1024 * 1024;   // 每个内存块的字节数
+const VkDeviceSize MEMORY_BLOCK_DEDICATED_THRESHOLD = MEMORY_BLOCK_SIZE / 2; // 超过该大小的资源独占一个内存块，不参与碎片整理
+#pragma endregion
+
+/**
+ * @struct MemoryBlockAllocation
+ * @brief 内存块中的一段子分配
+ */
+struct MemoryBlockAllocation {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset   = 0;
+    VkDeviceSize size     = 0;          // 资源要求的字节数，不包含对齐留下的空隙
+    uint32_t block        = UINT32_MAX; // 内存块编号
+    bool movable          = false;      // 碎片整理时可以搬移
+
+    explicit operator bool() const { return memory != VK_NULL_HANDLE; }
+};
+
+/**
+ * @struct MemoryBlockStats
+ * @brief 所有内存块的占用和碎片情况
+ */
+struct MemoryBlockStats {
+    uint32_t blocks               = 0;
+    uint32_t allocations          = 0;
+    VkDeviceSize blockBytes       = 0;    // 所有内存块的字节数
+    VkDeviceSize usedBytes        = 0;    // 子分配占用的字节数
+    VkDeviceSize freeBytes        = 0;    // 内存块内的空闲字节数，包含对齐留下的空隙
+    VkDeviceSize largestFreeRange = 0;    // 最大的连续空闲区间
+    float fragmentation           = 0.0f; // 1 - 最大空闲区间 / 空闲字节，0 表示空闲空间连续
+};
+
+/**
+ * @class MemoryBlockAllocator
+ * @brief 把 MEMORY_BLOCK_SIZE 大小的设备内存块切分给多个资源
+ *
+ * 每个内存块只存放一种内存类型和一种显存分类的资源，所以缓冲区和图像不会落在同一个内存块中，不需要考虑 bufferImageGranularity。
+ * 内存块内的空闲区间按偏移排序，分配时首次适配，释放时与相邻区间合并；内存块空了立即释放。
+ * 长时间流式加载之后内存块会变得稀疏，ResourceRegistry 选出 selectSparseBlocks() 返回的内存块，
+ * 把其中的资源搬到别的内存块，空出来的内存块随之释放。
+ */
+class MemoryBlockAllocator final {
+public:
+    explicit MemoryBlockAllocator(VulkanRenderer &renderer);
+    ~MemoryBlockAllocator();
+
+    MemoryBlockAllocator(const MemoryBlockAllocator &)            = delete;
+    MemoryBlockAllocator &operator=(const MemoryBlockAllocator &) = delete;
+    MemoryBlockAllocator(MemoryBlockAllocator &&)                 = delete;
+    MemoryBlockAllocator &operator=(MemoryBlockAllocator &&)      = delete;
+
+    MemoryBlockAllocation allocate(const VkMemoryRequirements &requirements, MemoryUsage usage, MemoryCategory category, bool movable); // 失败时返回空分配
+    void free(const MemoryBlockAllocation &allocation);                                                                                 // 资源已经不再被 GPU 使用时调用
+    void cleanup();                                                                                                                     // 释放所有内存块，调用前设备必须空闲
+
+    /**
+     * @brief 选出值得整理的稀疏内存块：占用率低于 maxOccupancy，且只含可搬移的资源
+     *
+     * 在每组同类内存块中按占用从低到高考察，把候选内存块中的每个子分配按大小和对齐在其余内存块的空闲区间副本上
+     * 按 allocate() 的顺序做一遍首次适配；只要有一个子分配放不下就跳过该内存块，因此搬移时不需要创建新的内存块。
+     */
+    std::vector<uint32_t> selectSparseBlocks(float maxOccupancy) const;
+    void setExcluded(uint32_t block, bool excluded); // 被排除的内存块不再接受新的分配，内存块释放后自动恢复
+    bool isExcluded(uint32_t block) const { return block < m_blocks.size() && m_blocks[block].excluded; }
+
+    MemoryBlockStats getStats() const;
+
+private:
+    struct Range {
+        VkDeviceSize offset;
+        VkDeviceSize size;
+    };
+
+    struct SubAllocation {
+        VkDeviceSize offset;
+        VkDeviceSize size;
+        VkDeviceSize alignment;
+    };
+
+    struct Block {
+        VkDeviceMemory memory    = VK_NULL_HANDLE; // 为空时表示编号可以复用
+        uint32_t memoryTypeIndex = 0;
+        MemoryCategory category  = MemoryCategory::Buffers;
+        VkDeviceSize size        = 0;
+        VkDeviceSize usedBytes   = 0;
+        uint32_t allocations     = 0;
+        uint32_t pinned          = 0;              // 不可搬移的资源数
+        bool dedicated           = false;          // 只存放一个大资源
+        bool excluded            = false;          // 正在被碎片整理清空
+        std::vector<Range> freeRanges;             // 按偏移排序
+        std::vector<SubAllocation> subAllocations; // 按偏移排序，选择稀疏内存块时模拟搬移
+    };
+
+    static bool allocateFromRanges(std::vector<Range> &freeRanges, const VkMemoryRequirements &requirements, VkDeviceSize &offset); // 首次适配
+    uint32_t createBlock(VkDeviceSize size, uint32_t memoryTypeIndex, MemoryCategory category, bool dedicated); // 失败时返回 UINT32_MAX
+    void releaseBlock(uint32_t block);
+
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer;
+    std::vector<Block> m_blocks;
+    std::vector<uint32_t> m_freeBlockIds; // 已释放、可以复用的内存块编号
+#pragma endregion
+};
+
+} // namespace engine::render
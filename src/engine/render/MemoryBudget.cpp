@@ -0,0 +1,207 @@
+#include "MemoryBudget.hpp"
+#include "TextRenderer.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+
+namespace engine::render {
+
+namespace {
+VkDeviceSize scaleBytes(VkDeviceSize bytes, float ratio) {
+    return static_cast<VkDeviceSize>(static_cast<double>(bytes) * ratio);
+}
+
+double toMiB(VkDeviceSize bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+// 格式化到栈上的缓冲区，叠加层每帧绘制也不分配堆内存，超长的部分截断
+template <typename... Args>
+void drawLine(TextRenderer &textRenderer, uint32_t font, const glm::vec2 &position, float scale, const glm::vec4 &color,
+              fmt::format_string<Args...> format, Args &&...args) {
+    std::array<char, 128> buffer;
+    auto result   = fmt::format_to_n(buffer.data(), buffer.size(), format, std::forward<Args>(args)...);
+    size_t length = std::min(static_cast<size_t>(result.size), buffer.size());
+    textRenderer.drawText(font, std::string_view(buffer.data(), length), position, color, scale);
+}
+} // namespace
+
+const char *toString(MemoryCategory category) {
+    switch (category) {
+    case MemoryCategory::Textures:
+        return "Textures";
+    case MemoryCategory::Meshes:
+        return "Meshes";
+    case MemoryCategory::Buffers:
+        return "Buffers";
+    case MemoryCategory::RenderTargets:
+        return "RenderTargets";
+    default:
+        return "Unknown";
+    }
+}
+
+MemoryBudget::MemoryBudget(VulkanRenderer &renderer) : m_renderer(renderer) {}
+
+MemoryBudget::~MemoryBudget() = default;
+
+void MemoryBudget::init(bool budgetExtension) {
+    vkGetPhysicalDeviceMemoryProperties(m_renderer.getPhysicalDevice(), &m_memoryProperties);
+    m_stats.budgetExtension = budgetExtension;
+    m_stats.heapCount       = m_memoryProperties.memoryHeapCount;
+    for (uint32_t i = 0; i < m_stats.heapCount; i++) {
+        m_stats.heaps[i].size        = m_memoryProperties.memoryHeaps[i].size;
+        m_stats.heaps[i].deviceLocal = (m_memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+    }
+    queryBudget();
+    for (uint32_t i = 0; i < m_stats.heapCount; i++) {
+        const MemoryHeapBudget &heap = m_stats.heaps[i];
+        spdlog::info("MemoryBudget::init()::内存堆 {}: {:.1f} MiB, 预算: {:.1f} MiB, 显存: {}", i, toMiB(heap.size), toMiB(heap.budget), heap.deviceLocal);
+    }
+    if (!budgetExtension) {
+        spdlog::info("MemoryBudget::init()::不支持 VK_EXT_memory_budget, 预算按堆大小的 {} 估计", MEMORY_BUDGET_FALLBACK_RATIO);
+    }
+}
+
+void MemoryBudget::queryBudget() {
+    if (m_stats.budgetExtension) {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
+        budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+        VkPhysicalDeviceMemoryProperties2 memoryProperties{};
+        memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        memoryProperties.pNext = &budgetProperties;
+        vkGetPhysicalDeviceMemoryProperties2(m_renderer.getPhysicalDevice(), &memoryProperties);
+        for (uint32_t i = 0; i < m_stats.heapCount; i++) {
+            m_stats.heaps[i].budget = budgetProperties.heapBudget[i];
+            m_stats.heaps[i].usage  = budgetProperties.heapUsage[i];
+        }
+        return;
+    }
+    for (uint32_t i = 0; i < m_stats.heapCount; i++) {
+        m_stats.heaps[i].budget = scaleBytes(m_stats.heaps[i].size, MEMORY_BUDGET_FALLBACK_RATIO);
+        m_stats.heaps[i].usage  = m_stats.heaps[i].tracked;
+    }
+}
+
+void MemoryBudget::update(uint64_t frameNumber) {
+    queryBudget();
+    for (uint32_t i = 0; i < m_stats.heapCount; i++) {
+        const MemoryHeapBudget &heap = m_stats.heaps[i];
+        bool overBudget              = heap.usage > scaleBytes(heap.budget, MEMORY_BUDGET_EVICT_RATIO);
+        if (overBudget && !m_overBudget[i]) {
+            spdlog::warn("MemoryBudget::update()::内存堆 {} 接近预算: {:.1f} / {:.1f} MiB", i, toMiB(heap.usage), toMiB(heap.budget));
+        }
+        m_overBudget[i] = overBudget;
+        if (!overBudget || frameNumber < m_nextCheckFrame) continue;
+        // 被淘汰的资源经由延迟销毁队列释放，等这些帧完成、驱动报告的用量下降后再检查
+        if (evict(i, heap.usage - scaleBytes(heap.budget, MEMORY_BUDGET_TARGET_RATIO)) > 0) {
+            m_nextCheckFrame = frameNumber + MAX_FRAMES_IN_FLIGHT + 1;
+        }
+    }
+}
+
+void MemoryBudget::trackAllocation(VkDeviceMemory memory, VkDeviceSize size, uint32_t memoryTypeIndex, MemoryCategory category) {
+    uint32_t heapIndex = getHeapIndex(memoryTypeIndex);
+    m_allocations.emplace(memory, Allocation{size, heapIndex, category});
+    m_stats.heaps[heapIndex].tracked += size;
+    m_stats.heaps[heapIndex].usage += size; // 下一次读取预算之前按登记的分配估计
+    m_stats.categoryBytes[static_cast<size_t>(category)] += size;
+    m_stats.categoryAllocations[static_cast<size_t>(category)]++;
+}
+
+void MemoryBudget::trackFree(VkDeviceMemory memory) {
+    auto it = m_allocations.find(memory);
+    if (it == m_allocations.end()) return;
+    const Allocation &allocation = it->second;
+    MemoryHeapBudget &heap       = m_stats.heaps[allocation.heapIndex];
+    heap.tracked -= allocation.size;
+    heap.usage -= std::min(heap.usage, allocation.size);
+    m_stats.categoryBytes[static_cast<size_t>(allocation.category)] -= allocation.size;
+    m_stats.categoryAllocations[static_cast<size_t>(allocation.category)]--;
+    m_allocations.erase(it);
+}
+
+void MemoryBudget::makeRoom(uint32_t memoryTypeIndex, VkDeviceSize size) {
+    uint32_t heapIndex           = getHeapIndex(memoryTypeIndex);
+    const MemoryHeapBudget &heap = m_stats.heaps[heapIndex];
+    VkDeviceSize projected       = heap.usage + size;
+    if (projected <= heap.budget) return;
+    evict(heapIndex, projected - scaleBytes(heap.budget, MEMORY_BUDGET_TARGET_RATIO));
+}
+
+VkDeviceSize MemoryBudget::evict(uint32_t heapIndex, VkDeviceSize bytes) {
+    if (m_evicting || bytes == 0) return 0;
+    m_evicting            = true;
+    VkDeviceSize released = 0;
+    try {
+        for (HandlerEntry &entry : m_handlers) {
+            if (released >= bytes) break;
+            VkDeviceSize freed = entry.handler(heapIndex, bytes - released);
+            if (freed == 0) continue;
+            released += freed;
+            m_stats.evictions++;
+        }
+    } catch (...) {
+        m_evicting = false;
+        throw;
+    }
+    m_evicting = false;
+    m_stats.evictedBytes += released;
+    if (released > 0) {
+        spdlog::info("MemoryBudget::evict()::内存堆 {} 需要释放 {:.1f} MiB, 淘汰了 {:.1f} MiB", heapIndex, toMiB(bytes), toMiB(released));
+    }
+    return released;
+}
+
+uint32_t MemoryBudget::addEvictionHandler(EvictionHandler handler) {
+    uint32_t id = m_nextHandlerId++;
+    m_handlers.push_back({id, std::move(handler)});
+    return id;
+}
+
+void MemoryBudget::removeEvictionHandler(uint32_t id) {
+    std::erase_if(m_handlers, [id](const HandlerEntry &entry) { return entry.id == id; });
+}
+
+uint32_t MemoryBudget::getHeapIndexOf(VkDeviceMemory memory) const {
+    auto it = m_allocations.find(memory);
+    return it == m_allocations.end() ? UINT32_MAX : it->second.heapIndex;
+}
+
+MemoryCategory MemoryBudget::categorizeBuffer(VkBufferUsageFlags usage) {
+    if (usage & (VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT)) return MemoryCategory::Meshes;
+    return MemoryCategory::Buffers;
+}
+
+MemoryCategory MemoryBudget::categorizeImage(VkImageUsageFlags usage) {
+    const VkImageUsageFlags targetUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+    if (usage & targetUsage) return MemoryCategory::RenderTargets;
+    return MemoryCategory::Textures;
+}
+
+void MemoryBudget::drawOverlay(TextRenderer &textRenderer, uint32_t font, const glm::vec2 &position, float scale) const {
+    const glm::vec4 white(1.0f);
+    const glm::vec4 red(1.0f, 0.3f, 0.3f, 1.0f);
+    glm::vec2 cursor = position;
+    float lineHeight = textRenderer.measureText(font, "M", scale).y;
+    for (uint32_t i = 0; i < m_stats.heapCount; i++) {
+        const MemoryHeapBudget &heap = m_stats.heaps[i];
+        drawLine(textRenderer, font, cursor, scale, heap.usage > heap.budget ? red : white, "Heap {}{}: {:.1f} / {:.1f} MiB (engine {:.1f} MiB)", i,
+                 heap.deviceLocal ? " VRAM" : "", toMiB(heap.usage), toMiB(heap.budget), toMiB(heap.tracked));
+        cursor.y += lineHeight;
+    }
+    for (size_t i = 0; i < static_cast<size_t>(MemoryCategory::Count); i++) {
+        drawLine(textRenderer, font, cursor, scale, white, "{}: {:.1f} MiB in {} allocations", toString(static_cast<MemoryCategory>(i)),
+                 toMiB(m_stats.categoryBytes[i]), m_stats.categoryAllocations[i]);
+        cursor.y += lineHeight;
+    }
+    drawLine(textRenderer, font, cursor, scale, white, "Evicted: {:.1f} MiB in {} evictions, {} allocation retries", toMiB(m_stats.evictedBytes),
+             m_stats.evictions, m_stats.allocationRetries);
+}
+
+} // namespace engine::render
@@ -0,0 +1,136 @@
+#pragma once
+#include "../utils/Math.hpp"
+#include "RenderConstants.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::render {
+class VulkanRenderer;
+class TextRenderer;
+
+#pragma region Constants
+const float MEMORY_BUDGET_FALLBACK_RATIO = 0.8f;  // 不支持 VK_EXT_memory_budget 时按堆大小的该比例作为预算
+const float MEMORY_BUDGET_EVICT_RATIO    = 0.95f; // 每帧检查：用量超过预算的该比例时开始淘汰
+const float MEMORY_BUDGET_TARGET_RATIO   = 0.85f; // 淘汰到预算的该比例为止，留出余量避免每帧反复淘汰
+#pragma endregion
+
+/**
+ * @enum MemoryCategory
+ * @brief 显存分配的用途分类，由缓冲区和图像的用途标志推断
+ */
+enum class MemoryCategory : uint32_t {
+    Textures,      // 采样图像
+    Meshes,        // 顶点和索引缓冲区
+    Buffers,       // 其他缓冲区：存储、间接、暂存、统一缓冲区
+    RenderTargets, // 颜色、深度和存储图像
+    Count
+};
+
+const char *toString(MemoryCategory category);
+
+/**
+ * @struct MemoryHeapBudget
+ * @brief 一个内存堆的用量和预算
+ */
+struct MemoryHeapBudget {
+    VkDeviceSize size    = 0;     // 堆的总大小
+    VkDeviceSize budget  = 0;     // 本进程可以使用的字节数，由驱动报告或按堆大小估计
+    VkDeviceSize usage   = 0;     // 本进程的用量，由驱动报告（包含驱动内部分配）或等于 tracked
+    VkDeviceSize tracked = 0;     // 渲染器自己分配的字节数
+    bool deviceLocal     = false; // 是否为显存
+};
+
+/**
+ * @struct MemoryBudgetStats
+ * @brief 显存预算统计
+ */
+struct MemoryBudgetStats {
+    uint32_t heapCount         = 0;
+    uint64_t evictions         = 0;     // 淘汰处理函数释放了内存的次数，累计值
+    VkDeviceSize evictedBytes  = 0;     // 淘汰处理函数报告释放的字节数，累计值
+    uint64_t allocationRetries = 0;     // 分配失败后淘汰并重试的次数，累计值
+    bool budgetExtension       = false; // 预算是否来自 VK_EXT_memory_budget
+
+    std::array<MemoryHeapBudget, VK_MAX_MEMORY_HEAPS> heaps{};
+    std::array<VkDeviceSize, static_cast<size_t>(MemoryCategory::Count)> categoryBytes{};   // 每个分类当前的字节数
+    std::array<uint32_t, static_cast<size_t>(MemoryCategory::Count)> categoryAllocations{}; // 每个分类当前的分配数量
+};
+
+/**
+ * @class MemoryBudget
+ * @brief 跟踪每个内存堆和每个用途分类的显存用量，超出预算时淘汰或降级可流式加载的资源
+ *
+ * 所有 vkAllocateMemory / vkFreeMemory 都经由 VulkanRenderer::allocateMemory() / freeMemory()，在这里登记。
+ * 支持 VK_EXT_memory_budget 时每帧从驱动读取各堆的预算和用量，否则按堆大小估计预算、按登记的分配计算用量。
+ * 可流式加载的资源注册淘汰处理函数：每帧用量超过预算，或分配会超出预算时，按注册顺序调用，直到释放足够的字节。
+ * 处理函数通过延迟销毁队列释放内存，用量在之后的帧里才下降，因此每帧检查在淘汰后等待 MAX_FRAMES_IN_FLIGHT 帧再进行。
+ */
+class MemoryBudget final {
+public:
+    // 返回将要释放的字节数，heapIndex 为需要释放内存的堆
+    using EvictionHandler = std::function<VkDeviceSize(uint32_t heapIndex, VkDeviceSize bytes)>;
+
+    explicit MemoryBudget(VulkanRenderer &renderer);
+    ~MemoryBudget();
+
+    MemoryBudget(const MemoryBudget &)            = delete;
+    MemoryBudget &operator=(const MemoryBudget &) = delete;
+    MemoryBudget(MemoryBudget &&)                 = delete;
+    MemoryBudget &operator=(MemoryBudget &&)      = delete;
+
+    void init(bool budgetExtension);   // 在逻辑设备创建之后调用
+    void update(uint64_t frameNumber); // 每帧在 Fence 等待和延迟销毁之后调用：读取预算，超出时淘汰
+
+    void trackAllocation(VkDeviceMemory memory, VkDeviceSize size, uint32_t memoryTypeIndex, MemoryCategory category);
+    void trackFree(VkDeviceMemory memory);
+    void makeRoom(uint32_t memoryTypeIndex, VkDeviceSize size); // 分配之前调用：分配后会超出预算时先淘汰
+    VkDeviceSize evict(uint32_t heapIndex, VkDeviceSize bytes); // 调用淘汰处理函数，返回报告释放的字节数
+    void countAllocationRetry() { m_stats.allocationRetries++; }
+
+    uint32_t addEvictionHandler(EvictionHandler handler); // 返回编号，用于 removeEvictionHandler()
+    void removeEvictionHandler(uint32_t id);
+
+    uint32_t getHeapIndex(uint32_t memoryTypeIndex) const { return m_memoryProperties.memoryTypes[memoryTypeIndex].heapIndex; }
+    uint32_t getHeapIndexOf(VkDeviceMemory memory) const; // 未登记的内存返回 UINT32_MAX
+    const MemoryBudgetStats &getStats() const { return m_stats; }
+
+    static MemoryCategory categorizeBuffer(VkBufferUsageFlags usage);
+    static MemoryCategory categorizeImage(VkImageUsageFlags usage);
+
+    void drawOverlay(TextRenderer &textRenderer, uint32_t font, const glm::vec2 &position, float scale = 1.0f) const; // 每帧调用，文字为 ASCII
+
+private:
+    struct Allocation {
+        VkDeviceSize size;
+        uint32_t heapIndex;
+        MemoryCategory category;
+    };
+
+    struct HandlerEntry {
+        uint32_t id;
+        EvictionHandler handler;
+    };
+
+    void queryBudget();
+
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer;
+    VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+
+    std::unordered_map<VkDeviceMemory, Allocation> m_allocations; // 所有登记的分配
+    std::vector<HandlerEntry> m_handlers;                         // 按注册顺序调用
+    uint32_t m_nextHandlerId  = 1;
+    bool m_evicting           = false;                            // 处理函数内部重新分配内存时不再递归淘汰
+    uint64_t m_nextCheckFrame = 0;                                // 每帧检查触发淘汰后，等被淘汰的资源真正释放再检查
+    std::array<bool, VK_MAX_MEMORY_HEAPS> m_overBudget{};         // 每个堆上一帧是否接近预算，只在变化时输出警告
+    MemoryBudgetStats m_stats;
+#pragma endregion
+};
+
+} // namespace engine::render
@@ -0,0 +1,194 @@
+#include "MemoryTypePolicy.hpp"
+
+#include <spdlog/fmt/ranges.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace engine::render {
+
+namespace {
+// 延迟分配的内存只能用于临时附件，受保护的内存需要受保护的队列，AMD 的设备一致性类型会让所有访问绕过缓存
+const VkMemoryPropertyFlags EXCLUDED_FLAGS = VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT | VK_MEMORY_PROPERTY_PROTECTED_BIT |
+                                             VK_MEMORY_PROPERTY_DEVICE_COHERENT_BIT_AMD | VK_MEMORY_PROPERTY_DEVICE_UNCACHED_BIT_AMD;
+
+const std::array<const char *, static_cast<size_t>(MemoryUsage::Count)> OVERRIDE_ENVIRONMENT_NAMES = {
+    "ENGINE_MEMORY_TYPE_GPU_ONLY",
+    "ENGINE_MEMORY_TYPE_UPLOAD",
+    "ENGINE_MEMORY_TYPE_READBACK",
+    "ENGINE_MEMORY_TYPE_STREAMING"};
+
+std::string describeFlags(VkMemoryPropertyFlags flags) {
+    const std::pair<VkMemoryPropertyFlags, const char *> names[] = {
+        {VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, "DEVICE_LOCAL"},
+        {VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, "HOST_VISIBLE"},
+        {VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, "HOST_COHERENT"},
+        {VK_MEMORY_PROPERTY_HOST_CACHED_BIT, "HOST_CACHED"},
+        {VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT, "LAZILY_ALLOCATED"},
+        {VK_MEMORY_PROPERTY_PROTECTED_BIT, "PROTECTED"}};
+    std::string result;
+    for (const auto &[flag, name] : names) {
+        if ((flags & flag) == 0) continue;
+        if (!result.empty()) result += '|';
+        result += name;
+        flags &= ~flag;
+    }
+    if (flags != 0) result += fmt::format("{}0x{:x}", result.empty() ? "" : "|", flags);
+    return result.empty() ? "NONE" : result;
+}
+} // namespace
+
+const char *toString(MemoryUsage usage) {
+    switch (usage) {
+    case MemoryUsage::GpuOnly:
+        return "GpuOnly";
+    case MemoryUsage::Upload:
+        return "Upload";
+    case MemoryUsage::Readback:
+        return "Readback";
+    case MemoryUsage::Streaming:
+        return "Streaming";
+    default:
+        return "Unknown";
+    }
+}
+
+MemoryTypePolicy::MemoryTypePolicy(VkPhysicalDevice physicalDevice) {
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &m_memoryProperties);
+    m_overrides.fill(UINT32_MAX);
+    for (size_t i = 0; i < m_rankings.size(); i++) {
+        MemoryUsage usage              = static_cast<MemoryUsage>(i);
+        std::vector<uint32_t> &ranking = m_rankings[i];
+        for (uint32_t memoryTypeIndex = 0; memoryTypeIndex < m_memoryProperties.memoryTypeCount; memoryTypeIndex++) {
+            if (isUsable(usage, memoryTypeIndex)) ranking.push_back(memoryTypeIndex);
+        }
+        // 分数相同时选择所在堆更大的类型，剩余空间更多，不容易触发淘汰
+        std::stable_sort(ranking.begin(), ranking.end(), [this, usage](uint32_t a, uint32_t b) {
+            int32_t scoreA = score(usage, a);
+            int32_t scoreB = score(usage, b);
+            if (scoreA != scoreB) return scoreA > scoreB;
+            return m_memoryProperties.memoryHeaps[m_memoryProperties.memoryTypes[a].heapIndex].size >
+                   m_memoryProperties.memoryHeaps[m_memoryProperties.memoryTypes[b].heapIndex].size;
+        });
+    }
+    readEnvironmentOverrides();
+    logMapping();
+}
+
+MemoryTypePolicy::~MemoryTypePolicy() = default;
+
+uint32_t MemoryTypePolicy::selectMemoryType(uint32_t typeFilter, MemoryUsage usage) const {
+    uint32_t overrideIndex = m_overrides[static_cast<size_t>(usage)];
+    if (overrideIndex != UINT32_MAX && (typeFilter & (1u << overrideIndex))) return overrideIndex;
+    for (uint32_t memoryTypeIndex : m_rankings[static_cast<size_t>(usage)]) {
+        if (typeFilter & (1u << memoryTypeIndex)) return memoryTypeIndex;
+    }
+    return UINT32_MAX;
+}
+
+void MemoryTypePolicy::setOverride(MemoryUsage usage, uint32_t memoryTypeIndex) {
+    if (!isUsable(usage, memoryTypeIndex)) {
+        throw std::runtime_error("MemoryTypePolicy::setOverride()::内存类型不存在或不满足用途的必需属性");
+    }
+    m_overrides[static_cast<size_t>(usage)] = memoryTypeIndex;
+    spdlog::info("MemoryTypePolicy::setOverride()::{} 强制使用内存类型 {}", toString(usage), memoryTypeIndex);
+}
+
+void MemoryTypePolicy::clearOverride(MemoryUsage usage) {
+    m_overrides[static_cast<size_t>(usage)] = UINT32_MAX;
+}
+
+VkMemoryPropertyFlags MemoryTypePolicy::getRequiredFlags(MemoryUsage usage) {
+    switch (usage) {
+    case MemoryUsage::Upload:
+    case MemoryUsage::Readback:
+        return VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    case MemoryUsage::Streaming:
+        return VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+    default:
+        return 0;
+    }
+}
+
+int32_t MemoryTypePolicy::score(MemoryUsage usage, uint32_t memoryTypeIndex) const {
+    VkMemoryPropertyFlags flags    = m_memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags;
+    VkMemoryPropertyFlags required = getRequiredFlags(usage);
+    if ((flags & required) != required || (flags & EXCLUDED_FLAGS) != 0) return -1;
+
+    bool deviceLocal = (flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) != 0;
+    bool hostVisible = (flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+    bool coherent    = (flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+    bool cached      = (flags & VK_MEMORY_PROPERTY_HOST_CACHED_BIT) != 0;
+    int32_t result   = 100; // 满足必需属性的类型都可用，偏好只调整先后
+    switch (usage) {
+    case MemoryUsage::GpuOnly:
+        result += deviceLocal ? 100 : 0;
+        result -= hostVisible ? 10 : 0; // ReBAR 和 BAR 窗口留给 CPU 写入的资源
+        break;
+    case MemoryUsage::Upload:
+        result -= deviceLocal ? 10 : 0; // 暂存区只读一次，不占用显存
+        result -= cached ? 5 : 0;       // 写合并的内存顺序写入更快
+        break;
+    case MemoryUsage::Readback:
+        result += cached ? 100 : 0;
+        result -= deviceLocal ? 10 : 0;
+        break;
+    case MemoryUsage::Streaming:
+        result += deviceLocal ? 100 : 0; // GPU 每帧多次读取，直接放在显存中
+        result += coherent ? 10 : 0;     // 省去刷新
+        result -= cached ? 5 : 0;
+        break;
+    default:
+        break;
+    }
+    return result;
+}
+
+bool MemoryTypePolicy::isUsable(MemoryUsage usage, uint32_t memoryTypeIndex) const {
+    return memoryTypeIndex < m_memoryProperties.memoryTypeCount && score(usage, memoryTypeIndex) >= 0;
+}
+
+void MemoryTypePolicy::readEnvironmentOverrides() {
+    for (size_t i = 0; i < OVERRIDE_ENVIRONMENT_NAMES.size(); i++) {
+        const char *value = std::getenv(OVERRIDE_ENVIRONMENT_NAMES[i]);
+        if (value == nullptr) continue;
+        std::string_view text(value);
+        uint32_t memoryTypeIndex = UINT32_MAX;
+        auto [end, error]        = std::from_chars(text.data(), text.data() + text.size(), memoryTypeIndex);
+        MemoryUsage usage        = static_cast<MemoryUsage>(i);
+        if (error != std::errc() || end != text.data() + text.size() || !isUsable(usage, memoryTypeIndex)) {
+            spdlog::warn("MemoryTypePolicy::readEnvironmentOverrides()::忽略 {}={}, 内存类型不存在或不满足 {} 的必需属性",
+                         OVERRIDE_ENVIRONMENT_NAMES[i], text, toString(usage));
+            continue;
+        }
+        setOverride(usage, memoryTypeIndex);
+    }
+}
+
+void MemoryTypePolicy::logMapping() const {
+    for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; i++) {
+        const VkMemoryType &memoryType = m_memoryProperties.memoryTypes[i];
+        double heapSize                = static_cast<double>(m_memoryProperties.memoryHeaps[memoryType.heapIndex].size) / (1024.0 * 1024.0);
+        spdlog::info("MemoryTypePolicy::logMapping()::内存类型 {}: 堆 {} ({:.1f} MiB), 属性: {}", i, memoryType.heapIndex, heapSize,
+                     describeFlags(memoryType.propertyFlags));
+    }
+    for (size_t i = 0; i < m_rankings.size(); i++) {
+        MemoryUsage usage        = static_cast<MemoryUsage>(i);
+        uint32_t memoryTypeIndex = selectMemoryType(UINT32_MAX, usage);
+        if (memoryTypeIndex == UINT32_MAX) {
+            spdlog::warn("MemoryTypePolicy::logMapping()::{} 没有可用的内存类型", toString(usage));
+            continue;
+        }
+        spdlog::info("MemoryTypePolicy::logMapping()::{} -> 内存类型 {} ({}){}, 候选顺序: [{}]", toString(usage), memoryTypeIndex,
+                     describeFlags(getPropertyFlags(memoryTypeIndex)), m_overrides[i] != UINT32_MAX ? ", 已覆盖" : "",
+                     fmt::join(m_rankings[i], ", "));
+    }
+}
+
+} // namespace engine::render
@@ -0,0 +1,67 @@
+#pragma once
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::render {
+
+/**
+ * @enum MemoryUsage
+ * @brief 资源的访问方式，决定选择哪种内存类型
+ */
+enum class MemoryUsage : uint32_t {
+    GpuOnly,   // 只由 GPU 访问：优先设备本地，避开 CPU 可见的类型，把 ReBAR 留给 CPU 写入的资源
+    Upload,    // CPU 顺序写入、GPU 读取一次的暂存区和参数：要求主机一致性，避开设备本地和带缓存的类型
+    Readback,  // GPU 写入、CPU 读取：要求主机一致性，优先 HOST_CACHED，未缓存的内存 CPU 读取极慢
+    Streaming, // CPU 每帧写入、GPU 读取多次：优先设备本地且 CPU 可见（ReBAR / 统一内存），允许非一致性，由调用方刷新
+    Count
+};
+
+const char *toString(MemoryUsage usage);
+
+/**
+ * @class MemoryTypePolicy
+ * @brief 按用途为每种资源选择内存类型
+ *
+ * 创建时对每种用途给所有内存类型打分排序：先看必需的属性，再看设备本地、主机缓存和一致性的偏好，
+ * 分数相同时选择所在堆更大的类型。分配时在资源允许的类型（memoryTypeBits）中取排序最靠前的一个。
+ * 启动时输出所有内存类型和每种用途的选择结果。
+ * 实验时可以用 setOverride() 或环境变量 ENGINE_MEMORY_TYPE_<用途>（如 ENGINE_MEMORY_TYPE_STREAMING=2）强制使用指定类型，
+ * 环境变量在创建时读取，因此也作用于初始化期间创建的资源。
+ */
+class MemoryTypePolicy final {
+public:
+    explicit MemoryTypePolicy(VkPhysicalDevice physicalDevice);
+    ~MemoryTypePolicy();
+
+    MemoryTypePolicy(const MemoryTypePolicy &)            = delete;
+    MemoryTypePolicy &operator=(const MemoryTypePolicy &) = delete;
+    MemoryTypePolicy(MemoryTypePolicy &&)                 = delete;
+    MemoryTypePolicy &operator=(MemoryTypePolicy &&)      = delete;
+
+    uint32_t selectMemoryType(uint32_t typeFilter, MemoryUsage usage) const; // typeFilter 为 memoryTypeBits，没有合适的类型时返回 UINT32_MAX
+    void setOverride(MemoryUsage usage, uint32_t memoryTypeIndex);           // 之后的分配优先使用该类型，类型不存在或缺少必需属性时抛出异常
+    void clearOverride(MemoryUsage usage);
+
+    const std::vector<uint32_t> &getRanking(MemoryUsage usage) const { return m_rankings[static_cast<size_t>(usage)]; } // 可用的内存类型，按偏好从高到低
+    VkMemoryPropertyFlags getPropertyFlags(uint32_t memoryTypeIndex) const { return m_memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags; }
+
+    static VkMemoryPropertyFlags getRequiredFlags(MemoryUsage usage);
+
+private:
+    int32_t score(MemoryUsage usage, uint32_t memoryTypeIndex) const; // 不能用于该用途时返回 -1
+    bool isUsable(MemoryUsage usage, uint32_t memoryTypeIndex) const;
+    void readEnvironmentOverrides();
+    void logMapping() const;
+
+#pragma region Menber Variables
+    VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+    std::array<std::vector<uint32_t>, static_cast<size_t>(MemoryUsage::Count)> m_rankings; // 每种用途可用的内存类型，按偏好从高到低
+    std::array<uint32_t, static_cast<size_t>(MemoryUsage::Count)> m_overrides;             // 强制使用的内存类型，UINT32_MAX 表示不覆盖
+#pragma endregion
+};
+
+} // namespace engine::render
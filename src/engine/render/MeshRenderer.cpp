@@ -0,0 +1,410 @@
+#include "MeshRenderer.hpp"
+#include "../utils/MeshSimplifier.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace engine::render {
+
+namespace {
+// 与 mesh.vert.glsl 中的 push_constant 布局一致（std430）
+struct MeshPushConstants {
+    glm::mat4 viewProjection;
+    uint32_t objectIndex; // USE_INSTANCE_INDEX 表示使用 gl_InstanceIndex
+};
+
+const uint32_t USE_INSTANCE_INDEX = 0xFFFFFFFFu;
+} // namespace
+
+MeshRenderer::MeshRenderer(VulkanRenderer &renderer) : m_renderer(renderer) {}
+
+MeshRenderer::~MeshRenderer() = default;
+
+void MeshRenderer::init() {
+    VkDevice device = m_renderer.getDevice();
+
+    VkDescriptorSetLayoutBinding binding{};
+    binding.binding         = 0;
+    binding.descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    binding.descriptorCount = 1;
+    binding.stageFlags      = VK_SHADER_STAGE_VERTEX_BIT;
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings    = &binding;
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &m_descriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("MeshRenderer::init()::创建描述符集布局失败");
+    }
+
+    VkDescriptorPoolSize poolSize{};
+    poolSize.type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSize.descriptorCount = 1;
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets       = 1;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes    = &poolSize;
+    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &m_descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("MeshRenderer::init()::创建描述符池失败");
+    }
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool     = m_descriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts        = &m_descriptorSetLayout;
+    if (vkAllocateDescriptorSets(device, &allocInfo, &m_descriptorSet) != VK_SUCCESS) {
+        throw std::runtime_error("MeshRenderer::init()::分配描述符集失败");
+    }
+
+    ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    m_vertexBuffer             = registry.createBuffer(MESH_VERTEX_BUFFER_SIZE, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, MemoryUsage::GpuOnly);
+    m_indexBuffer              = registry.createBuffer(MESH_INDEX_BUFFER_SIZE, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, MemoryUsage::GpuOnly);
+    m_objectBuffer             = registry.createBuffer(MAX_MESH_OBJECTS * sizeof(MeshObjectData),
+                                                       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, MemoryUsage::GpuOnly);
+
+    VkDescriptorBufferInfo bufferInfo{};
+    bufferInfo.buffer = registry.getBuffer(m_objectBuffer);
+    bufferInfo.offset = 0;
+    bufferInfo.range  = VK_WHOLE_SIZE;
+    VkWriteDescriptorSet write{};
+    write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet          = m_descriptorSet;
+    write.dstBinding      = 0;
+    write.descriptorCount = 1;
+    write.descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo     = &bufferInfo;
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+
+    // 没有 drawIndirectFirstInstance 时 firstInstance 必须为 0，着色器改为从推送常量获取物体索引，只能逐物体绘制
+    const VkPhysicalDeviceFeatures &features = m_renderer.getEnabledFeatures();
+    m_multiDrawIndirect                      = features.multiDrawIndirect && features.drawIndirectFirstInstance;
+    if (!m_multiDrawIndirect) {
+        spdlog::warn("MeshRenderer::init()::设备不支持 multiDrawIndirect/drawIndirectFirstInstance，退回逐物体间接绘制");
+    }
+    createPipeline();
+    spdlog::trace("MeshRenderer::init()::网格渲染器初始化成功");
+}
+
+void MeshRenderer::cleanup() {
+    VkDevice device = m_renderer.getDevice();
+    vkDestroyPipeline(device, m_pipeline, nullptr);
+    vkDestroyPipelineLayout(device, m_pipelineLayout, nullptr);
+    vkDestroyDescriptorPool(device, m_descriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(device, m_descriptorSetLayout, nullptr);
+    m_pipeline     = VK_NULL_HANDLE;
+    m_vertexBuffer = {}; // 缓冲区由资源注册表在清理时销毁
+    m_indexBuffer  = {};
+    m_objectBuffer = {};
+}
+
+VkBuffer MeshRenderer::getObjectBuffer() const {
+    return m_renderer.getResourceRegistry().getBuffer(m_objectBuffer);
+}
+
+void MeshRenderer::createPipeline() {
+    VkDevice device                 = m_renderer.getDevice();
+    auto vertShaderCode             = VulkanRenderer::readFile("assets/shaders/mesh.vert.spv");
+    auto fragShaderCode             = VulkanRenderer::readFile("assets/shaders/mesh.frag.spv");
+    VkShaderModule vertShaderModule = m_renderer.createShaderModule(vertShaderCode);
+    VkShaderModule fragShaderModule = m_renderer.createShaderModule(fragShaderCode);
+
+    std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages{};
+    shaderStages[0].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStages[0].stage  = VK_SHADER_STAGE_VERTEX_BIT;
+    shaderStages[0].module = vertShaderModule;
+    shaderStages[0].pName  = "main";
+    shaderStages[1].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStages[1].stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
+    shaderStages[1].module = fragShaderModule;
+    shaderStages[1].pName  = "main";
+
+    auto bindingDescription    = engine::utils::MeshVertex::getBindingDescription();
+    auto attributeDescriptions = engine::utils::MeshVertex::getAttributeDescriptions();
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+    vertexInputInfo.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInputInfo.vertexBindingDescriptionCount   = 1;
+    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+    vertexInputInfo.pVertexBindingDescriptions      = &bindingDescription;
+    vertexInputInfo.pVertexAttributeDescriptions    = attributeDescriptions.data();
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewportState{};
+    viewportState.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount  = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterizer{};
+    rasterizer.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.lineWidth   = 1.0f;
+    rasterizer.cullMode    = VK_CULL_MODE_NONE; // 网格来源不统一绕序，不做背面剔除
+    rasterizer.frontFace   = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+    VkPipelineMultisampleStateCreateInfo multisampling{};
+    multisampling.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.sType            = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable  = VK_TRUE;
+    depthStencil.depthWriteEnable = VK_TRUE;
+    depthStencil.depthCompareOp   = VK_COMPARE_OP_LESS; // 深度清除为 1.0，越近越小
+
+    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+    colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    colorBlendAttachment.blendEnable    = VK_FALSE;
+    VkPipelineColorBlendStateCreateInfo colorBlending{};
+    colorBlending.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlending.attachmentCount = 1;
+    colorBlending.pAttachments    = &colorBlendAttachment;
+
+    std::array<VkDynamicState, 2> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+    dynamicState.pDynamicStates    = dynamicStates.data();
+
+    VkPushConstantRange pushConstantRange{VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(MeshPushConstants)};
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount         = 1;
+    pipelineLayoutInfo.pSetLayouts            = &m_descriptorSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges    = &pushConstantRange;
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &m_pipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("MeshRenderer::createPipeline()::创建管线布局失败");
+    }
+
+    VkGraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount          = static_cast<uint32_t>(shaderStages.size());
+    pipelineInfo.pStages             = shaderStages.data();
+    pipelineInfo.pVertexInputState   = &vertexInputInfo;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState      = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState   = &multisampling;
+    pipelineInfo.pDepthStencilState  = &depthStencil;
+    pipelineInfo.pColorBlendState    = &colorBlending;
+    pipelineInfo.pDynamicState       = &dynamicState;
+    pipelineInfo.layout              = m_pipelineLayout;
+    pipelineInfo.renderPass          = m_renderer.getSceneRenderPass(); // 与保留版本的渲染通道兼容，两个阶段共用
+    pipelineInfo.subpass             = 0;
+    if (vkCreateGraphicsPipelines(device, m_renderer.getPipelineCache(), 1, &pipelineInfo, nullptr, &m_pipeline) != VK_SUCCESS) {
+        throw std::runtime_error("MeshRenderer::createPipeline()::创建网格管线失败");
+    }
+    vkDestroyShaderModule(device, fragShaderModule, nullptr);
+    vkDestroyShaderModule(device, vertShaderModule, nullptr);
+}
+
+MeshHandle MeshRenderer::uploadMesh(const std::vector<engine::utils::MeshVertex> &vertices, const std::vector<uint32_t> &indices, uint32_t maxLods) {
+    if (vertices.empty() || indices.empty()) {
+        throw std::runtime_error("MeshRenderer::uploadMesh()::网格数据为空");
+    }
+
+    // 各级 LOD 只引用原始顶点，顶点上传一次，索引依次追加
+    auto levels         = engine::utils::MeshSimplifier::buildLodChain(vertices, indices, std::clamp(maxLods, 1u, MAX_MESH_LODS));
+    size_t totalIndices = 0;
+    for (const auto &level : levels) {
+        totalIndices += level.indices.size();
+    }
+    VkDeviceSize vertexBytes = vertices.size() * sizeof(engine::utils::MeshVertex);
+    VkDeviceSize indexBytes  = totalIndices * sizeof(uint32_t);
+    if (m_vertexBytesUsed + vertexBytes > MESH_VERTEX_BUFFER_SIZE || m_indexBytesUsed + indexBytes > MESH_INDEX_BUFFER_SIZE) {
+        throw std::runtime_error("MeshRenderer::uploadMesh()::网格缓冲区空间不足");
+    }
+
+    MeshHandle mesh;
+    uint32_t firstIndex = static_cast<uint32_t>(m_indexBytesUsed / sizeof(uint32_t));
+    for (const auto &level : levels) {
+        MeshLod &lod   = mesh.lods[mesh.lodCount++];
+        lod.firstIndex = firstIndex;
+        lod.indexCount = static_cast<uint32_t>(level.indices.size());
+        lod.error      = level.error;
+        firstIndex += lod.indexCount;
+    }
+    mesh.vertexOffset = static_cast<int32_t>(m_vertexBytesUsed / sizeof(engine::utils::MeshVertex));
+    mesh.boundsMin    = vertices[0].pos;
+    mesh.boundsMax    = vertices[0].pos;
+    for (const auto &vertex : vertices) {
+        mesh.boundsMin = glm::min(mesh.boundsMin, vertex.pos);
+        mesh.boundsMax = glm::max(mesh.boundsMax, vertex.pos);
+    }
+
+    // 通过临时暂存缓冲区复制到设备本地缓冲区，只写入尚未使用的区域，不影响正在飞行中的帧
+    VkDevice device = m_renderer.getDevice();
+    VkBuffer stagingBuffer;
+    VkDeviceMemory stagingMemory;
+    m_renderer.createBuffer(vertexBytes + indexBytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                            MemoryUsage::Upload, stagingBuffer, stagingMemory);
+    void *data;
+    vkMapMemory(device, stagingMemory, 0, vertexBytes + indexBytes, 0, &data);
+    memcpy(data, vertices.data(), static_cast<size_t>(vertexBytes));
+    char *indexData = static_cast<char *>(data) + vertexBytes;
+    for (const auto &level : levels) {
+        memcpy(indexData, level.indices.data(), level.indices.size() * sizeof(uint32_t));
+        indexData += level.indices.size() * sizeof(uint32_t);
+    }
+    vkUnmapMemory(device, stagingMemory);
+
+    VkCommandBuffer commandBuffer = m_renderer.beginSingleTimeCommands();
+    VkBufferCopy vertexCopy{0, m_vertexBytesUsed, vertexBytes};
+    VkBufferCopy indexCopy{vertexBytes, m_indexBytesUsed, indexBytes};
+    ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    vkCmdCopyBuffer(commandBuffer, stagingBuffer, registry.getBuffer(m_vertexBuffer), 1, &vertexCopy);
+    vkCmdCopyBuffer(commandBuffer, stagingBuffer, registry.getBuffer(m_indexBuffer), 1, &indexCopy);
+    m_renderer.endSingleTimeCommands(commandBuffer);
+
+    vkDestroyBuffer(device, stagingBuffer, nullptr);
+    m_renderer.freeMemory(stagingMemory);
+    m_vertexBytesUsed += vertexBytes;
+    m_indexBytesUsed += indexBytes;
+    spdlog::trace("MeshRenderer::uploadMesh()::上传网格成功, 顶点数: {}, 索引数: {}, LOD 级数: {}, 最低级三角形数: {}", vertices.size(), indices.size(),
+                  mesh.lodCount, mesh.lods[mesh.lodCount - 1].indexCount / 3);
+    return mesh;
+}
+
+void MeshRenderer::setInstances(const std::vector<MeshInstance> &instances) {
+    if (instances.size() > MAX_MESH_OBJECTS) {
+        throw std::runtime_error("MeshRenderer::setInstances()::物体数量超过 MAX_MESH_OBJECTS");
+    }
+    m_objects.resize(instances.size());
+    m_frustumCuller.clear();
+    for (size_t i = 0; i < instances.size(); i++) {
+        const MeshInstance &instance = instances[i];
+        MeshObjectData &object       = m_objects[i];
+        if (instance.mesh.lodCount == 0) {
+            throw std::runtime_error("MeshRenderer::setInstances()::物体引用的网格未上传");
+        }
+
+        // 局部包围盒的 8 个角变换到世界空间后重新求轴对齐包围盒
+        glm::vec3 worldMin(std::numeric_limits<float>::max());
+        glm::vec3 worldMax(std::numeric_limits<float>::lowest());
+        for (int corner = 0; corner < 8; corner++) {
+            glm::vec3 local((corner & 1) ? instance.mesh.boundsMax.x : instance.mesh.boundsMin.x,
+                            (corner & 2) ? instance.mesh.boundsMax.y : instance.mesh.boundsMin.y,
+                            (corner & 4) ? instance.mesh.boundsMax.z : instance.mesh.boundsMin.z);
+            glm::vec3 world = glm::vec3(instance.transform * glm::vec4(local, 1.0f));
+            worldMin        = glm::min(worldMin, world);
+            worldMax        = glm::max(worldMax, world);
+        }
+        object.model        = instance.transform;
+        object.boundsMin    = glm::vec4(worldMin, 1.0f);
+        object.boundsMax    = glm::vec4(worldMax, 1.0f);
+        object.vertexOffset = instance.mesh.vertexOffset;
+        object.lodCount     = instance.mesh.lodCount;
+        object.lodScale     = std::max({glm::length(glm::vec3(instance.transform[0])), glm::length(glm::vec3(instance.transform[1])),
+                                        glm::length(glm::vec3(instance.transform[2]))});
+        object.padding      = 0;
+        for (uint32_t lod = 0; lod < MAX_MESH_LODS; lod++) {
+            const MeshLod &source = instance.mesh.lods[std::min(lod, instance.mesh.lodCount - 1)];
+            object.lods[lod]      = {source.firstIndex, source.indexCount, source.error, 0};
+        }
+        m_frustumCuller.addAabb(worldMin, worldMax, static_cast<uint32_t>(i));
+    }
+    m_objectsDirty = true;
+}
+
+void MeshRenderer::setCamera(const glm::mat4 &view, const glm::mat4 &projection) {
+    m_view            = view;
+    m_viewProjection  = projection * view;
+    m_cameraPosition  = glm::vec3(glm::inverse(view)[3]);
+    m_projectionScale = std::abs(projection[1][1]); // Vulkan 翻转 y 轴时为负
+}
+
+void MeshRenderer::recordUploads(VkCommandBuffer commandBuffer) {
+    if (!m_objectsDirty) return;
+    if (m_objects.empty()) {
+        m_objectCount  = 0;
+        m_objectsDirty = false;
+        return;
+    }
+    VkDeviceSize bytes          = m_objects.size() * sizeof(MeshObjectData);
+    StreamingAllocation staging = m_renderer.getStreamingBuffer().upload(m_objects.data(), bytes, alignof(MeshObjectData));
+    if (!staging) return; // 暂存空间不足，下一帧再上传
+
+    // 之前的帧可能仍在读取物体缓冲区（读后写）
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    VkBufferCopy copyRegion{};
+    copyRegion.srcOffset = staging.offset;
+    copyRegion.dstOffset = 0;
+    copyRegion.size      = bytes;
+    vkCmdCopyBuffer(commandBuffer, staging.buffer, m_renderer.getResourceRegistry().getBuffer(m_objectBuffer), 1, &copyRegion);
+
+    // 复制完成后才能被剔除着色器和顶点着色器读取
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    m_objectCount  = static_cast<uint32_t>(m_objects.size());
+    m_objectsDirty = false;
+}
+
+void MeshRenderer::cullObjects(engine::core::JobSystem *jobSystem) {
+    // 一次间接调用绘制所有物体时由 GPU 剔除决定 instanceCount，CPU 可见列表用不上，不必计算
+    // 物体数据还没上传时 GPU 上仍是旧物体，不能用新包围盒的结果跳过绘制
+    m_visibleListValid = !m_multiDrawIndirect && !m_objectsDirty && m_objectCount > 0;
+    if (!m_visibleListValid) return;
+    m_frustumCuller.cull(m_viewProjection, jobSystem);
+}
+
+void MeshRenderer::recordDraws(VkCommandBuffer commandBuffer, VkExtent2D extent, VkBuffer drawBuffer, VkDeviceSize drawOffset) {
+    if (m_objectCount == 0) return;
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1, &m_descriptorSet, 0, nullptr);
+
+    VkViewport viewport{0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f};
+    VkRect2D scissor{{0, 0}, extent};
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    VkBuffer vertexBuffer      = registry.getBuffer(m_vertexBuffer);
+    VkDeviceSize vertexOffset  = 0;
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, &vertexOffset);
+    vkCmdBindIndexBuffer(commandBuffer, registry.getBuffer(m_indexBuffer), 0, VK_INDEX_TYPE_UINT32);
+
+    MeshPushConstants constants{};
+    constants.viewProjection = m_viewProjection;
+    const uint32_t stride    = sizeof(VkDrawIndexedIndirectCommand);
+    if (m_multiDrawIndirect) {
+        constants.objectIndex = USE_INSTANCE_INDEX;
+        vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(constants), &constants);
+        vkCmdDrawIndexedIndirect(commandBuffer, drawBuffer, drawOffset, m_objectCount, stride);
+        return;
+    }
+    // 逐物体调用时只为 CPU 视锥剔除后的可见物体记录命令，其余物体的 instanceCount 本来就是 0
+    auto drawObject = [&](uint32_t i) {
+        constants.objectIndex = i;
+        vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(constants), &constants);
+        vkCmdDrawIndexedIndirect(commandBuffer, drawBuffer, drawOffset + i * stride, 1, stride);
+    };
+    if (m_visibleListValid) {
+        for (uint32_t i : m_frustumCuller.getVisible()) {
+            drawObject(i);
+        }
+        return;
+    }
+    for (uint32_t i = 0; i < m_objectCount; i++) {
+        drawObject(i);
+    }
+}
+
+} // namespace engine::render
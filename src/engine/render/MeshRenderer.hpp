@@ -0,0 +1,175 @@
+#pragma once
+#include "../utils/Math.hpp"
+#include "FrustumCuller.hpp"
+#include "ResourceRegistry.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace engine::render {
+class VulkanRenderer;
+
+#pragma region Constants
+const uint32_t MAX_MESH_OBJECTS            = 16384;           // 物体缓冲区和间接绘制缓冲区容纳的最大物体数量
+const VkDeviceSize MESH_VERTEX_BUFFER_SIZE = 8 * 1024 * 1024; // 所有网格共用的顶点缓冲区字节数
+const VkDeviceSize MESH_INDEX_BUFFER_SIZE  = 8 * 1024 * 1024; // 所有网格共用的索引缓冲区字节数
+const uint32_t MAX_MESH_LODS               = 4;               // 每个网格最多的 LOD 级数（包含原始网格）
+#pragma endregion
+
+/**
+ * @struct MeshLod
+ * @brief 一级 LOD 在共享索引缓冲区中的范围，所有级别共用同一段顶点
+ */
+struct MeshLod {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    float error         = 0.0f; // 相对原始网格的几何误差（模型空间距离）
+};
+
+/**
+ * @struct MeshHandle
+ * @brief 已上传网格在共享顶点/索引缓冲区中的位置和局部包围盒
+ */
+struct MeshHandle {
+    std::array<MeshLod, MAX_MESH_LODS> lods{}; // 第 0 级为原始网格，误差逐级增大
+    uint32_t lodCount    = 0;
+    int32_t vertexOffset = 0;
+    glm::vec3 boundsMin{0.0f};
+    glm::vec3 boundsMax{0.0f};
+};
+
+/**
+ * @struct MeshInstance
+ * @brief 场景中的一个物体：网格 + 模型矩阵
+ */
+struct MeshInstance {
+    MeshHandle mesh;
+    glm::mat4 transform{1.0f};
+};
+
+/**
+ * @struct MeshLodSettings
+ * @brief 运行时 LOD 选择参数：选择投影到屏幕上的误差不超过阈值的最粗一级
+ */
+struct MeshLodSettings {
+    bool enabled         = true;
+    float errorThreshold = 1.0f;  // 允许的屏幕空间误差（像素）
+    float hysteresis     = 0.25f; // 切换到更粗一级时阈值缩小的比例，避免在临界距离来回切换
+};
+
+/**
+ * @struct MeshLodData
+ * @brief 物体数据中的一级 LOD，与着色器中的布局一致（std430）
+ */
+struct MeshLodData {
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    float error;
+    uint32_t padding;
+};
+
+/**
+ * @struct MeshObjectData
+ * @brief 物体缓冲区中的一项，与 mesh.vert.glsl 和 occlusion_cull.comp.glsl 中的布局一致（std430）
+ */
+struct alignas(16) MeshObjectData {
+    glm::mat4 model;
+    glm::vec4 boundsMin; // 世界空间包围盒
+    glm::vec4 boundsMax;
+    int32_t vertexOffset;
+    uint32_t lodCount;
+    float lodScale; // 模型矩阵的最大缩放，把模型空间误差换算到世界空间
+    uint32_t padding;
+    MeshLodData lods[MAX_MESH_LODS];
+};
+static_assert(sizeof(MeshObjectData) == 176, "MeshObjectData 必须与着色器中的 std430 布局一致");
+
+/**
+ * @class MeshRenderer
+ * @brief 三维网格物体的 GPU 驱动绘制
+ *
+ * 所有网格共用一个顶点缓冲区和一个索引缓冲区，物体数据存放在存储缓冲区中。
+ * 绘制命令由遮挡剔除的计算着色器写入间接绘制缓冲区，被剔除的物体 instanceCount 为 0。
+ * 设备支持 multiDrawIndirect 和 drawIndirectFirstInstance 时一次调用绘制所有物体，否则逐物体调用。
+ * 上传网格时用 QEM 简化生成 LOD 链，剔除着色器根据投影到屏幕上的误差为每个物体选择 LOD。
+ * 每帧记录命令之前还在 CPU 上用 SIMD 做一次视锥剔除，逐物体调用的回退路径只为可见物体记录绘制命令。
+ */
+class MeshRenderer final {
+public:
+    explicit MeshRenderer(VulkanRenderer &renderer);
+    ~MeshRenderer();
+
+    MeshRenderer(const MeshRenderer &)            = delete;
+    MeshRenderer &operator=(const MeshRenderer &) = delete;
+    MeshRenderer(MeshRenderer &&)                 = delete;
+    MeshRenderer &operator=(MeshRenderer &&)      = delete;
+
+    void init();
+    void cleanup();
+
+    /**
+     * @brief 同步上传网格并生成 LOD 链，只在加载时调用
+     * @param maxLods 最多的 LOD 级数（包含原始网格），为 1 时不简化
+     */
+    MeshHandle uploadMesh(const std::vector<engine::utils::MeshVertex> &vertices, const std::vector<uint32_t> &indices, uint32_t maxLods = MAX_MESH_LODS);
+    void setInstances(const std::vector<MeshInstance> &instances);      // 替换场景中的所有物体，下一帧生效
+    void setCamera(const glm::mat4 &view, const glm::mat4 &projection); // Vulkan 裁剪空间：深度 [0, 1]，y 轴向下
+    void setLodSettings(const MeshLodSettings &settings) { m_lodSettings = settings; }
+
+    void recordUploads(VkCommandBuffer commandBuffer);    // 在渲染通道之外调用：物体数据有变化时复制到物体缓冲区
+    void cullObjects(engine::core::JobSystem *jobSystem); // 在 recordUploads() 之后、记录绘制之前调用：逐物体绘制时 CPU 视锥剔除得到可见物体列表
+    /**
+     * @brief 在渲染通道之内调用：按间接绘制缓冲区中的命令绘制所有物体
+     * @param drawOffset 第一条 VkDrawIndexedIndirectCommand 在缓冲区中的偏移，共 getObjectCount() 条
+     */
+    void recordDraws(VkCommandBuffer commandBuffer, VkExtent2D extent, VkBuffer drawBuffer, VkDeviceSize drawOffset);
+
+    VkBuffer getObjectBuffer() const; // 经由资源注册表解析
+    uint32_t getObjectCount() const { return m_objectCount; } // 已上传到 GPU 的物体数量
+    const glm::mat4 &getView() const { return m_view; }
+    const glm::mat4 &getViewProjection() const { return m_viewProjection; }
+    const glm::vec3 &getCameraPosition() const { return m_cameraPosition; }
+    float getProjectionScale() const { return m_projectionScale; } // |projection[1][1]|，用于把世界空间误差换算成像素
+    const MeshLodSettings &getLodSettings() const { return m_lodSettings; }
+    const std::vector<uint32_t> &getVisibleObjects() const { return m_frustumCuller.getVisible(); } // 最近一次 CPU 剔除的可见物体下标，按下标递增；支持多重间接绘制时不做 CPU 剔除
+    const FrustumCullStats &getFrustumCullStats() const { return m_frustumCuller.getStats(); }
+
+private:
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer;
+
+    VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE; // 物体存储缓冲区
+    VkDescriptorPool m_descriptorPool           = VK_NULL_HANDLE;
+    VkDescriptorSet m_descriptorSet             = VK_NULL_HANDLE;
+    VkPipelineLayout m_pipelineLayout           = VK_NULL_HANDLE;
+    VkPipeline m_pipeline                       = VK_NULL_HANDLE;
+
+    BufferHandle m_vertexBuffer; // 共享顶点缓冲区
+    BufferHandle m_indexBuffer;  // 共享索引缓冲区
+    BufferHandle m_objectBuffer; // 物体数据存储缓冲区
+
+    VkDeviceSize m_vertexBytesUsed = 0; // 顶点缓冲区已使用的字节数
+    VkDeviceSize m_indexBytesUsed  = 0; // 索引缓冲区已使用的字节数
+
+    std::vector<MeshObjectData> m_objects; // CPU 端物体数据
+    bool m_objectsDirty     = false;       // 物体数据是否需要重新上传
+    uint32_t m_objectCount  = 0;           // 已上传到 GPU 的物体数量
+    glm::mat4 m_view{1.0f};                // 观察矩阵
+    glm::mat4 m_viewProjection{1.0f};      // 观察投影矩阵
+    glm::vec3 m_cameraPosition{0.0f};      // 观察点的世界坐标
+    float m_projectionScale = 1.0f;        // 投影矩阵的垂直缩放
+    MeshLodSettings m_lodSettings;         // LOD 选择参数
+
+    bool m_multiDrawIndirect = false; // 是否可以一次间接调用绘制所有物体
+
+    FrustumCuller m_frustumCuller;   // 物体世界包围盒的 CPU 视锥剔除
+    bool m_visibleListValid = false; // 可见列表是否对应已上传到 GPU 的物体
+#pragma endregion
+
+    void createPipeline();
+};
+
+} // namespace engine::render
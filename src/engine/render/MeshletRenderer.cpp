@@ -0,0 +1,538 @@
+#include "MeshletRenderer.hpp"
+#include "../utils/MeshletBuilder.hpp"
+#include "MeshRenderer.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace engine::render {
+
+namespace {
+// 与 meshlet 系列着色器中的 Meshlet 布局一致（std430）
+struct GpuMeshlet {
+    glm::vec4 sphere;   // xyz 为模型空间球心，w 为半径
+    glm::vec4 coneAxis; // xyz 为锥轴，w 为 cutoff
+    glm::vec4 coneApex;
+    uint32_t vertexOffset;
+    uint32_t vertexCount;
+    uint32_t triangleOffset;
+    uint32_t triangleCount;
+};
+static_assert(sizeof(GpuMeshlet) == 64, "GpuMeshlet 必须与着色器中的 std430 布局一致");
+
+// 与 meshlet 系列着色器中的 push_constant 布局一致（std430）
+struct MeshletPushConstants {
+    glm::mat4 viewProjection;
+    glm::vec4 camera; // xyz 为观察点
+    uint32_t clusterCount;
+    uint32_t flags;
+    uint32_t padding[2];
+};
+
+// 与着色器中的标志位一致
+const uint32_t MESHLET_FLAG_FRUSTUM = 1u << 0; // 包围球视锥剔除
+const uint32_t MESHLET_FLAG_CONE    = 1u << 1; // 法线锥背面剔除
+const uint32_t MESHLET_FLAG_STATS   = 1u << 2; // 写入统计（多窗口时只有第一次绘制写入）
+
+const uint32_t MESHLET_INDEX_SHIFT    = 6;                                                       // 回退路径索引中簇内顶点编号的位数
+const uint32_t MESHLET_BINDING_COUNT  = 10;                                                      // 描述符集中的绑定数量，最后一个为统计
+const VkDeviceSize MESHLET_STATS_SIZE = 5 * sizeof(uint32_t);                                    // visible, frustumCulled, coneCulled, dropped, triangles
+const VkDeviceSize MESHLET_DRAW_SIZE  = sizeof(VkDrawIndexedIndirectCommand) + sizeof(uint32_t); // 绘制命令 + 可见簇槽位计数
+static_assert((1u << MESHLET_INDEX_SHIFT) >= engine::utils::MESHLET_MAX_VERTICES, "簇内顶点编号超出索引编码的位数");
+static_assert((MAX_VISIBLE_MESHLETS << MESHLET_INDEX_SHIFT) <= (1u << 24), "索引编码超出 maxDrawIndexedIndexValue 的最小保证值");
+} // namespace
+
+MeshletRenderer::MeshletRenderer(VulkanRenderer &renderer, MeshRenderer &meshRenderer) : m_renderer(renderer), m_meshRenderer(meshRenderer) {}
+
+MeshletRenderer::~MeshletRenderer() = default;
+
+void MeshletRenderer::init() {
+    VkDevice device = m_renderer.getDevice();
+    if (m_renderer.isMeshShaderSupported()) {
+        m_cmdDrawMeshTasks = reinterpret_cast<PFN_vkCmdDrawMeshTasksEXT>(vkGetDeviceProcAddr(device, "vkCmdDrawMeshTasksEXT"));
+        m_useMeshShaders   = m_cmdDrawMeshTasks != nullptr;
+    }
+    m_stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT;
+    if (m_useMeshShaders) m_stageFlags |= VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT;
+
+    // 所有绑定都是存储缓冲区，最后一个统计缓冲区使用动态偏移，每帧一个区域
+    std::array<VkDescriptorSetLayoutBinding, MESHLET_BINDING_COUNT> bindings{};
+    for (uint32_t binding = 0; binding < MESHLET_BINDING_COUNT; binding++) {
+        bindings[binding].binding         = binding;
+        bindings[binding].descriptorType  = binding + 1 == MESHLET_BINDING_COUNT ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[binding].descriptorCount = 1;
+        bindings[binding].stageFlags      = m_stageFlags;
+    }
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings    = bindings.data();
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &m_descriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("MeshletRenderer::init()::创建描述符集布局失败");
+    }
+
+    std::array<VkDescriptorPoolSize, 2> poolSizes{};
+    poolSizes[0] = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, MESHLET_BINDING_COUNT - 1};
+    poolSizes[1] = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1};
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets       = 1;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes    = poolSizes.data();
+    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &m_descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("MeshletRenderer::init()::创建描述符池失败");
+    }
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool     = m_descriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts        = &m_descriptorSetLayout;
+    if (vkAllocateDescriptorSets(device, &allocInfo, &m_descriptorSet) != VK_SUCCESS) {
+        throw std::runtime_error("MeshletRenderer::init()::分配描述符集失败");
+    }
+
+    VkPushConstantRange pushConstantRange{m_stageFlags, 0, sizeof(MeshletPushConstants)};
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount         = 1;
+    pipelineLayoutInfo.pSetLayouts            = &m_descriptorSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges    = &pushConstantRange;
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &m_pipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("MeshletRenderer::init()::创建管线布局失败");
+    }
+
+    createBuffers();
+    updateDescriptorSet();
+    if (!m_useMeshShaders) createCullPipeline();
+    createDrawPipeline();
+    spdlog::info("MeshletRenderer::init()::簇渲染器初始化成功, 路径: {}", m_useMeshShaders ? "任务 + 网格着色器" : "计算着色器剔除 + 间接绘制");
+}
+
+void MeshletRenderer::cleanup() {
+    VkDevice device = m_renderer.getDevice();
+    if (m_statsMapped != nullptr) vkUnmapMemory(device, m_renderer.getResourceRegistry().get(m_statsBuffer)->memory);
+    vkDestroyPipeline(device, m_drawPipeline, nullptr);
+    vkDestroyPipeline(device, m_cullPipeline, nullptr);
+    vkDestroyPipelineLayout(device, m_pipelineLayout, nullptr);
+    vkDestroyDescriptorPool(device, m_descriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(device, m_descriptorSetLayout, nullptr);
+    // 缓冲区由资源注册表在清理时销毁
+    for (BufferHandle *buffer : {&m_vertexBuffer, &m_meshletBuffer, &m_meshletVertexBuffer, &m_meshletTriangleBuffer, &m_instanceBuffer, &m_clusterBuffer,
+                                 &m_visibleClusterBuffer, &m_drawIndexBuffer, &m_drawCommandBuffer, &m_statsBuffer}) {
+        *buffer = {};
+    }
+    m_statsMapped  = nullptr;
+    m_drawPipeline = VK_NULL_HANDLE;
+    m_cullPipeline = VK_NULL_HANDLE;
+}
+
+void MeshletRenderer::createBuffers() {
+    ResourceRegistry &registry       = m_renderer.getResourceRegistry();
+    const VkBufferUsageFlags storage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    m_vertexBuffer                   = registry.createBuffer(MESHLET_VERTEX_BUFFER_SIZE, storage, MemoryUsage::GpuOnly);
+    m_meshletBuffer                  = registry.createBuffer(MESHLET_DATA_BUFFER_SIZE, storage, MemoryUsage::GpuOnly);
+    m_meshletVertexBuffer            = registry.createBuffer(MESHLET_DATA_BUFFER_SIZE, storage, MemoryUsage::GpuOnly);
+    m_meshletTriangleBuffer          = registry.createBuffer(MESHLET_DATA_BUFFER_SIZE, storage, MemoryUsage::GpuOnly);
+    m_instanceBuffer                 = registry.createBuffer(MAX_MESHLET_INSTANCES * sizeof(glm::mat4), storage, MemoryUsage::GpuOnly);
+    m_clusterBuffer                  = registry.createBuffer(MAX_MESHLET_CLUSTERS * sizeof(glm::uvec2), storage, MemoryUsage::GpuOnly);
+
+    // 网格着色器路径不使用回退路径的输出，只保留最小的缓冲区让描述符有效
+    VkDeviceSize visibleBytes = m_useMeshShaders ? sizeof(glm::uvec2) : MAX_VISIBLE_MESHLETS * sizeof(glm::uvec2);
+    VkDeviceSize indexBytes   = m_useMeshShaders ? sizeof(uint32_t) : static_cast<VkDeviceSize>(MAX_VISIBLE_MESHLETS) * engine::utils::MESHLET_MAX_TRIANGLES * 3 * sizeof(uint32_t);
+    m_visibleClusterBuffer    = registry.createBuffer(visibleBytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, MemoryUsage::GpuOnly);
+    m_drawIndexBuffer         = registry.createBuffer(indexBytes, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, MemoryUsage::GpuOnly);
+    m_drawCommandBuffer       = registry.createBuffer(MESHLET_DRAW_SIZE, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                                      MemoryUsage::GpuOnly);
+
+    // 统计缓冲区主机可见，Fence 等待之后直接读取该帧上一轮的计数
+    m_statsBuffer = registry.createBuffer(MESHLET_STATS_STRIDE * MAX_FRAMES_IN_FLIGHT, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                          MemoryUsage::Readback);
+    void *data    = nullptr;
+    if (vkMapMemory(m_renderer.getDevice(), registry.get(m_statsBuffer)->memory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS) {
+        throw std::runtime_error("MeshletRenderer::createBuffers()::映射统计缓冲区失败");
+    }
+    std::memset(data, 0, MESHLET_STATS_STRIDE * MAX_FRAMES_IN_FLIGHT);
+    m_statsMapped = static_cast<const char *>(data);
+}
+
+void MeshletRenderer::updateDescriptorSet() {
+    const ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    std::array<VkDescriptorBufferInfo, MESHLET_BINDING_COUNT> bufferInfos{};
+    bufferInfos[0] = {registry.getBuffer(m_vertexBuffer), 0, VK_WHOLE_SIZE};
+    bufferInfos[1] = {registry.getBuffer(m_meshletBuffer), 0, VK_WHOLE_SIZE};
+    bufferInfos[2] = {registry.getBuffer(m_meshletVertexBuffer), 0, VK_WHOLE_SIZE};
+    bufferInfos[3] = {registry.getBuffer(m_meshletTriangleBuffer), 0, VK_WHOLE_SIZE};
+    bufferInfos[4] = {registry.getBuffer(m_instanceBuffer), 0, VK_WHOLE_SIZE};
+    bufferInfos[5] = {registry.getBuffer(m_clusterBuffer), 0, VK_WHOLE_SIZE};
+    bufferInfos[6] = {registry.getBuffer(m_visibleClusterBuffer), 0, VK_WHOLE_SIZE};
+    bufferInfos[7] = {registry.getBuffer(m_drawIndexBuffer), 0, VK_WHOLE_SIZE};
+    bufferInfos[8] = {registry.getBuffer(m_drawCommandBuffer), 0, VK_WHOLE_SIZE};
+    bufferInfos[9] = {registry.getBuffer(m_statsBuffer), 0, MESHLET_STATS_SIZE};
+    std::array<VkWriteDescriptorSet, MESHLET_BINDING_COUNT> writes{};
+    for (uint32_t binding = 0; binding < MESHLET_BINDING_COUNT; binding++) {
+        writes[binding].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[binding].dstSet          = m_descriptorSet;
+        writes[binding].dstBinding      = binding;
+        writes[binding].descriptorCount = 1;
+        writes[binding].descriptorType  = binding + 1 == MESHLET_BINDING_COUNT ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[binding].pBufferInfo     = &bufferInfos[binding];
+    }
+    vkUpdateDescriptorSets(m_renderer.getDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+}
+
+VkShaderModule MeshletRenderer::loadShader(const std::string &filename) {
+    auto shaderCode = VulkanRenderer::readFile(filename);
+    return m_renderer.createShaderModule(shaderCode);
+}
+
+void MeshletRenderer::createCullPipeline() {
+    VkShaderModule shaderModule = loadShader("assets/shaders/meshlet_cull.comp.spv");
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType        = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = shaderModule;
+    pipelineInfo.stage.pName  = "main";
+    pipelineInfo.layout       = m_pipelineLayout;
+    if (vkCreateComputePipelines(m_renderer.getDevice(), m_renderer.getPipelineCache(), 1, &pipelineInfo, nullptr, &m_cullPipeline) != VK_SUCCESS) {
+        throw std::runtime_error("MeshletRenderer::createCullPipeline()::创建簇剔除管线失败");
+    }
+    vkDestroyShaderModule(m_renderer.getDevice(), shaderModule, nullptr);
+}
+
+void MeshletRenderer::createDrawPipeline() {
+    VkDevice device = m_renderer.getDevice();
+
+    // 网格着色器路径：任务 + 网格 + 片段；回退路径：从存储缓冲区取顶点的顶点着色器 + 片段，两者共用网格渲染器的片段着色器
+    std::vector<VkShaderModule> modules;
+    std::vector<VkPipelineShaderStageCreateInfo> shaderStages;
+    auto addStage = [&](VkShaderStageFlagBits stage, const std::string &filename) {
+        VkPipelineShaderStageCreateInfo stageInfo{};
+        stageInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stageInfo.stage  = stage;
+        stageInfo.module = loadShader(filename);
+        stageInfo.pName  = "main";
+        modules.push_back(stageInfo.module);
+        shaderStages.push_back(stageInfo);
+    };
+    if (m_useMeshShaders) {
+        addStage(VK_SHADER_STAGE_TASK_BIT_EXT, "assets/shaders/meshlet.task.spv");
+        addStage(VK_SHADER_STAGE_MESH_BIT_EXT, "assets/shaders/meshlet.mesh.spv");
+    } else {
+        addStage(VK_SHADER_STAGE_VERTEX_BIT, "assets/shaders/meshlet.vert.spv");
+    }
+    addStage(VK_SHADER_STAGE_FRAGMENT_BIT, "assets/shaders/mesh.frag.spv");
+
+    // 顶点从存储缓冲区读取，没有顶点输入
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+    vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewportState{};
+    viewportState.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount  = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterizer{};
+    rasterizer.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.lineWidth   = 1.0f;
+    rasterizer.cullMode    = VK_CULL_MODE_NONE; // 与网格渲染器一致；背面剔除在簇粒度由法线锥完成
+    rasterizer.frontFace   = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+    VkPipelineMultisampleStateCreateInfo multisampling{};
+    multisampling.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.sType            = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable  = VK_TRUE;
+    depthStencil.depthWriteEnable = VK_TRUE;
+    depthStencil.depthCompareOp   = VK_COMPARE_OP_LESS;
+
+    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+    colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    colorBlendAttachment.blendEnable    = VK_FALSE;
+    VkPipelineColorBlendStateCreateInfo colorBlending{};
+    colorBlending.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlending.attachmentCount = 1;
+    colorBlending.pAttachments    = &colorBlendAttachment;
+
+    std::array<VkDynamicState, 2> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+    dynamicState.pDynamicStates    = dynamicStates.data();
+
+    VkGraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount          = static_cast<uint32_t>(shaderStages.size());
+    pipelineInfo.pStages             = shaderStages.data();
+    pipelineInfo.pVertexInputState   = m_useMeshShaders ? nullptr : &vertexInputInfo; // 网格着色器管线忽略顶点输入和图元装配
+    pipelineInfo.pInputAssemblyState = m_useMeshShaders ? nullptr : &inputAssembly;
+    pipelineInfo.pViewportState      = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState   = &multisampling;
+    pipelineInfo.pDepthStencilState  = &depthStencil;
+    pipelineInfo.pColorBlendState    = &colorBlending;
+    pipelineInfo.pDynamicState       = &dynamicState;
+    pipelineInfo.layout              = m_pipelineLayout;
+    pipelineInfo.renderPass          = m_renderer.getSceneRenderPass();
+    pipelineInfo.subpass             = 0;
+    VkResult result = vkCreateGraphicsPipelines(device, m_renderer.getPipelineCache(), 1, &pipelineInfo, nullptr, &m_drawPipeline);
+    for (VkShaderModule module : modules) {
+        vkDestroyShaderModule(device, module, nullptr);
+    }
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error("MeshletRenderer::createDrawPipeline()::创建簇绘制管线失败");
+    }
+}
+
+MeshletMesh MeshletRenderer::uploadMesh(const std::vector<engine::utils::MeshVertex> &vertices, const std::vector<uint32_t> &indices) {
+    if (vertices.empty() || indices.empty()) {
+        throw std::runtime_error("MeshletRenderer::uploadMesh()::网格数据为空");
+    }
+    engine::utils::MeshletData data = engine::utils::buildMeshlets(vertices, indices);
+
+    VkDeviceSize vertexBytes   = vertices.size() * sizeof(engine::utils::MeshVertex);
+    VkDeviceSize meshletBytes  = data.meshlets.size() * sizeof(GpuMeshlet);
+    VkDeviceSize localBytes    = data.vertices.size() * sizeof(uint32_t);
+    VkDeviceSize triangleBytes = data.triangles.size() * sizeof(uint32_t);
+    if (m_vertexCount * sizeof(engine::utils::MeshVertex) + vertexBytes > MESHLET_VERTEX_BUFFER_SIZE ||
+        m_meshletCount * sizeof(GpuMeshlet) + meshletBytes > MESHLET_DATA_BUFFER_SIZE ||
+        m_meshletVertexCount * sizeof(uint32_t) + localBytes > MESHLET_DATA_BUFFER_SIZE ||
+        m_meshletTriangleCount * sizeof(uint32_t) + triangleBytes > MESHLET_DATA_BUFFER_SIZE) {
+        throw std::runtime_error("MeshletRenderer::uploadMesh()::簇缓冲区空间不足");
+    }
+
+    // 簇引用的顶点和三角形偏移换算为共享缓冲区中的全局位置，着色器不再需要网格的基址
+    std::vector<GpuMeshlet> meshlets(data.meshlets.size());
+    for (size_t i = 0; i < data.meshlets.size(); i++) {
+        const engine::utils::Meshlet &source = data.meshlets[i];
+        GpuMeshlet &meshlet                  = meshlets[i];
+        meshlet.sphere                       = glm::vec4(source.center, source.radius);
+        meshlet.coneAxis                     = glm::vec4(source.coneAxis, source.coneCutoff);
+        meshlet.coneApex                     = glm::vec4(source.coneApex, 0.0f);
+        meshlet.vertexOffset                 = m_meshletVertexCount + source.vertexOffset;
+        meshlet.vertexCount                  = source.vertexCount;
+        meshlet.triangleOffset               = m_meshletTriangleCount + source.triangleOffset;
+        meshlet.triangleCount                = source.triangleCount;
+    }
+    for (uint32_t &vertex : data.vertices) {
+        vertex += m_vertexCount;
+    }
+
+    // 通过临时暂存缓冲区复制到设备本地缓冲区，只写入尚未使用的区域，不影响正在飞行中的帧
+    VkDevice device         = m_renderer.getDevice();
+    VkDeviceSize totalBytes = vertexBytes + meshletBytes + localBytes + triangleBytes;
+    VkBuffer stagingBuffer;
+    VkDeviceMemory stagingMemory;
+    m_renderer.createBuffer(totalBytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, MemoryUsage::Upload,
+                            stagingBuffer, stagingMemory);
+    void *mapped;
+    vkMapMemory(device, stagingMemory, 0, totalBytes, 0, &mapped);
+    char *dst = static_cast<char *>(mapped);
+    memcpy(dst, vertices.data(), static_cast<size_t>(vertexBytes));
+    memcpy(dst + vertexBytes, meshlets.data(), static_cast<size_t>(meshletBytes));
+    memcpy(dst + vertexBytes + meshletBytes, data.vertices.data(), static_cast<size_t>(localBytes));
+    memcpy(dst + vertexBytes + meshletBytes + localBytes, data.triangles.data(), static_cast<size_t>(triangleBytes));
+    vkUnmapMemory(device, stagingMemory);
+
+    const ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    VkCommandBuffer commandBuffer    = m_renderer.beginSingleTimeCommands();
+    VkBufferCopy vertexCopy{0, m_vertexCount * sizeof(engine::utils::MeshVertex), vertexBytes};
+    VkBufferCopy meshletCopy{vertexBytes, m_meshletCount * sizeof(GpuMeshlet), meshletBytes};
+    VkBufferCopy localCopy{vertexBytes + meshletBytes, m_meshletVertexCount * sizeof(uint32_t), localBytes};
+    VkBufferCopy triangleCopy{vertexBytes + meshletBytes + localBytes, m_meshletTriangleCount * sizeof(uint32_t), triangleBytes};
+    vkCmdCopyBuffer(commandBuffer, stagingBuffer, registry.getBuffer(m_vertexBuffer), 1, &vertexCopy);
+    vkCmdCopyBuffer(commandBuffer, stagingBuffer, registry.getBuffer(m_meshletBuffer), 1, &meshletCopy);
+    vkCmdCopyBuffer(commandBuffer, stagingBuffer, registry.getBuffer(m_meshletVertexBuffer), 1, &localCopy);
+    vkCmdCopyBuffer(commandBuffer, stagingBuffer, registry.getBuffer(m_meshletTriangleBuffer), 1, &triangleCopy);
+    m_renderer.endSingleTimeCommands(commandBuffer);
+    vkDestroyBuffer(device, stagingBuffer, nullptr);
+    m_renderer.freeMemory(stagingMemory);
+
+    MeshletMesh mesh{m_meshletCount, static_cast<uint32_t>(meshlets.size())};
+    m_vertexCount += static_cast<uint32_t>(vertices.size());
+    m_meshletCount += static_cast<uint32_t>(meshlets.size());
+    m_meshletVertexCount += static_cast<uint32_t>(data.vertices.size());
+    m_meshletTriangleCount += static_cast<uint32_t>(data.triangles.size());
+    spdlog::trace("MeshletRenderer::uploadMesh()::上传网格成功, 顶点数: {}, 三角形数: {}, 簇数: {}", vertices.size(), indices.size() / 3, mesh.meshletCount);
+    return mesh;
+}
+
+void MeshletRenderer::setInstances(const std::vector<MeshletInstance> &instances) {
+    if (instances.size() > MAX_MESHLET_INSTANCES) {
+        throw std::runtime_error("MeshletRenderer::setInstances()::物体数量超过 MAX_MESHLET_INSTANCES");
+    }
+    m_instances.clear();
+    m_clusters.clear();
+    for (uint32_t i = 0; i < instances.size(); i++) {
+        const MeshletInstance &instance = instances[i];
+        if (instance.mesh.meshletCount == 0) {
+            throw std::runtime_error("MeshletRenderer::setInstances()::物体引用的网格未上传");
+        }
+        if (m_clusters.size() + instance.mesh.meshletCount > MAX_MESHLET_CLUSTERS) {
+            throw std::runtime_error("MeshletRenderer::setInstances()::簇数量超过 MAX_MESHLET_CLUSTERS");
+        }
+        m_instances.push_back(instance.transform);
+        for (uint32_t meshlet = 0; meshlet < instance.mesh.meshletCount; meshlet++) {
+            m_clusters.emplace_back(i, instance.mesh.firstMeshlet + meshlet);
+        }
+    }
+    m_instancesDirty = true;
+}
+
+void MeshletRenderer::recordUploads(VkCommandBuffer commandBuffer) {
+    if (!m_instancesDirty) return;
+    if (m_clusters.empty()) {
+        m_clusterCount   = 0;
+        m_instancesDirty = false;
+        return;
+    }
+    StreamingBuffer &streaming          = m_renderer.getStreamingBuffer();
+    VkDeviceSize instanceBytes          = m_instances.size() * sizeof(glm::mat4);
+    VkDeviceSize clusterBytes           = m_clusters.size() * sizeof(glm::uvec2);
+    StreamingAllocation instanceStaging = streaming.upload(m_instances.data(), instanceBytes);
+    StreamingAllocation clusterStaging  = instanceStaging ? streaming.upload(m_clusters.data(), clusterBytes) : StreamingAllocation{};
+    if (!instanceStaging || !clusterStaging) return; // 暂存空间不足，下一帧再上传
+
+    // 之前的帧可能仍在读取物体和簇列表（读后写）
+    VkPipelineStageFlags readStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    if (m_useMeshShaders) readStages |= VK_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | VK_PIPELINE_STAGE_MESH_SHADER_BIT_EXT;
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, readStages, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    VkBufferCopy instanceCopy{instanceStaging.offset, 0, instanceBytes};
+    VkBufferCopy clusterCopy{clusterStaging.offset, 0, clusterBytes};
+    const ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    vkCmdCopyBuffer(commandBuffer, instanceStaging.buffer, registry.getBuffer(m_instanceBuffer), 1, &instanceCopy);
+    vkCmdCopyBuffer(commandBuffer, clusterStaging.buffer, registry.getBuffer(m_clusterBuffer), 1, &clusterCopy);
+
+    // 复制完成后才能被剔除和绘制读取
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, readStages, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    m_clusterCount   = static_cast<uint32_t>(m_clusters.size());
+    m_instancesDirty = false;
+}
+
+void MeshletRenderer::beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+    // 该帧的 Fence 已经等待过，上一轮写入的计数已经对主机可见
+    m_frameIndex                     = frameIndex;
+    m_statsCounted                   = false;
+    const uint32_t *counts           = reinterpret_cast<const uint32_t *>(m_statsMapped + frameIndex * MESHLET_STATS_STRIDE);
+    m_stats.clusterCount             = m_frameClusterCounts[frameIndex];
+    m_stats.visibleClusters          = counts[0];
+    m_stats.frustumCulled            = counts[1];
+    m_stats.coneCulled               = counts[2];
+    m_stats.droppedClusters          = counts[3];
+    m_stats.triangles                = counts[4];
+    m_frameClusterCounts[frameIndex] = 0;
+
+    VkPipelineStageFlags writeStages = m_useMeshShaders ? VK_PIPELINE_STAGE_TASK_SHADER_BIT_EXT : VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    vkCmdFillBuffer(commandBuffer, m_renderer.getResourceRegistry().getBuffer(m_statsBuffer), frameIndex * MESHLET_STATS_STRIDE, MESHLET_STATS_SIZE, 0);
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, writeStages, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+void MeshletRenderer::recordCull(VkCommandBuffer commandBuffer) {
+    if (m_useMeshShaders || m_clusterCount == 0) return; // 网格着色器路径在任务着色器中剔除
+
+    // 上一帧的间接绘制读完命令、索引和可见簇之后才能重置和覆盖
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+    const uint32_t reset[6] = {0, 1, 0, 0, 0, 0}; // indexCount 由剔除着色器累加，instanceCount 固定为 1，最后一项为槽位计数
+    vkCmdUpdateBuffer(commandBuffer, m_renderer.getResourceRegistry().getBuffer(m_drawCommandBuffer), 0, MESHLET_DRAW_SIZE, reset);
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    MeshletPushConstants constants{};
+    constants.viewProjection = m_meshRenderer.getViewProjection();
+    constants.camera         = glm::vec4(m_meshRenderer.getCameraPosition(), 1.0f);
+    constants.clusterCount   = m_clusterCount;
+    constants.flags          = MESHLET_FLAG_STATS;
+    if (m_cullSettings.frustum) constants.flags |= MESHLET_FLAG_FRUSTUM;
+    if (m_cullSettings.cone) constants.flags |= MESHLET_FLAG_CONE;
+    uint32_t dynamicOffset = static_cast<uint32_t>(m_frameIndex * MESHLET_STATS_STRIDE);
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_cullPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1, &m_descriptorSet, 1, &dynamicOffset);
+    vkCmdPushConstants(commandBuffer, m_pipelineLayout, m_stageFlags, 0, sizeof(constants), &constants);
+    vkCmdDispatch(commandBuffer, (m_clusterCount + MESHLET_CULL_GROUP_SIZE - 1) / MESHLET_CULL_GROUP_SIZE, 1, 1);
+    m_frameClusterCounts[m_frameIndex] += m_clusterCount;
+
+    // 绘制命令供间接绘制读取，索引供顶点输入读取，可见簇供顶点着色器读取
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                         0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+void MeshletRenderer::recordDraws(VkCommandBuffer commandBuffer, VkExtent2D extent) {
+    if (m_clusterCount == 0) return;
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_drawPipeline);
+    uint32_t dynamicOffset = static_cast<uint32_t>(m_frameIndex * MESHLET_STATS_STRIDE);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1, &m_descriptorSet, 1, &dynamicOffset);
+
+    VkViewport viewport{0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f};
+    VkRect2D scissor{{0, 0}, extent};
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    MeshletPushConstants constants{};
+    constants.viewProjection = m_meshRenderer.getViewProjection();
+    constants.camera         = glm::vec4(m_meshRenderer.getCameraPosition(), 1.0f);
+    constants.clusterCount   = m_clusterCount;
+    if (m_cullSettings.frustum) constants.flags |= MESHLET_FLAG_FRUSTUM;
+    if (m_cullSettings.cone) constants.flags |= MESHLET_FLAG_CONE;
+    if (!m_useMeshShaders) {
+        // 剔除结果在 recordCull() 中已经写入，所有窗口共用
+        vkCmdPushConstants(commandBuffer, m_pipelineLayout, m_stageFlags, 0, sizeof(constants), &constants);
+        const ResourceRegistry &registry = m_renderer.getResourceRegistry();
+        vkCmdBindIndexBuffer(commandBuffer, registry.getBuffer(m_drawIndexBuffer), 0, VK_INDEX_TYPE_UINT32);
+        vkCmdDrawIndexedIndirect(commandBuffer, registry.getBuffer(m_drawCommandBuffer), 0, 1, sizeof(VkDrawIndexedIndirectCommand));
+        return;
+    }
+
+    // 任务着色器每个工作组剔除 MESHLET_TASK_GROUP_SIZE 个簇，只有第一个窗口的绘制写入统计
+    if (!m_statsCounted) {
+        constants.flags |= MESHLET_FLAG_STATS;
+        m_frameClusterCounts[m_frameIndex] += m_clusterCount;
+        m_statsCounted = true;
+    }
+    vkCmdPushConstants(commandBuffer, m_pipelineLayout, m_stageFlags, 0, sizeof(constants), &constants);
+    m_cmdDrawMeshTasks(commandBuffer, (m_clusterCount + MESHLET_TASK_GROUP_SIZE - 1) / MESHLET_TASK_GROUP_SIZE, 1, 1);
+}
+
+void MeshletRenderer::endFrame(VkCommandBuffer commandBuffer) {
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    VkPipelineStageFlags writeStages = m_useMeshShaders ? VK_PIPELINE_STAGE_TASK_SHADER_BIT_EXT : VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    vkCmdPipelineBarrier(commandBuffer, writeStages, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+} // namespace engine::render
@@ -0,0 +1,156 @@
+#pragma once
+#include "../utils/Math.hpp"
+#include "RenderConstants.hpp"
+#include "ResourceRegistry.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace engine::render {
+class VulkanRenderer;
+class MeshRenderer;
+
+#pragma region Constants
+const VkDeviceSize MESHLET_VERTEX_BUFFER_SIZE = 8 * 1024 * 1024; // 簇几何共用的顶点缓冲区字节数
+const VkDeviceSize MESHLET_DATA_BUFFER_SIZE   = 8 * 1024 * 1024; // 簇描述、簇顶点表、簇三角形各自的缓冲区字节数
+const uint32_t MAX_MESHLET_INSTANCES          = 4096;            // 簇渲染物体的最大数量
+const uint32_t MAX_MESHLET_CLUSTERS           = 131072;          // 所有物体的簇总数上限（每帧参与剔除的簇）
+const uint32_t MAX_VISIBLE_MESHLETS           = 8192;            // 计算回退路径每帧最多输出的可见簇
+const uint32_t MESHLET_CULL_GROUP_SIZE        = 64;              // 剔除计算着色器工作组大小，与着色器中的 local_size 一致
+const uint32_t MESHLET_TASK_GROUP_SIZE        = 32;              // 任务着色器工作组大小，与着色器中的 local_size 一致
+const VkDeviceSize MESHLET_STATS_STRIDE       = 256;             // 每帧统计区域的间隔，满足 minStorageBufferOffsetAlignment 的上限
+#pragma endregion
+
+/**
+ * @struct MeshletMesh
+ * @brief 已上传网格的簇在共享簇缓冲区中的范围
+ */
+struct MeshletMesh {
+    uint32_t firstMeshlet = 0;
+    uint32_t meshletCount = 0;
+};
+
+/**
+ * @struct MeshletInstance
+ * @brief 以簇为单位绘制的物体：网格 + 模型矩阵
+ * @note 背面锥在世界空间测试，模型矩阵只能包含旋转、平移和等比缩放
+ */
+struct MeshletInstance {
+    MeshletMesh mesh;
+    glm::mat4 transform{1.0f};
+};
+
+/**
+ * @struct MeshletCullSettings
+ * @brief 簇剔除开关，用于对比剔除效果
+ */
+struct MeshletCullSettings {
+    bool frustum = true; // 包围球视锥剔除
+    bool cone    = true; // 法线锥背面剔除，要求网格正面为逆时针绕序
+};
+
+/**
+ * @struct MeshletStats
+ * @brief 簇剔除统计，延迟 MAX_FRAMES_IN_FLIGHT 帧读回
+ */
+struct MeshletStats {
+    uint32_t clusterCount    = 0; // 参与剔除的簇数量
+    uint32_t visibleClusters = 0; // 通过剔除并绘制的簇数量
+    uint32_t frustumCulled   = 0; // 视锥剔除的簇数量
+    uint32_t coneCulled      = 0; // 背面锥剔除的簇数量
+    uint32_t droppedClusters = 0; // 计算回退路径超出 MAX_VISIBLE_MESHLETS 而未绘制的簇数量
+    uint32_t triangles       = 0; // 实际提交的三角形数量
+};
+
+/**
+ * @class MeshletRenderer
+ * @brief 以簇（meshlet）为单位剔除和绘制的几何路径
+ *
+ * 上传网格时划分为最多 64 个顶点、124 个三角形的簇，每个簇带包围球和法线锥。
+ * 设备支持 VK_EXT_mesh_shader 时由任务着色器逐簇剔除、网格着色器输出可见簇的三角形；
+ * 否则由计算着色器逐簇剔除，把可见簇的三角形写入压缩后的索引缓冲区，再用一次间接绘制完成（lavapipe 等设备）。
+ * 回退路径的索引编码为 (可见簇槽位 << 6) | 簇内顶点编号，顶点着色器据此从存储缓冲区取顶点。
+ */
+class MeshletRenderer final {
+public:
+    MeshletRenderer(VulkanRenderer &renderer, MeshRenderer &meshRenderer);
+    ~MeshletRenderer();
+
+    MeshletRenderer(const MeshletRenderer &)            = delete;
+    MeshletRenderer &operator=(const MeshletRenderer &) = delete;
+    MeshletRenderer(MeshletRenderer &&)                 = delete;
+    MeshletRenderer &operator=(MeshletRenderer &&)      = delete;
+
+    void init();
+    void cleanup();
+
+    MeshletMesh uploadMesh(const std::vector<engine::utils::MeshVertex> &vertices, const std::vector<uint32_t> &indices); // 同步上传，只在加载时调用
+    void setInstances(const std::vector<MeshletInstance> &instances);                                                     // 替换所有物体，下一帧生效
+    void setCullSettings(const MeshletCullSettings &settings) { m_cullSettings = settings; }
+
+    void recordUploads(VkCommandBuffer commandBuffer);                   // 在渲染通道之外调用：物体和簇列表有变化时复制到 GPU
+    void beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex); // 读取该帧上一轮的统计并清零
+    void recordCull(VkCommandBuffer commandBuffer);                      // 在渲染通道之外调用：计算回退路径的逐簇剔除，网格着色器路径不做任何事
+    void recordDraws(VkCommandBuffer commandBuffer, VkExtent2D extent);  // 在渲染通道之内调用，相机使用网格渲染器的设置
+    void endFrame(VkCommandBuffer commandBuffer);                        // 统计写入对主机可见
+
+    bool isUsingMeshShaders() const { return m_useMeshShaders; }
+    uint32_t getClusterCount() const { return m_clusterCount; } // 已上传到 GPU 的簇数量
+    const MeshletStats &getStats() const { return m_stats; }    // 最近一次完成帧的统计
+
+private:
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer;
+    MeshRenderer &m_meshRenderer;
+
+    VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE; // 所有存储缓冲区，剔除、顶点、任务、网格着色器共用
+    VkDescriptorPool m_descriptorPool           = VK_NULL_HANDLE;
+    VkDescriptorSet m_descriptorSet             = VK_NULL_HANDLE;
+    VkPipelineLayout m_pipelineLayout           = VK_NULL_HANDLE;
+    VkPipeline m_cullPipeline                   = VK_NULL_HANDLE; // 计算回退路径：逐簇剔除并写入索引
+    VkPipeline m_drawPipeline                   = VK_NULL_HANDLE; // 计算回退路径的顶点着色器管线，或任务 + 网格着色器管线
+    VkShaderStageFlags m_stageFlags             = 0;              // 描述符和推送常量可见的着色器阶段
+
+    BufferHandle m_vertexBuffer;          // 顶点（位置 + 颜色）
+    BufferHandle m_meshletBuffer;         // 簇描述：包围球、法线锥、顶点和三角形范围
+    BufferHandle m_meshletVertexBuffer;   // 簇的局部顶点 -> 全局顶点索引
+    BufferHandle m_meshletTriangleBuffer; // 8 位打包的局部三角形
+    BufferHandle m_instanceBuffer;        // 物体模型矩阵
+    BufferHandle m_clusterBuffer;         // 参与剔除的簇：(物体, 簇)
+    BufferHandle m_visibleClusterBuffer;  // 计算回退路径：可见簇槽位 -> (物体, 簇)
+    BufferHandle m_drawIndexBuffer;       // 计算回退路径：压缩后的索引
+    BufferHandle m_drawCommandBuffer;     // 计算回退路径：一条间接绘制命令 + 槽位计数
+    BufferHandle m_statsBuffer;           // 主机可见的统计缓冲区，每帧一个区域
+    const char *m_statsMapped = nullptr;
+
+    uint32_t m_vertexCount          = 0; // 各缓冲区已使用的元素数量
+    uint32_t m_meshletCount         = 0;
+    uint32_t m_meshletVertexCount   = 0;
+    uint32_t m_meshletTriangleCount = 0;
+
+    std::vector<glm::mat4> m_instances;                   // CPU 端物体模型矩阵
+    std::vector<glm::uvec2> m_clusters;                   // CPU 端簇列表
+    bool m_instancesDirty                        = false; // 物体和簇列表是否需要重新上传
+    uint32_t m_clusterCount                      = 0;     // 已上传到 GPU 的簇数量
+    MeshletCullSettings m_cullSettings;                   // 剔除开关
+    bool m_useMeshShaders                        = false; // 是否使用任务 + 网格着色器路径
+    PFN_vkCmdDrawMeshTasksEXT m_cmdDrawMeshTasks = nullptr;
+
+    uint32_t m_frameIndex = 0;                                         // 当前记录的帧
+    bool m_statsCounted   = false;                                     // 本帧是否已经有一次绘制写入统计（多窗口只统计第一个）
+    std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> m_frameClusterCounts{}; // 每帧提交剔除的簇数量
+    MeshletStats m_stats;                                              // 最近一次完成帧的统计
+#pragma endregion
+
+    void createBuffers();
+    void updateDescriptorSet();
+    void createCullPipeline();
+    void createDrawPipeline();
+    VkShaderModule loadShader(const std::string &filename);
+};
+
+} // namespace engine::render
@@ -0,0 +1,372 @@
+#include "OcclusionCuller.hpp"
+#include "MeshRenderer.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace engine::render {
+
+namespace {
+// 与 occlusion_cull.comp.glsl 中的 push_constant 布局一致（std430）
+struct CullPushConstants {
+    glm::mat4 viewProjection;
+    uint32_t objectCount;
+    uint32_t phase;
+    uint32_t flags;
+    uint32_t drawOffset;     // 本阶段第一条绘制命令的下标
+    glm::vec4 camera;        // xyz 为观察点，w 为投影矩阵的垂直缩放
+    float lodErrorThreshold; // 允许的屏幕空间误差（像素）
+    float lodHysteresis;
+    uint32_t padding[2];
+};
+
+// 与 occlusion_cull.comp.glsl 中的标志位一致
+const uint32_t CULL_FLAG_ENABLED        = 1u << 0; // 进行视锥和遮挡测试，否则全部可见
+const uint32_t CULL_FLAG_HIZ_VALID      = 1u << 1; // Hi-Z 有效，可以进行遮挡测试
+const uint32_t CULL_FLAG_FIRST_INSTANCE = 1u << 2; // firstInstance 写入物体索引
+const uint32_t CULL_FLAG_LOD            = 1u << 3; // 按屏幕空间误差选择 LOD，否则总是使用原始网格
+
+const VkDeviceSize OCCLUSION_STATS_SIZE = 6 * sizeof(uint32_t); // drawnEarly, drawnLate, frustumCulled, occlusionCulled, triangles, fullTriangles
+} // namespace
+
+OcclusionCuller::OcclusionCuller(VulkanRenderer &renderer, MeshRenderer &meshRenderer) : m_renderer(renderer), m_meshRenderer(meshRenderer) {}
+
+OcclusionCuller::~OcclusionCuller() = default;
+
+void OcclusionCuller::init() {
+    VkDevice device = m_renderer.getDevice();
+
+    // Hi-Z 构建：binding 0 为上一级（第 0 级为深度附件），binding 1 为本级
+    std::array<VkDescriptorSetLayoutBinding, 2> buildBindings{};
+    buildBindings[0] = {0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    buildBindings[1] = {1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = static_cast<uint32_t>(buildBindings.size());
+    layoutInfo.pBindings    = buildBindings.data();
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &m_buildSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("OcclusionCuller::init()::创建 Hi-Z 描述符集布局失败");
+    }
+
+    // 剔除：物体、绘制命令、可见性、Hi-Z、统计（动态偏移，每帧一个区域）
+    std::array<VkDescriptorSetLayoutBinding, 5> cullBindings{};
+    cullBindings[0] = {0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    cullBindings[1] = {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    cullBindings[2] = {2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    cullBindings[3] = {3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    cullBindings[4] = {4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    layoutInfo.bindingCount = static_cast<uint32_t>(cullBindings.size());
+    layoutInfo.pBindings    = cullBindings.data();
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &m_cullSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("OcclusionCuller::init()::创建剔除描述符集布局失败");
+    }
+
+    std::array<VkDescriptorPoolSize, 4> poolSizes{};
+    poolSizes[0] = {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_OCCLUSION_TARGET_SETS * (MAX_HIZ_MIP_LEVELS + 1)};
+    poolSizes[1] = {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, MAX_OCCLUSION_TARGET_SETS * MAX_HIZ_MIP_LEVELS};
+    poolSizes[2] = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, MAX_OCCLUSION_TARGET_SETS * 3};
+    poolSizes[3] = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, MAX_OCCLUSION_TARGET_SETS};
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags         = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT; // 交换链重建时 mip 数量可能变化，单独释放
+    poolInfo.maxSets       = MAX_OCCLUSION_TARGET_SETS * (MAX_HIZ_MIP_LEVELS + 1);
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes    = poolSizes.data();
+    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &m_descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("OcclusionCuller::init()::创建描述符池失败");
+    }
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts    = &m_buildSetLayout;
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &m_buildPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("OcclusionCuller::init()::创建 Hi-Z 管线布局失败");
+    }
+    VkPushConstantRange cullRange{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants)};
+    pipelineLayoutInfo.pSetLayouts            = &m_cullSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges    = &cullRange;
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &m_cullPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("OcclusionCuller::init()::创建剔除管线布局失败");
+    }
+    m_buildPipeline = createComputePipeline("assets/shaders/hiz_build.comp.spv", m_buildPipelineLayout);
+    m_cullPipeline  = createComputePipeline("assets/shaders/occlusion_cull.comp.spv", m_cullPipelineLayout);
+
+    // 着色器只用 texelFetch 读取，采样器不做过滤
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter    = VK_FILTER_NEAREST;
+    samplerInfo.minFilter    = VK_FILTER_NEAREST;
+    samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.maxLod       = VK_LOD_CLAMP_NONE;
+    m_sampler                = m_renderer.getSamplerCache().acquire(samplerInfo);
+
+    // 统计缓冲区主机可见，Fence 等待之后直接读取该帧上一轮的计数
+    ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    m_statsBuffer              = registry.createBuffer(OCCLUSION_STATS_STRIDE * MAX_FRAMES_IN_FLIGHT, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                                       MemoryUsage::Readback);
+    void *data                 = nullptr;
+    if (vkMapMemory(device, registry.get(m_statsBuffer)->memory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS) {
+        throw std::runtime_error("OcclusionCuller::init()::映射统计缓冲区失败");
+    }
+    std::memset(data, 0, OCCLUSION_STATS_STRIDE * MAX_FRAMES_IN_FLIGHT);
+    m_statsMapped = static_cast<const char *>(data);
+    spdlog::trace("OcclusionCuller::init()::遮挡剔除初始化成功");
+}
+
+void OcclusionCuller::cleanup() {
+    VkDevice device = m_renderer.getDevice();
+    if (m_statsMapped != nullptr) vkUnmapMemory(device, m_renderer.getResourceRegistry().get(m_statsBuffer)->memory); // 缓冲区由资源注册表在清理时销毁
+    if (m_sampler != VK_NULL_HANDLE) m_renderer.getSamplerCache().release(m_sampler);
+    vkDestroyPipeline(device, m_cullPipeline, nullptr);
+    vkDestroyPipeline(device, m_buildPipeline, nullptr);
+    vkDestroyPipelineLayout(device, m_cullPipelineLayout, nullptr);
+    vkDestroyPipelineLayout(device, m_buildPipelineLayout, nullptr);
+    vkDestroyDescriptorPool(device, m_descriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(device, m_cullSetLayout, nullptr);
+    vkDestroyDescriptorSetLayout(device, m_buildSetLayout, nullptr);
+    m_statsMapped  = nullptr;
+    m_statsBuffer  = {};
+    m_sampler      = VK_NULL_HANDLE;
+    m_cullPipeline = VK_NULL_HANDLE;
+}
+
+VkPipeline OcclusionCuller::createComputePipeline(const std::string &filename, VkPipelineLayout layout) {
+    auto shaderCode             = VulkanRenderer::readFile(filename);
+    VkShaderModule shaderModule = m_renderer.createShaderModule(shaderCode);
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType        = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = shaderModule;
+    pipelineInfo.stage.pName  = "main";
+    pipelineInfo.layout       = layout;
+    VkPipeline pipeline;
+    if (vkCreateComputePipelines(m_renderer.getDevice(), m_renderer.getPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+        throw std::runtime_error("OcclusionCuller::createComputePipeline()::创建计算管线失败: " + filename);
+    }
+    vkDestroyShaderModule(m_renderer.getDevice(), shaderModule, nullptr);
+    return pipeline;
+}
+
+void OcclusionCuller::createTargets(OcclusionTargets &targets, VkExtent2D extent, VkImageView depthView) {
+    // 第 0 级与深度附件同尺寸，逐级减半直到 1x1
+    targets.extent    = extent;
+    targets.mipLevels = std::min(static_cast<uint32_t>(std::bit_width(std::max(extent.width, extent.height))), MAX_HIZ_MIP_LEVELS);
+    ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    targets.hizImage           = registry.createImage(extent.width, extent.height, HIZ_FORMAT, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                                                      MemoryUsage::GpuOnly, targets.mipLevels);
+    VkImage hizImage           = registry.getImage(targets.hizImage);
+    targets.hizView            = m_renderer.createImageView(hizImage, HIZ_FORMAT, VK_IMAGE_ASPECT_COLOR_BIT, 0, targets.mipLevels);
+    targets.mipViews.resize(targets.mipLevels);
+    for (uint32_t mip = 0; mip < targets.mipLevels; mip++) {
+        targets.mipViews[mip] = m_renderer.createImageView(hizImage, HIZ_FORMAT, VK_IMAGE_ASPECT_COLOR_BIT, mip, 1);
+    }
+
+    targets.drawBuffer       = registry.createBuffer(2 * MAX_MESH_OBJECTS * sizeof(VkDrawIndexedIndirectCommand),
+                                                     VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, MemoryUsage::GpuOnly);
+    targets.visibilityBuffer = registry.createBuffer(MAX_MESH_OBJECTS * sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, MemoryUsage::GpuOnly);
+
+    std::vector<VkDescriptorSetLayout> layouts(targets.mipLevels, m_buildSetLayout);
+    layouts.push_back(m_cullSetLayout);
+    std::vector<VkDescriptorSet> sets(layouts.size());
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool     = m_descriptorPool;
+    allocInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+    allocInfo.pSetLayouts        = layouts.data();
+    if (vkAllocateDescriptorSets(m_renderer.getDevice(), &allocInfo, sets.data()) != VK_SUCCESS) {
+        throw std::runtime_error("OcclusionCuller::createTargets()::分配描述符集失败");
+    }
+    targets.cullSet = sets.back();
+    sets.pop_back();
+    targets.buildSets = std::move(sets);
+    targets.hizValid  = false;
+    updateDescriptorSets(targets, depthView);
+}
+
+void OcclusionCuller::destroyTargets(OcclusionTargets &targets) {
+    VkDevice device = m_renderer.getDevice();
+    if (targets.cullSet != VK_NULL_HANDLE) {
+        std::vector<VkDescriptorSet> sets = targets.buildSets;
+        sets.push_back(targets.cullSet);
+        vkFreeDescriptorSets(device, m_descriptorPool, static_cast<uint32_t>(sets.size()), sets.data());
+    }
+    for (VkImageView view : targets.mipViews) {
+        m_renderer.releaseImageView(view);
+    }
+    if (targets.hizView != VK_NULL_HANDLE) m_renderer.releaseImageView(targets.hizView);
+    ResourceRegistry &registry = m_renderer.getResourceRegistry(); // 之前的帧可能仍在使用，经由延迟销毁队列释放
+    registry.destroy(targets.hizImage);
+    registry.destroy(targets.drawBuffer);
+    registry.destroy(targets.visibilityBuffer);
+    targets = OcclusionTargets{};
+}
+
+void OcclusionCuller::updateDescriptorSets(const OcclusionTargets &targets, VkImageView depthView) {
+    // 每级 mip 的输入和输出，第 0 级从深度附件复制
+    std::vector<VkDescriptorImageInfo> imageInfos(targets.mipLevels * 2 + 1);
+    std::vector<VkWriteDescriptorSet> writes;
+    for (uint32_t mip = 0; mip < targets.mipLevels; mip++) {
+        VkDescriptorImageInfo &srcInfo = imageInfos[mip * 2];
+        srcInfo.sampler                = m_sampler;
+        srcInfo.imageView              = mip == 0 ? depthView : targets.mipViews[mip - 1];
+        srcInfo.imageLayout            = mip == 0 ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL;
+        VkDescriptorImageInfo &dstInfo = imageInfos[mip * 2 + 1];
+        dstInfo.imageView              = targets.mipViews[mip];
+        dstInfo.imageLayout            = VK_IMAGE_LAYOUT_GENERAL;
+
+        VkWriteDescriptorSet write{};
+        write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet          = targets.buildSets[mip];
+        write.descriptorCount = 1;
+        write.dstBinding      = 0;
+        write.descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo      = &srcInfo;
+        writes.push_back(write);
+        write.dstBinding     = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        write.pImageInfo     = &dstInfo;
+        writes.push_back(write);
+    }
+
+    VkDescriptorImageInfo &hizInfo = imageInfos.back();
+    hizInfo.sampler                = m_sampler;
+    hizInfo.imageView              = targets.hizView;
+    hizInfo.imageLayout            = VK_IMAGE_LAYOUT_GENERAL;
+    std::array<VkDescriptorBufferInfo, 4> bufferInfos{};
+    bufferInfos[0] = {m_meshRenderer.getObjectBuffer(), 0, VK_WHOLE_SIZE};
+    const ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    bufferInfos[1]                   = {registry.getBuffer(targets.drawBuffer), 0, VK_WHOLE_SIZE};
+    bufferInfos[2]                   = {registry.getBuffer(targets.visibilityBuffer), 0, VK_WHOLE_SIZE};
+    bufferInfos[3]                   = {registry.getBuffer(m_statsBuffer), 0, OCCLUSION_STATS_SIZE};
+    std::array<VkDescriptorType, 5> cullTypes = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                                 VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC};
+    for (uint32_t binding = 0; binding < cullTypes.size(); binding++) {
+        VkWriteDescriptorSet write{};
+        write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet          = targets.cullSet;
+        write.dstBinding      = binding;
+        write.descriptorCount = 1;
+        write.descriptorType  = cullTypes[binding];
+        if (binding == 3) {
+            write.pImageInfo = &hizInfo;
+        } else {
+            write.pBufferInfo = &bufferInfos[binding < 3 ? binding : 3];
+        }
+        writes.push_back(write);
+    }
+    vkUpdateDescriptorSets(m_renderer.getDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+}
+
+void OcclusionCuller::beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+    // 该帧的 Fence 已经等待过，上一轮写入的计数已经对主机可见
+    m_frameIndex                    = frameIndex;
+    const uint32_t *counts          = reinterpret_cast<const uint32_t *>(m_statsMapped + frameIndex * OCCLUSION_STATS_STRIDE);
+    m_stats.objectCount             = m_frameObjectCounts[frameIndex];
+    m_stats.drawnEarly              = counts[0];
+    m_stats.drawnLate               = counts[1];
+    m_stats.frustumCulled           = counts[2];
+    m_stats.occlusionCulled         = counts[3];
+    m_stats.triangles               = counts[4];
+    m_stats.fullTriangles           = counts[5];
+    m_frameObjectCounts[frameIndex] = 0;
+
+    vkCmdFillBuffer(commandBuffer, m_renderer.getResourceRegistry().getBuffer(m_statsBuffer), frameIndex * OCCLUSION_STATS_STRIDE, OCCLUSION_STATS_SIZE, 0);
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+void OcclusionCuller::recordCull(VkCommandBuffer commandBuffer, OcclusionTargets &targets, CullPhase phase) {
+    uint32_t objectCount = m_meshRenderer.getObjectCount();
+    if (objectCount == 0) return;
+
+    const MeshLodSettings &lodSettings = m_meshRenderer.getLodSettings();
+    uint32_t flags                     = m_renderer.getEnabledFeatures().drawIndirectFirstInstance ? CULL_FLAG_FIRST_INSTANCE : 0;
+    if (m_enabled) flags |= CULL_FLAG_ENABLED;
+    if (lodSettings.enabled) flags |= CULL_FLAG_LOD;
+    if (phase == CullPhase::Early) {
+        // 上一帧的间接绘制读取完绘制命令、Hi-Z 构建写完之后才能覆盖绘制命令和读取 Hi-Z
+        VkMemoryBarrier barrier{};
+        barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+        if (!m_enabled) targets.hizValid = false; // 关闭期间不构建 Hi-Z，重新启用时不能使用过期的金字塔
+        if (!targets.hizValid) {
+            VulkanRenderer::recordImageBarrier(commandBuffer, m_renderer.getResourceRegistry().getImage(targets.hizImage), VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                                               VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                                               VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+        } else {
+            flags |= CULL_FLAG_HIZ_VALID;
+        }
+        m_frameObjectCounts[m_frameIndex] += objectCount;
+    } else {
+        flags |= CULL_FLAG_HIZ_VALID; // buildHiZ() 刚用本帧深度重建
+    }
+
+    CullPushConstants constants{};
+    constants.viewProjection    = m_meshRenderer.getViewProjection();
+    constants.objectCount       = objectCount;
+    constants.phase             = static_cast<uint32_t>(phase);
+    constants.flags             = flags;
+    constants.drawOffset        = static_cast<uint32_t>(getDrawOffset(phase) / sizeof(VkDrawIndexedIndirectCommand));
+    constants.camera            = glm::vec4(m_meshRenderer.getCameraPosition(), m_meshRenderer.getProjectionScale());
+    constants.lodErrorThreshold = lodSettings.errorThreshold;
+    constants.lodHysteresis     = lodSettings.hysteresis;
+    uint32_t dynamicOffset      = static_cast<uint32_t>(m_frameIndex * OCCLUSION_STATS_STRIDE);
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_cullPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_cullPipelineLayout, 0, 1, &targets.cullSet, 1, &dynamicOffset);
+    vkCmdPushConstants(commandBuffer, m_cullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+    vkCmdDispatch(commandBuffer, (objectCount + OCCLUSION_CULL_GROUP_SIZE - 1) / OCCLUSION_CULL_GROUP_SIZE, 1, 1);
+
+    // 绘制命令供间接绘制读取，可见性供第二阶段读取，计数在 Fence 之后由主机读取
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+                         0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+void OcclusionCuller::buildHiZ(VkCommandBuffer commandBuffer, OcclusionTargets &targets) {
+    // 第一阶段的剔除读完 Hi-Z 之后才能覆盖；深度附件由渲染通道的外部依赖保证写入完成
+    VkImage hizImage = m_renderer.getResourceRegistry().getImage(targets.hizImage);
+    VulkanRenderer::recordImageBarrier(commandBuffer, hizImage, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+                                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_buildPipeline);
+    for (uint32_t mip = 0; mip < targets.mipLevels; mip++) {
+        uint32_t width  = std::max(targets.extent.width >> mip, 1u);
+        uint32_t height = std::max(targets.extent.height >> mip, 1u);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_buildPipelineLayout, 0, 1, &targets.buildSets[mip], 0, nullptr);
+        vkCmdDispatch(commandBuffer, (width + HIZ_BUILD_TILE_SIZE - 1) / HIZ_BUILD_TILE_SIZE, (height + HIZ_BUILD_TILE_SIZE - 1) / HIZ_BUILD_TILE_SIZE, 1);
+
+        // 本级写完后才能作为下一级的输入，最后一级之后供第二阶段的剔除读取
+        VulkanRenderer::recordImageBarrier(commandBuffer, hizImage, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+                                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    }
+    targets.hizValid = true;
+}
+
+VkDeviceSize OcclusionCuller::getDrawOffset(CullPhase phase) const {
+    return phase == CullPhase::Late ? MAX_MESH_OBJECTS * sizeof(VkDrawIndexedIndirectCommand) : 0;
+}
+
+} // namespace engine::render
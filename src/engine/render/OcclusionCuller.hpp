@@ -0,0 +1,127 @@
+#pragma once
+#include "RenderConstants.hpp"
+#include "ResourceRegistry.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace engine::render {
+class VulkanRenderer;
+class MeshRenderer;
+
+#pragma region Constants
+const VkFormat HIZ_FORMAT                 = VK_FORMAT_R32_SFLOAT; // Hi-Z 金字塔格式，每个 texel 保存覆盖区域内的最大深度
+const uint32_t MAX_HIZ_MIP_LEVELS         = 16;                   // Hi-Z 金字塔最多的 mip 级数
+const uint32_t HIZ_BUILD_TILE_SIZE        = 8;                    // Hi-Z 构建着色器工作组尺寸，与着色器中的 local_size 一致
+const uint32_t OCCLUSION_CULL_GROUP_SIZE  = 64;                   // 剔除着色器工作组大小，与着色器中的 local_size 一致
+const uint32_t MAX_OCCLUSION_TARGET_SETS  = 32;                   // 描述符池最多支持的目标数量（每个窗口一组）
+const VkDeviceSize OCCLUSION_STATS_STRIDE = 256;                  // 每帧统计区域的间隔，满足 minStorageBufferOffsetAlignment 的上限
+#pragma endregion
+
+/**
+ * @enum CullPhase
+ * @brief 两阶段遮挡剔除的阶段
+ */
+enum class CullPhase : uint32_t {
+    Early = 0, // 用上一帧的 Hi-Z 测试所有物体
+    Late  = 1, // 用本帧第一阶段深度重建的 Hi-Z 重新测试第一阶段被剔除的物体
+};
+
+/**
+ * @struct OcclusionTargets
+ * @brief 每个窗口的遮挡剔除资源：Hi-Z 金字塔、两个阶段的间接绘制命令和第一阶段的可见性
+ */
+struct OcclusionTargets {
+    VkExtent2D extent{};
+    uint32_t mipLevels      = 0;
+    ImageHandle hizImage;                     // Hi-Z 金字塔
+    VkImageView hizView     = VK_NULL_HANDLE; // 包含全部 mip，剔除时采样
+    std::vector<VkImageView> mipViews;        // 每级 mip 一个视图，构建时读上一级、写本级
+    std::vector<VkDescriptorSet> buildSets;   // 每级 mip 一个描述符集，第 0 级读取深度附件
+    VkDescriptorSet cullSet = VK_NULL_HANDLE;
+    BufferHandle drawBuffer;                  // 两个阶段各 MAX_MESH_OBJECTS 条 VkDrawIndexedIndirectCommand
+    BufferHandle visibilityBuffer;            // 每个物体在第一阶段是否已绘制
+    bool hizValid           = false;          // Hi-Z 是否已经由之前的帧构建过
+};
+
+/**
+ * @struct OcclusionStats
+ * @brief 遮挡剔除统计，所有窗口累计，延迟 MAX_FRAMES_IN_FLIGHT 帧读回
+ */
+struct OcclusionStats {
+    uint32_t objectCount     = 0; // 参与剔除的物体数量
+    uint32_t drawnEarly      = 0; // 第一阶段绘制的物体数量
+    uint32_t drawnLate       = 0; // 第二阶段补画的物体数量
+    uint32_t frustumCulled   = 0; // 视锥剔除的物体数量
+    uint32_t occlusionCulled = 0; // 遮挡剔除的物体数量
+    uint32_t triangles       = 0; // 实际提交的三角形数量（按选择的 LOD）
+    uint32_t fullTriangles   = 0; // 同样的物体全部使用原始网格时的三角形数量，与 triangles 对比 LOD 的效果
+
+    uint32_t culledDraws() const { return frustumCulled + occlusionCulled; } // 本帧被剔除的绘制数量
+};
+
+/**
+ * @class OcclusionCuller
+ * @brief 基于 Hi-Z 金字塔的两阶段 GPU 遮挡剔除
+ *
+ * 第一阶段用上一帧构建的 Hi-Z 测试物体包围盒，写入第一批间接绘制命令；场景绘制后用本帧深度重建 Hi-Z，
+ * 第二阶段只重新测试第一阶段被剔除的物体，把实际可见的补画出来。镜头移动时上一帧的 Hi-Z 可能把可见物体误剔除，
+ * 第二阶段保证这些物体在同一帧内画出，不会出现闪现。
+ */
+class OcclusionCuller final {
+public:
+    OcclusionCuller(VulkanRenderer &renderer, MeshRenderer &meshRenderer);
+    ~OcclusionCuller();
+
+    OcclusionCuller(const OcclusionCuller &)            = delete;
+    OcclusionCuller &operator=(const OcclusionCuller &) = delete;
+    OcclusionCuller(OcclusionCuller &&)                 = delete;
+    OcclusionCuller &operator=(OcclusionCuller &&)      = delete;
+
+    void init();
+    void cleanup();
+
+    void createTargets(OcclusionTargets &targets, VkExtent2D extent, VkImageView depthView); // 创建与深度附件同尺寸的 Hi-Z 金字塔和绘制命令缓冲区
+    void destroyTargets(OcclusionTargets &targets);                                           // 销毁所有资源并释放描述符集
+
+    void setEnabled(bool enabled) { m_enabled = enabled; } // 关闭后所有物体都在第一阶段绘制，用于对比
+    bool isEnabled() const { return m_enabled; }
+
+    void beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex);                        // 读取该帧上一轮的统计并清零
+    void recordCull(VkCommandBuffer commandBuffer, OcclusionTargets &targets, CullPhase phase); // 在渲染通道之外调用
+    void buildHiZ(VkCommandBuffer commandBuffer, OcclusionTargets &targets);                    // 深度附件必须处于 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+    VkDeviceSize getDrawOffset(CullPhase phase) const;                                          // 该阶段的绘制命令在 drawBuffer 中的偏移
+
+    const OcclusionStats &getStats() const { return m_stats; } // 最近一次完成帧的统计
+
+private:
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer;
+    MeshRenderer &m_meshRenderer;
+
+    VkDescriptorSetLayout m_buildSetLayout = VK_NULL_HANDLE; // 输入采样图像 + 输出存储图像
+    VkDescriptorSetLayout m_cullSetLayout  = VK_NULL_HANDLE; // 物体、绘制命令、可见性、Hi-Z、统计
+    VkDescriptorPool m_descriptorPool      = VK_NULL_HANDLE;
+    VkPipelineLayout m_buildPipelineLayout = VK_NULL_HANDLE;
+    VkPipelineLayout m_cullPipelineLayout  = VK_NULL_HANDLE;
+    VkPipeline m_buildPipeline             = VK_NULL_HANDLE; // Hi-Z 逐级最大值下采样
+    VkPipeline m_cullPipeline              = VK_NULL_HANDLE; // 视锥 + Hi-Z 遮挡测试
+    VkSampler m_sampler                    = VK_NULL_HANDLE; // 最近邻采样器，来自采样器缓存
+
+    BufferHandle m_statsBuffer;                                       // 主机可见的统计缓冲区，每帧一个区域
+    const char *m_statsMapped = nullptr;
+    bool m_enabled            = true;                                 // 是否启用剔除
+    uint32_t m_frameIndex     = 0;                                    // 当前记录的帧
+    std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> m_frameObjectCounts{}; // 每帧提交剔除的物体数量
+    OcclusionStats m_stats;                                           // 最近一次完成帧的统计
+#pragma endregion
+
+    VkPipeline createComputePipeline(const std::string &filename, VkPipelineLayout layout);
+    void updateDescriptorSets(const OcclusionTargets &targets, VkImageView depthView);
+};
+
+} // namespace engine::render
@@ -0,0 +1,520 @@
+#include "ParticleSystem.hpp"
+#include "MeshRenderer.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace engine::render {
+
+namespace {
+// 与 particle 系列着色器中的 Particle 布局一致（std430）
+struct GpuParticle {
+    glm::vec4 position; // xyz 为位置，w 为已存活的时间
+    glm::vec4 velocity; // xyz 为速度，w 为寿命
+    uint32_t startColor;
+    uint32_t endColor;
+    float startSize;
+    float endSize;
+};
+static_assert(sizeof(GpuParticle) == 48, "GpuParticle 必须与着色器中的 std430 布局一致");
+
+// 与 particle_emit.comp.glsl 中的 Emitter 布局一致（std430）
+struct GpuEmitter {
+    glm::vec4 position; // xyz 为发射中心，w 为出生球半径
+    glm::vec4 velocity; // xyz 为初速度，w 为随机扰动半径
+    glm::vec4 startColor;
+    glm::vec4 endColor;
+    float startSize;
+    float endSize;
+    float minLifetime;
+    float maxLifetime;
+    uint32_t first; // 本帧第一个粒子在所有新粒子中的编号
+    uint32_t count; // 本帧发射的粒子数量
+    uint32_t padding[2];
+};
+static_assert(sizeof(GpuEmitter) == 96, "GpuEmitter 必须与着色器中的 std430 布局一致");
+
+// 与 particle 系列着色器中的 push_constant 布局一致，正好是 maxPushConstantsSize 的最小保证值
+struct ParticlePushConstants {
+    glm::mat4 viewProjection;
+    glm::vec4 cameraRight; // xyz 为观察空间 x 轴在世界空间中的方向
+    glm::vec4 cameraUp;    // xyz 为观察空间 y 轴在世界空间中的方向
+    glm::vec4 gravity;     // xyz 为加速度，w 为阻力
+    float deltaTime;
+    uint32_t emitterCount;
+    uint32_t emitCount;
+    uint32_t seed;
+};
+static_assert(sizeof(ParticlePushConstants) == 128, "推送常量超出 maxPushConstantsSize 的最小保证值");
+
+const uint32_t PARTICLE_BINDING_COUNT      = 5;                                          // 读取端、写入端、计数、工作组计数、发射器（动态偏移）
+const VkDeviceSize PARTICLE_EMITTER_STRIDE = MAX_PARTICLE_EMITTERS * sizeof(GpuEmitter); // 每帧发射器区域的间隔
+const VkDeviceSize PARTICLE_COUNTER_SIZE   = 11 * sizeof(uint32_t);                      // 调度参数 3 + 绘制参数 4 + alive, emitted, dropped, total
+const VkDeviceSize PARTICLE_STATS_OFFSET   = 7 * sizeof(uint32_t);                       // 计数缓冲区中 alive, emitted, dropped 的位置
+const VkDeviceSize PARTICLE_STATS_SIZE     = 3 * sizeof(uint32_t);
+const uint32_t PARTICLE_MAX_GROUPS         = MAX_PARTICLES / PARTICLE_GROUP_SIZE;        // 模拟和压缩的最大工作组数量
+const float PARTICLE_MAX_DELTA_TIME        = 0.1f;                                       // 单帧模拟时间的上限，卡顿后粒子不会一次跳得太远
+static_assert(PARTICLE_EMITTER_STRIDE % PARTICLE_STATS_STRIDE == 0, "发射器区域必须满足 minStorageBufferOffsetAlignment 的上限");
+static_assert(MAX_PARTICLES % (PARTICLE_GROUP_SIZE * PARTICLE_GROUP_SIZE) == 0, "扫描着色器要求每个线程处理整数个工作组计数");
+} // namespace
+
+ParticleSystem::ParticleSystem(VulkanRenderer &renderer, MeshRenderer &meshRenderer) : m_renderer(renderer), m_meshRenderer(meshRenderer) {}
+
+ParticleSystem::~ParticleSystem() = default;
+
+void ParticleSystem::init() {
+    VkDevice device                = m_renderer.getDevice();
+    const VkShaderStageFlags stage = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT;
+
+    // 所有绑定都是存储缓冲区，最后一个发射器缓冲区使用动态偏移，每帧一个区域
+    std::array<VkDescriptorSetLayoutBinding, PARTICLE_BINDING_COUNT> bindings{};
+    for (uint32_t binding = 0; binding < PARTICLE_BINDING_COUNT; binding++) {
+        bindings[binding].binding         = binding;
+        bindings[binding].descriptorType  = binding + 1 == PARTICLE_BINDING_COUNT ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[binding].descriptorCount = 1;
+        bindings[binding].stageFlags      = stage;
+    }
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings    = bindings.data();
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &m_descriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("ParticleSystem::init()::创建描述符集布局失败");
+    }
+
+    const uint32_t setCount = static_cast<uint32_t>(m_descriptorSets.size());
+    std::array<VkDescriptorPoolSize, 2> poolSizes{};
+    poolSizes[0] = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, (PARTICLE_BINDING_COUNT - 1) * setCount};
+    poolSizes[1] = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, setCount};
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets       = setCount;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes    = poolSizes.data();
+    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &m_descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("ParticleSystem::init()::创建描述符池失败");
+    }
+    std::array<VkDescriptorSetLayout, 2> setLayouts = {m_descriptorSetLayout, m_descriptorSetLayout};
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool     = m_descriptorPool;
+    allocInfo.descriptorSetCount = setCount;
+    allocInfo.pSetLayouts        = setLayouts.data();
+    if (vkAllocateDescriptorSets(device, &allocInfo, m_descriptorSets.data()) != VK_SUCCESS) {
+        throw std::runtime_error("ParticleSystem::init()::分配描述符集失败");
+    }
+
+    VkPushConstantRange pushConstantRange{stage, 0, sizeof(ParticlePushConstants)};
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount         = 1;
+    pipelineLayoutInfo.pSetLayouts            = &m_descriptorSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges    = &pushConstantRange;
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &m_pipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("ParticleSystem::init()::创建管线布局失败");
+    }
+
+    createBuffers();
+    updateDescriptorSets();
+    m_emitPipeline     = createComputePipeline("assets/shaders/particle_emit.comp.spv");
+    m_simulatePipeline = createComputePipeline("assets/shaders/particle_simulate.comp.spv");
+    m_scanPipeline     = createComputePipeline("assets/shaders/particle_scan.comp.spv");
+    m_compactPipeline  = createComputePipeline("assets/shaders/particle_compact.comp.spv");
+    createDrawPipeline();
+    spdlog::info("ParticleSystem::init()::粒子系统初始化成功, 粒子上限: {}", MAX_PARTICLES);
+}
+
+void ParticleSystem::cleanup() {
+    VkDevice device            = m_renderer.getDevice();
+    ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    if (m_emitterMapped != nullptr) vkUnmapMemory(device, registry.get(m_emitterBuffer)->memory);
+    if (m_statsMapped != nullptr) vkUnmapMemory(device, registry.get(m_statsBuffer)->memory);
+    for (VkPipeline *pipeline : {&m_emitPipeline, &m_simulatePipeline, &m_scanPipeline, &m_compactPipeline, &m_drawPipeline}) {
+        vkDestroyPipeline(device, *pipeline, nullptr);
+        *pipeline = VK_NULL_HANDLE;
+    }
+    vkDestroyPipelineLayout(device, m_pipelineLayout, nullptr);
+    vkDestroyDescriptorPool(device, m_descriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(device, m_descriptorSetLayout, nullptr);
+    // 缓冲区由资源注册表在清理时销毁
+    m_particleBuffers = {};
+    m_counterBuffer   = {};
+    m_blockBuffer     = {};
+    m_emitterBuffer   = {};
+    m_statsBuffer     = {};
+    m_emitterMapped   = nullptr;
+    m_statsMapped     = nullptr;
+}
+
+void ParticleSystem::createBuffers() {
+    VkDevice device            = m_renderer.getDevice();
+    ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    for (BufferHandle &particleBuffer : m_particleBuffers) {
+        particleBuffer = registry.createBuffer(static_cast<VkDeviceSize>(MAX_PARTICLES) * sizeof(GpuParticle), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, MemoryUsage::GpuOnly);
+    }
+    m_counterBuffer = registry.createBuffer(PARTICLE_COUNTER_SIZE,
+                                            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                            MemoryUsage::GpuOnly);
+    m_blockBuffer   = registry.createBuffer(PARTICLE_MAX_GROUPS * sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, MemoryUsage::GpuOnly);
+
+    // 发射器参数由 CPU 每帧写入该帧的区域，Fence 等待之后才会覆盖
+    m_emitterBuffer = registry.createBuffer(PARTICLE_EMITTER_STRIDE * MAX_FRAMES_IN_FLIGHT, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, MemoryUsage::Upload);
+    void *data      = nullptr;
+    if (vkMapMemory(device, registry.get(m_emitterBuffer)->memory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS) {
+        throw std::runtime_error("ParticleSystem::createBuffers()::映射发射器缓冲区失败");
+    }
+    m_emitterMapped = static_cast<char *>(data);
+
+    // 统计缓冲区主机可见，Fence 等待之后直接读取该帧上一轮复制的计数
+    m_statsBuffer = registry.createBuffer(PARTICLE_STATS_STRIDE * MAX_FRAMES_IN_FLIGHT, VK_BUFFER_USAGE_TRANSFER_DST_BIT, MemoryUsage::Readback);
+    if (vkMapMemory(device, registry.get(m_statsBuffer)->memory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS) {
+        throw std::runtime_error("ParticleSystem::createBuffers()::映射统计缓冲区失败");
+    }
+    std::memset(data, 0, PARTICLE_STATS_STRIDE * MAX_FRAMES_IN_FLIGHT);
+    m_statsMapped = static_cast<const char *>(data);
+}
+
+void ParticleSystem::updateDescriptorSets() {
+    // 两个描述符集的读取端和写入端互换，每帧交替使用
+    const ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    for (uint32_t set = 0; set < m_descriptorSets.size(); set++) {
+        std::array<VkDescriptorBufferInfo, PARTICLE_BINDING_COUNT> bufferInfos{};
+        bufferInfos[0] = {registry.getBuffer(m_particleBuffers[set]), 0, VK_WHOLE_SIZE};
+        bufferInfos[1] = {registry.getBuffer(m_particleBuffers[set ^ 1]), 0, VK_WHOLE_SIZE};
+        bufferInfos[2] = {registry.getBuffer(m_counterBuffer), 0, VK_WHOLE_SIZE};
+        bufferInfos[3] = {registry.getBuffer(m_blockBuffer), 0, VK_WHOLE_SIZE};
+        bufferInfos[4] = {registry.getBuffer(m_emitterBuffer), 0, PARTICLE_EMITTER_STRIDE};
+        std::array<VkWriteDescriptorSet, PARTICLE_BINDING_COUNT> writes{};
+        for (uint32_t binding = 0; binding < PARTICLE_BINDING_COUNT; binding++) {
+            writes[binding].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[binding].dstSet          = m_descriptorSets[set];
+            writes[binding].dstBinding      = binding;
+            writes[binding].descriptorCount = 1;
+            writes[binding].descriptorType  = binding + 1 == PARTICLE_BINDING_COUNT ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[binding].pBufferInfo     = &bufferInfos[binding];
+        }
+        vkUpdateDescriptorSets(m_renderer.getDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+}
+
+VkShaderModule ParticleSystem::loadShader(const std::string &filename) {
+    auto shaderCode = VulkanRenderer::readFile(filename);
+    return m_renderer.createShaderModule(shaderCode);
+}
+
+VkPipeline ParticleSystem::createComputePipeline(const std::string &filename) {
+    VkShaderModule shaderModule = loadShader(filename);
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType        = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = shaderModule;
+    pipelineInfo.stage.pName  = "main";
+    pipelineInfo.layout       = m_pipelineLayout;
+    VkPipeline pipeline       = VK_NULL_HANDLE;
+    VkResult result           = vkCreateComputePipelines(m_renderer.getDevice(), m_renderer.getPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline);
+    vkDestroyShaderModule(m_renderer.getDevice(), shaderModule, nullptr);
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error("ParticleSystem::createComputePipeline()::创建计算管线失败: " + filename);
+    }
+    return pipeline;
+}
+
+void ParticleSystem::createDrawPipeline() {
+    VkDevice device = m_renderer.getDevice();
+
+    VkShaderModule vertShaderModule = loadShader("assets/shaders/particle.vert.spv");
+    VkShaderModule fragShaderModule = loadShader("assets/shaders/particle.frag.spv");
+    std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages{};
+    shaderStages[0].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStages[0].stage  = VK_SHADER_STAGE_VERTEX_BIT;
+    shaderStages[0].module = vertShaderModule;
+    shaderStages[0].pName  = "main";
+    shaderStages[1].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStages[1].stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
+    shaderStages[1].module = fragShaderModule;
+    shaderStages[1].pName  = "main";
+
+    // 粒子从存储缓冲区读取，没有顶点输入
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+    vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+
+    VkPipelineViewportStateCreateInfo viewportState{};
+    viewportState.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount  = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterizer{};
+    rasterizer.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.lineWidth   = 1.0f;
+    rasterizer.cullMode    = VK_CULL_MODE_NONE;
+    rasterizer.frontFace   = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+    VkPipelineMultisampleStateCreateInfo multisampling{};
+    multisampling.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    // 与场景深度比较但不写入，粒子之间不需要排序
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.sType            = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable  = VK_TRUE;
+    depthStencil.depthWriteEnable = VK_FALSE;
+    depthStencil.depthCompareOp   = VK_COMPARE_OP_LESS;
+
+    // 加法混合，结果与绘制顺序无关
+    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+    colorBlendAttachment.colorWriteMask      = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    colorBlendAttachment.blendEnable         = VK_TRUE;
+    colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.colorBlendOp        = VK_BLEND_OP_ADD;
+    colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.alphaBlendOp        = VK_BLEND_OP_ADD;
+    VkPipelineColorBlendStateCreateInfo colorBlending{};
+    colorBlending.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlending.attachmentCount = 1;
+    colorBlending.pAttachments    = &colorBlendAttachment;
+
+    std::array<VkDynamicState, 2> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+    dynamicState.pDynamicStates    = dynamicStates.data();
+
+    VkGraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount          = static_cast<uint32_t>(shaderStages.size());
+    pipelineInfo.pStages             = shaderStages.data();
+    pipelineInfo.pVertexInputState   = &vertexInputInfo;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState      = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState   = &multisampling;
+    pipelineInfo.pDepthStencilState  = &depthStencil;
+    pipelineInfo.pColorBlendState    = &colorBlending;
+    pipelineInfo.pDynamicState       = &dynamicState;
+    pipelineInfo.layout              = m_pipelineLayout;
+    pipelineInfo.renderPass          = m_renderer.getSceneRenderPass();
+    pipelineInfo.subpass             = 0;
+    VkResult result = vkCreateGraphicsPipelines(device, m_renderer.getPipelineCache(), 1, &pipelineInfo, nullptr, &m_drawPipeline);
+    vkDestroyShaderModule(device, vertShaderModule, nullptr);
+    vkDestroyShaderModule(device, fragShaderModule, nullptr);
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error("ParticleSystem::createDrawPipeline()::创建粒子绘制管线失败");
+    }
+}
+
+ParticleEmitterId ParticleSystem::createEmitter(const ParticleEmitter &emitter) {
+    for (ParticleEmitterId id = 0; id < MAX_PARTICLE_EMITTERS; id++) {
+        EmitterSlot &slot = m_emitters[id];
+        if (slot.active) continue;
+        slot         = EmitterSlot{};
+        slot.emitter = emitter;
+        slot.active  = true;
+        m_emitterCount++;
+        return id;
+    }
+    throw std::runtime_error("ParticleSystem::createEmitter()::发射器数量超过 MAX_PARTICLE_EMITTERS");
+}
+
+void ParticleSystem::setEmitter(ParticleEmitterId id, const ParticleEmitter &emitter) {
+    slotOf(id).emitter = emitter;
+}
+
+void ParticleSystem::destroyEmitter(ParticleEmitterId id) {
+    slotOf(id) = EmitterSlot{}; // 尚未发射的粒子一起丢弃
+    m_emitterCount--;
+}
+
+void ParticleSystem::burst(ParticleEmitterId id, uint32_t count) {
+    EmitterSlot &slot = slotOf(id);
+    slot.pending      = std::min(slot.pending + std::min(count, MAX_PARTICLES), MAX_PARTICLES);
+}
+
+void ParticleSystem::clear() {
+    for (EmitterSlot &slot : m_emitters) {
+        slot.accumulated = 0.0f;
+        slot.pending     = 0;
+    }
+    m_resetPending = true;
+    m_simulating   = false;
+}
+
+void ParticleSystem::update(float deltaTime) {
+    m_pendingDeltaTime = std::min(m_pendingDeltaTime + deltaTime, PARTICLE_MAX_DELTA_TIME);
+    for (EmitterSlot &slot : m_emitters) {
+        if (!slot.active || slot.emitter.rate <= 0.0f) continue;
+        slot.accumulated += slot.emitter.rate * deltaTime;
+        float whole = std::floor(slot.accumulated);
+        slot.accumulated -= whole;
+        uint32_t count = static_cast<uint32_t>(std::min(whole, static_cast<float>(MAX_PARTICLES)));
+        slot.pending   = std::min(slot.pending + count, MAX_PARTICLES);
+    }
+}
+
+bool ParticleSystem::isActive() const {
+    if (m_simulating && (m_stats.aliveParticles > 0 || m_unreadFrames > 0)) return true;
+    return std::any_of(m_emitters.begin(), m_emitters.end(),
+                       [](const EmitterSlot &slot) { return slot.pending > 0 || (slot.active && slot.emitter.rate > 0.0f); });
+}
+
+void ParticleSystem::recordSimulate(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+    // 该帧的 Fence 已经等待过，上一轮复制的计数已经对主机可见
+    if (m_frameRecorded[frameIndex]) {
+        const uint32_t *counts   = reinterpret_cast<const uint32_t *>(m_statsMapped + frameIndex * PARTICLE_STATS_STRIDE);
+        m_stats.aliveParticles   = counts[0];
+        m_stats.emittedParticles = counts[1];
+        m_stats.droppedParticles = counts[2];
+    } else {
+        m_stats = ParticleStats{};
+    }
+
+    // 本帧有新粒子的发射器按顺序写入该帧的区域，新粒子的编号在发射器之间连续；一帧最多发射 MAX_PARTICLES 个
+    GpuEmitter *emitters  = reinterpret_cast<GpuEmitter *>(m_emitterMapped + frameIndex * PARTICLE_EMITTER_STRIDE);
+    uint32_t emitterCount = 0;
+    uint32_t emitCount    = 0;
+    for (EmitterSlot &slot : m_emitters) {
+        uint32_t count = std::min(slot.pending, MAX_PARTICLES - emitCount);
+        slot.pending   = 0;
+        if (count == 0) continue;
+        const ParticleEmitter &source = slot.emitter;
+        GpuEmitter &emitter           = emitters[emitterCount++];
+        emitter.position              = glm::vec4(source.position, source.radius);
+        emitter.velocity              = glm::vec4(source.velocity, source.velocityJitter);
+        emitter.startColor            = source.startColor;
+        emitter.endColor              = source.endColor;
+        emitter.startSize             = source.startSize;
+        emitter.endSize               = source.endSize;
+        emitter.minLifetime           = source.minLifetime;
+        emitter.maxLifetime           = std::max(source.maxLifetime, source.minLifetime);
+        emitter.first                 = emitCount;
+        emitter.count                 = count;
+        emitCount += count;
+    }
+    m_frameRecorded[frameIndex] = false;
+    if (emitCount > 0) {
+        m_simulating   = true;
+        m_unreadFrames = MAX_FRAMES_IN_FLIGHT; // 统计延迟 MAX_FRAMES_IN_FLIGHT 帧读回，之前存活数量还不包含新粒子
+    } else if (m_unreadFrames > 0) {
+        m_unreadFrames--;
+    }
+    if (!m_simulating) {
+        m_pendingDeltaTime = 0.0f;
+        return; // 没有存活的粒子，不记录任何命令
+    }
+
+    // 上一帧的绘制和统计复制读完之后才能覆盖粒子和计数（读后写）
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+    VkBuffer counterBuffer = m_renderer.getResourceRegistry().getBuffer(m_counterBuffer);
+    if (m_resetPending) {
+        vkCmdFillBuffer(commandBuffer, counterBuffer, 0, PARTICLE_COUNTER_SIZE, 0);
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+        m_resetPending = false;
+    }
+
+    const glm::mat4 &view = m_meshRenderer.getView();
+    ParticlePushConstants constants{};
+    constants.viewProjection = m_meshRenderer.getViewProjection();
+    constants.cameraRight    = glm::vec4(view[0][0], view[1][0], view[2][0], 0.0f);
+    constants.cameraUp       = glm::vec4(view[0][1], view[1][1], view[2][1], 0.0f);
+    constants.gravity        = glm::vec4(m_settings.gravity, m_settings.drag);
+    constants.deltaTime      = m_pendingDeltaTime;
+    constants.emitterCount   = emitterCount;
+    constants.emitCount      = emitCount;
+    constants.seed           = m_seed++;
+    uint32_t dynamicOffset   = static_cast<uint32_t>(frameIndex * PARTICLE_EMITTER_STRIDE);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1, &m_descriptorSets[m_source], 1, &dynamicOffset);
+    vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(constants), &constants);
+
+    // 每一步都读取上一步写入的粒子或计数，模拟和压缩的工作组数量由发射着色器写入
+    auto computeBarrier = [&](VkPipelineStageFlags dstStages, VkAccessFlags dstAccess) {
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = dstAccess;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, dstStages, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+    };
+    const VkPipelineStageFlags computeAndIndirect = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+    const VkAccessFlags shaderReadWrite           = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+    // 发射：至少一个工作组，第一个线程总要写入本帧的调度参数
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_emitPipeline);
+    vkCmdDispatch(commandBuffer, std::max((emitCount + PARTICLE_GROUP_SIZE - 1) / PARTICLE_GROUP_SIZE, 1u), 1, 1);
+    computeBarrier(computeAndIndirect, shaderReadWrite | VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+
+    // 模拟：每个工作组统计自己的存活数量
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_simulatePipeline);
+    vkCmdDispatchIndirect(commandBuffer, counterBuffer, 0);
+    computeBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, shaderReadWrite);
+
+    // 扫描：一个工作组对所有工作组计数做前缀和，写入间接绘制参数
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_scanPipeline);
+    vkCmdDispatch(commandBuffer, 1, 1, 1);
+    computeBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, shaderReadWrite);
+
+    // 压缩：存活粒子按原顺序写入另一个缓冲区
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_compactPipeline);
+    vkCmdDispatchIndirect(commandBuffer, counterBuffer, 0);
+    computeBarrier(VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                   VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT);
+
+    // 计数复制到该帧的统计区域，只有三个整数，不需要读回整个粒子缓冲区
+    VkBufferCopy statsCopy{PARTICLE_STATS_OFFSET, frameIndex * PARTICLE_STATS_STRIDE, PARTICLE_STATS_SIZE};
+    vkCmdCopyBuffer(commandBuffer, counterBuffer, m_renderer.getResourceRegistry().getBuffer(m_statsBuffer), 1, &statsCopy);
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    m_frameRecorded[frameIndex] = true;
+    m_drawSet                   = m_source;
+    m_source ^= 1;
+    m_pendingDeltaTime = 0.0f;
+}
+
+void ParticleSystem::recordDraws(VkCommandBuffer commandBuffer, VkExtent2D extent) {
+    if (!m_simulating) return;
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_drawPipeline);
+    uint32_t dynamicOffset = 0; // 顶点着色器不读取发射器
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1, &m_descriptorSets[m_drawSet], 1, &dynamicOffset);
+
+    VkViewport viewport{0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f};
+    VkRect2D scissor{{0, 0}, extent};
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    const glm::mat4 &view = m_meshRenderer.getView();
+    ParticlePushConstants constants{};
+    constants.viewProjection = m_meshRenderer.getViewProjection();
+    constants.cameraRight    = glm::vec4(view[0][0], view[1][0], view[2][0], 0.0f);
+    constants.cameraUp       = glm::vec4(view[0][1], view[1][1], view[2][1], 0.0f);
+    vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(constants), &constants);
+
+    // 实例数量由扫描着色器写入，CPU 不知道存活的粒子数量
+    vkCmdDrawIndirect(commandBuffer, m_renderer.getResourceRegistry().getBuffer(m_counterBuffer), 3 * sizeof(uint32_t), 1, sizeof(VkDrawIndirectCommand));
+}
+
+ParticleSystem::EmitterSlot &ParticleSystem::slotOf(ParticleEmitterId id) {
+    if (id >= MAX_PARTICLE_EMITTERS || !m_emitters[id].active) {
+        throw std::runtime_error("ParticleSystem::slotOf()::无效的粒子发射器");
+    }
+    return m_emitters[id];
+}
+
+} // namespace engine::render
@@ -0,0 +1,156 @@
+#pragma once
+#include "RenderConstants.hpp"
+#include "ResourceRegistry.hpp"
+
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace engine::render {
+class VulkanRenderer;
+class MeshRenderer;
+
+using ParticleEmitterId = uint32_t;
+
+const ParticleEmitterId INVALID_PARTICLE_EMITTER = UINT32_MAX;
+
+#pragma region Constants
+const uint32_t MAX_PARTICLES             = 1024 * 1024; // 同时存活的粒子数量上限
+const uint32_t MAX_PARTICLE_EMITTERS     = 64;          // 发射器数量上限
+const uint32_t PARTICLE_GROUP_SIZE       = 256;         // 计算着色器工作组大小，与着色器中的 local_size 一致
+const VkDeviceSize PARTICLE_STATS_STRIDE = 256;         // 每帧统计区域的间隔，满足 minStorageBufferOffsetAlignment 的上限
+#pragma endregion
+
+/**
+ * @struct ParticleEmitter
+ * @brief 发射器参数，新粒子在发射时从这里取初始状态，之后与发射器无关
+ */
+struct ParticleEmitter {
+    glm::vec3 position{0.0f};             // 发射中心
+    float radius         = 0.0f;          // 在以 position 为中心的球内随机出生
+    glm::vec3 velocity{0.0f, 1.0f, 0.0f}; // 初速度
+    float velocityJitter = 0.5f;          // 初速度叠加的随机扰动半径
+    glm::vec4 startColor{1.0f};           // 出生时的颜色，线性插值到 endColor
+    glm::vec4 endColor{1.0f, 1.0f, 1.0f, 0.0f};
+    float startSize      = 0.1f;          // 出生时的公告板边长（世界单位），线性插值到 endSize
+    float endSize        = 0.0f;
+    float minLifetime    = 1.0f;          // 寿命在 [minLifetime, maxLifetime] 内随机（秒）
+    float maxLifetime    = 2.0f;
+    float rate           = 1000.0f;       // 每秒发射的粒子数量，为 0 时只通过 burst() 发射
+};
+
+/**
+ * @struct ParticleSettings
+ * @brief 所有粒子共用的模拟参数
+ */
+struct ParticleSettings {
+    glm::vec3 gravity{0.0f, -9.8f, 0.0f}; // 加速度
+    float drag = 0.1f;                    // 每秒速度衰减的比例
+};
+
+/**
+ * @struct ParticleStats
+ * @brief 粒子统计，延迟 MAX_FRAMES_IN_FLIGHT 帧读回
+ */
+struct ParticleStats {
+    uint32_t aliveParticles   = 0; // 压缩之后存活的粒子数量，即绘制的实例数量
+    uint32_t emittedParticles = 0; // 本帧实际发射的粒子数量
+    uint32_t droppedParticles = 0; // 超出 MAX_PARTICLES 而未发射的粒子数量
+};
+
+/**
+ * @class ParticleSystem
+ * @brief 发射、模拟、压缩和生成绘制参数全部在计算着色器中完成的粒子系统
+ *
+ * 粒子存放在两个设备本地缓冲区中交替读写，存活的粒子总是连续排列在缓冲区开头，数量只保存在 GPU 上。
+ * 每帧依次执行：发射（追加到存活粒子之后，并写入模拟的间接调度参数）、模拟（积分并统计每个工作组的存活数量）、
+ * 扫描（对工作组计数做前缀和，写入间接绘制参数）、压缩（按前缀和把存活粒子按原顺序写入另一个缓冲区）。
+ * 绘制时每个粒子是一个实例化的公告板四边形，加法混合，不写深度。
+ * CPU 每帧只上传本帧有发射的发射器参数，工作量与粒子数量无关。
+ */
+class ParticleSystem final {
+public:
+    ParticleSystem(VulkanRenderer &renderer, MeshRenderer &meshRenderer);
+    ~ParticleSystem();
+
+    ParticleSystem(const ParticleSystem &)            = delete;
+    ParticleSystem &operator=(const ParticleSystem &) = delete;
+    ParticleSystem(ParticleSystem &&)                 = delete;
+    ParticleSystem &operator=(ParticleSystem &&)      = delete;
+
+    void init();
+    void cleanup();
+
+    ParticleEmitterId createEmitter(const ParticleEmitter &emitter);
+    void setEmitter(ParticleEmitterId id, const ParticleEmitter &emitter); // 只影响之后发射的粒子
+    void destroyEmitter(ParticleEmitterId id);                              // 已发射的粒子继续存活到寿命结束
+    void burst(ParticleEmitterId id, uint32_t count);                       // 下一帧额外发射 count 个粒子
+    void clear();                                                           // 下一帧删除所有存活的粒子
+    void setSettings(const ParticleSettings &settings) { m_settings = settings; }
+
+    void update(float deltaTime); // 每次游戏更新调用：累计模拟时间和按发射速率产生的粒子数量
+
+    void recordSimulate(VkCommandBuffer commandBuffer, uint32_t frameIndex); // 在渲染通道之外调用：读取该帧上一轮的统计，发射、模拟、压缩
+    void recordDraws(VkCommandBuffer commandBuffer, VkExtent2D extent);      // 在渲染通道之内调用，相机使用网格渲染器的设置
+
+    bool isActive() const; // 还有粒子存活或等待发射，粒子在 GPU 上运动，画面每帧都会变化
+    uint32_t getEmitterCount() const { return m_emitterCount; }
+    const ParticleStats &getStats() const { return m_stats; } // 最近一次完成帧的统计
+
+private:
+    struct EmitterSlot {
+        ParticleEmitter emitter;
+        bool active       = false;
+        float accumulated = 0.0f; // 按发射速率累计的小数部分
+        uint32_t pending  = 0;    // 下一帧要发射的粒子数量
+    };
+
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer;
+    MeshRenderer &m_meshRenderer;
+
+    VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool m_descriptorPool           = VK_NULL_HANDLE;
+    std::array<VkDescriptorSet, 2> m_descriptorSets{};            // 两个粒子缓冲区交替作为读取端和写入端
+    VkPipelineLayout m_pipelineLayout           = VK_NULL_HANDLE;
+    VkPipeline m_emitPipeline                   = VK_NULL_HANDLE; // 追加新粒子，写入模拟的间接调度参数
+    VkPipeline m_simulatePipeline               = VK_NULL_HANDLE; // 积分并统计每个工作组的存活数量
+    VkPipeline m_scanPipeline                   = VK_NULL_HANDLE; // 工作组计数的前缀和，写入间接绘制参数
+    VkPipeline m_compactPipeline                = VK_NULL_HANDLE; // 把存活粒子写入另一个缓冲区
+    VkPipeline m_drawPipeline                   = VK_NULL_HANDLE; // 实例化公告板
+
+    std::array<BufferHandle, 2> m_particleBuffers{}; // 粒子状态
+    BufferHandle m_counterBuffer;                    // 间接调度参数 + 间接绘制参数 + 粒子计数
+    BufferHandle m_blockBuffer;                      // 每个工作组的存活数量，前缀和后为写入位置
+    BufferHandle m_emitterBuffer;                    // 主机可见的发射器参数，每帧一个区域
+    char *m_emitterMapped     = nullptr;
+    BufferHandle m_statsBuffer;                      // 主机可见的统计缓冲区，每帧一个区域
+    const char *m_statsMapped = nullptr;
+
+    std::array<EmitterSlot, MAX_PARTICLE_EMITTERS> m_emitters{};
+    uint32_t m_emitterCount  = 0;                             // 活动的发射器数量
+    ParticleSettings m_settings;                              // 模拟参数
+    float m_pendingDeltaTime = 0.0f;                          // 上次模拟之后累计的时间
+    uint32_t m_seed          = 0;                             // 每帧递增的随机数种子
+    uint32_t m_source        = 0;                             // 本帧读取的粒子缓冲区，压缩后写入另一个
+    uint32_t m_drawSet       = 0;                             // 绘制使用的描述符集，其写入端保存压缩后的粒子
+    bool m_resetPending      = true;                          // 下一帧是否先清零粒子计数
+    bool m_simulating        = false;                         // 是否发射过粒子，之前不需要记录任何计算
+    uint32_t m_unreadFrames  = 0;                             // 最近一次发射之后，统计尚未反映该次发射的帧数
+    std::array<bool, MAX_FRAMES_IN_FLIGHT> m_frameRecorded{}; // 每帧上一轮是否复制了统计
+    ParticleStats m_stats;                                    // 最近一次完成帧的统计
+#pragma endregion
+
+    void createBuffers();
+    void updateDescriptorSets();
+    VkPipeline createComputePipeline(const std::string &filename);
+    void createDrawPipeline();
+    VkShaderModule loadShader(const std::string &filename);
+    EmitterSlot &slotOf(ParticleEmitterId id); // 发射器无效时抛出异常
+};
+
+} // namespace engine::render
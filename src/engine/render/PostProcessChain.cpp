@@ -0,0 +1,371 @@
+#include "PostProcessChain.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace engine::render {
+
+namespace {
+// 与 postprocess_pixel.comp.glsl 中的 push_constant 布局一致（std430）
+struct PixelPushConstants {
+    uint32_t ops[MAX_FUSED_PIXEL_OPS];
+    float params[MAX_FUSED_PIXEL_OPS][4];
+    uint32_t opCount;
+};
+
+// 与 postprocess_blur.comp.glsl 中的 push_constant 布局一致（std430）
+struct BlurPushConstants {
+    int32_t direction[2];
+    int32_t radius;
+    float sigma;
+};
+
+const char *stageName(PostProcessStageType type) {
+    switch (type) {
+    case PostProcessStageType::Exposure: return "Exposure";
+    case PostProcessStageType::ToneMap: return "ToneMap";
+    case PostProcessStageType::Vignette: return "Vignette";
+    case PostProcessStageType::Gamma: return "Gamma";
+    case PostProcessStageType::GaussianBlur: return "GaussianBlur";
+    default: return "Unknown";
+    }
+}
+} // namespace
+
+PostProcessChain::PostProcessChain(VulkanRenderer &renderer) : m_renderer(renderer) {
+    // 默认阶段：曝光 + ACES 色调映射，交换链为 sRGB 格式，blit 时自动完成伽马编码
+    m_stages = {
+        {PostProcessStageType::Exposure, {1.0f, 0.0f, 0.0f, 0.0f}},
+        {PostProcessStageType::ToneMap, {}},
+    };
+    compilePasses();
+}
+
+PostProcessChain::~PostProcessChain() = default;
+
+void PostProcessChain::init() {
+    VkDevice device = m_renderer.getDevice();
+
+    // 描述符集布局：binding 0 为输入存储图像，binding 1 为输出存储图像
+    std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+    for (uint32_t i = 0; i < bindings.size(); i++) {
+        bindings[i].binding         = i;
+        bindings[i].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags      = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings    = bindings.data();
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &m_descriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("PostProcessChain::init()::创建描述符集布局失败");
+    }
+
+    VkDescriptorPoolSize poolSize{};
+    poolSize.type            = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    poolSize.descriptorCount = MAX_POST_PROCESS_TARGET_SETS * 2 * 2; // 每组目标 2 个描述符集，每个集 2 个存储图像
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags         = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT; // 窗口关闭时单独释放
+    poolInfo.maxSets       = MAX_POST_PROCESS_TARGET_SETS * 2;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes    = &poolSize;
+    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &m_descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("PostProcessChain::init()::创建描述符池失败");
+    }
+
+    VkPushConstantRange pixelRange{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PixelPushConstants)};
+    VkPushConstantRange blurRange{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(BlurPushConstants)};
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount         = 1;
+    pipelineLayoutInfo.pSetLayouts            = &m_descriptorSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges    = &pixelRange;
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &m_pixelPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("PostProcessChain::init()::创建逐像素管线布局失败");
+    }
+    pipelineLayoutInfo.pPushConstantRanges = &blurRange;
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &m_blurPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("PostProcessChain::init()::创建模糊管线布局失败");
+    }
+    m_pixelPipeline = createComputePipeline("assets/shaders/postprocess_pixel.comp.spv", m_pixelPipelineLayout);
+    m_blurPipeline  = createComputePipeline("assets/shaders/postprocess_blur.comp.spv", m_blurPipelineLayout);
+
+    // 图形队列族支持时间戳时才创建查询池
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(m_renderer.getPhysicalDevice(), &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(m_renderer.getPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(m_renderer.getPhysicalDevice(), &properties);
+    m_timestampsSupported = queueFamilies[m_renderer.getQueueFamilyIndices().graphicsFamily.value()].timestampValidBits > 0 &&
+                            properties.limits.timestampPeriod > 0.0f;
+    m_timestampPeriod     = properties.limits.timestampPeriod;
+    if (m_timestampsSupported) {
+        VkQueryPoolCreateInfo queryPoolInfo{};
+        queryPoolInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolInfo.queryCount = MAX_TIMESTAMP_QUERIES * MAX_FRAMES_IN_FLIGHT;
+        if (vkCreateQueryPool(device, &queryPoolInfo, nullptr, &m_timestampPool) != VK_SUCCESS) {
+            throw std::runtime_error("PostProcessChain::init()::创建时间戳查询池失败");
+        }
+    } else {
+        spdlog::warn("PostProcessChain::init()::图形队列不支持时间戳，无法统计后处理通道耗时");
+    }
+    spdlog::trace("PostProcessChain::init()::后处理链初始化成功, 调度次数: {}", m_passes.size());
+}
+
+void PostProcessChain::cleanup() {
+    VkDevice device = m_renderer.getDevice();
+    if (m_timestampPool != VK_NULL_HANDLE) vkDestroyQueryPool(device, m_timestampPool, nullptr);
+    vkDestroyPipeline(device, m_blurPipeline, nullptr);
+    vkDestroyPipeline(device, m_pixelPipeline, nullptr);
+    vkDestroyPipelineLayout(device, m_blurPipelineLayout, nullptr);
+    vkDestroyPipelineLayout(device, m_pixelPipelineLayout, nullptr);
+    vkDestroyDescriptorPool(device, m_descriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(device, m_descriptorSetLayout, nullptr);
+    m_timestampPool = VK_NULL_HANDLE;
+}
+
+void PostProcessChain::setStages(const std::vector<PostProcessStage> &stages) {
+    m_stages = stages;
+    compilePasses();
+}
+
+void PostProcessChain::setFusionEnabled(bool enabled) {
+    m_fusionEnabled = enabled;
+    compilePasses();
+}
+
+void PostProcessChain::compilePasses() {
+    m_passes.clear();
+    for (const auto &stage : m_stages) {
+        if (!stage.enabled) continue;
+        if (stage.isPerPixel()) {
+            // 与上一个逐像素调度融合，避免中间结果写回显存
+            bool canFuse = m_fusionEnabled && !m_passes.empty() && !m_passes.back().blur && m_passes.back().opCount < MAX_FUSED_PIXEL_OPS;
+            if (!canFuse) {
+                m_passes.emplace_back();
+            } else {
+                m_passes.back().name += "+";
+            }
+            Pass &pass = m_passes.back();
+            pass.name += stageName(stage.type);
+            pass.ops[pass.opCount]    = static_cast<uint32_t>(stage.type);
+            pass.params[pass.opCount] = stage.params;
+            pass.opCount++;
+        } else {
+            // 可分离模糊拆成水平和垂直两次调度
+            for (int axis = 0; axis < 2; axis++) {
+                Pass pass;
+                pass.name         = std::string(stageName(stage.type)) + (axis == 0 ? "H" : "V");
+                pass.blur         = true;
+                pass.direction[0] = axis == 0 ? 1 : 0;
+                pass.direction[1] = axis == 0 ? 0 : 1;
+                pass.radius       = std::clamp(static_cast<int32_t>(stage.params[0]), 0, 16);
+                pass.sigma        = std::max(stage.params[1], 0.01f);
+                m_passes.push_back(pass);
+            }
+        }
+    }
+
+    // 耗时表只在编译时重建，每帧只更新耗时，记录和统计路径不分配内存
+    m_passTimings.clear();
+    for (const Pass &pass : m_passes) {
+        m_passTimings.push_back({pass.name, 0.0});
+    }
+    m_passTimings.push_back({"Blit", 0.0});
+    m_passGeneration++;
+}
+
+VkPipeline PostProcessChain::createComputePipeline(const std::string &filename, VkPipelineLayout layout) {
+    auto shaderCode             = VulkanRenderer::readFile(filename);
+    VkShaderModule shaderModule = m_renderer.createShaderModule(shaderCode);
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType        = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = shaderModule;
+    pipelineInfo.stage.pName  = "main";
+    pipelineInfo.layout       = layout;
+    VkPipeline pipeline;
+    if (vkCreateComputePipelines(m_renderer.getDevice(), m_renderer.getPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+        throw std::runtime_error("PostProcessChain::createComputePipeline()::创建计算管线失败: " + filename);
+    }
+    vkDestroyShaderModule(m_renderer.getDevice(), shaderModule, nullptr);
+    return pipeline;
+}
+
+void PostProcessChain::createTargets(PostProcessTargets &targets, VkExtent2D extent) {
+    targets.extent = extent;
+    for (size_t i = 0; i < targets.images.size(); i++) {
+        m_renderer.createImage(extent.width, extent.height, HDR_COLOR_FORMAT,
+                               VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                               MemoryUsage::GpuOnly, targets.images[i], targets.memories[i]);
+        targets.views[i] = m_renderer.createImageView(targets.images[i], HDR_COLOR_FORMAT, VK_IMAGE_ASPECT_COLOR_BIT);
+    }
+    if (targets.descriptorSets[0] == VK_NULL_HANDLE) {
+        std::array<VkDescriptorSetLayout, 2> layouts = {m_descriptorSetLayout, m_descriptorSetLayout};
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool     = m_descriptorPool;
+        allocInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+        allocInfo.pSetLayouts        = layouts.data();
+        if (vkAllocateDescriptorSets(m_renderer.getDevice(), &allocInfo, targets.descriptorSets.data()) != VK_SUCCESS) {
+            throw std::runtime_error("PostProcessChain::createTargets()::分配描述符集失败");
+        }
+    }
+    updateDescriptorSets(targets);
+}
+
+void PostProcessChain::destroyTargets(PostProcessTargets &targets) {
+    VkDevice device = m_renderer.getDevice();
+    for (size_t i = 0; i < targets.images.size(); i++) {
+        m_renderer.releaseImageView(targets.views[i]);
+        vkDestroyImage(device, targets.images[i], nullptr);
+        m_renderer.freeMemory(targets.memories[i]);
+        targets.views[i]    = VK_NULL_HANDLE;
+        targets.images[i]   = VK_NULL_HANDLE;
+        targets.memories[i] = VK_NULL_HANDLE;
+    }
+    // 描述符集保留下来，交换链重建时直接更新指向新图像；窗口销毁时才释放
+}
+
+void PostProcessChain::freeTargets(PostProcessTargets &targets) {
+    destroyTargets(targets);
+    if (targets.descriptorSets[0] != VK_NULL_HANDLE) {
+        vkFreeDescriptorSets(m_renderer.getDevice(), m_descriptorPool, static_cast<uint32_t>(targets.descriptorSets.size()), targets.descriptorSets.data());
+        targets.descriptorSets = {};
+    }
+}
+
+void PostProcessChain::updateDescriptorSets(const PostProcessTargets &targets) {
+    std::array<VkDescriptorImageInfo, 2> imageInfos{};
+    for (size_t i = 0; i < imageInfos.size(); i++) {
+        imageInfos[i].imageView   = targets.views[i];
+        imageInfos[i].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+    }
+    std::array<VkWriteDescriptorSet, 4> writes{};
+    for (uint32_t set = 0; set < 2; set++) {
+        for (uint32_t binding = 0; binding < 2; binding++) {
+            VkWriteDescriptorSet &write = writes[set * 2 + binding];
+            write.sType                 = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet                = targets.descriptorSets[set];
+            write.dstBinding            = binding;
+            write.descriptorCount       = 1;
+            write.descriptorType        = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            write.pImageInfo            = &imageInfos[(set + binding) % 2]; // 集 0：读 0 写 1；集 1：读 1 写 0
+        }
+    }
+    vkUpdateDescriptorSets(m_renderer.getDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+}
+
+void PostProcessChain::beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+    m_frameIndex = frameIndex;
+    if (!m_timestampsSupported) return;
+    collectTimings(frameIndex); // 该帧的 Fence 已经等待过，上一轮写入的时间戳已经可用
+    vkCmdResetQueryPool(commandBuffer, m_timestampPool, frameIndex * MAX_TIMESTAMP_QUERIES, MAX_TIMESTAMP_QUERIES);
+}
+
+void PostProcessChain::writeTimestamp(VkCommandBuffer commandBuffer, uint32_t label) {
+    if (!m_timestampsSupported) return;
+    uint32_t &count = m_queryCounts[m_frameIndex];
+    if (count >= MAX_TIMESTAMP_QUERIES) return;
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_timestampPool, m_frameIndex * MAX_TIMESTAMP_QUERIES + count);
+    m_queryLabels[m_frameIndex][count] = label;
+    m_queryGenerations[m_frameIndex]   = m_passGeneration;
+    count++;
+}
+
+void PostProcessChain::collectTimings(uint32_t frameIndex) {
+    uint32_t count = m_queryCounts[frameIndex];
+    m_queryCounts[frameIndex] = 0;
+    if (count == 0) return;
+    if (m_queryGenerations[frameIndex] != m_passGeneration) return; // 记录后调度列表已重新编译，下标不再对应
+    VkResult result = vkGetQueryPoolResults(m_renderer.getDevice(), m_timestampPool, frameIndex * MAX_TIMESTAMP_QUERIES, count,
+                                            count * sizeof(uint64_t), m_timestampResults.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+    if (result != VK_SUCCESS) return;
+
+    // 多个窗口的同名通道耗时累加
+    for (auto &timing : m_passTimings) {
+        timing.milliseconds = 0.0;
+    }
+    const auto &labels = m_queryLabels[frameIndex];
+    for (uint32_t i = 1; i < count; i++) {
+        if (labels[i] == TIMESTAMP_START_LABEL || labels[i] >= m_passTimings.size()) continue;
+        m_passTimings[labels[i]].milliseconds += static_cast<double>(m_timestampResults[i] - m_timestampResults[i - 1]) * m_timestampPeriod / 1000000.0;
+    }
+}
+
+void PostProcessChain::record(VkCommandBuffer commandBuffer, const PostProcessTargets &targets, VkImage swapChainImage, VkExtent2D swapChainExtent) {
+    writeTimestamp(commandBuffer, TIMESTAMP_START_LABEL);
+
+    // 场景颜色写入完成后才能被计算着色器读取；images[1] 上一帧可能仍被 blit 读取
+    VulkanRenderer::recordImageBarrier(commandBuffer, targets.images[0], VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+                                       VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    VulkanRenderer::recordImageBarrier(commandBuffer, targets.images[1], VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                                       VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+
+    uint32_t groupCountX = (targets.extent.width + POST_PROCESS_TILE_SIZE - 1) / POST_PROCESS_TILE_SIZE;
+    uint32_t groupCountY = (targets.extent.height + POST_PROCESS_TILE_SIZE - 1) / POST_PROCESS_TILE_SIZE;
+    uint32_t current     = 0; // 当前结果所在的图像
+    for (uint32_t passIndex = 0; passIndex < m_passes.size(); passIndex++) {
+        const Pass &pass = m_passes[passIndex];
+        if (pass.blur) {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_blurPipeline);
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_blurPipelineLayout, 0, 1, &targets.descriptorSets[current], 0, nullptr);
+            BlurPushConstants constants{{pass.direction[0], pass.direction[1]}, pass.radius, pass.sigma};
+            vkCmdPushConstants(commandBuffer, m_blurPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+        } else {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pixelPipeline);
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pixelPipelineLayout, 0, 1, &targets.descriptorSets[current], 0, nullptr);
+            PixelPushConstants constants{};
+            for (uint32_t i = 0; i < pass.opCount; i++) {
+                constants.ops[i] = pass.ops[i];
+                std::copy(pass.params[i].begin(), pass.params[i].end(), constants.params[i]);
+            }
+            constants.opCount = pass.opCount;
+            vkCmdPushConstants(commandBuffer, m_pixelPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+        }
+        vkCmdDispatch(commandBuffer, groupCountX, groupCountY, 1);
+        writeTimestamp(commandBuffer, passIndex);
+
+        // 本次输出成为下一次输入，下一次输出覆盖上一次输入（写后读 + 读后写）
+        current = 1 - current;
+        VulkanRenderer::recordImageBarrier(commandBuffer, targets.images[current], VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+                                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+        VulkanRenderer::recordImageBarrier(commandBuffer, targets.images[1 - current], VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+                                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+                                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+    }
+
+    // 结果 blit 到交换链图像，blit 会完成 float -> sRGB 的格式转换
+    VulkanRenderer::recordImageBarrier(commandBuffer, targets.images[current], VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                                       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+    VulkanRenderer::recordImageBarrier(commandBuffer, swapChainImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                       VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                                       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+    VkImageBlit blit{};
+    blit.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    blit.srcOffsets[1]  = {static_cast<int32_t>(targets.extent.width), static_cast<int32_t>(targets.extent.height), 1};
+    blit.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    blit.dstOffsets[1]  = {static_cast<int32_t>(swapChainExtent.width), static_cast<int32_t>(swapChainExtent.height), 1};
+    vkCmdBlitImage(commandBuffer, targets.images[current], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, swapChainImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+    writeTimestamp(commandBuffer, static_cast<uint32_t>(m_passes.size()));
+
+    VulkanRenderer::recordImageBarrier(commandBuffer, swapChainImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                                       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                                       VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0);
+}
+
+} // namespace engine::render
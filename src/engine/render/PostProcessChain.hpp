@@ -0,0 +1,160 @@
+#pragma once
+#include "RenderConstants.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace engine::render {
+class VulkanRenderer;
+
+#pragma region Constants
+const VkFormat HDR_COLOR_FORMAT             = VK_FORMAT_R16G16B16A16_SFLOAT; // 离屏 HDR 颜色目标格式
+const uint32_t POST_PROCESS_TILE_SIZE       = 16;                            // 计算着色器工作组尺寸，与着色器中的 local_size 一致
+const uint32_t MAX_FUSED_PIXEL_OPS          = 4;                             // 单次调度最多融合的逐像素操作数量
+const uint32_t MAX_POST_PROCESS_TARGET_SETS = 32;                            // 描述符池最多支持的目标数量（每个窗口一组）
+const uint32_t MAX_TIMESTAMP_QUERIES        = 64;                            // 每帧最多的时间戳查询数量
+const uint32_t TIMESTAMP_START_LABEL        = UINT32_MAX;                    // 时间戳起始标记，不对应任何通道
+#pragma endregion
+
+/**
+ * @enum PostProcessStageType
+ * @brief 后处理阶段类型，逐像素阶段可以融合到同一次调度中
+ */
+enum class PostProcessStageType : uint32_t {
+    Exposure     = 0, // 曝光，params[0] 为曝光倍数
+    ToneMap      = 1, // ACES 色调映射
+    Vignette     = 2, // 暗角，params[0] 强度，params[1]/params[2] 为内外半径
+    Gamma        = 3, // 伽马校正，params[0] 为指数
+    GaussianBlur = 4, // 可分离高斯模糊（邻域阶段，不能融合），params[0] 半径，params[1] 标准差
+};
+
+/**
+ * @struct PostProcessStage
+ * @brief 后处理链中的一个阶段
+ */
+struct PostProcessStage {
+    PostProcessStageType type;
+    std::array<float, 4> params{};
+    bool enabled = true;
+
+    bool isPerPixel() const { return type != PostProcessStageType::GaussianBlur; }
+};
+
+/**
+ * @struct PostProcessTargets
+ * @brief 每个窗口的离屏目标：两张 HDR 图像在后处理阶段之间来回交替（ping-pong）
+ *
+ * images[0] 同时作为场景渲染的颜色附件，descriptorSets[0] 读 0 写 1，descriptorSets[1] 读 1 写 0。
+ */
+struct PostProcessTargets {
+    VkExtent2D extent{};
+    std::array<VkImage, 2> images{};
+    std::array<VkDeviceMemory, 2> memories{};
+    std::array<VkImageView, 2> views{};
+    std::array<VkDescriptorSet, 2> descriptorSets{};
+};
+
+/**
+ * @struct PassTiming
+ * @brief 单个 GPU 通道的耗时
+ */
+struct PassTiming {
+    std::string name;
+    double milliseconds = 0.0;
+};
+
+/**
+ * @class PostProcessChain
+ * @brief 基于计算着色器的后处理链
+ *
+ * 场景渲染到离屏 HDR 目标后，按顺序执行各个阶段，最后把结果 blit 到交换链图像。
+ * 相邻的逐像素阶段在启用融合时合并为一次调度，减少显存带宽；模糊阶段使用共享内存分块。
+ * 每个通道前后写入时间戳，帧完成后可以通过 getPassTimings() 读取 GPU 耗时。
+ */
+class PostProcessChain final {
+public:
+    PostProcessChain(VulkanRenderer &renderer);
+    ~PostProcessChain();
+
+    PostProcessChain(const PostProcessChain &)            = delete;
+    PostProcessChain &operator=(const PostProcessChain &) = delete;
+    PostProcessChain(PostProcessChain &&)                 = delete;
+    PostProcessChain &operator=(PostProcessChain &&)      = delete;
+
+    void init();
+    void cleanup();
+
+    void setStages(const std::vector<PostProcessStage> &stages);
+    const std::vector<PostProcessStage> &getStages() const { return m_stages; }
+    void setFusionEnabled(bool enabled);
+    bool isFusionEnabled() const { return m_fusionEnabled; }
+
+    void createTargets(PostProcessTargets &targets, VkExtent2D extent); // 创建（或重建）离屏图像并更新描述符集
+    void destroyTargets(PostProcessTargets &targets);                   // 销毁离屏图像，保留描述符集供重建使用
+    void freeTargets(PostProcessTargets &targets);                      // 销毁离屏图像并释放描述符集
+
+    void beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex); // 读取该帧上一轮的时间戳并重置查询
+    /**
+     * @brief 记录后处理链并把结果 blit 到交换链图像
+     * @note 调用前 images[0] 必须处于 VK_IMAGE_LAYOUT_GENERAL（场景渲染通道的最终布局）
+     */
+    void record(VkCommandBuffer commandBuffer, const PostProcessTargets &targets, VkImage swapChainImage, VkExtent2D swapChainExtent);
+
+    const std::vector<PassTiming> &getPassTimings() const { return m_passTimings; } // 最近一次完成帧的各通道 GPU 耗时
+    size_t getDispatchCount() const { return m_passes.size(); }                     // 当前阶段配置每帧的调度次数
+
+private:
+    /**
+     * @struct Pass
+     * @brief 由阶段编译出的一次计算调度
+     */
+    struct Pass {
+        std::string name;
+        bool blur = false;
+        std::array<uint32_t, MAX_FUSED_PIXEL_OPS> ops{};
+        std::array<std::array<float, 4>, MAX_FUSED_PIXEL_OPS> params{};
+        uint32_t opCount = 0;
+        int32_t direction[2]{};
+        int32_t radius = 0;
+        float sigma    = 1.0f;
+    };
+
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer;
+
+    std::vector<PostProcessStage> m_stages; // 用户配置的阶段
+    std::vector<Pass> m_passes;             // 编译后的调度列表
+    bool m_fusionEnabled = true;            // 是否融合相邻的逐像素阶段
+
+    VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE; // 输入/输出存储图像
+    VkDescriptorPool m_descriptorPool           = VK_NULL_HANDLE;
+    VkPipelineLayout m_pixelPipelineLayout      = VK_NULL_HANDLE;
+    VkPipelineLayout m_blurPipelineLayout       = VK_NULL_HANDLE;
+    VkPipeline m_pixelPipeline                  = VK_NULL_HANDLE; // 逐像素（可融合）管线
+    VkPipeline m_blurPipeline                   = VK_NULL_HANDLE; // 共享内存分块模糊管线
+
+    VkQueryPool m_timestampPool = VK_NULL_HANDLE; // 时间戳查询池，每帧 MAX_TIMESTAMP_QUERIES 个
+    bool m_timestampsSupported  = false;          // 图形队列是否支持时间戳
+    float m_timestampPeriod     = 1.0f;           // 每个时间戳计数的纳秒数
+    uint32_t m_frameIndex       = 0;              // 当前记录的帧
+
+    std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> m_queryCounts{};                                    // 每帧已写入的时间戳数量
+    std::array<std::array<uint32_t, MAX_TIMESTAMP_QUERIES>, MAX_FRAMES_IN_FLIGHT> m_queryLabels{}; // 每帧时间戳对应的 m_passTimings 下标
+    std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> m_queryGenerations{};                               // 每帧记录时的调度列表版本
+    std::array<uint64_t, MAX_TIMESTAMP_QUERIES> m_timestampResults{};                              // 读回的时间戳，避免每帧分配
+    std::vector<PassTiming> m_passTimings;                                                         // 最近一次完成帧的通道耗时，按调度顺序，最后一项为 Blit
+    uint32_t m_passGeneration = 0;                                                                 // 调度列表版本，重新编译后旧帧的下标失效
+#pragma endregion
+
+    void compilePasses();
+    VkPipeline createComputePipeline(const std::string &filename, VkPipelineLayout layout);
+    void updateDescriptorSets(const PostProcessTargets &targets);
+    void writeTimestamp(VkCommandBuffer commandBuffer, uint32_t label);
+    void collectTimings(uint32_t frameIndex);
+};
+
+} // namespace engine::render
@@ -0,0 +1,10 @@
+#pragma once
+#include <cstdint>
+
+namespace engine::render {
+
+#pragma region Constants
+const uint32_t MAX_FRAMES_IN_FLIGHT = 2; // 同时在飞行中的最大帧数
+#pragma endregion
+
+} // namespace engine::render
@@ -0,0 +1,275 @@
+#include "RenderSurface.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_vulkan.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace engine::render {
+
+RenderSurface::RenderSurface(VulkanRenderer &renderer, SDL_Window *window)
+    : m_renderer(renderer), m_window(window), m_windowID(SDL_GetWindowID(window)) {
+    if (!SDL_Vulkan_CreateSurface(m_window, m_renderer.getInstance(), nullptr, &m_surface)) {
+        throw std::runtime_error("RenderSurface::RenderSurface()::创建窗口表面失败");
+    }
+}
+
+RenderSurface::~RenderSurface() = default;
+
+SwapChainSupportDetails RenderSurface::querySwapChainSupport(VkPhysicalDevice device, VkSurfaceKHR surface) {
+    SwapChainSupportDetails details;                                                   // 获取交换链支持的能力，格式和呈现模式
+    vkGetPhysicalDeviceSurfaceCapabilitiesKHR(device, surface, &details.capabilities); // 获取交换链支持的能力
+    uint32_t formatCount;
+    vkGetPhysicalDeviceSurfaceFormatsKHR(device, surface, &formatCount, nullptr); // 获取支持的格式数量
+    if (formatCount != 0) {
+        details.formats.resize(formatCount);
+        vkGetPhysicalDeviceSurfaceFormatsKHR(device, surface, &formatCount, details.formats.data()); // 获取支持的格式
+    }
+
+    uint32_t presentModeCount;
+    vkGetPhysicalDeviceSurfacePresentModesKHR(device, surface, &presentModeCount, nullptr);
+    if (presentModeCount != 0) {
+        details.presentModes.resize(presentModeCount);
+        vkGetPhysicalDeviceSurfacePresentModesKHR(device, surface, &presentModeCount, details.presentModes.data());
+    }
+    return details;
+}
+
+#pragma region Swap Chain and Image Views
+VkSurfaceFormatKHR RenderSurface::chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR> &availableFormats) {
+    for (const auto &availableFormat : availableFormats) {
+        if (availableFormat.format == VK_FORMAT_B8G8R8A8_SRGB && availableFormat.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
+            return availableFormat;
+        }
+    }
+    return availableFormats[0];
+}
+VkPresentModeKHR RenderSurface::chooseSwapPresentMode(const std::vector<VkPresentModeKHR> &availablePresentModes) {
+    for (const auto &availablePresentMode : availablePresentModes) {
+        if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR) {
+            return availablePresentMode; // 如果支持 mailbox 模式，则优先使用
+        }
+    }
+    return VK_PRESENT_MODE_FIFO_KHR;
+}
+VkExtent2D RenderSurface::chooseSwapExtent(const VkSurfaceCapabilitiesKHR &capabilities) {
+    if (capabilities.currentExtent.width != std::numeric_limits<uint32_t>::max()) {
+        return capabilities.currentExtent;
+    } else {
+        int width, height;
+        SDL_GetWindowSizeInPixels(m_window, &width, &height);
+        VkExtent2D actualExtent = {
+            static_cast<uint32_t>(width),
+            static_cast<uint32_t>(height)};
+        actualExtent.width  = std::clamp(actualExtent.width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+        actualExtent.height = std::clamp(actualExtent.height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+        return actualExtent;
+    }
+}
+void RenderSurface::createSwapChain() {
+    VkDevice device                          = m_renderer.getDevice();
+    SwapChainSupportDetails swapChainSupport = querySwapChainSupport(m_renderer.getPhysicalDevice(), m_surface);
+    VkSurfaceFormatKHR surfaceFormat         = chooseSwapSurfaceFormat(swapChainSupport.formats);
+    VkPresentModeKHR presentMode             = chooseSwapPresentMode(swapChainSupport.presentModes);
+    VkExtent2D extent                        = chooseSwapExtent(swapChainSupport.capabilities);
+    uint32_t imageCount                      = swapChainSupport.capabilities.minImageCount + 1;
+
+    // 后处理结果通过 blit 写入交换链图像，交换链格式必须支持作为 blit 目标
+    VkFormatProperties formatProperties;
+    vkGetPhysicalDeviceFormatProperties(m_renderer.getPhysicalDevice(), surfaceFormat.format, &formatProperties);
+    if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_DST_BIT)) {
+        throw std::runtime_error("RenderSurface::createSwapChain()::交换链格式不支持作为 blit 目标");
+    }
+    if (swapChainSupport.capabilities.maxImageCount > 0 && imageCount > swapChainSupport.capabilities.maxImageCount) {
+        imageCount = swapChainSupport.capabilities.maxImageCount; // 如果最大图像数量不为0，则将图像数量设置为最大图像数量
+    }
+
+    VkSwapchainCreateInfoKHR createInfo{};
+    createInfo.sType            = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+    createInfo.surface          = m_surface;                                                             // 设置交换链的表面
+    createInfo.minImageCount    = imageCount;                                                            // 设置交换链的图像数量
+    createInfo.imageFormat      = surfaceFormat.format;                                                  // 设置交换链的图像格式
+    createInfo.imageColorSpace  = surfaceFormat.colorSpace;                                              // 设置交换链的图像颜色空间
+    createInfo.imageExtent      = extent;                                                                // 设置交换链的图像尺寸
+    createInfo.imageArrayLayers = 1;                                                                     // 设置交换链的图像层数
+    createInfo.imageUsage       = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT; // 设置交换链的图像用途，后处理结果通过 blit 写入
+
+    const QueueFamilyIndices &indices = m_renderer.getQueueFamilyIndices();                              // 查找队列家族索引
+    uint32_t queueFamilyIndices[]     = {indices.graphicsFamily.value(), indices.presentFamily.value()}; // 设置队列家族索引
+
+    if (indices.graphicsFamily != indices.presentFamily) {
+        createInfo.imageSharingMode      = VK_SHARING_MODE_CONCURRENT; // 如果图形队列和呈现队列不同，则使用并发模式
+        createInfo.queueFamilyIndexCount = 2;                          // 设置队列家族索引数量
+        createInfo.pQueueFamilyIndices   = queueFamilyIndices;         // 设置队列家族索引
+    } else {
+        createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE; // 如果图形队列和呈现队列相同，则使用独占模式
+    }
+    createInfo.preTransform   = swapChainSupport.capabilities.currentTransform; // 设置交换链的图像变换
+    createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;              // 设置交换链的图像透明度
+    createInfo.presentMode    = presentMode;                                    // 设置交换链的呈现模式
+    createInfo.clipped        = VK_TRUE;                                        // 设置交换链的剪裁模式
+    createInfo.oldSwapchain   = VK_NULL_HANDLE;                                 // 设置旧的交换链
+
+    if (vkCreateSwapchainKHR(device, &createInfo, nullptr, &m_swapChain) != VK_SUCCESS) {
+        throw std::runtime_error("RenderSurface::createSwapChain()::创建交换链失败");
+    }
+
+    vkGetSwapchainImagesKHR(device, m_swapChain, &imageCount, nullptr);                  // 获取交换链图像数量
+    m_swapChainImages.resize(imageCount);                                                // 创建交换链图像
+    vkGetSwapchainImagesKHR(device, m_swapChain, &imageCount, m_swapChainImages.data()); // 获取交换链图像
+    spdlog::trace("RenderSurface::createSwapChain()::创建交换链成功, 窗口 ID: {}, 交换链图像数量: {}", m_windowID, imageCount);
+
+    m_swapChainImageFormat = surfaceFormat.format; // 设置交换链图像格式
+    m_swapChainExtent      = extent;               // 设置交换链图像尺寸
+}
+void RenderSurface::createImageViews() {
+    m_swapChainImageViews.resize(m_swapChainImages.size());
+    for (size_t i = 0; i < m_swapChainImages.size(); i++) {
+        VkImageViewCreateInfo createInfo{};
+        createInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        createInfo.image                           = m_swapChainImages[i];          // 设置图像
+        createInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;         // 设置图像视图类型
+        createInfo.format                          = m_swapChainImageFormat;        // 设置图像格式
+        createInfo.components.r                    = VK_COMPONENT_SWIZZLE_IDENTITY; // 设置颜色分量 r
+        createInfo.components.g                    = VK_COMPONENT_SWIZZLE_IDENTITY; // 设置颜色分量 g
+        createInfo.components.b                    = VK_COMPONENT_SWIZZLE_IDENTITY; // 设置颜色分量 b
+        createInfo.components.a                    = VK_COMPONENT_SWIZZLE_IDENTITY; // 设置颜色分量 a
+        createInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;     // 设置图像视图的方面掩码
+        createInfo.subresourceRange.baseMipLevel   = 0;                             // 设置图像视图的基础Mipmap级别
+        createInfo.subresourceRange.levelCount     = 1;                             // 设置图像视图的Mipmap级别数量
+        createInfo.subresourceRange.baseArrayLayer = 0;                             // 设置图像视图的基础数组层
+        createInfo.subresourceRange.layerCount     = 1;                             // 设置图像视图的数组层数
+        m_swapChainImageViews[i]                   = m_renderer.getImageViewCache().acquire(createInfo);
+    }
+    spdlog::trace("RenderSurface::createImageViews()::创建交换链图像视图成功, 交换链图像视图数量: {}", m_swapChainImageViews.size());
+}
+#pragma endregion
+
+void RenderSurface::createOffscreenTargets() {
+    m_renderer.getPostProcessChain().createTargets(m_postProcessTargets, m_swapChainExtent);
+
+    VkFormat depthFormat = m_renderer.getDepthFormat();
+    m_renderer.createImage(m_swapChainExtent.width, m_swapChainExtent.height, depthFormat,
+                           VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                           MemoryUsage::GpuOnly, m_depthImage, m_depthMemory);
+    m_depthView = m_renderer.createImageView(m_depthImage, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT);
+    m_renderer.getOcclusionCuller().createTargets(m_occlusionTargets, m_swapChainExtent, m_depthView);
+
+    std::array<VkImageView, 2> attachments = {m_postProcessTargets.views[0], m_depthView};
+    VkFramebufferCreateInfo framebufferInfo{};
+    framebufferInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    framebufferInfo.renderPass      = m_renderer.getSceneRenderPass();           // 设置渲染通道
+    framebufferInfo.attachmentCount = static_cast<uint32_t>(attachments.size()); // 设置附件数量
+    framebufferInfo.pAttachments    = attachments.data();                        // 设置附件
+    framebufferInfo.width           = m_swapChainExtent.width;                   // 设置帧缓冲宽度
+    framebufferInfo.height          = m_swapChainExtent.height;                  // 设置帧缓冲高度
+    framebufferInfo.layers          = 1;                                         // 设置帧缓冲层数量
+    if (vkCreateFramebuffer(m_renderer.getDevice(), &framebufferInfo, nullptr, &m_sceneFramebuffer) != VK_SUCCESS) {
+        throw std::runtime_error("RenderSurface::createOffscreenTargets()::创建场景帧缓冲失败");
+    }
+    spdlog::trace("RenderSurface::createOffscreenTargets()::创建离屏目标成功, 尺寸: {}x{}", m_swapChainExtent.width, m_swapChainExtent.height);
+}
+
+void RenderSurface::createSyncObjects() {
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    for (auto &semaphore : m_imageAvailableSemaphores) {
+        if (vkCreateSemaphore(m_renderer.getDevice(), &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
+            throw std::runtime_error("RenderSurface::createSyncObjects()::创建同步对象失败");
+        }
+    }
+}
+
+void RenderSurface::cleanupSwapChain() {
+    VkDevice device = m_renderer.getDevice();
+    vkDestroyFramebuffer(device, m_sceneFramebuffer, nullptr);
+    m_renderer.getOcclusionCuller().destroyTargets(m_occlusionTargets);
+    m_renderer.releaseImageView(m_depthView);
+    vkDestroyImage(device, m_depthImage, nullptr);
+    m_renderer.freeMemory(m_depthMemory);
+    m_renderer.getPostProcessChain().destroyTargets(m_postProcessTargets);
+    for (auto imageView : m_swapChainImageViews) {
+        m_renderer.releaseImageView(imageView);
+    }
+    vkDestroySwapchainKHR(device, m_swapChain, nullptr);
+    m_sceneFramebuffer = VK_NULL_HANDLE;
+    m_depthView        = VK_NULL_HANDLE;
+    m_depthImage       = VK_NULL_HANDLE;
+    m_depthMemory      = VK_NULL_HANDLE;
+    m_swapChainImageViews.clear();
+    m_swapChain = VK_NULL_HANDLE;
+}
+
+void RenderSurface::recreateSwapChain() {
+    vkDeviceWaitIdle(m_renderer.getDevice());
+    cleanupSwapChain();
+
+    createSwapChain();
+    createImageViews();
+    createOffscreenTargets();
+    m_damageRects.clear();        // 交换链重建后整帧都需要重新呈现
+    m_framebufferResized = false; // 交换链已按新尺寸重建
+    spdlog::trace("RenderSurface::recreateSwapChain()::重新创建交换链成功, 窗口 ID: {}", m_windowID);
+}
+
+void RenderSurface::destroy() {
+    // 添加窗口可能在任意一步失败，只释放已经创建的对象
+    VkDevice device = m_renderer.getDevice();
+    if (m_swapChain != VK_NULL_HANDLE) {
+        cleanupSwapChain();
+        m_renderer.getPostProcessChain().freeTargets(m_postProcessTargets);
+    }
+    for (auto &semaphore : m_imageAvailableSemaphores) {
+        if (semaphore == VK_NULL_HANDLE) continue;
+        vkDestroySemaphore(device, semaphore, nullptr);
+        semaphore = VK_NULL_HANDLE;
+    }
+    if (m_surface != VK_NULL_HANDLE) {
+        vkDestroySurfaceKHR(m_renderer.getInstance(), m_surface, nullptr);
+        m_surface = VK_NULL_HANDLE;
+    }
+}
+
+bool RenderSurface::acquireNextImage(uint32_t frameIndex) {
+    if (isMinimized()) return false; // 窗口最小化时无法创建交换链，跳过该表面
+
+    if (m_framebufferResized) {
+        recreateSwapChain();
+    }
+    VkResult result = vkAcquireNextImageKHR(m_renderer.getDevice(), m_swapChain, UINT64_MAX, m_imageAvailableSemaphores[frameIndex], VK_NULL_HANDLE, &m_imageIndex); // 获取下一个图像
+    if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+        recreateSwapChain();
+        return false;
+    } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+        throw std::runtime_error("RenderSurface::acquireNextImage()::获取下一个交换链图像失败");
+    }
+    return true;
+}
+
+bool RenderSurface::isMinimized() const {
+    if (m_minimized) return true;
+    int width = 0, height = 0;
+    SDL_GetWindowSizeInPixels(m_window, &width, &height);
+    return width == 0 || height == 0;
+}
+
+void RenderSurface::addDamageRect(const VkRect2D &rect) {
+    // 裁剪到交换链范围内，呈现区域超出图像范围是未定义行为
+    int32_t x0 = std::clamp(rect.offset.x, 0, static_cast<int32_t>(m_swapChainExtent.width));
+    int32_t y0 = std::clamp(rect.offset.y, 0, static_cast<int32_t>(m_swapChainExtent.height));
+    int32_t x1 = std::clamp(rect.offset.x + static_cast<int32_t>(rect.extent.width), x0, static_cast<int32_t>(m_swapChainExtent.width));
+    int32_t y1 = std::clamp(rect.offset.y + static_cast<int32_t>(rect.extent.height), y0, static_cast<int32_t>(m_swapChainExtent.height));
+    if (x1 == x0 || y1 == y0) return;
+
+    VkRectLayerKHR damage{};
+    damage.offset = {x0, y0};
+    damage.extent = {static_cast<uint32_t>(x1 - x0), static_cast<uint32_t>(y1 - y0)};
+    damage.layer  = 0;
+    m_damageRects.push_back(damage);
+}
+
+} // namespace engine::render
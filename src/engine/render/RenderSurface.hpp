@@ -0,0 +1,117 @@
+#pragma once
+#include "OcclusionCuller.hpp"
+#include "PostProcessChain.hpp"
+#include "RenderConstants.hpp"
+
+#include <SDL3/SDL_video.h>
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <vector>
+
+namespace engine::render {
+class VulkanRenderer;
+
+/**
+ * @struct SwapChainSupportDetails
+ * @brief 存储交换链支持信息的容器
+ */
+struct SwapChainSupportDetails {
+    VkSurfaceCapabilitiesKHR capabilities;
+    std::vector<VkSurfaceFormatKHR> formats;
+    std::vector<VkPresentModeKHR> presentModes;
+};
+
+/**
+ * @class RenderSurface
+ * @brief 每个窗口独有的呈现状态
+ *
+ * 持有窗口表面、交换链、交换链图像视图、离屏 HDR 目标、深度附件、Hi-Z 金字塔、场景帧缓冲以及获取图像用的信号量。
+ * 设备级状态（逻辑设备、管线、命令池、内存）由 VulkanRenderer 持有，多个 RenderSurface 共享。
+ */
+class RenderSurface final {
+public:
+    RenderSurface(VulkanRenderer &renderer, SDL_Window *window);
+    ~RenderSurface();
+
+    RenderSurface(const RenderSurface &)            = delete;
+    RenderSurface &operator=(const RenderSurface &) = delete;
+    RenderSurface(RenderSurface &&)                 = delete;
+    RenderSurface &operator=(RenderSurface &&)      = delete;
+
+    static SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device, VkSurfaceKHR surface);
+
+    void createSwapChain();
+    void createImageViews();
+    void createOffscreenTargets(); // 创建与交换链同尺寸的离屏 HDR 目标、深度附件、遮挡剔除目标和场景帧缓冲
+    void createSyncObjects();
+    void cleanupSwapChain();
+    void recreateSwapChain();
+    void destroy(); // 销毁已经创建的 Vulkan 对象，必须在逻辑设备销毁之前调用；创建中途失败时也可以调用
+
+    /**
+     * @brief 获取下一张交换链图像
+     * @return 成功获取返回 true；交换链过期被重建或窗口尺寸为 0 时返回 false，本帧应跳过该表面
+     */
+    bool acquireNextImage(uint32_t frameIndex);
+
+    void addDamageRect(const VkRect2D &rect); // 添加本帧发生变化的区域
+    void clearDamageRects() { m_damageRects.clear(); }
+
+    SDL_Window *getWindow() const { return m_window; }
+    SDL_WindowID getWindowID() const { return m_windowID; }
+    VkSurfaceKHR getSurface() const { return m_surface; }
+    VkSwapchainKHR getSwapChain() const { return m_swapChain; }
+    VkFormat getImageFormat() const { return m_swapChainImageFormat; }
+    VkExtent2D getExtent() const { return m_swapChainExtent; }
+    VkImage getImage(uint32_t imageIndex) const { return m_swapChainImages[imageIndex]; }
+    VkFramebuffer getSceneFramebuffer() const { return m_sceneFramebuffer; }
+    const PostProcessTargets &getPostProcessTargets() const { return m_postProcessTargets; }
+    OcclusionTargets &getOcclusionTargets() { return m_occlusionTargets; }
+    uint32_t getImageIndex() const { return m_imageIndex; }
+    VkSemaphore getImageAvailableSemaphore(uint32_t frameIndex) const { return m_imageAvailableSemaphores[frameIndex]; }
+    const std::vector<VkRectLayerKHR> &getDamageRects() const { return m_damageRects; }
+
+    bool isMinimized() const; // 窗口被最小化或像素尺寸为 0，不获取图像也不呈现
+    void setMinimized(bool minimized) { m_minimized = minimized; }
+    bool isFramebufferResized() const { return m_framebufferResized; }
+    void setFramebufferResized(bool resized) { m_framebufferResized = resized; }
+
+private:
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer; // 共享设备级状态的渲染器
+    SDL_Window *m_window;       // SDL windows 窗口句柄
+    SDL_WindowID m_windowID;    // SDL 窗口 ID，用于分发窗口事件
+
+    VkSurfaceKHR m_surface = VK_NULL_HANDLE; // Vulkan 窗口句柄
+
+    VkSwapchainKHR m_swapChain = VK_NULL_HANDLE;        // 交换链句柄
+    std::vector<VkImage> m_swapChainImages;             // 交换链图像句柄
+    VkFormat m_swapChainImageFormat;                    // 交换链图像格式
+    VkExtent2D m_swapChainExtent;                       // 交换链图像尺寸
+    std::vector<VkImageView> m_swapChainImageViews;     // 交换链图像视图句柄
+
+    PostProcessTargets m_postProcessTargets;           // 离屏 HDR 目标，后处理阶段之间来回交替
+    VkImage m_depthImage             = VK_NULL_HANDLE; // 场景深度附件，同时作为 Hi-Z 构建的输入
+    VkDeviceMemory m_depthMemory     = VK_NULL_HANDLE; // 深度附件内存
+    VkImageView m_depthView          = VK_NULL_HANDLE; // 深度附件视图
+    OcclusionTargets m_occlusionTargets;               // Hi-Z 金字塔和间接绘制命令
+    VkFramebuffer m_sceneFramebuffer = VK_NULL_HANDLE; // 场景渲染通道的帧缓冲，渲染到离屏 HDR 目标
+
+    std::array<VkSemaphore, MAX_FRAMES_IN_FLIGHT> m_imageAvailableSemaphores{}; // 图像可用信号量
+
+    uint32_t m_imageIndex     = 0;     // 本帧获取到的交换链图像索引
+    bool m_framebufferResized = false; // 是否调整了窗口大小
+    bool m_minimized          = false; // 窗口是否被最小化
+
+    std::vector<VkRectLayerKHR> m_damageRects; // 本帧变化区域，用于增量呈现
+#pragma endregion
+
+#pragma region Swap Chain and Image Views
+    VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR> &availableFormats);
+    VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR> &availablePresentModes);
+    VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR &capabilities);
+#pragma endregion
+};
+
+} // namespace engine::render
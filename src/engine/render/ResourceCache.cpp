@@ -0,0 +1,152 @@
+#include "ResourceCache.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <bit>
+#include <functional>
+#include <stdexcept>
+
+namespace engine::render {
+
+namespace {
+void hashCombine(size_t &seed, size_t value) {
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+size_t hashValue(uint32_t value) { return std::hash<uint32_t>{}(value); }
+size_t hashValue(float value) { return std::hash<uint32_t>{}(std::bit_cast<uint32_t>(value)); }
+} // namespace
+
+#pragma region Keys
+SamplerKey::SamplerKey(const VkSamplerCreateInfo &info)
+    : flags(info.flags), magFilter(info.magFilter), minFilter(info.minFilter), mipmapMode(info.mipmapMode),
+      addressModeU(info.addressModeU), addressModeV(info.addressModeV), addressModeW(info.addressModeW),
+      mipLodBias(info.mipLodBias), anisotropyEnable(info.anisotropyEnable), maxAnisotropy(info.maxAnisotropy),
+      compareEnable(info.compareEnable), compareOp(info.compareOp), minLod(info.minLod), maxLod(info.maxLod),
+      borderColor(info.borderColor), unnormalizedCoordinates(info.unnormalizedCoordinates) {}
+
+size_t SamplerKeyHash::operator()(const SamplerKey &key) const {
+    size_t seed = 0;
+    hashCombine(seed, hashValue(key.flags));
+    hashCombine(seed, hashValue(static_cast<uint32_t>(key.magFilter)));
+    hashCombine(seed, hashValue(static_cast<uint32_t>(key.minFilter)));
+    hashCombine(seed, hashValue(static_cast<uint32_t>(key.mipmapMode)));
+    hashCombine(seed, hashValue(static_cast<uint32_t>(key.addressModeU)));
+    hashCombine(seed, hashValue(static_cast<uint32_t>(key.addressModeV)));
+    hashCombine(seed, hashValue(static_cast<uint32_t>(key.addressModeW)));
+    hashCombine(seed, hashValue(key.mipLodBias));
+    hashCombine(seed, hashValue(key.anisotropyEnable));
+    hashCombine(seed, hashValue(key.maxAnisotropy));
+    hashCombine(seed, hashValue(key.compareEnable));
+    hashCombine(seed, hashValue(static_cast<uint32_t>(key.compareOp)));
+    hashCombine(seed, hashValue(key.minLod));
+    hashCombine(seed, hashValue(key.maxLod));
+    hashCombine(seed, hashValue(static_cast<uint32_t>(key.borderColor)));
+    hashCombine(seed, hashValue(key.unnormalizedCoordinates));
+    return seed;
+}
+
+ImageViewKey::ImageViewKey(const VkImageViewCreateInfo &info)
+    : flags(info.flags), image(info.image), viewType(info.viewType), format(info.format),
+      components(info.components), subresourceRange(info.subresourceRange) {}
+
+bool ImageViewKey::operator==(const ImageViewKey &other) const {
+    return flags == other.flags && image == other.image && viewType == other.viewType && format == other.format &&
+           components.r == other.components.r && components.g == other.components.g &&
+           components.b == other.components.b && components.a == other.components.a &&
+           subresourceRange.aspectMask == other.subresourceRange.aspectMask &&
+           subresourceRange.baseMipLevel == other.subresourceRange.baseMipLevel &&
+           subresourceRange.levelCount == other.subresourceRange.levelCount &&
+           subresourceRange.baseArrayLayer == other.subresourceRange.baseArrayLayer &&
+           subresourceRange.layerCount == other.subresourceRange.layerCount;
+}
+
+size_t ImageViewKeyHash::operator()(const ImageViewKey &key) const {
+    size_t seed = std::hash<VkImage>{}(key.image);
+    hashCombine(seed, hashValue(key.flags));
+    hashCombine(seed, hashValue(static_cast<uint32_t>(key.viewType)));
+    hashCombine(seed, hashValue(static_cast<uint32_t>(key.format)));
+    hashCombine(seed, hashValue(static_cast<uint32_t>(key.components.r)));
+    hashCombine(seed, hashValue(static_cast<uint32_t>(key.components.g)));
+    hashCombine(seed, hashValue(static_cast<uint32_t>(key.components.b)));
+    hashCombine(seed, hashValue(static_cast<uint32_t>(key.components.a)));
+    hashCombine(seed, hashValue(key.subresourceRange.aspectMask));
+    hashCombine(seed, hashValue(key.subresourceRange.baseMipLevel));
+    hashCombine(seed, hashValue(key.subresourceRange.levelCount));
+    hashCombine(seed, hashValue(key.subresourceRange.baseArrayLayer));
+    hashCombine(seed, hashValue(key.subresourceRange.layerCount));
+    return seed;
+}
+#pragma endregion
+
+#pragma region Sampler Cache
+SamplerCache::SamplerCache(VkDevice device, VkPhysicalDevice physicalDevice) : m_device(device) {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    m_maxSamplerAllocationCount = properties.limits.maxSamplerAllocationCount;
+}
+
+SamplerCache::~SamplerCache() = default;
+
+VkSampler SamplerCache::acquire(const VkSamplerCreateInfo &createInfo) {
+    if (createInfo.pNext != nullptr) {
+        throw std::runtime_error("SamplerCache::acquire()::不支持带 pNext 扩展结构的采样器");
+    }
+    return m_cache.acquire(SamplerKey(createInfo), [&]() {
+        if (m_cache.size() >= m_maxSamplerAllocationCount) {
+            throw std::runtime_error("SamplerCache::acquire()::采样器数量超过 maxSamplerAllocationCount");
+        }
+        VkSampler sampler;
+        if (vkCreateSampler(m_device, &createInfo, nullptr, &sampler) != VK_SUCCESS) {
+            throw std::runtime_error("SamplerCache::acquire()::创建采样器失败");
+        }
+        return sampler;
+    });
+}
+
+void SamplerCache::release(VkSampler sampler) {
+    if (m_cache.release(sampler)) {
+        vkDestroySampler(m_device, sampler, nullptr);
+    }
+}
+
+void SamplerCache::cleanup() {
+    const CacheStats &stats = m_cache.getStats();
+    spdlog::info("SamplerCache::cleanup()::采样器缓存命中率: {:.1f}% (命中 {}, 未命中 {}, 存活 {})",
+                 stats.hitRate() * 100.0, stats.hits, stats.misses, stats.liveCount);
+    m_cache.clear([this](VkSampler sampler) { vkDestroySampler(m_device, sampler, nullptr); });
+}
+#pragma endregion
+
+#pragma region Image View Cache
+ImageViewCache::ImageViewCache(VkDevice device) : m_device(device) {}
+
+ImageViewCache::~ImageViewCache() = default;
+
+VkImageView ImageViewCache::acquire(const VkImageViewCreateInfo &createInfo) {
+    if (createInfo.pNext != nullptr) {
+        throw std::runtime_error("ImageViewCache::acquire()::不支持带 pNext 扩展结构的图像视图");
+    }
+    return m_cache.acquire(ImageViewKey(createInfo), [&]() {
+        VkImageView imageView;
+        if (vkCreateImageView(m_device, &createInfo, nullptr, &imageView) != VK_SUCCESS) {
+            throw std::runtime_error("ImageViewCache::acquire()::创建图像视图失败");
+        }
+        return imageView;
+    });
+}
+
+void ImageViewCache::release(VkImageView imageView) {
+    if (m_cache.release(imageView)) {
+        vkDestroyImageView(m_device, imageView, nullptr);
+    }
+}
+
+void ImageViewCache::cleanup() {
+    const CacheStats &stats = m_cache.getStats();
+    spdlog::info("ImageViewCache::cleanup()::图像视图缓存命中率: {:.1f}% (命中 {}, 未命中 {}, 存活 {})",
+                 stats.hitRate() * 100.0, stats.hits, stats.misses, stats.liveCount);
+    m_cache.clear([this](VkImageView imageView) { vkDestroyImageView(m_device, imageView, nullptr); });
+}
+#pragma endregion
+
+} // namespace engine::render
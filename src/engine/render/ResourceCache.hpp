@@ -0,0 +1,193 @@
+#pragma once
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace engine::render {
+
+/**
+ * @struct CacheStats
+ * @brief 去重缓存的统计信息
+ */
+struct CacheStats {
+    uint64_t hits    = 0; // 命中次数（返回已有句柄）
+    uint64_t misses  = 0; // 未命中次数（创建新句柄）
+    size_t liveCount = 0; // 当前存活的句柄数量
+
+    double hitRate() const {
+        uint64_t total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+    }
+};
+
+/**
+ * @class RefCountedCache
+ * @brief 以创建参数为键、带引用计数的句柄缓存
+ *
+ * 相同参数的请求返回同一个句柄并增加引用计数，引用计数归零时由调用方销毁句柄。
+ */
+template <typename Key, typename Handle, typename KeyHash>
+class RefCountedCache {
+public:
+    template <typename CreateFunc>
+    Handle acquire(const Key &key, CreateFunc &&create) {
+        if (auto it = m_entries.find(key); it != m_entries.end()) {
+            it->second.refCount++;
+            m_stats.hits++;
+            return it->second.handle;
+        }
+        Handle handle = create();
+        m_entries.emplace(key, Entry{handle, 1});
+        m_keys.emplace(handle, key);
+        m_stats.misses++;
+        m_stats.liveCount = m_entries.size();
+        return handle;
+    }
+
+    /**
+     * @brief 减少引用计数
+     * @return 引用计数归零时返回 true，调用方负责销毁句柄
+     */
+    bool release(Handle handle) {
+        auto keyIt = m_keys.find(handle);
+        if (keyIt == m_keys.end()) return false;
+        auto it = m_entries.find(keyIt->second);
+        if (--it->second.refCount > 0) return false;
+        m_entries.erase(it);
+        m_keys.erase(keyIt);
+        m_stats.liveCount = m_entries.size();
+        return true;
+    }
+
+    template <typename DestroyFunc>
+    void clear(DestroyFunc &&destroy) {
+        for (auto &[key, entry] : m_entries) {
+            destroy(entry.handle);
+        }
+        m_entries.clear();
+        m_keys.clear();
+        m_stats.liveCount = 0;
+    }
+
+    const CacheStats &getStats() const { return m_stats; }
+    size_t size() const { return m_entries.size(); }
+
+private:
+    struct Entry {
+        Handle handle;
+        uint32_t refCount;
+    };
+    std::unordered_map<Key, Entry, KeyHash> m_entries; // 创建参数 -> 句柄和引用计数
+    std::unordered_map<Handle, Key> m_keys;            // 句柄 -> 创建参数，用于释放
+    CacheStats m_stats;
+};
+
+/**
+ * @struct SamplerKey
+ * @brief VkSamplerCreateInfo 中参与去重的字段（不支持 pNext 扩展结构）
+ */
+struct SamplerKey {
+    VkSamplerCreateFlags flags;
+    VkFilter magFilter;
+    VkFilter minFilter;
+    VkSamplerMipmapMode mipmapMode;
+    VkSamplerAddressMode addressModeU;
+    VkSamplerAddressMode addressModeV;
+    VkSamplerAddressMode addressModeW;
+    float mipLodBias;
+    VkBool32 anisotropyEnable;
+    float maxAnisotropy;
+    VkBool32 compareEnable;
+    VkCompareOp compareOp;
+    float minLod;
+    float maxLod;
+    VkBorderColor borderColor;
+    VkBool32 unnormalizedCoordinates;
+
+    explicit SamplerKey(const VkSamplerCreateInfo &info);
+    bool operator==(const SamplerKey &) const = default;
+};
+
+struct SamplerKeyHash {
+    size_t operator()(const SamplerKey &key) const;
+};
+
+/**
+ * @struct ImageViewKey
+ * @brief VkImageViewCreateInfo 中参与去重的字段（不支持 pNext 扩展结构）
+ */
+struct ImageViewKey {
+    VkImageViewCreateFlags flags;
+    VkImage image;
+    VkImageViewType viewType;
+    VkFormat format;
+    VkComponentMapping components;
+    VkImageSubresourceRange subresourceRange;
+
+    explicit ImageViewKey(const VkImageViewCreateInfo &info);
+    bool operator==(const ImageViewKey &other) const;
+};
+
+struct ImageViewKeyHash {
+    size_t operator()(const ImageViewKey &key) const;
+};
+
+/**
+ * @class SamplerCache
+ * @brief 采样器去重缓存
+ *
+ * 成千上万的纹理通常只用到少数几种采样参数，共享采样器可以避免触及 maxSamplerAllocationCount。
+ */
+class SamplerCache final {
+public:
+    SamplerCache(VkDevice device, VkPhysicalDevice physicalDevice);
+    ~SamplerCache();
+
+    SamplerCache(const SamplerCache &)            = delete;
+    SamplerCache &operator=(const SamplerCache &) = delete;
+    SamplerCache(SamplerCache &&)                 = delete;
+    SamplerCache &operator=(SamplerCache &&)      = delete;
+
+    VkSampler acquire(const VkSamplerCreateInfo &createInfo); // 获取共享采样器，引用计数加一
+    void release(VkSampler sampler);                          // 引用计数减一，归零时销毁
+    void cleanup();                                           // 销毁所有采样器
+
+    const CacheStats &getStats() const { return m_cache.getStats(); }
+
+private:
+    VkDevice m_device;
+    uint32_t m_maxSamplerAllocationCount; // 设备允许同时存在的最大采样器数量
+    RefCountedCache<SamplerKey, VkSampler, SamplerKeyHash> m_cache;
+};
+
+/**
+ * @class ImageViewCache
+ * @brief 图像视图去重缓存
+ *
+ * 对同一图像、同一子资源范围的视图请求返回同一个 VkImageView。
+ * 图像销毁前必须释放其所有视图。
+ */
+class ImageViewCache final {
+public:
+    explicit ImageViewCache(VkDevice device);
+    ~ImageViewCache();
+
+    ImageViewCache(const ImageViewCache &)            = delete;
+    ImageViewCache &operator=(const ImageViewCache &) = delete;
+    ImageViewCache(ImageViewCache &&)                 = delete;
+    ImageViewCache &operator=(ImageViewCache &&)      = delete;
+
+    VkImageView acquire(const VkImageViewCreateInfo &createInfo); // 获取共享图像视图，引用计数加一
+    void release(VkImageView imageView);                          // 引用计数减一，归零时销毁
+    void cleanup();                                               // 销毁所有图像视图
+
+    const CacheStats &getStats() const { return m_cache.getStats(); }
+
+private:
+    VkDevice m_device;
+    RefCountedCache<ImageViewKey, VkImageView, ImageViewKeyHash> m_cache;
+};
+
+} // namespace engine::render
@@ -0,0 +1,421 @@
+#include "ResourceRegistry.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace engine::render {
+
+namespace {
+VkImageMemoryBarrier makeImageBarrier(VkImage image, uint32_t mipLevels, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess,
+                                      VkAccessFlags dstAccess) {
+    VkImageMemoryBarrier barrier{};
+    barrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask       = srcAccess;
+    barrier.dstAccessMask       = dstAccess;
+    barrier.oldLayout           = oldLayout;
+    barrier.newLayout           = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image               = image;
+    barrier.subresourceRange    = {VK_IMAGE_ASPECT_COLOR_BIT, 0, mipLevels, 0, 1};
+    return barrier;
+}
+} // namespace
+
+ResourceRegistry::ResourceRegistry(VulkanRenderer &renderer) : m_renderer(renderer), m_allocator(renderer) {}
+
+ResourceRegistry::~ResourceRegistry() = default;
+
+BufferHandle ResourceRegistry::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, MemoryUsage memoryUsage, bool relocatable) {
+    if (relocatable && memoryUsage != MemoryUsage::GpuOnly) {
+        throw std::runtime_error("ResourceRegistry::createBuffer()::只有 GpuOnly 的缓冲区可以搬移");
+    }
+    BufferResource buffer;
+    buffer.size        = size;
+    buffer.usage       = relocatable ? usage | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT : usage; // 搬移时在新旧缓冲区之间复制
+    buffer.memoryUsage = memoryUsage;
+    buffer.relocatable = relocatable;
+    if (!createBufferObject(buffer)) {
+        throw std::runtime_error("ResourceRegistry::createBuffer()::创建缓冲区失败");
+    }
+
+    BufferHandle handle = m_buffers.insert(buffer);
+    if (!handle) {
+        destroyNow(buffer);
+        throw std::runtime_error("ResourceRegistry::createBuffer()::缓冲区数量超过句柄上限");
+    }
+    return handle;
+}
+
+ImageHandle ResourceRegistry::createImage(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage, MemoryUsage memoryUsage, uint32_t mipLevels,
+                                          VkImageLayout relocatableLayout) {
+    bool relocatable = relocatableLayout != VK_IMAGE_LAYOUT_UNDEFINED;
+    if (relocatable && (memoryUsage != MemoryUsage::GpuOnly || (usage & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) != 0)) {
+        throw std::runtime_error("ResourceRegistry::createImage()::只有 GpuOnly 的颜色图像可以搬移");
+    }
+    ImageResource image;
+    image.format      = format;
+    image.extent      = {width, height};
+    image.mipLevels   = mipLevels;
+    image.usage       = relocatable ? usage | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT : usage;
+    image.memoryUsage = memoryUsage;
+    image.relocatable = relocatable;
+    image.layout      = relocatableLayout;
+    if (!createImageObject(image)) {
+        throw std::runtime_error("ResourceRegistry::createImage()::创建图像失败");
+    }
+
+    ImageHandle handle = m_images.insert(image);
+    if (!handle) {
+        destroyNow(image);
+        throw std::runtime_error("ResourceRegistry::createImage()::图像数量超过句柄上限");
+    }
+    return handle;
+}
+
+PipelineHandle ResourceRegistry::addPipeline(VkPipeline pipeline, VkPipelineLayout layout, VkPipelineBindPoint bindPoint) {
+    PipelineResource resource{pipeline, layout, bindPoint};
+    PipelineHandle handle = m_pipelines.insert(resource);
+    if (!handle) {
+        destroyNow(resource);
+        throw std::runtime_error("ResourceRegistry::addPipeline()::管线数量超过句柄上限");
+    }
+    return handle;
+}
+
+SamplerHandle ResourceRegistry::createSampler(const VkSamplerCreateInfo &createInfo) {
+    SamplerResource sampler{m_renderer.getSamplerCache().acquire(createInfo)};
+    SamplerHandle handle = m_samplers.insert(sampler);
+    if (!handle) {
+        destroyNow(sampler);
+        throw std::runtime_error("ResourceRegistry::createSampler()::采样器数量超过句柄上限");
+    }
+    return handle;
+}
+
+void ResourceRegistry::destroy(BufferHandle handle) {
+    BufferResource buffer;
+    if (!m_buffers.remove(handle, buffer)) return;
+    m_renderer.deferDestroy([this, buffer]() { destroyNow(buffer); });
+}
+
+void ResourceRegistry::destroy(ImageHandle handle) {
+    ImageResource image;
+    if (!m_images.remove(handle, image)) return;
+    m_renderer.deferDestroy([this, image]() { destroyNow(image); });
+}
+
+void ResourceRegistry::destroy(PipelineHandle handle) {
+    PipelineResource pipeline;
+    if (!m_pipelines.remove(handle, pipeline)) return;
+    m_renderer.deferDestroy([this, pipeline]() { destroyNow(pipeline); });
+}
+
+void ResourceRegistry::destroy(SamplerHandle handle) {
+    SamplerResource sampler;
+    if (!m_samplers.remove(handle, sampler)) return;
+    m_renderer.deferDestroy([this, sampler]() { destroyNow(sampler); });
+}
+
+void ResourceRegistry::cleanup() {
+    ResourceRegistryStats stats = getStats();
+    for (const BufferResource &buffer : m_buffers.getItems()) destroyNow(buffer);
+    for (const ImageResource &image : m_images.getItems()) destroyNow(image);
+    for (const PipelineResource &pipeline : m_pipelines.getItems()) destroyNow(pipeline);
+    for (const SamplerResource &sampler : m_samplers.getItems()) destroyNow(sampler);
+    m_buffers.clear();
+    m_images.clear();
+    m_pipelines.clear();
+    m_samplers.clear();
+    m_allocator.cleanup();
+    m_defragmentationPhase = DefragmentationPhase::Idle;
+    m_defragmentationBlocks.clear();
+    spdlog::trace("ResourceRegistry::cleanup()::销毁了 {} 个缓冲区, {} 个图像, {} 个管线, {} 个采样器", stats.buffers, stats.images, stats.pipelines,
+                  stats.samplers);
+}
+
+VkBuffer ResourceRegistry::getBuffer(BufferHandle handle) const {
+    const BufferResource *buffer = m_buffers.get(handle);
+    return buffer ? buffer->buffer : VK_NULL_HANDLE;
+}
+
+VkImage ResourceRegistry::getImage(ImageHandle handle) const {
+    const ImageResource *image = m_images.get(handle);
+    return image ? image->image : VK_NULL_HANDLE;
+}
+
+VkPipeline ResourceRegistry::getPipeline(PipelineHandle handle) const {
+    const PipelineResource *pipeline = m_pipelines.get(handle);
+    return pipeline ? pipeline->pipeline : VK_NULL_HANDLE;
+}
+
+VkSampler ResourceRegistry::getSampler(SamplerHandle handle) const {
+    const SamplerResource *sampler = m_samplers.get(handle);
+    return sampler ? sampler->sampler : VK_NULL_HANDLE;
+}
+
+ResourceRegistryStats ResourceRegistry::getStats() const {
+    ResourceRegistryStats stats;
+    stats.buffers   = static_cast<uint32_t>(m_buffers.size());
+    stats.images    = static_cast<uint32_t>(m_images.size());
+    stats.pipelines = static_cast<uint32_t>(m_pipelines.size());
+    stats.samplers  = static_cast<uint32_t>(m_samplers.size());
+    for (const BufferResource &buffer : m_buffers.getItems()) stats.bufferBytes += buffer.memorySize;
+    for (const ImageResource &image : m_images.getItems()) stats.imageBytes += image.memorySize;
+    return stats;
+}
+
+bool ResourceRegistry::beginDefragmentation() {
+    if (m_defragmentationPhase != DefragmentationPhase::Idle) return false;
+    std::vector<uint32_t> blocks = m_allocator.selectSparseBlocks(RESOURCE_DEFRAG_SPARSE_OCCUPANCY);
+    if (blocks.empty()) return false;
+
+    MemoryBlockStats &before = m_defragmentationStats.before;
+    before                   = m_allocator.getStats();
+    for (uint32_t block : blocks) m_allocator.setExcluded(block, true);
+    m_defragmentationBlocks     = std::move(blocks);
+    m_defragmentationPhase      = DefragmentationPhase::Moving;
+    m_defragmentationStartFrame = m_renderer.getFrameNumber();
+    spdlog::info("ResourceRegistry::beginDefragmentation()::开始碎片整理, 清空 {} 个稀疏内存块; 整理前: 内存块 {} 个, 空闲 {} 字节, 最大空闲区间 {} 字节, 碎片率 {:.2f}",
+                 m_defragmentationBlocks.size(), before.blocks, before.freeBytes, before.largestFreeRange, before.fragmentation);
+    return true;
+}
+
+void ResourceRegistry::recordDefragmentation(VkCommandBuffer commandBuffer) {
+    if (m_defragmentationPhase == DefragmentationPhase::Idle) {
+        if (!m_autoDefragmentation || m_renderer.getFrameNumber() % RESOURCE_DEFRAG_CHECK_INTERVAL != 0) return;
+        if (m_allocator.getStats().freeBytes < RESOURCE_DEFRAG_MIN_FREE_BYTES) return;
+        if (!beginDefragmentation()) return;
+    }
+    if (m_defragmentationPhase != DefragmentationPhase::Moving) return;
+
+    // 新对象分配在未被排除的内存块中，注册表中的记录原地更新，句柄不变
+    std::vector<BufferMove> bufferMoves;
+    std::vector<ImageMove> imageMoves;
+    VkDeviceSize movedBytes = 0;
+    bool remaining          = false; // 超出本帧预算，还有资源留在要清空的内存块中
+    bool failed             = false;
+
+    auto overBudget = [&](VkDeviceSize bytes) {
+        size_t moves = bufferMoves.size() + imageMoves.size();
+        return moves >= RESOURCE_DEFRAG_MOVES_PER_FRAME || (moves > 0 && movedBytes + bytes > RESOURCE_DEFRAG_BYTES_PER_FRAME);
+    };
+    for (BufferResource &buffer : m_buffers.getItems()) {
+        if (!buffer.relocatable || !m_allocator.isExcluded(buffer.block)) continue;
+        if (overBudget(buffer.memorySize)) {
+            remaining = true;
+            break;
+        }
+        BufferResource moved = buffer;
+        if (!createBufferObject(moved)) {
+            failed = true;
+            break;
+        }
+        bufferMoves.push_back({buffer, moved.buffer});
+        movedBytes += buffer.memorySize;
+        buffer      = moved;
+    }
+    for (ImageResource &image : m_images.getItems()) {
+        if (remaining || failed) break;
+        if (!image.relocatable || !m_allocator.isExcluded(image.block)) continue;
+        if (overBudget(image.memorySize)) {
+            remaining = true;
+            break;
+        }
+        ImageResource moved = image;
+        if (!createImageObject(moved)) {
+            failed = true;
+            break;
+        }
+        imageMoves.push_back({image, moved.image});
+        movedBytes += image.memorySize;
+        image       = moved;
+    }
+
+    if (!bufferMoves.empty() || !imageMoves.empty()) {
+        recordMoves(commandBuffer, bufferMoves, imageMoves);
+        // 旧对象可能仍被本帧之前记录的命令使用，等 GPU 完成本帧之后再销毁，空了的内存块随之释放
+        for (const BufferMove &move : bufferMoves) {
+            m_renderer.deferDestroy([this, buffer = move.from]() { destroyNow(buffer); });
+        }
+        for (const ImageMove &move : imageMoves) {
+            m_renderer.deferDestroy([this, image = move.from]() { destroyNow(image); });
+        }
+        m_defragmentationStats.movedResources += static_cast<uint32_t>(bufferMoves.size() + imageMoves.size());
+        m_defragmentationStats.movedBytes     += movedBytes;
+    }
+    if (failed) {
+        spdlog::warn("ResourceRegistry::recordDefragmentation()::无法为搬移的资源分配内存, 提前结束本轮整理");
+        endMoving();
+    } else if (!remaining) {
+        endMoving();
+    }
+}
+
+bool ResourceRegistry::createBufferObject(BufferResource &buffer) {
+    VkDevice device = m_renderer.getDevice();
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size        = buffer.size;
+    bufferInfo.usage       = buffer.usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer.buffer) != VK_SUCCESS) return false;
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, buffer.buffer, &memRequirements);
+    buffer.memorySize = memRequirements.size;
+    if (!allocateMemory(memRequirements, buffer.memoryUsage, MemoryBudget::categorizeBuffer(buffer.usage), buffer.relocatable, buffer.memory, buffer.offset,
+                        buffer.block)) {
+        vkDestroyBuffer(device, buffer.buffer, nullptr);
+        buffer.buffer = VK_NULL_HANDLE;
+        return false;
+    }
+    vkBindBufferMemory(device, buffer.buffer, buffer.memory, buffer.offset);
+    return true;
+}
+
+bool ResourceRegistry::createImageObject(ImageResource &image) {
+    VkDevice device = m_renderer.getDevice();
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+    imageInfo.extent        = {image.extent.width, image.extent.height, 1};
+    imageInfo.mipLevels     = image.mipLevels;
+    imageInfo.arrayLayers   = 1;
+    imageInfo.format        = image.format;
+    imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage         = image.usage;
+    imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateImage(device, &imageInfo, nullptr, &image.image) != VK_SUCCESS) return false;
+
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(device, image.image, &memRequirements);
+    image.memorySize = memRequirements.size;
+    if (!allocateMemory(memRequirements, image.memoryUsage, MemoryBudget::categorizeImage(image.usage), image.relocatable, image.memory, image.offset,
+                        image.block)) {
+        vkDestroyImage(device, image.image, nullptr);
+        image.image = VK_NULL_HANDLE;
+        return false;
+    }
+    vkBindImageMemory(device, image.image, image.memory, image.offset);
+    return true;
+}
+
+bool ResourceRegistry::allocateMemory(const VkMemoryRequirements &requirements, MemoryUsage memoryUsage, MemoryCategory category, bool movable,
+                                      VkDeviceMemory &memory, VkDeviceSize &offset, uint32_t &block) {
+    if (memoryUsage == MemoryUsage::GpuOnly) {
+        MemoryBlockAllocation allocation = m_allocator.allocate(requirements, memoryUsage, category, movable);
+        memory                           = allocation.memory;
+        offset                           = allocation.offset;
+        block                            = allocation.block;
+        return static_cast<bool>(allocation);
+    }
+    // CPU 可见的资源由使用者整块映射，独立分配
+    offset = 0;
+    block  = UINT32_MAX;
+    return m_renderer.allocateMemory(requirements, memoryUsage, category, memory) == VK_SUCCESS;
+}
+
+void ResourceRegistry::freeMemory(VkDeviceMemory memory, VkDeviceSize offset, VkDeviceSize size, uint32_t block, bool movable) {
+    if (block == UINT32_MAX) {
+        m_renderer.freeMemory(memory);
+    } else {
+        m_allocator.free({memory, offset, size, block, movable});
+    }
+}
+
+void ResourceRegistry::recordMoves(VkCommandBuffer commandBuffer, const std::vector<BufferMove> &bufferMoves, const std::vector<ImageMove> &imageMoves) {
+    // 之前的帧对旧对象的写入要在复制之前完成；新图像从未定义布局开始，旧图像复制完后回到原布局，本帧之前记录的命令仍然可以读取
+    std::vector<VkImageMemoryBarrier> barriers;
+    barriers.reserve(imageMoves.size() * 2);
+    for (const ImageMove &move : imageMoves) {
+        barriers.push_back(makeImageBarrier(move.from.image, move.from.mipLevels, move.from.layout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                            VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT));
+        barriers.push_back(makeImageBarrier(move.to, move.from.mipLevels, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0,
+                                            VK_ACCESS_TRANSFER_WRITE_BIT));
+    }
+    VkMemoryBarrier memoryBarrier{};
+    memoryBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &memoryBarrier, 0, nullptr,
+                         static_cast<uint32_t>(barriers.size()), barriers.data());
+
+    for (const BufferMove &move : bufferMoves) {
+        VkBufferCopy region{0, 0, move.from.size};
+        vkCmdCopyBuffer(commandBuffer, move.from.buffer, move.to, 1, &region);
+    }
+    std::vector<VkImageCopy> regions;
+    for (const ImageMove &move : imageMoves) {
+        regions.clear();
+        for (uint32_t mip = 0; mip < move.from.mipLevels; mip++) {
+            VkImageCopy region{};
+            region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, mip, 0, 1};
+            region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, mip, 0, 1};
+            region.extent         = {std::max(move.from.extent.width >> mip, 1u), std::max(move.from.extent.height >> mip, 1u), 1};
+            regions.push_back(region);
+        }
+        vkCmdCopyImage(commandBuffer, move.from.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, move.to, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                       static_cast<uint32_t>(regions.size()), regions.data());
+    }
+
+    // 复制结果对之后的所有命令可见，包括使用者在本帧写入新对象
+    barriers.clear();
+    for (const ImageMove &move : imageMoves) {
+        barriers.push_back(makeImageBarrier(move.from.image, move.from.mipLevels, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, move.from.layout,
+                                            VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_MEMORY_READ_BIT));
+        barriers.push_back(makeImageBarrier(move.to, move.from.mipLevels, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, move.from.layout, VK_ACCESS_TRANSFER_WRITE_BIT,
+                                            VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT));
+    }
+    memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &memoryBarrier, 0, nullptr,
+                         static_cast<uint32_t>(barriers.size()), barriers.data());
+}
+
+void ResourceRegistry::endMoving() {
+    // 延迟销毁队列按顺序执行，这条排在本轮所有旧对象之后
+    m_defragmentationPhase = DefragmentationPhase::Draining;
+    m_renderer.deferDestroy([this]() { finishDefragmentation(); });
+}
+
+void ResourceRegistry::finishDefragmentation() {
+    for (uint32_t block : m_defragmentationBlocks) m_allocator.setExcluded(block, false); // 没有清空的内存块（搬移失败）恢复分配
+    m_defragmentationBlocks.clear();
+    m_defragmentationPhase = DefragmentationPhase::Idle;
+
+    DefragmentationStats &stats = m_defragmentationStats;
+    stats.after                 = m_allocator.getStats();
+    stats.lastPassFrames        = m_renderer.getFrameNumber() - m_defragmentationStartFrame;
+    stats.passes++;
+    spdlog::info("ResourceRegistry::finishDefragmentation()::碎片整理完成, 用时 {} 帧; 内存块 {} -> {} 个, 空闲 {} -> {} 字节, 最大空闲区间 {} -> {} 字节, 碎片率 {:.2f} -> {:.2f}",
+                 stats.lastPassFrames, stats.before.blocks, stats.after.blocks, stats.before.freeBytes, stats.after.freeBytes, stats.before.largestFreeRange,
+                 stats.after.largestFreeRange, stats.before.fragmentation, stats.after.fragmentation);
+}
+
+void ResourceRegistry::destroyNow(const BufferResource &buffer) {
+    vkDestroyBuffer(m_renderer.getDevice(), buffer.buffer, nullptr);
+    freeMemory(buffer.memory, buffer.offset, buffer.memorySize, buffer.block, buffer.relocatable);
+}
+
+void ResourceRegistry::destroyNow(const ImageResource &image) {
+    vkDestroyImage(m_renderer.getDevice(), image.image, nullptr);
+    freeMemory(image.memory, image.offset, image.memorySize, image.block, image.relocatable);
+}
+
+void ResourceRegistry::destroyNow(const PipelineResource &pipeline) {
+    vkDestroyPipeline(m_renderer.getDevice(), pipeline.pipeline, nullptr);
+    if (pipeline.layout != VK_NULL_HANDLE) vkDestroyPipelineLayout(m_renderer.getDevice(), pipeline.layout, nullptr);
+}
+
+void ResourceRegistry::destroyNow(const SamplerResource &sampler) {
+    m_renderer.getSamplerCache().release(sampler.sampler);
+}
+
+} // namespace engine::render
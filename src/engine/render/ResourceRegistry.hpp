@@ -0,0 +1,343 @@
+#pragma once
+#include "MemoryBlockAllocator.hpp"
+#include "MemoryTypePolicy.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine::render {
+class VulkanRenderer;
+
+#pragma region Constants
+const uint32_t RESOURCE_HANDLE_INDEX_BITS          = 20;                                            // 句柄低位为槽位，每种资源最多约一百万个
+const uint32_t RESOURCE_HANDLE_INDEX_MASK          = (1u << RESOURCE_HANDLE_INDEX_BITS) - 1;        // 槽位掩码
+const uint32_t RESOURCE_HANDLE_GENERATION_MASK     = (1u << (32 - RESOURCE_HANDLE_INDEX_BITS)) - 1; // 高位为代数，回绕时跳过 0
+const VkDeviceSize RESOURCE_DEFRAG_BYTES_PER_FRAME = 16ull * 1024 * 1024;                           // 碎片整理每帧最多在 GPU 上复制的字节数，单个更大的资源也会搬移
+const uint32_t RESOURCE_DEFRAG_MOVES_PER_FRAME     = 32;                                            // 碎片整理每帧最多搬移的资源数
+const float RESOURCE_DEFRAG_SPARSE_OCCUPANCY       = 0.5f;                                          // 占用率低于该值的内存块被视为稀疏
+const uint64_t RESOURCE_DEFRAG_CHECK_INTERVAL      = 300;                                           // 自动整理时每隔多少帧检查一次
+const VkDeviceSize RESOURCE_DEFRAG_MIN_FREE_BYTES  = MEMORY_BLOCK_SIZE;                             // 内存块内的空闲字节达到该值时自动开始整理
+#pragma endregion
+
+/**
+ * @struct ResourceHandle
+ * @brief 32 位资源句柄：低 20 位为槽位，高 12 位为代数
+ *
+ * 槽位被回收复用时代数加一，旧句柄随之失效。代数从 1 开始，值为 0 的句柄永远无效。
+ * 句柄可以按值复制，可以放进其他线程生成的渲染快照，在渲染线程通过 ResourceRegistry 解析。
+ */
+template <typename T>
+struct ResourceHandle {
+    uint32_t value = 0;
+
+    uint32_t getIndex() const { return value & RESOURCE_HANDLE_INDEX_MASK; }
+    uint32_t getGeneration() const { return value >> RESOURCE_HANDLE_INDEX_BITS; }
+
+    bool operator==(const ResourceHandle &) const = default;
+    explicit operator bool() const { return value != 0; }
+};
+
+/**
+ * @class ResourcePool
+ * @brief 稀疏槽位加紧密数组的对象池
+ *
+ * 句柄经由槽位找到紧密数组中的位置，查找为 O(1) 并校验代数；删除时用最后一个元素填补，
+ * 所以紧密数组始终连续，统计和清理时线性遍历。只能在一个线程中使用。
+ */
+template <typename T>
+class ResourcePool {
+public:
+    using Handle = ResourceHandle<T>;
+
+    Handle insert(const T &item) {
+        uint32_t index = 0;
+        if (!m_freeSlots.empty()) {
+            index = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            if (m_slots.size() > RESOURCE_HANDLE_INDEX_MASK) return Handle{}; // 槽位耗尽
+            index = static_cast<uint32_t>(m_slots.size());
+            m_slots.push_back({0, 1});
+        }
+        Slot &slot = m_slots[index];
+        slot.dense = static_cast<uint32_t>(m_items.size());
+        m_items.push_back(item);
+        m_itemSlots.push_back(index);
+        return Handle{(slot.generation << RESOURCE_HANDLE_INDEX_BITS) | index};
+    }
+
+    T *get(Handle handle) {
+        const Slot *slot = find(handle);
+        return slot ? &m_items[slot->dense] : nullptr;
+    }
+
+    const T *get(Handle handle) const {
+        const Slot *slot = find(handle);
+        return slot ? &m_items[slot->dense] : nullptr;
+    }
+
+    bool contains(Handle handle) const { return find(handle) != nullptr; }
+
+    /**
+     * @brief 删除句柄指向的元素，句柄立即失效
+     * @return 句柄无效时返回 false，否则把被删除的元素写入 removed
+     */
+    bool remove(Handle handle, T &removed) {
+        const Slot *found = find(handle);
+        if (found == nullptr) return false;
+        uint32_t dense = found->dense;
+        removed        = m_items[dense];
+        if (dense + 1 != m_items.size()) {
+            m_items[dense]                    = m_items.back();
+            m_itemSlots[dense]                = m_itemSlots.back();
+            m_slots[m_itemSlots[dense]].dense = dense;
+        }
+        m_items.pop_back();
+        m_itemSlots.pop_back();
+        Slot &slot      = m_slots[handle.getIndex()];
+        slot.generation = (slot.generation + 1) & RESOURCE_HANDLE_GENERATION_MASK;
+        if (slot.generation == 0) slot.generation = 1;
+        m_freeSlots.push_back(handle.getIndex());
+        return true;
+    }
+
+    void clear() {
+        for (uint32_t index : m_itemSlots) {
+            Slot &slot      = m_slots[index];
+            slot.generation = (slot.generation + 1) & RESOURCE_HANDLE_GENERATION_MASK;
+            if (slot.generation == 0) slot.generation = 1;
+            m_freeSlots.push_back(index);
+        }
+        m_items.clear();
+        m_itemSlots.clear();
+    }
+
+    Handle getHandle(size_t dense) const { // 紧密数组中第 dense 个元素的句柄
+        uint32_t index = m_itemSlots[dense];
+        return Handle{(m_slots[index].generation << RESOURCE_HANDLE_INDEX_BITS) | index};
+    }
+
+    std::span<T> getItems() { return m_items; }
+    std::span<const T> getItems() const { return m_items; }
+    size_t size() const { return m_items.size(); }
+
+private:
+    struct Slot {
+        uint32_t dense;      // 在紧密数组中的位置
+        uint32_t generation; // 当前有效句柄的代数
+    };
+
+    const Slot *find(Handle handle) const {
+        uint32_t index = handle.getIndex();
+        if (!handle || index >= m_slots.size()) return nullptr;
+        const Slot &slot = m_slots[index];
+        if (slot.generation != handle.getGeneration() || slot.dense >= m_items.size() || m_itemSlots[slot.dense] != index) return nullptr;
+        return &slot;
+    }
+
+#pragma region Menber Variables
+    std::vector<T> m_items;            // 紧密数组
+    std::vector<uint32_t> m_itemSlots; // 紧密数组中每个元素的槽位
+    std::vector<Slot> m_slots;         // 按槽位索引
+    std::vector<uint32_t> m_freeSlots; // 可复用的槽位
+#pragma endregion
+};
+
+/**
+ * @struct BufferResource
+ * @brief 注册表中的缓冲区
+ */
+struct BufferResource {
+    VkBuffer buffer          = VK_NULL_HANDLE;
+    VkDeviceMemory memory    = VK_NULL_HANDLE;
+    VkDeviceSize offset      = 0;          // 在 memory 中的偏移，独立分配时为 0
+    VkDeviceSize size        = 0;          // 创建时请求的字节数
+    VkDeviceSize memorySize  = 0;          // 实际分配的字节数
+    VkBufferUsageFlags usage = 0;
+    MemoryUsage memoryUsage  = MemoryUsage::GpuOnly;
+    uint32_t block           = UINT32_MAX; // 所在的内存块，UINT32_MAX 表示独立分配
+    bool relocatable         = false;      // 碎片整理时可以搬移
+};
+
+/**
+ * @struct ImageResource
+ * @brief 注册表中的二维图像
+ */
+struct ImageResource {
+    VkImage image           = VK_NULL_HANDLE;
+    VkDeviceMemory memory   = VK_NULL_HANDLE;
+    VkDeviceSize offset     = 0;                         // 在 memory 中的偏移，独立分配时为 0
+    VkDeviceSize memorySize = 0;                         // 实际分配的字节数
+    VkFormat format         = VK_FORMAT_UNDEFINED;
+    VkExtent2D extent       = {0, 0};
+    uint32_t mipLevels      = 1;
+    VkImageUsageFlags usage = 0;
+    MemoryUsage memoryUsage = MemoryUsage::GpuOnly;
+    uint32_t block          = UINT32_MAX;                // 所在的内存块，UINT32_MAX 表示独立分配
+    bool relocatable        = false;                     // 碎片整理时可以搬移
+    VkImageLayout layout    = VK_IMAGE_LAYOUT_UNDEFINED; // 可搬移的图像在帧与帧之间所处的布局
+};
+
+/**
+ * @struct PipelineResource
+ * @brief 注册表中的管线和它独占的管线布局
+ */
+struct PipelineResource {
+    VkPipeline pipeline           = VK_NULL_HANDLE;
+    VkPipelineLayout layout       = VK_NULL_HANDLE; // 为空时表示管线布局不由注册表管理
+    VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+};
+
+/**
+ * @struct SamplerResource
+ * @brief 注册表中的采样器，来自采样器缓存
+ */
+struct SamplerResource {
+    VkSampler sampler = VK_NULL_HANDLE;
+};
+
+using BufferHandle   = ResourceHandle<BufferResource>;
+using ImageHandle    = ResourceHandle<ImageResource>;
+using PipelineHandle = ResourceHandle<PipelineResource>;
+using SamplerHandle  = ResourceHandle<SamplerResource>;
+
+/**
+ * @struct ResourceRegistryStats
+ * @brief 注册表中存活的资源数量和显存
+ */
+struct ResourceRegistryStats {
+    uint32_t buffers         = 0;
+    uint32_t images          = 0;
+    uint32_t pipelines       = 0;
+    uint32_t samplers        = 0;
+    VkDeviceSize bufferBytes = 0; // 缓冲区实际分配的字节数
+    VkDeviceSize imageBytes  = 0; // 图像实际分配的字节数
+};
+
+/**
+ * @struct DefragmentationStats
+ * @brief 碎片整理的累计统计和最近一轮前后的内存块情况
+ */
+struct DefragmentationStats {
+    uint32_t passes         = 0; // 已完成的整理轮数
+    uint32_t movedResources = 0; // 累计搬移的资源数
+    VkDeviceSize movedBytes = 0; // 累计在 GPU 上复制的字节数
+    uint64_t lastPassFrames = 0; // 最近一轮从开始到空内存块释放经过的帧数
+    MemoryBlockStats before;     // 最近一轮开始时
+    MemoryBlockStats after;      // 最近一轮结束时
+};
+
+/**
+ * @class ResourceRegistry
+ * @brief 缓冲区、图像、管线和采样器的集中注册表，以 32 位代数句柄引用
+ *
+ * 每种资源存放在各自的 ResourcePool 中：查找为 O(1) 并校验句柄是否过期，统计和清理时线性遍历紧密数组。
+ * destroy() 立即使句柄失效，Vulkan 对象经由延迟销毁队列在 GPU 用完之后销毁。
+ * 注册表只能在渲染线程中访问；句柄本身可以复制到其他线程，例如放进渲染快照。
+ *
+ * GpuOnly 的缓冲区和图像从 MemoryBlockAllocator 的内存块中子分配，CPU 可见的资源需要单独映射，仍然独立分配。
+ * 创建时声明为可搬移的资源参与增量碎片整理：每帧在 recordDefragmentation() 中把稀疏内存块里的一部分资源
+ * 复制到新创建的对象，注册表中的记录原地更新，句柄保持有效；旧对象和旧内存在 GPU 用完之后释放，内存块清空后随之释放。
+ * 使用者每帧经由句柄取得 Vulkan 对象，对象变化时重建引用它的描述符集。
+ */
+class ResourceRegistry final {
+public:
+    explicit ResourceRegistry(VulkanRenderer &renderer);
+    ~ResourceRegistry();
+
+    ResourceRegistry(const ResourceRegistry &)            = delete;
+    ResourceRegistry &operator=(const ResourceRegistry &) = delete;
+    ResourceRegistry(ResourceRegistry &&)                 = delete;
+    ResourceRegistry &operator=(ResourceRegistry &&)      = delete;
+
+    BufferHandle createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, MemoryUsage memoryUsage, bool relocatable = false); // 只有 GpuOnly 的资源可以搬移
+
+    /**
+     * @brief 创建二维图像
+     * @param relocatableLayout 图像在帧与帧之间所处的布局，传入时允许碎片整理搬移；只支持 GpuOnly 的颜色图像
+     */
+    ImageHandle createImage(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage, MemoryUsage memoryUsage, uint32_t mipLevels = 1,
+                            VkImageLayout relocatableLayout = VK_IMAGE_LAYOUT_UNDEFINED);
+    PipelineHandle addPipeline(VkPipeline pipeline, VkPipelineLayout layout, VkPipelineBindPoint bindPoint); // 接管管线和布局的所有权，共享的布局传 VK_NULL_HANDLE
+    SamplerHandle createSampler(const VkSamplerCreateInfo &createInfo);                                     // 经由采样器缓存去重
+
+    void destroy(BufferHandle handle); // 句柄无效时什么都不做
+    void destroy(ImageHandle handle);
+    void destroy(PipelineHandle handle);
+    void destroy(SamplerHandle handle);
+    void cleanup(); // 立即销毁所有资源，调用前设备必须空闲
+
+    const BufferResource *get(BufferHandle handle) const { return m_buffers.get(handle); } // 句柄过期时返回 nullptr
+    const ImageResource *get(ImageHandle handle) const { return m_images.get(handle); }
+    const PipelineResource *get(PipelineHandle handle) const { return m_pipelines.get(handle); }
+    const SamplerResource *get(SamplerHandle handle) const { return m_samplers.get(handle); }
+    VkBuffer getBuffer(BufferHandle handle) const;       // 句柄过期时返回 VK_NULL_HANDLE
+    VkImage getImage(ImageHandle handle) const;
+    VkPipeline getPipeline(PipelineHandle handle) const;
+    VkSampler getSampler(SamplerHandle handle) const;
+
+    std::span<const BufferResource> getBuffers() const { return m_buffers.getItems(); } // 紧密数组，顺序在删除后会改变
+    std::span<const ImageResource> getImages() const { return m_images.getItems(); }
+    std::span<const PipelineResource> getPipelines() const { return m_pipelines.getItems(); }
+    std::span<const SamplerResource> getSamplers() const { return m_samplers.getItems(); }
+    ResourceRegistryStats getStats() const;
+
+    bool beginDefragmentation();                               // 选出稀疏内存块开始一轮整理，正在整理或没有值得整理的内存块时返回 false
+    void recordDefragmentation(VkCommandBuffer commandBuffer); // 每帧在其他命令之前调用：按帧预算搬移资源，开启自动整理时定期检查碎片情况
+    void setAutoDefragmentation(bool enabled) { m_autoDefragmentation = enabled; }
+    bool isDefragmenting() const { return m_defragmentationPhase != DefragmentationPhase::Idle; }
+    const DefragmentationStats &getDefragmentationStats() const { return m_defragmentationStats; }
+    MemoryBlockStats getMemoryBlockStats() const { return m_allocator.getStats(); }
+
+private:
+    enum class DefragmentationPhase : uint8_t {
+        Idle,
+        Moving,  // 每帧搬移一部分资源
+        Draining // 资源都已搬走，等旧内存在 GPU 用完之后释放
+    };
+
+    struct BufferMove {
+        BufferResource from;
+        VkBuffer to;
+    };
+
+    struct ImageMove {
+        ImageResource from;
+        VkImage to;
+    };
+
+    bool createBufferObject(BufferResource &buffer); // 创建 Vulkan 对象并分配、绑定内存，失败时返回 false 且不留下任何对象
+    bool createImageObject(ImageResource &image);
+    bool allocateMemory(const VkMemoryRequirements &requirements, MemoryUsage memoryUsage, MemoryCategory category, bool movable, VkDeviceMemory &memory,
+                        VkDeviceSize &offset, uint32_t &block);
+    void freeMemory(VkDeviceMemory memory, VkDeviceSize offset, VkDeviceSize size, uint32_t block, bool movable);
+    void recordMoves(VkCommandBuffer commandBuffer, const std::vector<BufferMove> &bufferMoves, const std::vector<ImageMove> &imageMoves);
+    void endMoving(); // 等本轮所有旧内存释放之后结束整理并输出前后对比
+    void finishDefragmentation();
+
+    void destroyNow(const BufferResource &buffer);
+    void destroyNow(const ImageResource &image);
+    void destroyNow(const PipelineResource &pipeline);
+    void destroyNow(const SamplerResource &sampler);
+
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer;
+    MemoryBlockAllocator m_allocator; // GpuOnly 资源的子分配
+    ResourcePool<BufferResource> m_buffers;
+    ResourcePool<ImageResource> m_images;
+    ResourcePool<PipelineResource> m_pipelines;
+    ResourcePool<SamplerResource> m_samplers;
+
+    DefragmentationPhase m_defragmentationPhase = DefragmentationPhase::Idle;
+    std::vector<uint32_t> m_defragmentationBlocks; // 本轮要清空的内存块
+    uint64_t m_defragmentationStartFrame        = 0;
+    bool m_autoDefragmentation                  = true;
+    DefragmentationStats m_defragmentationStats;
+#pragma endregion
+};
+
+} // namespace engine::render
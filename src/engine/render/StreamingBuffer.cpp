@@ -0,0 +1,155 @@
+#include "StreamingBuffer.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace engine::render {
+
+namespace {
+VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+VkDeviceSize alignDown(VkDeviceSize value, VkDeviceSize alignment) {
+    return value & ~(alignment - 1);
+}
+} // namespace
+
+StreamingBuffer::StreamingBuffer(VulkanRenderer &renderer, VkDeviceSize capacity, VkBufferUsageFlags usage)
+    : m_renderer(renderer), m_capacity(capacity) {
+    VkDevice device = m_renderer.getDevice();
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size        = m_capacity;                // 设置缓冲区大小
+    bufferInfo.usage       = usage;                     // 设置缓冲区用途
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE; // 设置共享模式
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &m_buffer) != VK_SUCCESS) {
+        throw std::runtime_error("StreamingBuffer::StreamingBuffer()::创建流式缓冲区失败");
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, m_buffer, &memRequirements);
+    // 优先选择 GPU 本地且 CPU 可见的内存（ReBAR / 统一内存架构），GPU 读取更快；不一致的内存在 endFrame() 时刷新
+    const MemoryTypePolicy &memoryTypePolicy = m_renderer.getMemoryTypePolicy();
+    uint32_t memoryTypeIndex                 = memoryTypePolicy.selectMemoryType(memRequirements.memoryTypeBits, MemoryUsage::Streaming);
+    if (memoryTypeIndex == UINT32_MAX) {
+        throw std::runtime_error("StreamingBuffer::StreamingBuffer()::找不到 CPU 可见的内存类型");
+    }
+    m_coherent = (memoryTypePolicy.getPropertyFlags(memoryTypeIndex) & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(m_renderer.getPhysicalDevice(), &properties);
+    m_atomSize = std::max<VkDeviceSize>(properties.limits.nonCoherentAtomSize, 1);
+
+    if (m_renderer.allocateMemory(memRequirements.size, memoryTypeIndex, MemoryCategory::Buffers, m_memory) != VK_SUCCESS) {
+        throw std::runtime_error("StreamingBuffer::StreamingBuffer()::分配流式缓冲区内存失败");
+    }
+    m_allocationSize = memRequirements.size;
+    vkBindBufferMemory(device, m_buffer, m_memory, 0);
+
+    void *data;
+    if (vkMapMemory(device, m_memory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS) {
+        throw std::runtime_error("StreamingBuffer::StreamingBuffer()::映射流式缓冲区失败");
+    }
+    m_mapped = static_cast<char *>(data); // 持久映射，直到 cleanup() 才解除
+    spdlog::trace("StreamingBuffer::StreamingBuffer()::创建流式缓冲区成功, 容量: {} 字节, 内存类型: {}, 一致性: {}",
+                  m_capacity, memoryTypeIndex, m_coherent);
+}
+
+StreamingBuffer::~StreamingBuffer() = default;
+
+void StreamingBuffer::cleanup() {
+    VkDevice device = m_renderer.getDevice();
+    if (m_mapped != nullptr) {
+        vkUnmapMemory(device, m_memory);
+        m_mapped = nullptr;
+    }
+    vkDestroyBuffer(device, m_buffer, nullptr);
+    m_renderer.freeMemory(m_memory);
+    m_buffer = VK_NULL_HANDLE;
+    m_memory = VK_NULL_HANDLE;
+    spdlog::trace("StreamingBuffer::cleanup()::流式缓冲区已销毁, 峰值占用: {} / {} 字节", m_peakUsedBytes, m_capacity);
+}
+
+StreamingAllocation StreamingBuffer::reserve(VkDeviceSize size, VkDeviceSize alignment) {
+    if (size == 0 || size > m_capacity) {
+        throw std::runtime_error("StreamingBuffer::reserve()::请求大小无效或超过缓冲区容量");
+    }
+    if (m_usedBytes == 0) {
+        m_head         = 0; // 缓冲区已全部回收，从头开始以减少回绕
+        m_pendingStart = 0;
+    }
+
+    VkDeviceSize offset   = alignUp(m_head, alignment);
+    bool wraps            = offset + size > m_capacity;
+    VkDeviceSize consumed = wraps ? (m_capacity - m_head) + size : (offset - m_head) + size; // 回绕时尾部剩余空间作废
+    if (wraps) offset = 0;
+    if (m_usedBytes + consumed > m_capacity) {
+        spdlog::warn("StreamingBuffer::reserve()::流式缓冲区空间不足, 请求: {} 字节, 已占用: {} / {} 字节", size, m_usedBytes, m_capacity);
+        return {};
+    }
+
+    m_usedBytes += consumed;
+    m_pendingBytes += consumed;
+
+    m_head           = offset + size;
+    m_pendingWrapped = m_pendingWrapped || wraps;
+    m_peakUsedBytes  = std::max(m_peakUsedBytes, m_usedBytes);
+
+    StreamingAllocation allocation;
+    allocation.buffer = m_buffer;
+    allocation.offset = offset;
+    allocation.size   = size;
+    allocation.data   = m_mapped + offset;
+    return allocation;
+}
+
+StreamingAllocation StreamingBuffer::upload(const void *data, VkDeviceSize size, VkDeviceSize alignment) {
+    StreamingAllocation allocation = reserve(size, alignment);
+    if (allocation) {
+        memcpy(allocation.data, data, static_cast<size_t>(size));
+    }
+    return allocation;
+}
+
+void StreamingBuffer::beginFrame(uint32_t frameIndex) {
+    m_usedBytes -= m_frameBytes[frameIndex];
+    m_frameBytes[frameIndex] = 0;
+}
+
+void StreamingBuffer::endFrame(uint32_t frameIndex) {
+    if (!m_coherent && m_pendingBytes > 0) {
+        if (m_pendingWrapped) {
+            flushRange(m_pendingStart, m_capacity);
+            flushRange(0, m_head);
+        } else {
+            flushRange(m_pendingStart, m_head);
+        }
+    }
+    m_frameBytes[frameIndex] += m_pendingBytes;
+
+    m_pendingBytes   = 0;
+    m_pendingStart   = m_head;
+    m_pendingWrapped = false;
+}
+
+void StreamingBuffer::flushRange(VkDeviceSize begin, VkDeviceSize end) {
+    if (begin >= end) return;
+    // 刷新范围必须按 nonCoherentAtomSize 对齐，末尾超出分配大小时改用 VK_WHOLE_SIZE
+    VkDeviceSize alignedBegin = alignDown(begin, m_atomSize);
+    VkDeviceSize alignedEnd   = alignUp(end, m_atomSize);
+    VkMappedMemoryRange range{};
+    range.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    range.memory = m_memory;
+    range.offset = alignedBegin;
+    range.size   = alignedEnd >= m_allocationSize ? VK_WHOLE_SIZE : alignedEnd - alignedBegin;
+    if (vkFlushMappedMemoryRanges(m_renderer.getDevice(), 1, &range) != VK_SUCCESS) {
+        throw std::runtime_error("StreamingBuffer::flushRange()::刷新映射内存失败");
+    }
+}
+
+} // namespace engine::render
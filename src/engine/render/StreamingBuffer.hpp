@@ -0,0 +1,92 @@
+#pragma once
+#include "RenderConstants.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+
+namespace engine::render {
+class VulkanRenderer;
+
+#pragma region Constants
+const VkDeviceSize STREAMING_BUFFER_SIZE      = 4 * 1024 * 1024; // 流式缓冲区默认容量（字节）
+const VkDeviceSize STREAMING_BUFFER_ALIGNMENT = 16;              // reserve() 默认对齐
+#pragma endregion
+
+/**
+ * @struct StreamingAllocation
+ * @brief reserve() 返回的一段可直接写入的缓冲区空间
+ */
+struct StreamingAllocation {
+    VkBuffer buffer     = VK_NULL_HANDLE; // 绑定用的缓冲区句柄
+    VkDeviceSize offset = 0;              // 在缓冲区中的偏移，可直接用于 vkCmdBindVertexBuffers/vkCmdBindIndexBuffer
+    VkDeviceSize size   = 0;              // 分配的字节数
+    void *data          = nullptr;        // 持久映射的 CPU 地址
+
+    explicit operator bool() const { return data != nullptr; }
+};
+
+/**
+ * @class StreamingBuffer
+ * @brief 持久映射的环形缓冲区，用于每帧变化的顶点和索引数据
+ *
+ * 缓冲区创建时映射一次，之后每帧只需 reserve() 并直接写入，不再重复 map/unmap。
+ * 每段分配记入提交它的帧上下文，该帧的 Fence 等待完成后（beginFrame）才回收其空间。
+ * 内存不是 HOST_COHERENT 时，endFrame() 会在提交前刷新本帧写入的范围。
+ */
+class StreamingBuffer final {
+public:
+    StreamingBuffer(VulkanRenderer &renderer, VkDeviceSize capacity = STREAMING_BUFFER_SIZE,
+                    VkBufferUsageFlags usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+    ~StreamingBuffer();
+
+    StreamingBuffer(const StreamingBuffer &)            = delete;
+    StreamingBuffer &operator=(const StreamingBuffer &) = delete;
+    StreamingBuffer(StreamingBuffer &&)                 = delete;
+    StreamingBuffer &operator=(StreamingBuffer &&)      = delete;
+
+    void cleanup();
+
+    /**
+     * @brief 预留一段空间，调用方直接写入 data
+     * @param alignment 必须是 2 的幂；索引数据至少按索引类型大小对齐
+     * @return 空间不足时返回空分配（operator bool 为 false）
+     */
+    StreamingAllocation reserve(VkDeviceSize size, VkDeviceSize alignment = STREAMING_BUFFER_ALIGNMENT);
+    StreamingAllocation upload(const void *data, VkDeviceSize size, VkDeviceSize alignment = STREAMING_BUFFER_ALIGNMENT); // 预留并复制数据
+
+    void beginFrame(uint32_t frameIndex); // 该帧的 Fence 已等待完成，回收它上一轮使用的空间
+    void endFrame(uint32_t frameIndex);   // 提交前调用：刷新非一致性内存，把本帧的分配记入该帧上下文
+
+    VkBuffer getBuffer() const { return m_buffer; }
+    VkDeviceSize getCapacity() const { return m_capacity; }
+    VkDeviceSize getUsedBytes() const { return m_usedBytes; }
+    VkDeviceSize getPeakUsedBytes() const { return m_peakUsedBytes; }
+    bool isCoherent() const { return m_coherent; }
+
+private:
+    void flushRange(VkDeviceSize begin, VkDeviceSize end);
+
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer;
+
+    VkBuffer m_buffer             = VK_NULL_HANDLE;
+    VkDeviceMemory m_memory       = VK_NULL_HANDLE;
+    VkDeviceSize m_capacity       = 0;       // 可用容量
+    VkDeviceSize m_allocationSize = 0;       // 实际分配的内存大小
+    VkDeviceSize m_atomSize       = 1;       // nonCoherentAtomSize，刷新范围的对齐单位
+    bool m_coherent               = true;    // 内存是否为 HOST_COHERENT
+    char *m_mapped                = nullptr; // 持久映射地址
+
+    VkDeviceSize m_head          = 0;     // 下一次分配的起始位置
+    VkDeviceSize m_usedBytes     = 0;     // 尚未回收的字节数（含对齐和回绕浪费的空间）
+    VkDeviceSize m_peakUsedBytes = 0;     // 历史最大占用
+    VkDeviceSize m_pendingStart  = 0;     // 本帧第一段分配的起始位置
+    VkDeviceSize m_pendingBytes  = 0;     // 本帧分配的字节数
+    bool m_pendingWrapped        = false; // 本帧分配是否回绕到了缓冲区开头
+
+    std::array<VkDeviceSize, MAX_FRAMES_IN_FLIGHT> m_frameBytes{}; // 每个帧上下文占用、等待 Fence 后回收的字节数
+#pragma endregion
+};
+
+} // namespace engine::render
@@ -0,0 +1,650 @@
+#include "TextRenderer.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace engine::render {
+
+namespace {
+// 与 text 系列着色器中的 push_constant 布局一致
+struct TextPushConstants {
+    glm::vec2 viewportSize;
+};
+
+uint32_t packColor(const glm::vec4 &color) {
+    auto channel = [](float value) { return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+    return channel(color.r) | channel(color.g) << 8 | channel(color.b) << 16 | channel(color.a) << 24;
+}
+
+uint64_t glyphKey(uint32_t font, uint32_t codepoint) {
+    return static_cast<uint64_t>(font) << 32 | codepoint;
+}
+
+const size_t BITMAP_ATLAS = 0; // m_instances、m_pipelines 等数组的下标
+const size_t SDF_ATLAS    = 1;
+const float EDT_INF       = 1e20f;
+
+int floorDiv(int value, int divisor) {
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+/**
+ * 一维平方欧氏距离变换（Felzenszwalb & Huttenlocher），f 为每个位置的初始代价，结果写入 d
+ */
+void distanceTransform1D(const float *f, float *d, int *v, float *z, int n) {
+    int k = 0;
+    v[0]  = 0;
+    z[0]  = -EDT_INF;
+    z[1]  = EDT_INF;
+    for (int q = 1; q < n; q++) {
+        float s = ((f[q] + static_cast<float>(q * q)) - (f[v[k]] + static_cast<float>(v[k] * v[k]))) / static_cast<float>(2 * q - 2 * v[k]);
+        while (s <= z[k]) {
+            k--;
+            s = ((f[q] + static_cast<float>(q * q)) - (f[v[k]] + static_cast<float>(v[k] * v[k]))) / static_cast<float>(2 * q - 2 * v[k]);
+        }
+        k++;
+        v[k]     = q;
+        z[k]     = s;
+        z[k + 1] = EDT_INF;
+    }
+    k = 0;
+    for (int q = 0; q < n; q++) {
+        while (z[k + 1] < static_cast<float>(q)) k++;
+        d[q] = static_cast<float>((q - v[k]) * (q - v[k])) + f[v[k]];
+    }
+}
+
+/**
+ * 二维平方距离变换：grid 中为 0 的像素是目标，返回每个像素到最近目标像素中心的平方距离
+ */
+void distanceTransform2D(std::vector<float> &grid, int width, int height) {
+    int length = std::max(width, height);
+    std::vector<float> f(length), d(length), z(length + 1);
+    std::vector<int> v(length);
+    for (int x = 0; x < width; x++) {
+        for (int y = 0; y < height; y++) f[y] = grid[y * width + x];
+        distanceTransform1D(f.data(), d.data(), v.data(), z.data(), height);
+        for (int y = 0; y < height; y++) grid[y * width + x] = d[y];
+    }
+    for (int y = 0; y < height; y++) {
+        distanceTransform1D(&grid[y * width], d.data(), v.data(), z.data(), width);
+        std::copy(d.begin(), d.begin() + width, grid.begin() + y * width);
+    }
+}
+
+/**
+ * 把放大 TEXT_SDF_SUPERSAMPLE 倍光栅化的覆盖率位图转换为原字号的有符号距离场
+ *
+ * 在放大的网格上分别计算到轮廓内外的精确距离，再按块平均缩小；输出四周各留 TEXT_SDF_SPREAD 像素，
+ * 0.5 对应轮廓，1 表示在轮廓内 TEXT_SDF_SPREAD 像素以上。可以在任意线程调用。
+ */
+GlyphBitmap generateSdf(const GlyphBitmap &coverage) {
+    const int scale  = static_cast<int>(TEXT_SDF_SUPERSAMPLE);
+    const int spread = static_cast<int>(TEXT_SDF_SPREAD);
+    GlyphBitmap sdf;
+    sdf.advance = coverage.advance / static_cast<float>(scale);
+    if (coverage.width == 0 || coverage.height == 0) return sdf;
+
+    // 输出像素与放大网格按整块对齐
+    int left     = floorDiv(coverage.offsetX, scale) - spread;
+    int top      = floorDiv(coverage.offsetY, scale) - spread;
+    int right    = floorDiv(coverage.offsetX + static_cast<int>(coverage.width) + scale - 1, scale) + spread;
+    int bottom   = floorDiv(coverage.offsetY + static_cast<int>(coverage.height) + scale - 1, scale) + spread;
+    int width    = right - left;
+    int height   = bottom - top;
+    int hiWidth  = width * scale;
+    int hiHeight = height * scale;
+    int originX  = coverage.offsetX - left * scale;
+    int originY  = coverage.offsetY - top * scale;
+
+    std::vector<float> inside(static_cast<size_t>(hiWidth) * hiHeight, EDT_INF);  // 到最近的轮廓内像素
+    std::vector<float> outside(static_cast<size_t>(hiWidth) * hiHeight, 0.0f);    // 到最近的轮廓外像素
+    for (uint32_t y = 0; y < coverage.height; y++) {
+        for (uint32_t x = 0; x < coverage.width; x++) {
+            if (coverage.pixels[y * coverage.width + x] < 128) continue;
+            size_t index   = static_cast<size_t>(originY + static_cast<int>(y)) * hiWidth + originX + static_cast<int>(x);
+            inside[index]  = 0.0f;
+            outside[index] = EDT_INF;
+        }
+    }
+    distanceTransform2D(inside, hiWidth, hiHeight);
+    distanceTransform2D(outside, hiWidth, hiHeight);
+
+    sdf.width   = static_cast<uint32_t>(width);
+    sdf.height  = static_cast<uint32_t>(height);
+    sdf.offsetX = left;
+    sdf.offsetY = top;
+    sdf.pixels.resize(static_cast<size_t>(width) * height);
+    float invBlock = 1.0f / static_cast<float>(scale * scale * scale); // 块内求平均，再换算到原字号像素
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            float distance = 0.0f; // 轮廓外为正
+            for (int by = 0; by < scale; by++) {
+                for (int bx = 0; bx < scale; bx++) {
+                    size_t index = static_cast<size_t>(y * scale + by) * hiWidth + x * scale + bx;
+                    distance += inside[index] > 0.0f ? std::sqrt(inside[index]) - 0.5f : 0.5f - std::sqrt(outside[index]);
+                }
+            }
+            float value               = 0.5f - distance * invBlock / (2.0f * static_cast<float>(spread));
+            sdf.pixels[y * width + x] = static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+    }
+    return sdf;
+}
+} // namespace
+
+TextRenderer::TextRenderer(VulkanRenderer &renderer) : m_renderer(renderer) {}
+
+TextRenderer::~TextRenderer() = default;
+
+void TextRenderer::init() {
+    if (!TTF_Init()) {
+        throw std::runtime_error(std::string("TextRenderer::init()::初始化 SDL_ttf 失败: ") + SDL_GetError());
+    }
+    m_ttfInitialized = true;
+
+    m_glyphCache = std::make_unique<GlyphCache>(m_renderer);
+    m_glyphCache->init();
+    m_glyphCache->beginFrame(m_frameNumber);
+
+    VkDevice device = m_renderer.getDevice();
+    VkDescriptorSetLayoutBinding binding{};
+    binding.binding         = 0;
+    binding.descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    binding.descriptorCount = 1;
+    binding.stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT;
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings    = &binding;
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &m_descriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("TextRenderer::init()::创建描述符集布局失败");
+    }
+
+    VkDescriptorPoolSize poolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, static_cast<uint32_t>(m_descriptorSets.size())};
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets       = static_cast<uint32_t>(m_descriptorSets.size());
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes    = &poolSize;
+    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &m_descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("TextRenderer::init()::创建描述符池失败");
+    }
+
+    VkPushConstantRange pushConstantRange{VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(TextPushConstants)};
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount         = 1;
+    pipelineLayoutInfo.pSetLayouts            = &m_descriptorSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges    = &pushConstantRange;
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &m_pipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("TextRenderer::init()::创建管线布局失败");
+    }
+    createPipelines();
+
+    // 位图字形按像素对齐放置，线性过滤只在缩放时起作用；距离场必须线性插值
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter    = VK_FILTER_LINEAR;
+    samplerInfo.minFilter    = VK_FILTER_LINEAR;
+    samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    m_sampler                = m_renderer.getSamplerCache().acquire(samplerInfo);
+
+    m_descriptorSets[BITMAP_ATLAS] = allocateDescriptorSet(m_glyphCache->getImageView());
+    spdlog::trace("TextRenderer::init()::文字渲染初始化成功");
+}
+
+VkDescriptorSet TextRenderer::allocateDescriptorSet(VkImageView atlasView) {
+    VkDevice device               = m_renderer.getDevice();
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool     = m_descriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts        = &m_descriptorSetLayout;
+    if (vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet) != VK_SUCCESS) {
+        throw std::runtime_error("TextRenderer::allocateDescriptorSet()::分配描述符集失败");
+    }
+    VkDescriptorImageInfo atlasInfo{m_sampler, atlasView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+    VkWriteDescriptorSet write{};
+    write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet          = descriptorSet;
+    write.dstBinding      = 0;
+    write.descriptorCount = 1;
+    write.descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo      = &atlasInfo;
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+    return descriptorSet;
+}
+
+void TextRenderer::createSdfCache() {
+    m_sdfCache = std::make_unique<GlyphCache>(m_renderer);
+    m_sdfCache->init();
+    m_sdfCache->beginFrame(m_frameNumber);
+    m_descriptorSets[SDF_ATLAS] = allocateDescriptorSet(m_sdfCache->getImageView());
+}
+
+void TextRenderer::cleanup() {
+    VkDevice device = m_renderer.getDevice();
+    for (VkPipeline &pipeline : m_pipelines) {
+        vkDestroyPipeline(device, pipeline, nullptr);
+        pipeline = VK_NULL_HANDLE;
+    }
+    vkDestroyPipelineLayout(device, m_pipelineLayout, nullptr);
+    vkDestroyDescriptorPool(device, m_descriptorPool, nullptr); // 同时释放描述符集
+    vkDestroyDescriptorSetLayout(device, m_descriptorSetLayout, nullptr);
+    if (m_sampler != VK_NULL_HANDLE) m_renderer.getSamplerCache().release(m_sampler);
+    if (m_glyphCache) m_glyphCache->cleanup();
+    if (m_sdfCache) m_sdfCache->cleanup();
+    m_pipelineLayout      = VK_NULL_HANDLE;
+    m_descriptorPool      = VK_NULL_HANDLE;
+    m_descriptorSets      = {};
+    m_descriptorSetLayout = VK_NULL_HANDLE;
+    m_sampler             = VK_NULL_HANDLE;
+
+    for (Font &font : m_fonts) {
+        TTF_CloseFont(font.font);
+    }
+    m_fonts.clear();
+    if (m_ttfInitialized) TTF_Quit();
+    m_ttfInitialized = false;
+}
+
+void TextRenderer::createPipelines() {
+    VkDevice device                 = m_renderer.getDevice();
+    VkShaderModule vertShaderModule = m_renderer.createShaderModule(VulkanRenderer::readFile("assets/shaders/text.vert.spv"));
+    std::array<VkShaderModule, 2> fragShaderModules{};
+    fragShaderModules[BITMAP_ATLAS] = m_renderer.createShaderModule(VulkanRenderer::readFile("assets/shaders/text.frag.spv"));
+    fragShaderModules[SDF_ATLAS]    = m_renderer.createShaderModule(VulkanRenderer::readFile("assets/shaders/text_sdf.frag.spv"));
+
+    std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages{};
+    shaderStages[0].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStages[0].stage  = VK_SHADER_STAGE_VERTEX_BIT;
+    shaderStages[0].module = vertShaderModule;
+    shaderStages[0].pName  = "main";
+    shaderStages[1].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStages[1].stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
+    shaderStages[1].pName  = "main";
+
+    auto bindingDescription    = TextInstance::getBindingDescription();
+    auto attributeDescriptions = TextInstance::getAttributeDescriptions();
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+    vertexInputInfo.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInputInfo.vertexBindingDescriptionCount   = 1;
+    vertexInputInfo.pVertexBindingDescriptions      = &bindingDescription;
+    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+    vertexInputInfo.pVertexAttributeDescriptions    = attributeDescriptions.data();
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewportState{};
+    viewportState.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount  = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterizer{};
+    rasterizer.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.lineWidth   = 1.0f;
+    rasterizer.cullMode    = VK_CULL_MODE_NONE;
+    rasterizer.frontFace   = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+    VkPipelineMultisampleStateCreateInfo multisampling{};
+    multisampling.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    // 文字总是画在场景之上，不做深度测试
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.sType            = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable  = VK_FALSE;
+    depthStencil.depthWriteEnable = VK_FALSE;
+
+    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+    colorBlendAttachment.colorWriteMask      = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    colorBlendAttachment.blendEnable         = VK_TRUE;
+    colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.colorBlendOp        = VK_BLEND_OP_ADD;
+    colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.alphaBlendOp        = VK_BLEND_OP_ADD;
+    VkPipelineColorBlendStateCreateInfo colorBlending{};
+    colorBlending.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlending.attachmentCount = 1;
+    colorBlending.pAttachments    = &colorBlendAttachment;
+
+    std::array<VkDynamicState, 2> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+    dynamicState.pDynamicStates    = dynamicStates.data();
+
+    // 两条管线只有片段着色器不同：位图覆盖率，或者从距离场重建轮廓
+    VkResult result = VK_SUCCESS;
+    for (size_t i = 0; i < m_pipelines.size() && result == VK_SUCCESS; i++) {
+        shaderStages[1].module = fragShaderModules[i];
+
+        VkGraphicsPipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineInfo.stageCount          = static_cast<uint32_t>(shaderStages.size());
+        pipelineInfo.pStages             = shaderStages.data();
+        pipelineInfo.pVertexInputState   = &vertexInputInfo;
+        pipelineInfo.pInputAssemblyState = &inputAssembly;
+        pipelineInfo.pViewportState      = &viewportState;
+        pipelineInfo.pRasterizationState = &rasterizer;
+        pipelineInfo.pMultisampleState   = &multisampling;
+        pipelineInfo.pDepthStencilState  = &depthStencil;
+        pipelineInfo.pColorBlendState    = &colorBlending;
+        pipelineInfo.pDynamicState       = &dynamicState;
+        pipelineInfo.layout              = m_pipelineLayout;
+        pipelineInfo.renderPass          = m_renderer.getSceneRenderPass(); // 与加载已有内容的渲染通道兼容
+        pipelineInfo.subpass             = 0;
+        result = vkCreateGraphicsPipelines(device, m_renderer.getPipelineCache(), 1, &pipelineInfo, nullptr, &m_pipelines[i]);
+    }
+    for (VkShaderModule fragShaderModule : fragShaderModules) {
+        vkDestroyShaderModule(device, fragShaderModule, nullptr);
+    }
+    vkDestroyShaderModule(device, vertShaderModule, nullptr);
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error("TextRenderer::createPipelines()::创建文字管线失败");
+    }
+}
+
+uint32_t TextRenderer::loadFont(const std::string &path, float pointSize) {
+    TTF_Font *font = TTF_OpenFont(path.c_str(), pointSize);
+    if (font == nullptr) {
+        throw std::runtime_error("TextRenderer::loadFont()::加载字体失败: " + path + ", " + SDL_GetError());
+    }
+    Font entry;
+    entry.font     = font;
+    entry.lineSkip = static_cast<float>(TTF_GetFontLineSkip(font));
+    m_fonts.push_back(std::move(entry));
+    spdlog::info("TextRenderer::loadFont()::加载字体: {}, 字号: {}", path, pointSize);
+    return static_cast<uint32_t>(m_fonts.size() - 1);
+}
+
+uint32_t TextRenderer::loadSdfFont(engine::core::JobSystem &jobSystem, const std::string &path, std::string_view charset) {
+    auto start     = std::chrono::steady_clock::now();
+    TTF_Font *font = TTF_OpenFont(path.c_str(), TEXT_SDF_BASE_SIZE * static_cast<float>(TEXT_SDF_SUPERSAMPLE));
+    if (font == nullptr) {
+        throw std::runtime_error("TextRenderer::loadSdfFont()::加载字体失败: " + path + ", " + SDL_GetError());
+    }
+    if (!m_sdfCache) createSdfCache();
+
+    Font entry;
+    entry.font        = font;
+    entry.metricScale = 1.0f / static_cast<float>(TEXT_SDF_SUPERSAMPLE);
+    entry.lineSkip    = static_cast<float>(TTF_GetFontLineSkip(font)) * entry.metricScale;
+    entry.sdf         = true;
+    m_fonts.push_back(std::move(entry));
+    uint32_t fontIndex = static_cast<uint32_t>(m_fonts.size() - 1);
+
+    std::vector<uint32_t> codepoints;
+    const char *cursor = charset.data();
+    size_t remaining   = charset.size();
+    while (remaining > 0) {
+        uint32_t codepoint = SDL_StepUTF8(&cursor, &remaining);
+        if (codepoint == 0) break;
+        codepoints.push_back(codepoint);
+    }
+    std::sort(codepoints.begin(), codepoints.end());
+    codepoints.erase(std::unique(codepoints.begin(), codepoints.end()), codepoints.end());
+
+    // TTF_Font 不是线程安全的，光栅化留在当前线程；耗时的距离变换分给工作线程
+    std::vector<GlyphBitmap> bitmaps(codepoints.size());
+    for (size_t i = 0; i < codepoints.size(); i++) {
+        bitmaps[i] = rasterizeGlyph(font, codepoints[i]);
+    }
+    jobSystem.parallelFor(static_cast<uint32_t>(bitmaps.size()), 4, [&bitmaps](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            bitmaps[i] = generateSdf(bitmaps[i]);
+        }
+    });
+
+    uint32_t failed = 0;
+    for (size_t i = 0; i < codepoints.size(); i++) {
+        if (m_sdfCache->insert(glyphKey(fontIndex, codepoints[i]), bitmaps[i]) == nullptr) failed++;
+    }
+    m_stats.sdfGlyphs += codepoints.size() - failed;
+    if (failed > 0) {
+        spdlog::warn("TextRenderer::loadSdfFont()::SDF 图集已满, 未能放入的字形: {}", failed);
+    }
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    spdlog::info("TextRenderer::loadSdfFont()::加载 SDF 字体: {}, 字形: {}, 耗时: {:.1f} ms", path, codepoints.size(), elapsed);
+    return fontIndex;
+}
+
+void TextRenderer::drawText(uint32_t font, std::string_view text, const glm::vec2 &position, const glm::vec4 &color, float scale) {
+    const TextLayout &layout           = getLayout(font, text);
+    std::vector<TextInstance> &targets = m_instances[m_fonts[font].sdf ? SDF_ATLAS : BITMAP_ATLAS];
+    uint32_t packed                    = packColor(color);
+    glm::vec2 origin(std::round(position.x), std::round(position.y)); // 对齐到像素，位图字形不会被过滤模糊
+    for (const TextQuad &quad : layout.quads) {
+        glm::vec4 rect(glm::vec2(quad.rect) * scale + origin, glm::vec2(quad.rect.z, quad.rect.w) * scale);
+        targets.push_back({rect, quad.uv, packed});
+    }
+}
+
+glm::vec2 TextRenderer::measureText(uint32_t font, std::string_view text, float scale) {
+    return getLayout(font, text).size * scale;
+}
+
+TextRenderer::TextLayout &TextRenderer::getLayout(uint32_t font, std::string_view text) {
+    if (font >= m_fonts.size()) {
+        throw std::runtime_error("TextRenderer::getLayout()::无效的字体编号");
+    }
+    auto &layouts = m_fonts[font].layouts;
+    auto it       = layouts.find(text);
+    bool created  = it == layouts.end();
+    if (created) {
+        it = layouts.emplace(std::string(text), TextLayout{}).first;
+        m_stats.cachedLayouts++;
+    }
+    TextLayout &layout = it->second;
+
+    // 图集淘汰过字形后，缓存的纹理坐标可能已经指向其他字形
+    GlyphCache &cache = getCache(font);
+    if (created || !layout.complete || layout.generation != cache.getGeneration()) {
+        m_stats.layoutMisses++;
+        buildLayout(font, text, layout);
+    } else {
+        m_stats.layoutHits++;
+        for (uint32_t shelf : layout.shelves) {
+            cache.touchShelf(shelf);
+        }
+    }
+    layout.lastUsedFrame = m_frameNumber;
+    return layout;
+}
+
+void TextRenderer::buildLayout(uint32_t font, std::string_view text, TextLayout &layout) {
+    const Font &fontInfo = m_fonts[font];
+    GlyphCache &cache    = getCache(font);
+    float atlasScale     = 1.0f / static_cast<float>(cache.getSize());
+    layout.quads.clear();
+    layout.shelves.clear();
+    layout.complete = true;
+
+    glm::vec2 pen(0.0f);
+    float width        = 0.0f;
+    uint32_t previous  = 0;
+    const char *cursor = text.data();
+    size_t remaining   = text.size();
+    while (remaining > 0) {
+        uint32_t codepoint = SDL_StepUTF8(&cursor, &remaining);
+        if (codepoint == 0) break; // 字符串中间的空字符
+        if (codepoint == '\r') continue;
+        if (codepoint == '\n') {
+            width    = std::max(width, pen.x);
+            pen      = glm::vec2(0.0f, pen.y + fontInfo.lineSkip);
+            previous = 0;
+            continue;
+        }
+        int kerning = 0;
+        if (previous != 0 && TTF_GetGlyphKerning(fontInfo.font, previous, codepoint, &kerning)) {
+            pen.x += static_cast<float>(kerning) * fontInfo.metricScale;
+        }
+        previous = codepoint;
+
+        const GlyphEntry *glyph = getGlyph(font, codepoint);
+        if (glyph == nullptr) {
+            layout.complete = false; // 图集放不下，本次跳过该字形
+            continue;
+        }
+        if (glyph->shelf != GLYPH_NO_SHELF) {
+            glm::vec2 topLeft(std::round(pen.x) + static_cast<float>(glyph->offsetX), pen.y + static_cast<float>(glyph->offsetY));
+            glm::vec2 size(static_cast<float>(glyph->width), static_cast<float>(glyph->height));
+            glm::vec2 uv(static_cast<float>(glyph->x), static_cast<float>(glyph->y));
+            layout.quads.push_back({glm::vec4(topLeft, size), glm::vec4(uv * atlasScale, (uv + size) * atlasScale)});
+            if (std::find(layout.shelves.begin(), layout.shelves.end(), glyph->shelf) == layout.shelves.end()) {
+                layout.shelves.push_back(glyph->shelf);
+            }
+        }
+        pen.x += glyph->advance;
+    }
+    layout.size = glm::vec2(std::max(width, pen.x), pen.y + fontInfo.lineSkip);
+
+    // 排版过程中可能淘汰过其他层，本字符串用到的层都在本帧使用过，不会被淘汰
+    layout.generation = cache.getGeneration();
+}
+
+const GlyphEntry *TextRenderer::getGlyph(uint32_t font, uint32_t codepoint) {
+    uint64_t key      = glyphKey(font, codepoint);
+    GlyphCache &cache = getCache(font);
+    if (const GlyphEntry *glyph = cache.find(key)) return glyph;
+
+    // SDF 字体遇到字符集之外的字符时在当前线程补充生成
+    m_stats.rasterizedGlyphs++;
+    GlyphBitmap bitmap = rasterizeGlyph(m_fonts[font].font, codepoint);
+    if (m_fonts[font].sdf) bitmap = generateSdf(bitmap);
+    return cache.insert(key, bitmap);
+}
+
+GlyphBitmap TextRenderer::rasterizeGlyph(TTF_Font *font, uint32_t codepoint) const {
+    GlyphBitmap bitmap;
+    int minX = 0, maxX = 0, minY = 0, maxY = 0, advance = 0;
+    if (!TTF_GetGlyphMetrics(font, codepoint, &minX, &maxX, &minY, &maxY, &advance)) {
+        spdlog::warn("TextRenderer::rasterizeGlyph()::获取字形度量失败, 字符: U+{:04X}, {}", codepoint, SDL_GetError());
+        return bitmap;
+    }
+    bitmap.advance = static_cast<float>(advance);
+
+    // 渲染结果以笔位置和行顶部为原点，高度为整行；空白字符没有像素
+    SDL_Surface *rendered = TTF_RenderGlyph_Blended(font, codepoint, SDL_Color{255, 255, 255, 255});
+    if (rendered == nullptr) return bitmap;
+    SDL_Surface *surface = SDL_ConvertSurface(rendered, SDL_PIXELFORMAT_RGBA32);
+    SDL_DestroySurface(rendered);
+    if (surface == nullptr) {
+        throw std::runtime_error(std::string("TextRenderer::rasterizeGlyph()::转换字形像素格式失败: ") + SDL_GetError());
+    }
+
+    // 裁掉透明边缘，只把有覆盖率的部分放进图集
+    SDL_LockSurface(surface);
+    const auto *pixels = static_cast<const uint8_t *>(surface->pixels);
+    auto alpha         = [&](int x, int y) { return pixels[y * surface->pitch + x * 4 + 3]; };
+    int left = surface->w, top = surface->h, right = -1, bottom = -1;
+    for (int y = 0; y < surface->h; y++) {
+        for (int x = 0; x < surface->w; x++) {
+            if (alpha(x, y) == 0) continue;
+            left   = std::min(left, x);
+            right  = std::max(right, x);
+            top    = std::min(top, y);
+            bottom = std::max(bottom, y);
+        }
+    }
+    if (right >= left) {
+        bitmap.width   = static_cast<uint32_t>(right - left + 1);
+        bitmap.height  = static_cast<uint32_t>(bottom - top + 1);
+        bitmap.offsetX = left;
+        bitmap.offsetY = top;
+        bitmap.pixels.resize(static_cast<size_t>(bitmap.width) * bitmap.height);
+        for (uint32_t y = 0; y < bitmap.height; y++) {
+            for (uint32_t x = 0; x < bitmap.width; x++) {
+                bitmap.pixels[y * bitmap.width + x] = alpha(left + static_cast<int>(x), top + static_cast<int>(y));
+            }
+        }
+    }
+    SDL_UnlockSurface(surface);
+    SDL_DestroySurface(surface);
+    return bitmap;
+}
+
+void TextRenderer::flush(VkCommandBuffer commandBuffer) {
+    m_glyphCache->recordUploads(commandBuffer);
+    if (m_sdfCache) m_sdfCache->recordUploads(commandBuffer);
+
+    // 超出上限时先保证位图部分，两个图集的实例放在同一段流式缓冲区中
+    std::array<uint32_t, 2> counts{};
+    counts[BITMAP_ATLAS] = static_cast<uint32_t>(std::min<size_t>(m_instances[BITMAP_ATLAS].size(), TEXT_MAX_INSTANCES));
+    counts[SDF_ATLAS]    = static_cast<uint32_t>(std::min<size_t>(m_instances[SDF_ATLAS].size(), TEXT_MAX_INSTANCES - counts[BITMAP_ATLAS]));
+    uint32_t requested   = static_cast<uint32_t>(m_instances[BITMAP_ATLAS].size() + m_instances[SDF_ATLAS].size());
+    m_drawCounts         = {0, 0};
+    if (counts[BITMAP_ATLAS] + counts[SDF_ATLAS] > 0) {
+        StreamingAllocation allocation = m_renderer.getStreamingBuffer().reserve((counts[BITMAP_ATLAS] + counts[SDF_ATLAS]) * sizeof(TextInstance), sizeof(TextInstance));
+        if (allocation) {
+            auto *dst = static_cast<TextInstance *>(allocation.data);
+            std::copy_n(m_instances[BITMAP_ATLAS].begin(), counts[BITMAP_ATLAS], dst);
+            std::copy_n(m_instances[SDF_ATLAS].begin(), counts[SDF_ATLAS], dst + counts[BITMAP_ATLAS]);
+            m_drawBuffer = allocation.buffer;
+            m_drawOffset = allocation.offset;
+            m_drawCounts = counts;
+        }
+    }
+    m_stats.instances        = m_drawCounts[BITMAP_ATLAS] + m_drawCounts[SDF_ATLAS];
+    m_stats.droppedInstances = requested - m_stats.instances;
+    if (m_stats.droppedInstances > 0) {
+        spdlog::warn("TextRenderer::flush()::文字字形过多, 丢弃: {}", m_stats.droppedInstances);
+    }
+    for (std::vector<TextInstance> &instances : m_instances) {
+        instances.clear();
+    }
+
+    // 定期删除长时间没有使用的排版，避免每帧变化的字符串（计时器、坐标等）让缓存无限增长
+    if (m_frameNumber % TEXT_LAYOUT_TTL_FRAMES == 0) {
+        uint32_t cachedLayouts = 0;
+        for (Font &font : m_fonts) {
+            std::erase_if(font.layouts, [this](const auto &entry) { return entry.second.lastUsedFrame + TEXT_LAYOUT_TTL_FRAMES < m_frameNumber; });
+            cachedLayouts += static_cast<uint32_t>(font.layouts.size());
+        }
+        m_stats.cachedLayouts = cachedLayouts;
+    }
+    m_frameNumber++;
+    m_glyphCache->beginFrame(m_frameNumber);
+    if (m_sdfCache) m_sdfCache->beginFrame(m_frameNumber);
+}
+
+void TextRenderer::recordDraws(VkCommandBuffer commandBuffer, VkExtent2D extent) {
+    if (m_drawCounts[BITMAP_ATLAS] == 0 && m_drawCounts[SDF_ATLAS] == 0) return;
+    VkViewport viewport{0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f};
+    VkRect2D scissor{{0, 0}, extent};
+    TextPushConstants constants{glm::vec2(static_cast<float>(extent.width), static_cast<float>(extent.height))};
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_drawBuffer, &m_drawOffset);
+
+    // 每个图集一次实例化绘制
+    uint32_t firstInstance = 0;
+    for (size_t atlas = 0; atlas < m_pipelines.size(); atlas++) {
+        if (m_drawCounts[atlas] == 0) continue;
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelines[atlas]);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1, &m_descriptorSets[atlas], 0, nullptr);
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+        vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(constants), &constants);
+        vkCmdDraw(commandBuffer, 6, m_drawCounts[atlas], 0, firstInstance);
+        firstInstance += m_drawCounts[atlas];
+    }
+}
+
+} // namespace engine::render
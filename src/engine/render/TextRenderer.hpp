@@ -0,0 +1,176 @@
+#pragma once
+#include "../core/JobSystem.hpp"
+#include "../utils/Math.hpp"
+#include "GlyphCache.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct TTF_Font;
+
+namespace engine::render {
+class VulkanRenderer;
+
+#pragma region Constants
+const uint32_t TEXT_MAX_INSTANCES     = 16384; // 每帧最多绘制的字形数量，超出的部分丢弃
+const uint64_t TEXT_LAYOUT_TTL_FRAMES = 120;   // 排版缓存连续这么多帧没有使用就删除
+const float TEXT_SDF_BASE_SIZE        = 32.0f; // SDF 字形生成时的字号（像素），drawText() 的 scale 相对该字号
+const uint32_t TEXT_SDF_SPREAD        = 4;     // 距离场覆盖轮廓内外各多少像素
+const uint32_t TEXT_SDF_SUPERSAMPLE   = 4;     // 先按该倍数的字号光栅化再计算距离场，轮廓更准确
+#pragma endregion
+
+/**
+ * @struct TextInstance
+ * @brief 一个字形四边形，按实例输入
+ */
+struct TextInstance {
+    glm::vec4 rect; // 左上角 x, y 和宽高，窗口像素坐标
+    glm::vec4 uv;   // 图集中的 u0, v0, u1, v1
+    uint32_t color; // r | g << 8 | b << 16 | a << 24
+
+    static VkVertexInputBindingDescription getBindingDescription() {
+        VkVertexInputBindingDescription bindingDescription{};
+        bindingDescription.binding   = 0;                             // 顶点属性绑定索引
+        bindingDescription.stride    = sizeof(TextInstance);          // 每个实例的大小
+        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE; // 输入速率，表示每个实例输入一次数据
+        return bindingDescription;                                    // 返回顶点输入绑定描述
+    }
+
+    static std::array<VkVertexInputAttributeDescription, 3> getAttributeDescriptions() {
+        std::array<VkVertexInputAttributeDescription, 3> attributeDescriptions{};
+        attributeDescriptions[0].binding  = 0;                             // 顶点属性绑定索引
+        attributeDescriptions[0].location = 0;                             // 顶点属性位置索引
+        attributeDescriptions[0].format   = VK_FORMAT_R32G32B32A32_SFLOAT; // 顶点属性格式
+        attributeDescriptions[0].offset   = offsetof(TextInstance, rect);  // 顶点属性在结构体中的偏移量
+        attributeDescriptions[1].binding  = 0;                             // 顶点属性绑定索引
+        attributeDescriptions[1].location = 1;                             // 顶点属性位置索引
+        attributeDescriptions[1].format   = VK_FORMAT_R32G32B32A32_SFLOAT; // 顶点属性格式
+        attributeDescriptions[1].offset   = offsetof(TextInstance, uv);    // 顶点属性在结构体中的偏移量
+        attributeDescriptions[2].binding  = 0;                             // 顶点属性绑定索引
+        attributeDescriptions[2].location = 2;                             // 顶点属性位置索引
+        attributeDescriptions[2].format   = VK_FORMAT_R8G8B8A8_UNORM;      // 着色器中读取为归一化的 vec4
+        attributeDescriptions[2].offset   = offsetof(TextInstance, color); // 顶点属性在结构体中的偏移量
+        return attributeDescriptions;
+    }
+};
+
+/**
+ * @struct TextStats
+ * @brief 文字渲染统计，字形缓存的命中率见 GlyphCache::getStats()
+ */
+struct TextStats {
+    uint64_t layoutHits       = 0; // drawText() 直接使用缓存排版的次数，累计值
+    uint64_t layoutMisses     = 0; // 需要重新排版的次数（新字符串或字形被淘汰），累计值
+    uint64_t rasterizedGlyphs = 0; // 光栅化的字形数量，累计值
+    uint64_t sdfGlyphs        = 0; // 加载 SDF 字体时在工作线程上生成的字形数量，累计值
+    uint32_t cachedLayouts    = 0; // 当前缓存的排版数量
+    uint32_t instances        = 0; // 最近一帧绘制的字形数量
+    uint32_t droppedInstances = 0; // 最近一帧超出 TEXT_MAX_INSTANCES 或流式缓冲区空间不足而丢弃的字形数量
+};
+
+/**
+ * @class TextRenderer
+ * @brief 基于 SDL3_ttf 的屏幕文字：字形按需光栅化到共享图集，字符串排版结果按内容缓存
+ *
+ * 每个字形只在第一次出现时用 SDL_ttf 光栅化，之后从 GlyphCache 的图集中取用；
+ * 同一字体下相同的字符串直接复用上次的排版（字形四边形的相对位置和纹理坐标），图集淘汰过字形后才重新排版。
+ * 位图字体每个字号各占一份字形；SDF 字体只生成一份有符号距离场，任意缩放都保持清晰，放在单独的图集中。
+ * 每帧每个图集合并为一次实例化绘制调用。坐标是窗口像素，原点在左上角；只能在渲染线程（主线程）使用。
+ */
+class TextRenderer final {
+public:
+    TextRenderer(VulkanRenderer &renderer);
+    ~TextRenderer();
+
+    TextRenderer(const TextRenderer &)            = delete;
+    TextRenderer &operator=(const TextRenderer &) = delete;
+    TextRenderer(TextRenderer &&)                 = delete;
+    TextRenderer &operator=(TextRenderer &&)      = delete;
+
+    void init();
+    void cleanup();
+
+    uint32_t loadFont(const std::string &path, float pointSize);                                                 // 返回字体编号
+    uint32_t loadSdfFont(engine::core::JobSystem &jobSystem, const std::string &path, std::string_view charset); // 在工作线程上预先生成 charset 中的字形
+    void drawText(uint32_t font, std::string_view text, const glm::vec2 &position, const glm::vec4 &color,
+                  float scale = 1.0f); // position 为左上角，支持 UTF-8 和换行；位图字体缩放后会变模糊
+    glm::vec2 measureText(uint32_t font, std::string_view text, float scale = 1.0f);
+
+    void flush(VkCommandBuffer commandBuffer);                          // 在渲染通道之外调用：上传新字形和本帧的字形实例
+    void recordDraws(VkCommandBuffer commandBuffer, VkExtent2D extent); // 在场景最后一个渲染通道之内调用
+
+    const GlyphCache &getGlyphCache() const { return *m_glyphCache; }
+    const GlyphCache *getSdfGlyphCache() const { return m_sdfCache.get(); } // 没有加载过 SDF 字体时为空
+    const TextStats &getStats() const { return m_stats; }
+
+private:
+    struct TextQuad {
+        glm::vec4 rect; // 相对字符串左上角
+        glm::vec4 uv;
+    };
+
+    struct TextLayout {
+        std::vector<TextQuad> quads;
+        std::vector<uint32_t> shelves; // 用到的图集层，每帧使用时标记，避免被淘汰
+        glm::vec2 size{0.0f};
+        uint32_t generation    = 0;    // 排版时图集的淘汰代数
+        uint64_t lastUsedFrame = 0;
+        bool complete          = true; // 图集放不下某个字形时为 false，下次使用时重新排版
+    };
+
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+    };
+
+    struct Font {
+        TTF_Font *font    = nullptr;
+        float lineSkip    = 0.0f;
+        float metricScale = 1.0f; // SDL_ttf 度量换算到排版像素的比例，SDF 字体按放大的字号打开
+        bool sdf          = false;
+        std::unordered_map<std::string, TextLayout, StringHash, std::equal_to<>> layouts;
+    };
+
+    TextLayout &getLayout(uint32_t font, std::string_view text);
+    void buildLayout(uint32_t font, std::string_view text, TextLayout &layout);
+    GlyphCache &getCache(uint32_t font) { return m_fonts[font].sdf ? *m_sdfCache : *m_glyphCache; }
+    const GlyphEntry *getGlyph(uint32_t font, uint32_t codepoint);
+    GlyphBitmap rasterizeGlyph(TTF_Font *font, uint32_t codepoint) const;
+    VkDescriptorSet allocateDescriptorSet(VkImageView atlasView);
+    void createSdfCache();
+    void createPipelines();
+
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer;
+    std::unique_ptr<GlyphCache> m_glyphCache;
+    std::unique_ptr<GlyphCache> m_sdfCache; // 第一次加载 SDF 字体时创建
+    std::vector<Font> m_fonts;
+    bool m_ttfInitialized = false;
+
+    VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool m_descriptorPool           = VK_NULL_HANDLE;
+    VkSampler m_sampler                         = VK_NULL_HANDLE;
+    VkPipelineLayout m_pipelineLayout           = VK_NULL_HANDLE;
+    std::array<VkDescriptorSet, 2> m_descriptorSets{}; // 按图集分开：位图、SDF；图集视图不会改变
+    std::array<VkPipeline, 2> m_pipelines{};           // 只有片段着色器不同
+
+    std::array<std::vector<TextInstance>, 2> m_instances; // 本帧提交的字形，按图集分开
+    uint64_t m_frameNumber = 1;                           // 从 1 开始，图集层的初始使用帧 0 表示从未使用
+
+    VkBuffer m_drawBuffer     = VK_NULL_HANDLE; // 本帧实例所在的流式缓冲区
+    VkDeviceSize m_drawOffset = 0;
+    std::array<uint32_t, 2> m_drawCounts{};     // 每个图集的实例数，位图在前
+    TextStats m_stats;
+#pragma endregion
+};
+
+} // namespace engine::render
@@ -0,0 +1,516 @@
+#include "TilemapRenderer.hpp"
+#include "RenderConstants.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace engine::render {
+
+namespace {
+// 与 tilemap 系列着色器中的 push_constant 布局一致（std430）
+struct TilemapPushConstants {
+    glm::vec2 cameraCenter;
+    glm::vec2 viewportSize;
+    float pixelsPerTile;
+    uint32_t firstChunk;
+    uint32_t layerChunksX;
+    uint32_t atlasColumns;
+    glm::ivec2 chunkOrigin;
+    uint32_t visibleChunksX;
+    uint32_t padding;
+};
+static_assert(sizeof(TilemapPushConstants) == 48, "TilemapPushConstants 必须与着色器中的 push_constant 布局一致");
+
+const VkDeviceSize TILEMAP_CHUNK_BYTES = TILEMAP_CHUNK_TILES * sizeof(uint32_t); // 每个区块在图块缓冲区中的字节数
+const uint32_t TILEMAP_DESCRIPTOR_SETS = MAX_FRAMES_IN_FLIGHT + 2;               // 替换图集时旧描述符集要等飞行中的帧用完才能释放
+} // namespace
+
+TilemapRenderer::TilemapRenderer(VulkanRenderer &renderer) : m_renderer(renderer) {}
+
+TilemapRenderer::~TilemapRenderer() = default;
+
+void TilemapRenderer::init() {
+    VkDevice device = m_renderer.getDevice();
+
+    std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+    bindings[0].binding         = 0;
+    bindings[0].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[0].descriptorCount = 1;
+    bindings[0].stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT;
+    bindings[1].binding         = 1;
+    bindings[1].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[1].descriptorCount = 1;
+    bindings[1].stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT;
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings    = bindings.data();
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &m_descriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("TilemapRenderer::init()::创建描述符集布局失败");
+    }
+
+    std::array<VkDescriptorPoolSize, 2> poolSizes{};
+    poolSizes[0] = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, TILEMAP_DESCRIPTOR_SETS};
+    poolSizes[1] = {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, TILEMAP_DESCRIPTOR_SETS};
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags         = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT; // 替换图集时单独释放旧描述符集
+    poolInfo.maxSets       = TILEMAP_DESCRIPTOR_SETS;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes    = poolSizes.data();
+    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &m_descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("TilemapRenderer::init()::创建描述符池失败");
+    }
+
+    VkPushConstantRange pushConstantRange{VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(TilemapPushConstants)};
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount         = 1;
+    pipelineLayoutInfo.pSetLayouts            = &m_descriptorSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges    = &pushConstantRange;
+    VkPipelineLayout pipelineLayout;
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("TilemapRenderer::init()::创建管线布局失败");
+    }
+    createPipeline(pipelineLayout);
+
+    // 着色器只用 texelFetch 读取，采样器不做过滤
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter    = VK_FILTER_NEAREST;
+    samplerInfo.minFilter    = VK_FILTER_NEAREST;
+    samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    m_sampler                = m_renderer.getSamplerCache().acquire(samplerInfo);
+
+    m_tileBuffer = m_renderer.getResourceRegistry().createBuffer(TILEMAP_MAX_CHUNKS * TILEMAP_CHUNK_BYTES,
+                                                                 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, MemoryUsage::GpuOnly, true);
+    spdlog::trace("TilemapRenderer::init()::图块地图初始化成功");
+}
+
+void TilemapRenderer::cleanup() {
+    VkDevice device = m_renderer.getDevice();
+    vkDestroyDescriptorPool(device, m_descriptorPool, nullptr); // 同时释放所有描述符集
+    vkDestroyDescriptorSetLayout(device, m_descriptorSetLayout, nullptr);
+    if (m_sampler != VK_NULL_HANDLE) m_renderer.getSamplerCache().release(m_sampler);
+    if (m_atlasView != VK_NULL_HANDLE) m_renderer.releaseImageView(m_atlasView);
+    m_descriptorPool      = VK_NULL_HANDLE;
+    m_descriptorSet       = VK_NULL_HANDLE;
+    m_descriptorSetLayout = VK_NULL_HANDLE;
+    m_sampler             = VK_NULL_HANDLE;
+    m_atlasView           = VK_NULL_HANDLE;
+    m_boundAtlasImage     = VK_NULL_HANDLE;
+    m_boundTileBuffer     = VK_NULL_HANDLE;
+    m_atlas               = {}; // 图集、图块缓冲区和管线由资源注册表在清理时销毁
+    m_tileBuffer          = {};
+    m_pipeline            = {};
+}
+
+void TilemapRenderer::createPipeline(VkPipelineLayout pipelineLayout) {
+    VkDevice device                 = m_renderer.getDevice();
+    VkShaderModule vertShaderModule = m_renderer.createShaderModule(VulkanRenderer::readFile("assets/shaders/tilemap.vert.spv"));
+    VkShaderModule fragShaderModule = m_renderer.createShaderModule(VulkanRenderer::readFile("assets/shaders/tilemap.frag.spv"));
+
+    std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages{};
+    shaderStages[0].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStages[0].stage  = VK_SHADER_STAGE_VERTEX_BIT;
+    shaderStages[0].module = vertShaderModule;
+    shaderStages[0].pName  = "main";
+    shaderStages[1].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStages[1].stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
+    shaderStages[1].module = fragShaderModule;
+    shaderStages[1].pName  = "main";
+
+    // 四边形顶点由 gl_VertexIndex 和 gl_InstanceIndex 生成，没有顶点输入
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+    vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewportState{};
+    viewportState.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount  = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterizer{};
+    rasterizer.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.lineWidth   = 1.0f;
+    rasterizer.cullMode    = VK_CULL_MODE_NONE;
+    rasterizer.frontFace   = VK_FRONT_FACE_CLOCKWISE;
+
+    VkPipelineMultisampleStateCreateInfo multisampling{};
+    multisampling.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    // 二维图层按绘制顺序叠加，不参与深度测试
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.sType            = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable  = VK_FALSE;
+    depthStencil.depthWriteEnable = VK_FALSE;
+
+    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+    colorBlendAttachment.colorWriteMask      = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    colorBlendAttachment.blendEnable         = VK_TRUE;
+    colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.colorBlendOp        = VK_BLEND_OP_ADD;
+    colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.alphaBlendOp        = VK_BLEND_OP_ADD;
+    VkPipelineColorBlendStateCreateInfo colorBlending{};
+    colorBlending.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlending.attachmentCount = 1;
+    colorBlending.pAttachments    = &colorBlendAttachment;
+
+    std::array<VkDynamicState, 2> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+    dynamicState.pDynamicStates    = dynamicStates.data();
+
+    VkGraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount          = static_cast<uint32_t>(shaderStages.size());
+    pipelineInfo.pStages             = shaderStages.data();
+    pipelineInfo.pVertexInputState   = &vertexInputInfo;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState      = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState   = &multisampling;
+    pipelineInfo.pDepthStencilState  = &depthStencil;
+    pipelineInfo.pColorBlendState    = &colorBlending;
+    pipelineInfo.pDynamicState       = &dynamicState;
+    pipelineInfo.layout              = pipelineLayout;
+    pipelineInfo.renderPass          = m_renderer.getSceneRenderPass();
+    pipelineInfo.subpass             = 0;
+    VkPipeline pipeline;
+    VkResult result = vkCreateGraphicsPipelines(device, m_renderer.getPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline);
+    vkDestroyShaderModule(device, fragShaderModule, nullptr);
+    vkDestroyShaderModule(device, vertShaderModule, nullptr);
+    if (result != VK_SUCCESS) {
+        vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+        throw std::runtime_error("TilemapRenderer::createPipeline()::创建图块地图管线失败");
+    }
+    m_pipeline = m_renderer.getResourceRegistry().addPipeline(pipeline, pipelineLayout, VK_PIPELINE_BIND_POINT_GRAPHICS);
+}
+
+void TilemapRenderer::setAtlas(const void *pixels, uint32_t width, uint32_t height, uint32_t tileSize) {
+    if (pixels == nullptr || tileSize == 0 || width < tileSize || height < tileSize) {
+        throw std::runtime_error("TilemapRenderer::setAtlas()::图集尺寸无效");
+    }
+    VkDevice device = m_renderer.getDevice();
+
+    // 先分配描述符集，失败时不影响当前图集
+    VkDescriptorSet descriptorSet = allocateDescriptorSet();
+
+    // 图集平时处于着色器只读布局，碎片整理可以把它搬到别的内存块
+    ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    ImageHandle atlas          = registry.createImage(width, height, TILEMAP_ATLAS_FORMAT, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                                                      MemoryUsage::GpuOnly, 1, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    VkImage image              = registry.getImage(atlas);
+
+    // 通过临时暂存缓冲区复制像素，只在加载时调用
+    VkDeviceSize imageBytes = static_cast<VkDeviceSize>(width) * height * 4;
+    VkBuffer stagingBuffer;
+    VkDeviceMemory stagingMemory;
+    m_renderer.createBuffer(imageBytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, MemoryUsage::Upload,
+                            stagingBuffer, stagingMemory);
+    void *mapped;
+    vkMapMemory(device, stagingMemory, 0, imageBytes, 0, &mapped);
+    memcpy(mapped, pixels, static_cast<size_t>(imageBytes));
+    vkUnmapMemory(device, stagingMemory);
+
+    VkCommandBuffer commandBuffer = m_renderer.beginSingleTimeCommands();
+    VulkanRenderer::recordImageBarrier(commandBuffer, image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                       VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+    VkBufferImageCopy region{};
+    region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.imageExtent      = {width, height, 1};
+    vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    VulkanRenderer::recordImageBarrier(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    m_renderer.endSingleTimeCommands(commandBuffer);
+    vkDestroyBuffer(device, stagingBuffer, nullptr);
+    m_renderer.freeMemory(stagingMemory);
+
+    VkImageView view    = m_renderer.createImageView(image, TILEMAP_ATLAS_FORMAT, VK_IMAGE_ASPECT_COLOR_BIT);
+    VkBuffer tileBuffer = registry.getBuffer(m_tileBuffer);
+    writeDescriptorSet(descriptorSet, tileBuffer, view);
+
+    // 旧图集可能仍被飞行中的帧使用，等 GPU 用完之后再销毁
+    if (m_descriptorSet != VK_NULL_HANDLE) {
+        m_renderer.deferDestroy([this, set = m_descriptorSet, oldView = m_atlasView]() {
+            vkFreeDescriptorSets(m_renderer.getDevice(), m_descriptorPool, 1, &set);
+            m_renderer.releaseImageView(oldView);
+        });
+        registry.destroy(m_atlas);
+    }
+    m_descriptorSet   = descriptorSet;
+    m_atlas           = atlas;
+    m_atlasView       = view;
+    m_boundAtlasImage = image;
+    m_boundTileBuffer = tileBuffer;
+    m_atlasColumns    = width / tileSize;
+    spdlog::trace("TilemapRenderer::setAtlas()::设置图集成功, 尺寸: {}x{}, 格子数: {}", width, height, m_atlasColumns * (height / tileSize));
+}
+
+VkDescriptorSet TilemapRenderer::allocateDescriptorSet() {
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool     = m_descriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts        = &m_descriptorSetLayout;
+    if (vkAllocateDescriptorSets(m_renderer.getDevice(), &allocInfo, &descriptorSet) != VK_SUCCESS) {
+        throw std::runtime_error("TilemapRenderer::allocateDescriptorSet()::分配描述符集失败，短时间内替换图集次数过多");
+    }
+    return descriptorSet;
+}
+
+void TilemapRenderer::writeDescriptorSet(VkDescriptorSet descriptorSet, VkBuffer tileBuffer, VkImageView atlasView) {
+    VkDescriptorBufferInfo tileInfo{tileBuffer, 0, VK_WHOLE_SIZE};
+    VkDescriptorImageInfo atlasInfo{m_sampler, atlasView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+    std::array<VkWriteDescriptorSet, 2> writes{};
+    writes[0].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writes[0].dstSet          = descriptorSet;
+    writes[0].dstBinding      = 0;
+    writes[0].descriptorCount = 1;
+    writes[0].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    writes[0].pBufferInfo     = &tileInfo;
+    writes[1].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writes[1].dstSet          = descriptorSet;
+    writes[1].dstBinding      = 1;
+    writes[1].descriptorCount = 1;
+    writes[1].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    writes[1].pImageInfo      = &atlasInfo;
+    vkUpdateDescriptorSets(m_renderer.getDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+}
+
+void TilemapRenderer::rebindDescriptorSet() {
+    // 正在使用的描述符集不能修改，换一个新的；旧描述符集和视图等飞行中的帧用完之后释放
+    ResourceRegistry &registry    = m_renderer.getResourceRegistry();
+    VkDescriptorSet descriptorSet = allocateDescriptorSet();
+    VkImage atlasImage            = registry.getImage(m_atlas);
+    VkBuffer tileBuffer           = registry.getBuffer(m_tileBuffer);
+    VkImageView view              = m_renderer.createImageView(atlasImage, TILEMAP_ATLAS_FORMAT, VK_IMAGE_ASPECT_COLOR_BIT);
+    writeDescriptorSet(descriptorSet, tileBuffer, view);
+    m_renderer.deferDestroy([this, set = m_descriptorSet, oldView = m_atlasView]() {
+        vkFreeDescriptorSets(m_renderer.getDevice(), m_descriptorPool, 1, &set);
+        m_renderer.releaseImageView(oldView);
+    });
+    m_descriptorSet   = descriptorSet;
+    m_atlasView       = view;
+    m_boundAtlasImage = atlasImage;
+    m_boundTileBuffer = tileBuffer;
+    spdlog::trace("TilemapRenderer::rebindDescriptorSet()::图块缓冲区或图集被搬移, 重建描述符集");
+}
+
+uint32_t TilemapRenderer::createLayer(uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0) {
+        throw std::runtime_error("TilemapRenderer::createLayer()::图层尺寸无效");
+    }
+    if (m_layers.size() >= TILEMAP_MAX_LAYERS) {
+        throw std::runtime_error("TilemapRenderer::createLayer()::图层数量超过 TILEMAP_MAX_LAYERS");
+    }
+    Layer layer;
+    layer.width         = width;
+    layer.height        = height;
+    layer.chunksX       = (width + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE;
+    layer.chunksY       = (height + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE;
+    uint32_t chunkCount = layer.chunksX * layer.chunksY;
+    if (m_chunkCount + chunkCount > TILEMAP_MAX_CHUNKS) {
+        throw std::runtime_error("TilemapRenderer::createLayer()::区块数量超过 TILEMAP_MAX_CHUNKS");
+    }
+    layer.firstChunk = m_chunkCount;
+    layer.tiles.assign(static_cast<size_t>(chunkCount) * TILEMAP_CHUNK_TILES, TILEMAP_EMPTY_TILE);
+
+    // 新区块在 GPU 上的内容未定义，全部标记为需要上传
+    layer.chunkDirty.assign(chunkCount, true);
+    layer.dirtyChunks.resize(chunkCount);
+    for (uint32_t chunk = 0; chunk < chunkCount; chunk++) {
+        layer.dirtyChunks[chunk] = chunk;
+    }
+    m_chunkCount += chunkCount;
+    m_layers.push_back(std::move(layer));
+    spdlog::trace("TilemapRenderer::createLayer()::创建图层成功, 尺寸: {}x{}, 区块数: {}", width, height, chunkCount);
+    return static_cast<uint32_t>(m_layers.size() - 1);
+}
+
+TilemapRenderer::Layer &TilemapRenderer::getLayer(uint32_t layer) {
+    if (layer >= m_layers.size()) {
+        throw std::runtime_error("TilemapRenderer::getLayer()::图层编号无效");
+    }
+    return m_layers[layer];
+}
+
+const TilemapRenderer::Layer &TilemapRenderer::getLayer(uint32_t layer) const {
+    if (layer >= m_layers.size()) {
+        throw std::runtime_error("TilemapRenderer::getLayer()::图层编号无效");
+    }
+    return m_layers[layer];
+}
+
+void TilemapRenderer::setLayerVisible(uint32_t layer, bool visible) {
+    getLayer(layer).visible = visible;
+}
+
+void TilemapRenderer::markDirty(Layer &layer, uint32_t x, uint32_t y) {
+    uint32_t chunk = (y / TILEMAP_CHUNK_SIZE) * layer.chunksX + x / TILEMAP_CHUNK_SIZE;
+    if (layer.chunkDirty[chunk]) return;
+    layer.chunkDirty[chunk] = true;
+    layer.dirtyChunks.push_back(chunk);
+}
+
+void TilemapRenderer::setTile(uint32_t layerIndex, uint32_t x, uint32_t y, uint32_t tile) {
+    Layer &layer = getLayer(layerIndex);
+    if (x >= layer.width || y >= layer.height) {
+        throw std::runtime_error("TilemapRenderer::setTile()::图块坐标超出图层");
+    }
+    uint32_t chunk   = (y / TILEMAP_CHUNK_SIZE) * layer.chunksX + x / TILEMAP_CHUNK_SIZE;
+    uint32_t &target = layer.tiles[chunk * TILEMAP_CHUNK_TILES + (y % TILEMAP_CHUNK_SIZE) * TILEMAP_CHUNK_SIZE + x % TILEMAP_CHUNK_SIZE];
+    if (target == tile) return; // 没有变化的写入不触发重新上传
+    target = tile;
+    markDirty(layer, x, y);
+}
+
+void TilemapRenderer::fillTiles(uint32_t layerIndex, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t tile) {
+    Layer &layer  = getLayer(layerIndex);
+    uint32_t endX = std::min(layer.width, x + width);
+    uint32_t endY = std::min(layer.height, y + height);
+    for (uint32_t ty = y; ty < endY; ty++) {
+        for (uint32_t tx = x; tx < endX; tx++) {
+            setTile(layerIndex, tx, ty, tile);
+        }
+    }
+}
+
+uint32_t TilemapRenderer::getTile(uint32_t layerIndex, uint32_t x, uint32_t y) const {
+    const Layer &layer = getLayer(layerIndex);
+    if (x >= layer.width || y >= layer.height) return TILEMAP_EMPTY_TILE;
+    uint32_t chunk = (y / TILEMAP_CHUNK_SIZE) * layer.chunksX + x / TILEMAP_CHUNK_SIZE;
+    return layer.tiles[chunk * TILEMAP_CHUNK_TILES + (y % TILEMAP_CHUNK_SIZE) * TILEMAP_CHUNK_SIZE + x % TILEMAP_CHUNK_SIZE];
+}
+
+void TilemapRenderer::setCamera(const glm::vec2 &center, float pixelsPerTile) {
+    if (pixelsPerTile <= 0.0f) {
+        throw std::runtime_error("TilemapRenderer::setCamera()::每个图块的像素数必须大于 0");
+    }
+    m_cameraCenter  = center;
+    m_pixelsPerTile = pixelsPerTile;
+}
+
+void TilemapRenderer::recordUploads(VkCommandBuffer commandBuffer) {
+    m_stats.rebakedThisFrame       = 0;
+    m_stats.visibleChunksThisFrame = 0;
+    m_stats.drawCallsThisFrame     = 0;
+
+    // 碎片整理在本帧开始时搬移了图块缓冲区或图集，之后记录的命令都要引用新对象
+    ResourceRegistry &registry = m_renderer.getResourceRegistry();
+    VkBuffer tileBuffer        = registry.getBuffer(m_tileBuffer);
+    if (m_descriptorSet != VK_NULL_HANDLE && (tileBuffer != m_boundTileBuffer || registry.getImage(m_atlas) != m_boundAtlasImage)) {
+        rebindDescriptorSet();
+    }
+
+    // 区块内容已经按 GPU 布局存放，每个脏区块是一段连续的暂存复制
+    StreamingBuffer &streaming = m_renderer.getStreamingBuffer();
+    std::vector<VkBufferCopy> copies;
+    VkDeviceSize budget = TILEMAP_UPLOAD_BUDGET;
+    for (Layer &layer : m_layers) {
+        size_t uploaded = 0;
+        for (; uploaded < layer.dirtyChunks.size() && budget >= TILEMAP_CHUNK_BYTES; uploaded++) {
+            uint32_t chunk                 = layer.dirtyChunks[uploaded];
+            StreamingAllocation allocation = streaming.upload(&layer.tiles[static_cast<size_t>(chunk) * TILEMAP_CHUNK_TILES], TILEMAP_CHUNK_BYTES);
+            if (!allocation) break; // 暂存空间不足，剩下的区块下一帧再上传
+            copies.push_back({allocation.offset, (layer.firstChunk + chunk) * TILEMAP_CHUNK_BYTES, TILEMAP_CHUNK_BYTES});
+            layer.chunkDirty[chunk] = false;
+            budget -= TILEMAP_CHUNK_BYTES;
+        }
+        layer.dirtyChunks.erase(layer.dirtyChunks.begin(), layer.dirtyChunks.begin() + static_cast<std::ptrdiff_t>(uploaded));
+    }
+
+    m_stats.layerCount  = static_cast<uint32_t>(m_layers.size());
+    m_stats.chunkCount  = m_chunkCount;
+    m_stats.dirtyChunks = 0;
+    for (const Layer &layer : m_layers) {
+        m_stats.dirtyChunks += static_cast<uint32_t>(layer.dirtyChunks.size());
+    }
+    if (copies.empty()) return;
+    m_stats.rebakedThisFrame = static_cast<uint32_t>(copies.size());
+
+    // 之前的帧可能仍在读取图块缓冲区（读后写）
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    vkCmdCopyBuffer(commandBuffer, streaming.getBuffer(), tileBuffer, static_cast<uint32_t>(copies.size()), copies.data());
+
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+void TilemapRenderer::recordDraws(VkCommandBuffer commandBuffer, VkExtent2D extent) {
+    if (m_descriptorSet == VK_NULL_HANDLE || m_layers.empty() || extent.width == 0 || extent.height == 0) return;
+
+    // 视口覆盖的图块范围换算为区块矩形，所有图层共用；CPU 开销与地图大小无关
+    glm::vec2 halfView(static_cast<float>(extent.width) * 0.5f / m_pixelsPerTile, static_cast<float>(extent.height) * 0.5f / m_pixelsPerTile);
+    glm::vec2 minTile  = m_cameraCenter - halfView;
+    glm::vec2 maxTile  = m_cameraCenter + halfView;
+    int64_t minChunkX  = static_cast<int64_t>(std::floor(minTile.x / TILEMAP_CHUNK_SIZE));
+    int64_t minChunkY  = static_cast<int64_t>(std::floor(minTile.y / TILEMAP_CHUNK_SIZE));
+    int64_t maxChunkX  = static_cast<int64_t>(std::floor(maxTile.x / TILEMAP_CHUNK_SIZE));
+    int64_t maxChunkY  = static_cast<int64_t>(std::floor(maxTile.y / TILEMAP_CHUNK_SIZE));
+    bool pipelineBound = false;
+
+    const PipelineResource *pipeline = m_renderer.getResourceRegistry().get(m_pipeline);
+    for (const Layer &layer : m_layers) {
+        if (!layer.visible) continue;
+        int64_t beginX = std::max<int64_t>(minChunkX, 0);
+        int64_t beginY = std::max<int64_t>(minChunkY, 0);
+        int64_t endX   = std::min<int64_t>(maxChunkX, static_cast<int64_t>(layer.chunksX) - 1);
+        int64_t endY   = std::min<int64_t>(maxChunkY, static_cast<int64_t>(layer.chunksY) - 1);
+        if (beginX > endX || beginY > endY) continue;
+
+        if (!pipelineBound) {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->pipeline);
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->layout, 0, 1, &m_descriptorSet, 0, nullptr);
+            VkViewport viewport{0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f};
+            VkRect2D scissor{{0, 0}, extent};
+            vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+            vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+            pipelineBound = true;
+        }
+
+        TilemapPushConstants constants{};
+        constants.cameraCenter   = m_cameraCenter;
+        constants.viewportSize   = glm::vec2(static_cast<float>(extent.width), static_cast<float>(extent.height));
+        constants.pixelsPerTile  = m_pixelsPerTile;
+        constants.firstChunk     = layer.firstChunk;
+        constants.layerChunksX   = layer.chunksX;
+        constants.atlasColumns   = m_atlasColumns;
+        constants.chunkOrigin    = glm::ivec2(static_cast<int32_t>(beginX), static_cast<int32_t>(beginY));
+        constants.visibleChunksX = static_cast<uint32_t>(endX - beginX + 1);
+        uint32_t visibleChunks   = constants.visibleChunksX * static_cast<uint32_t>(endY - beginY + 1);
+        vkCmdPushConstants(commandBuffer, pipeline->layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(constants), &constants);
+        vkCmdDraw(commandBuffer, 6, visibleChunks, 0, 0);
+        m_stats.visibleChunksThisFrame += visibleChunks;
+        m_stats.drawCallsThisFrame++;
+    }
+}
+
+} // namespace engine::render
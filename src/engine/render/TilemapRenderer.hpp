@@ -0,0 +1,122 @@
+#pragma once
+#include "../utils/Math.hpp"
+#include "ResourceRegistry.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::render {
+class VulkanRenderer;
+
+#pragma region Constants
+const uint32_t TILEMAP_CHUNK_SIZE        = 32;                                      // 区块边长（图块数），与着色器中的 CHUNK_SIZE 一致
+const uint32_t TILEMAP_CHUNK_TILES       = TILEMAP_CHUNK_SIZE * TILEMAP_CHUNK_SIZE; // 每个区块的图块数
+const uint32_t TILEMAP_MAX_CHUNKS        = 4096;                                    // 所有图层的区块总数上限（约 400 万个图块）
+const uint32_t TILEMAP_MAX_LAYERS        = 16;                                      // 最多的图层数量
+const uint32_t TILEMAP_EMPTY_TILE        = 0;                                       // 空图块，不绘制；图块 n 对应图集中的第 n - 1 格
+const VkFormat TILEMAP_ATLAS_FORMAT      = VK_FORMAT_R8G8B8A8_SRGB;                 // 图集格式，采样时转换到线性空间
+const VkDeviceSize TILEMAP_UPLOAD_BUDGET = 1024 * 1024;                             // 每帧最多重新上传的区块字节数
+#pragma endregion
+
+/**
+ * @struct TilemapStats
+ * @brief 图块地图的统计信息，帧相关的字段在每次 recordUploads() 时清零
+ */
+struct TilemapStats {
+    uint32_t layerCount             = 0; // 图层数量
+    uint32_t chunkCount             = 0; // 所有图层的区块数量
+    uint32_t dirtyChunks            = 0; // 等待重新上传的区块数量
+    uint32_t rebakedThisFrame       = 0; // 本帧重新上传的区块数量
+    uint32_t visibleChunksThisFrame = 0; // 本帧绘制的区块数量（所有窗口累计）
+    uint32_t drawCallsThisFrame     = 0; // 本帧的绘制调用数量
+};
+
+/**
+ * @class TilemapRenderer
+ * @brief 按区块缓存的二维图块地图
+ *
+ * 每个图层划分为 TILEMAP_CHUNK_SIZE x TILEMAP_CHUNK_SIZE 的区块，区块的图块编号按区块连续存放在一个设备本地存储缓冲区中，
+ * 只有图块发生变化的区块才会重新上传。绘制时每个可见区块是一个实例化的四边形，片段着色器按像素位置查找图块编号并从图集中取色，
+ * 因此 CPU 每帧只需要计算可见区块的矩形范围，与地图大小无关。
+ * 坐标以图块为单位，x 向右、y 向下；相机给出视口中心对应的图块坐标和每个图块的像素数。
+ */
+class TilemapRenderer final {
+public:
+    explicit TilemapRenderer(VulkanRenderer &renderer);
+    ~TilemapRenderer();
+
+    TilemapRenderer(const TilemapRenderer &)            = delete;
+    TilemapRenderer &operator=(const TilemapRenderer &) = delete;
+    TilemapRenderer(TilemapRenderer &&)                 = delete;
+    TilemapRenderer &operator=(TilemapRenderer &&)      = delete;
+
+    void init();
+    void cleanup();
+
+    /**
+     * @brief 设置图集：RGBA8 像素数据，按 tileSize 像素划分为格子，从左到右、从上到下编号
+     * @note 可以在运行时替换，旧图集在 GPU 用完之后销毁
+     */
+    void setAtlas(const void *pixels, uint32_t width, uint32_t height, uint32_t tileSize);
+
+    uint32_t createLayer(uint32_t width, uint32_t height);                                                  // 创建全空图层，返回图层编号；图层按创建顺序由下到上绘制
+    void setLayerVisible(uint32_t layer, bool visible);
+    void setTile(uint32_t layer, uint32_t x, uint32_t y, uint32_t tile);
+    void fillTiles(uint32_t layer, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t tile); // 超出图层的部分被忽略
+    uint32_t getTile(uint32_t layer, uint32_t x, uint32_t y) const;
+
+    void setCamera(const glm::vec2 &center, float pixelsPerTile); // center 为视口中心对应的图块坐标
+
+    void recordUploads(VkCommandBuffer commandBuffer);                  // 在渲染通道之外调用：重新上传有变化的区块
+    void recordDraws(VkCommandBuffer commandBuffer, VkExtent2D extent); // 在渲染通道之内调用：每个图层一次实例化绘制
+
+    const TilemapStats &getStats() const { return m_stats; }
+
+private:
+    struct Layer {
+        uint32_t width      = 0;           // 图块数
+        uint32_t height     = 0;
+        uint32_t chunksX    = 0;           // 区块数
+        uint32_t chunksY    = 0;
+        uint32_t firstChunk = 0;           // 第一个区块在图块缓冲区中的编号
+        bool visible        = true;
+        std::vector<uint32_t> tiles;       // 按区块连续存放，与图块缓冲区的布局一致
+        std::vector<bool> chunkDirty;      // 区块是否在等待重新上传
+        std::vector<uint32_t> dirtyChunks; // 等待重新上传的区块（图层内编号）
+    };
+
+    Layer &getLayer(uint32_t layer);
+    const Layer &getLayer(uint32_t layer) const;
+    void markDirty(Layer &layer, uint32_t x, uint32_t y);
+    void createPipeline(VkPipelineLayout pipelineLayout); // 注册表接管管线和布局
+    VkDescriptorSet allocateDescriptorSet();
+    void writeDescriptorSet(VkDescriptorSet descriptorSet, VkBuffer tileBuffer, VkImageView atlasView);
+    void rebindDescriptorSet(); // 碎片整理搬移了图块缓冲区或图集之后重建描述符集
+
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer;
+
+    VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE; // 图块缓冲区 + 图集
+    VkDescriptorPool m_descriptorPool           = VK_NULL_HANDLE;
+    VkDescriptorSet m_descriptorSet             = VK_NULL_HANDLE; // 设置图集后才有效
+    VkSampler m_sampler                         = VK_NULL_HANDLE; // 来自采样器缓存，着色器只用 texelFetch
+
+    PipelineHandle m_pipeline;                   // 管线和管线布局
+    BufferHandle m_tileBuffer;                   // 所有图层的区块图块编号，可以被碎片整理搬移
+    ImageHandle m_atlas;                         // 可以被碎片整理搬移
+    VkBuffer m_boundTileBuffer = VK_NULL_HANDLE; // 描述符集引用的对象，与注册表中的不一致时重建描述符集
+    VkImage m_boundAtlasImage  = VK_NULL_HANDLE;
+    VkImageView m_atlasView    = VK_NULL_HANDLE;
+    uint32_t m_atlasColumns    = 0;              // 图集每行的格子数
+
+    std::vector<Layer> m_layers;
+    uint32_t m_chunkCount = 0; // 已分配的区块数
+    glm::vec2 m_cameraCenter{0.0f};
+    float m_pixelsPerTile = 16.0f;
+    TilemapStats m_stats;
+#pragma endregion
+};
+
+} // namespace engine::render
@@ -1,4 +1,5 @@
 #include "VulkanRenderer.hpp"
+#include "../utils/AllocationCounter.hpp"
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_vulkan.h>
@@ -19,40 +20,79 @@ VulkanRenderer::VulkanRenderer(SDL_Window *window) : m_window(window) {
 VulkanRenderer::~VulkanRenderer() = default;
 
 void VulkanRenderer::initVulkan() {
-    createInstance();         //  创建 Vulkan 实例
-    setupDebugMessenger();    //  设置调试消息
-    createSurface();          //  创建 Vulkan 表面
-    pickPhysicalDevice();     //  选择物理设备
-    createLogicalDevice();    //  创建逻辑设备
-    createSwapChain();        //  创建交换链
-    createImageViews();       //  创建交换链图像视图
-    createRenderPass();       //  创建渲染通道
-    createGraphicsPipeline(); //  创建图形管线
-    createFramebuffers();     //  创建帧缓冲区
-    createCommandPool();      //  创建命令池
-    createVertexBuffer();     //  创建顶点缓冲区
-    createCommandBuffers();   //  创建命令缓冲区
-    createSyncObjects();      //  创建同步对象
-    m_initialized = true;     //  设置初始化标志
-}
-
-void VulkanRenderer::render() {
-    drawFrame(); //  绘制一帧
+    createInstance();                                                       //  创建 Vulkan 实例
+    setupDebugMessenger();                                                  //  设置调试消息
+    m_surfaces.push_back(std::make_unique<RenderSurface>(*this, m_window)); //  创建主窗口的 Vulkan 表面
+    pickPhysicalDevice();                                                   //  选择物理设备
+    createLogicalDevice();                                                  //  创建逻辑设备
+    createResourceCaches();                                                 //  创建采样器和图像视图缓存、资源注册表
+    m_surfaces.front()->createSwapChain();                                  //  创建交换链
+    m_surfaces.front()->createImageViews();                                 //  创建交换链图像视图
+    createRenderPass();                                                     //  创建渲染通道
+    createPipelineCache();                                                  //  创建管线缓存
+    createGraphicsPipeline();                                               //  创建图形管线
+    createPostProcessChain();                                               //  创建后处理链
+    createMeshRenderer();                                                   //  创建网格渲染器、遮挡剔除器、簇渲染器、图块地图和调试图形
+    m_surfaces.front()->createOffscreenTargets();                           //  创建离屏目标和场景帧缓冲区
+    m_surfaces.front()->createSyncObjects();                                //  创建获取图像用的信号量
+    createCommandPool();                                                    //  创建命令池
+    createVertexBuffer();                                                   //  创建顶点缓冲区
+    createStreamingBuffer();                                                //  创建流式缓冲区
+    m_worldStreamer = std::make_unique<WorldStreamer>(*this);               //  创建世界流式加载器，调用 start() 后才分配几何池
+    createCommandBuffers();                                                 //  创建命令缓冲区
+    createSyncObjects();                                                    //  创建同步对象
+    m_initialized = true;                                                   //  设置初始化标志
+}
+
+bool VulkanRenderer::render() {
+    uint64_t allocations   = engine::utils::getThreadAllocationCount();
+    bool presented         = drawFrame(); //  绘制一帧
+    m_frameHeapAllocations = engine::utils::getThreadAllocationCount() - allocations;
+    if (m_heapAllocationCheck && m_frameHeapAllocations > 0) {
+        spdlog::warn("VulkanRenderer::render()::第 {} 帧在渲染线程分配了 {} 次堆内存", m_frameNumber, m_frameHeapAllocations);
+    }
+    return presented;
+}
+
+bool VulkanRenderer::hasPendingWork() const {
+    return m_particleSystem->isActive() || m_worldStreamer->hasPendingWork() || m_resourceRegistry->isDefragmenting();
+}
+
+void VulkanRenderer::setHeapAllocationCheck(bool enabled) {
+    if (enabled && !engine::utils::isAllocationCounterEnabled()) {
+        spdlog::warn("VulkanRenderer::setHeapAllocationCheck()::发布构建没有替换全局 operator new, 无法统计堆分配");
+    }
+    m_heapAllocationCheck = enabled;
 }
 
 void VulkanRenderer::cleanup() {
     vkDeviceWaitIdle(m_device); //  等待设备空闲
     if (m_initialized) {
-        cleanupSwapChain();
-        vkDestroyPipeline(m_device, m_graphicsPipeline, nullptr);
-        vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
+        m_deletionQueue.flushAll(); //  设备已空闲，执行所有延迟销毁
+        m_worldStreamer->cleanup();
+        for (auto &surface : m_surfaces) {
+            surface->destroy();
+        }
+        m_surfaces.clear();
+        m_postProcessChain->cleanup();
+        m_textRenderer->cleanup();
+        m_debugDraw->cleanup();
+        m_tilemapRenderer->cleanup();
+        m_particleSystem->cleanup();
+        m_meshletRenderer->cleanup();
+        m_occlusionCuller->cleanup();
+        m_meshRenderer->cleanup();
+        m_deletionQueue.flushAll();    // 子系统清理时经由资源注册表延迟销毁的资源（如遮挡剔除目标）
+        m_resourceRegistry->cleanup(); // 采样器归还给采样器缓存，需要在缓存清理之前
+        m_samplerCache->cleanup();
+        m_imageViewCache->cleanup();
+        vkDestroyPipelineCache(m_device, m_pipelineCache, nullptr);
         vkDestroyRenderPass(m_device, m_renderPass, nullptr);
+        vkDestroyRenderPass(m_device, m_renderPassLoad, nullptr);
 
-        vkDestroyBuffer(m_device, m_vertexBuffer, nullptr);
-        vkFreeMemory(m_device, m_vertexBufferMemory, nullptr);
-        for (size_t i = 0; i < m_commandBuffers.size(); i++) {
+        m_streamingBuffer->cleanup();
+        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
             vkDestroySemaphore(m_device, m_renderFinishedSemaphores[i], nullptr);
-            vkDestroySemaphore(m_device, m_imageAvailableSemaphores[i], nullptr);
             vkDestroyFence(m_device, m_inFlightFences[i], nullptr);
         }
         vkDestroyCommandPool(m_device, m_commandPool, nullptr);
@@ -60,7 +100,6 @@ void VulkanRenderer::cleanup() {
         if (ENABLE_VALIDATION_LAYER) {
             DestroyDebugUtilsMessengerEXT(m_instance, m_debugMessenger, nullptr);
         }
-        vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
         vkDestroyInstance(m_instance, nullptr);
         m_initialized = false; //  设置初始化标志
         spdlog::trace("VulkanRenderer::cleanup()::Vulkan已销毁");
@@ -69,7 +108,7 @@ void VulkanRenderer::cleanup() {
     }
 }
 
-#pragma region Instance and Validation Layers and Surface
+#pragma region Instance and Validation Layers
 void VulkanRenderer::createInstance() {
     if (ENABLE_VALIDATION_LAYER && !checkValidationLayerSupport()) {
         throw std::runtime_error("VulkanRenderer::createInstance()::验证层不支持");
@@ -81,7 +120,7 @@ void VulkanRenderer::createInstance() {
     appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);           //  设置应用程序版本 为1.0.0
     appInfo.pEngineName        = "No Engine";                        //  引擎名称设置为"No Engine"
     appInfo.engineVersion      = VK_MAKE_VERSION(1, 0, 0);           //  引擎版本设置为1.0.0
-    appInfo.apiVersion         = VK_API_VERSION_1_0;                 //  Vulkan API版本设置为1.0
+    appInfo.apiVersion         = VK_API_VERSION_1_1;                 //  Vulkan API版本设置为1.1（VK_EXT_mesh_shader 和 vkGetPhysicalDeviceFeatures2 需要）
 
     VkInstanceCreateInfo createInfo{};
     createInfo.flags |= VK_INSTANCE_CREATE_ENUMERATE_PORTABILITY_BIT_KHR; //  设置可移植性枚举标志（防止 macOS 上的问题）
@@ -217,11 +256,6 @@ bool VulkanRenderer::checkValidationLayerSupport() {
     return true;
 }
 
-void VulkanRenderer::createSurface() {
-    if (!SDL_Vulkan_CreateSurface(m_window, m_instance, nullptr, &m_surface)) {
-        throw std::runtime_error("VulkanRenderer::createSurface()::创建窗口表面失败");
-    }
-}
 #pragma endregion
 
 #pragma region Devices and Queues
@@ -234,8 +268,9 @@ void VulkanRenderer::pickPhysicalDevice() {
     std::vector<VkPhysicalDevice> devices(deviceCount);
     vkEnumeratePhysicalDevices(m_instance, &deviceCount, devices.data());
 
+    VkSurfaceKHR surface = m_surfaces.front()->getSurface(); // 以主窗口表面判断呈现支持
     for (const auto &device : devices) {
-        if (isDeviceSuitable(device)) {
+        if (isDeviceSuitable(device, surface)) {
             m_physicalDevice = device; // 在这里我们只选择第一个合适的设备，你可以根据需要选择其他设备
             break;
         }
@@ -243,9 +278,10 @@ void VulkanRenderer::pickPhysicalDevice() {
     if (m_physicalDevice == VK_NULL_HANDLE) {
         throw std::runtime_error("VulkanRenderer::pickPhysicalDevice()::没有找到合适的物理设备");
     }
+    m_queueFamilyIndices = findQueueFamilies(m_physicalDevice, surface);
     printPhysicalDeviceProperties(m_physicalDevice);
 }
-QueueFamilyIndices VulkanRenderer::findQueueFamilies(const VkPhysicalDevice &device) {
+QueueFamilyIndices VulkanRenderer::findQueueFamilies(const VkPhysicalDevice &device, VkSurfaceKHR surface) {
     QueueFamilyIndices indices;
     uint32_t queueFamilyCount = 0;
     vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
@@ -258,7 +294,7 @@ QueueFamilyIndices VulkanRenderer::findQueueFamilies(const VkPhysicalDevice &dev
             indices.graphicsFamily = i;
         }
         VkBool32 presentSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_surface, &presentSupport);
+        vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
         if (presentSupport) {
             indices.presentFamily = i;
         }
@@ -267,12 +303,12 @@ QueueFamilyIndices VulkanRenderer::findQueueFamilies(const VkPhysicalDevice &dev
     }
     return indices;
 }
-bool VulkanRenderer::isDeviceSuitable(const VkPhysicalDevice &device) {
-    QueueFamilyIndices indices = findQueueFamilies(device);           // 查找队列家族
+bool VulkanRenderer::isDeviceSuitable(const VkPhysicalDevice &device, VkSurfaceKHR surface) {
+    QueueFamilyIndices indices = findQueueFamilies(device, surface);  // 查找队列家族
     bool extensionsSupported   = checkDeviceExtensionSupport(device); // 检查设备扩展支持
     bool swapChainAdequate     = false;
     if (extensionsSupported) {
-        SwapChainSupportDetails swapChainSupport = querySwapChainSupport(device);
+        SwapChainSupportDetails swapChainSupport = RenderSurface::querySwapChainSupport(device, surface);
 
         swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty(); // 检查交换链支持是否足够,格式和呈现模式
     }
@@ -289,23 +325,15 @@ bool VulkanRenderer::checkDeviceExtensionSupport(const VkPhysicalDevice &device)
     }
     return requiredExtensions.empty();
 }
-SwapChainSupportDetails VulkanRenderer::querySwapChainSupport(VkPhysicalDevice device) {
-    SwapChainSupportDetails details;                                                     // 获取交换链支持的能力，格式和呈现模式
-    vkGetPhysicalDeviceSurfaceCapabilitiesKHR(device, m_surface, &details.capabilities); // 获取交换链支持的能力
-    uint32_t formatCount;
-    vkGetPhysicalDeviceSurfaceFormatsKHR(device, m_surface, &formatCount, nullptr); // 获取支持的格式数量
-    if (formatCount != 0) {
-        details.formats.resize(formatCount);
-        vkGetPhysicalDeviceSurfaceFormatsKHR(device, m_surface, &formatCount, details.formats.data()); // 获取支持的格式
-    }
-
-    uint32_t presentModeCount;
-    vkGetPhysicalDeviceSurfacePresentModesKHR(device, m_surface, &presentModeCount, nullptr);
-    if (presentModeCount != 0) {
-        details.presentModes.resize(presentModeCount);
-        vkGetPhysicalDeviceSurfacePresentModesKHR(device, m_surface, &presentModeCount, details.presentModes.data());
+bool VulkanRenderer::isDeviceExtensionAvailable(const VkPhysicalDevice &device, const char *extensionName) {
+    uint32_t extensionCount;
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+    std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
+    for (const auto &extension : availableExtensions) {
+        if (strcmp(extensionName, extension.extensionName) == 0) return true;
     }
-    return details;
+    return false;
 }
 void VulkanRenderer::printPhysicalDeviceProperties(VkPhysicalDevice &device) {
     VkPhysicalDeviceProperties properties;
@@ -330,7 +358,7 @@ void VulkanRenderer::printPhysicalDeviceProperties(VkPhysicalDevice &device) {
     spdlog::info("  驱动版本: {}.{}.{}", VK_VERSION_MAJOR(driverVersion), VK_VERSION_MINOR(driverVersion), VK_VERSION_PATCH(driverVersion));
 }
 void VulkanRenderer::createLogicalDevice() {
-    QueueFamilyIndices indices = findQueueFamilies(m_physicalDevice);
+    const QueueFamilyIndices &indices = m_queueFamilyIndices;
 
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
     std::set<uint32_t> uniqueQueueFamilies = {indices.graphicsFamily.value(), indices.presentFamily.value()}; // 将图形队列和呈现队列的索引添加到集合中
@@ -344,15 +372,63 @@ void VulkanRenderer::createLogicalDevice() {
         queueCreateInfos.push_back(queueCreateInfo);
     }
 
-    VkPhysicalDeviceFeatures deviceFeatures{}; // 获取设备特性，这里我们使用默认特性
+    // 只启用设备支持的可选特性，不支持时网格渲染器退回逐物体的间接绘制
+    VkPhysicalDeviceFeatures supportedFeatures;
+    vkGetPhysicalDeviceFeatures(m_physicalDevice, &supportedFeatures);
+    VkPhysicalDeviceFeatures deviceFeatures{};
+    deviceFeatures.multiDrawIndirect         = supportedFeatures.multiDrawIndirect;         // 一次间接调用绘制多个物体
+    deviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance; // 间接绘制命令的 firstInstance 可以不为 0
+    m_enabledFeatures                        = deviceFeatures;
+
+    // 必需扩展 + 设备支持的可选扩展
+    m_enabledDeviceExtensions = deviceExtensions;
+    for (const char *extensionName : optionalDeviceExtensions) {
+        if (isDeviceExtensionAvailable(m_physicalDevice, extensionName)) {
+            m_enabledDeviceExtensions.push_back(extensionName);
+            spdlog::info("VulkanRenderer::createLogicalDevice()::启用可选设备扩展: {}", extensionName);
+        }
+    }
+    m_incrementalPresentSupported = isDeviceExtensionAvailable(m_physicalDevice, VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME);
+
+    // 任务和网格着色器：需要 Vulkan 1.1 设备，SPIR-V 1.4 在 1.2 之前由扩展提供；不支持时簇渲染器退回计算着色器剔除
+    VkPhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures{};
+    meshShaderFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(m_physicalDevice, &deviceProperties);
+    bool spirv14Core      = deviceProperties.apiVersion >= VK_API_VERSION_1_2;
+    m_meshShaderSupported = deviceProperties.apiVersion >= VK_API_VERSION_1_1 &&
+                            isDeviceExtensionAvailable(m_physicalDevice, VK_EXT_MESH_SHADER_EXTENSION_NAME) &&
+                            (spirv14Core || (isDeviceExtensionAvailable(m_physicalDevice, VK_KHR_SPIRV_1_4_EXTENSION_NAME) &&
+                                             isDeviceExtensionAvailable(m_physicalDevice, VK_KHR_SHADER_FLOAT_CONTROLS_EXTENSION_NAME)));
+    if (m_meshShaderSupported) {
+        VkPhysicalDeviceFeatures2 features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &meshShaderFeatures;
+        vkGetPhysicalDeviceFeatures2(m_physicalDevice, &features2);
+        m_meshShaderSupported = meshShaderFeatures.taskShader && meshShaderFeatures.meshShader;
+    }
+    if (m_meshShaderSupported) {
+        // 只启用任务和网格着色器本身，不需要多视图和图元着色率
+        meshShaderFeatures            = VkPhysicalDeviceMeshShaderFeaturesEXT{};
+        meshShaderFeatures.sType      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+        meshShaderFeatures.taskShader = VK_TRUE;
+        meshShaderFeatures.meshShader = VK_TRUE;
+        m_enabledDeviceExtensions.push_back(VK_EXT_MESH_SHADER_EXTENSION_NAME);
+        if (!spirv14Core) {
+            m_enabledDeviceExtensions.push_back(VK_KHR_SPIRV_1_4_EXTENSION_NAME);
+            m_enabledDeviceExtensions.push_back(VK_KHR_SHADER_FLOAT_CONTROLS_EXTENSION_NAME);
+        }
+        spdlog::info("VulkanRenderer::createLogicalDevice()::启用任务和网格着色器: {}", VK_EXT_MESH_SHADER_EXTENSION_NAME);
+    }
 
     VkDeviceCreateInfo createInfo{};
     createInfo.sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    createInfo.pNext                   = m_meshShaderSupported ? &meshShaderFeatures : nullptr;
     createInfo.queueCreateInfoCount    = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos       = queueCreateInfos.data();
     createInfo.pEnabledFeatures        = &deviceFeatures;
-    createInfo.enabledExtensionCount   = static_cast<uint32_t>(deviceExtensions.size()); // 设置启用的设备扩展数量
-    createInfo.ppEnabledExtensionNames = deviceExtensions.data();                        // 设置启用的设备扩展名称
+    createInfo.enabledExtensionCount   = static_cast<uint32_t>(m_enabledDeviceExtensions.size()); // 设置启用的设备扩展数量
+    createInfo.ppEnabledExtensionNames = m_enabledDeviceExtensions.data();                        // 设置启用的设备扩展名称
     if (ENABLE_VALIDATION_LAYER) {
         createInfo.enabledLayerCount   = static_cast<uint32_t>(validationLayers.size()); // 设置启用的验证层数量
         createInfo.ppEnabledLayerNames = validationLayers.data();                        // 设置启用的验证层名称
@@ -367,110 +443,85 @@ void VulkanRenderer::createLogicalDevice() {
     vkGetDeviceQueue(m_device, indices.graphicsFamily.value(), 0, &m_graphicsQueue);
     vkGetDeviceQueue(m_device, indices.presentFamily.value(), 0, &m_presentQueue);
     spdlog::trace("VulkanRenderer::createLogicalDevice()::逻辑设备创建成功");
+
+    m_memoryTypePolicy = std::make_unique<MemoryTypePolicy>(m_physicalDevice); // 按用途排序内存类型并输出选择结果
+
+    // 显存预算需要 vkGetPhysicalDeviceMemoryProperties2，不支持时按堆大小估计
+    m_memoryBudgetSupported = deviceProperties.apiVersion >= VK_API_VERSION_1_1 && isDeviceExtensionAvailable(m_physicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    m_memoryBudget          = std::make_unique<MemoryBudget>(*this);
+    m_memoryBudget->init(m_memoryBudgetSupported);
+}
+void VulkanRenderer::createResourceCaches() {
+    m_samplerCache     = std::make_unique<SamplerCache>(m_device, m_physicalDevice);
+    m_imageViewCache   = std::make_unique<ImageViewCache>(m_device);
+    m_resourceRegistry = std::make_unique<ResourceRegistry>(*this);
 }
 #pragma endregion
 
-#pragma region Swap Chain and Image Views
-VkSurfaceFormatKHR VulkanRenderer::chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR> &availableFormats) {
-    for (const auto &availableFormat : availableFormats) {
-        if (availableFormat.format == VK_FORMAT_B8G8R8A8_SRGB && availableFormat.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
-            return availableFormat;
-        }
+#pragma region Surfaces
+RenderSurface *VulkanRenderer::findSurface(SDL_WindowID windowID) {
+    for (auto &surface : m_surfaces) {
+        if (surface->getWindowID() == windowID) return surface.get();
     }
-    return availableFormats[0];
+    return nullptr;
 }
-VkPresentModeKHR VulkanRenderer::chooseSwapPresentMode(const std::vector<VkPresentModeKHR> &availablePresentModes) {
-    for (const auto &availablePresentMode : availablePresentModes) {
-        if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR) {
-            return availablePresentMode; // 如果支持 mailbox 模式，则优先使用
+void VulkanRenderer::addWindow(SDL_Window *window) {
+    auto surface = std::make_unique<RenderSurface>(*this, window);
+    try {
+        // 新窗口必须能被已选定的呈现队列族呈现，否则无法共享同一个逻辑设备
+        VkBool32 presentSupport = false;
+        vkGetPhysicalDeviceSurfaceSupportKHR(m_physicalDevice, m_queueFamilyIndices.presentFamily.value(), surface->getSurface(), &presentSupport);
+        if (!presentSupport) {
+            throw std::runtime_error("VulkanRenderer::addWindow()::呈现队列不支持该窗口表面");
         }
+        surface->createSwapChain();
+        surface->createImageViews();
+        surface->createOffscreenTargets();
+        surface->createSyncObjects();
+    } catch (...) {
+        surface->destroy(); // 只释放失败之前已经创建的对象
+        throw;
     }
-    return VK_PRESENT_MODE_FIFO_KHR;
+    spdlog::trace("VulkanRenderer::addWindow()::添加窗口成功, 窗口 ID: {}, 窗口数量: {}", surface->getWindowID(), m_surfaces.size() + 1);
+    m_surfaces.push_back(std::move(surface));
 }
-VkExtent2D VulkanRenderer::chooseSwapExtent(const VkSurfaceCapabilitiesKHR &capabilities) {
-    if (capabilities.currentExtent.width != std::numeric_limits<uint32_t>::max()) {
-        return capabilities.currentExtent;
-    } else {
-        int width, height;
-        SDL_GetWindowSizeInPixels(m_window, &width, &height);
-        VkExtent2D actualExtent = {
-            static_cast<uint32_t>(width),
-            static_cast<uint32_t>(height)};
-        actualExtent.width  = std::clamp(actualExtent.width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
-        actualExtent.height = std::clamp(actualExtent.height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
-        return actualExtent;
-    }
-}
-void VulkanRenderer::createSwapChain() {
-    SwapChainSupportDetails swapChainSupport = querySwapChainSupport(m_physicalDevice);
-    VkSurfaceFormatKHR surfaceFormat         = chooseSwapSurfaceFormat(swapChainSupport.formats);
-    VkPresentModeKHR presentMode             = chooseSwapPresentMode(swapChainSupport.presentModes);
-    VkExtent2D extent                        = chooseSwapExtent(swapChainSupport.capabilities);
-    uint32_t imageCount                      = swapChainSupport.capabilities.minImageCount + 1;
-    if (swapChainSupport.capabilities.maxImageCount > 0 && imageCount > swapChainSupport.capabilities.maxImageCount) {
-        imageCount = swapChainSupport.capabilities.maxImageCount; // 如果最大图像数量不为0，则将图像数量设置为最大图像数量
-    }
-
-    VkSwapchainCreateInfoKHR createInfo{};
-    createInfo.sType            = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-    createInfo.surface          = m_surface;                           // 设置交换链的表面
-    createInfo.minImageCount    = imageCount;                          // 设置交换链的图像数量
-    createInfo.imageFormat      = surfaceFormat.format;                // 设置交换链的图像格式
-    createInfo.imageColorSpace  = surfaceFormat.colorSpace;            // 设置交换链的图像颜色空间
-    createInfo.imageExtent      = extent;                              // 设置交换链的图像尺寸
-    createInfo.imageArrayLayers = 1;                                   // 设置交换链的图像层数
-    createInfo.imageUsage       = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT; // 设置交换链的图像用途
-
-    QueueFamilyIndices indices    = findQueueFamilies(m_physicalDevice);                             // 查找队列家族索引
-    uint32_t queueFamilyIndices[] = {indices.graphicsFamily.value(), indices.presentFamily.value()}; // 设置队列家族索引
-
-    if (indices.graphicsFamily != indices.presentFamily) {
-        createInfo.imageSharingMode      = VK_SHARING_MODE_CONCURRENT; // 如果图形队列和呈现队列不同，则使用并发模式
-        createInfo.queueFamilyIndexCount = 2;                          // 设置队列家族索引数量
-        createInfo.pQueueFamilyIndices   = queueFamilyIndices;         // 设置队列家族索引
-    } else {
-        createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE; // 如果图形队列和呈现队列相同，则使用独占模式
-    }
-    createInfo.preTransform   = swapChainSupport.capabilities.currentTransform; // 设置交换链的图像变换
-    createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;              // 设置交换链的图像透明度
-    createInfo.presentMode    = presentMode;                                    // 设置交换链的呈现模式
-    createInfo.clipped        = VK_TRUE;                                        // 设置交换链的剪裁模式
-    createInfo.oldSwapchain   = VK_NULL_HANDLE;                                 // 设置旧的交换链
-
-    if (vkCreateSwapchainKHR(m_device, &createInfo, nullptr, &m_swapChain) != VK_SUCCESS) {
-        throw std::runtime_error("VulkanRenderer::createSwapChain()::创建交换链失败");
-    }
-
-    vkGetSwapchainImagesKHR(m_device, m_swapChain, &imageCount, nullptr);                  // 获取交换链图像数量
-    m_swapChainImages.resize(imageCount);                                                  // 创建交换链图像
-    vkGetSwapchainImagesKHR(m_device, m_swapChain, &imageCount, m_swapChainImages.data()); // 获取交换链图像
-    spdlog::trace("VulkanRenderer::createSwapChain()::创建交换链成功, 交换链图像数量: {}", imageCount);
-
-    m_swapChainImageFormat = surfaceFormat.format; // 设置交换链图像格式
-    m_swapChainExtent      = extent;               // 设置交换链图像尺寸
-}
-void VulkanRenderer::createImageViews() {
-    m_swapChainImageViews.resize(m_swapChainImages.size());
-    for (size_t i = 0; i < m_swapChainImages.size(); i++) {
-        VkImageViewCreateInfo createInfo{};
-        createInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-        createInfo.image                           = m_swapChainImages[i];          // 设置图像
-        createInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;         // 设置图像视图类型
-        createInfo.format                          = m_swapChainImageFormat;        // 设置图像格式
-        createInfo.components.r                    = VK_COMPONENT_SWIZZLE_IDENTITY; // 设置颜色分量 r
-        createInfo.components.g                    = VK_COMPONENT_SWIZZLE_IDENTITY; // 设置颜色分量 g
-        createInfo.components.b                    = VK_COMPONENT_SWIZZLE_IDENTITY; // 设置颜色分量 b
-        createInfo.components.a                    = VK_COMPONENT_SWIZZLE_IDENTITY; // 设置颜色分量 a
-        createInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;     // 设置图像视图的方面掩码
-        createInfo.subresourceRange.baseMipLevel   = 0;                             // 设置图像视图的基础Mipmap级别
-        createInfo.subresourceRange.levelCount     = 1;                             // 设置图像视图的Mipmap级别数量
-        createInfo.subresourceRange.baseArrayLayer = 0;                             // 设置图像视图的基础数组层
-        createInfo.subresourceRange.layerCount     = 1;                             // 设置图像视图的数组层数
-        if (vkCreateImageView(m_device, &createInfo, nullptr, &m_swapChainImageViews[i]) != VK_SUCCESS) {
-            throw std::runtime_error("VulkanRenderer::createImageViews()::创建交换链图像视图失败");
-        }
+void VulkanRenderer::removeWindow(SDL_Window *window) {
+    if (window == m_window) {
+        spdlog::warn("VulkanRenderer::removeWindow()::不能移除主窗口");
+        return;
+    }
+    auto it = std::find_if(m_surfaces.begin(), m_surfaces.end(), [window](const auto &surface) { return surface->getWindow() == window; });
+    if (it == m_surfaces.end()) return;
+    vkDeviceWaitIdle(m_device); // 等待使用该交换链的帧全部完成
+    (*it)->destroy();
+    m_surfaces.erase(it);
+    spdlog::trace("VulkanRenderer::removeWindow()::移除窗口成功, 窗口数量: {}", m_surfaces.size());
+}
+void VulkanRenderer::setFramebufferResized(bool resized) {
+    for (auto &surface : m_surfaces) {
+        surface->setFramebufferResized(resized);
+    }
+}
+void VulkanRenderer::setFramebufferResized(SDL_WindowID windowID, bool resized) {
+    if (RenderSurface *surface = findSurface(windowID)) {
+        surface->setFramebufferResized(resized);
+    }
+}
+void VulkanRenderer::setMinimized(SDL_WindowID windowID, bool minimized) {
+    if (RenderSurface *surface = findSurface(windowID)) {
+        surface->setMinimized(minimized);
+    }
+}
+bool VulkanRenderer::areAllWindowsMinimized() const {
+    return std::all_of(m_surfaces.begin(), m_surfaces.end(), [](const auto &surface) { return surface->isMinimized(); });
+}
+void VulkanRenderer::addDamageRect(const VkRect2D &rect) {
+    m_surfaces.front()->addDamageRect(rect);
+}
+void VulkanRenderer::addDamageRect(SDL_WindowID windowID, const VkRect2D &rect) {
+    if (RenderSurface *surface = findSurface(windowID)) {
+        surface->addDamageRect(rect);
     }
-    spdlog::trace("VulkanRenderer::createImageViews()::创建交换链图像视图成功, 交换链图像视图数量: {}", m_swapChainImageViews.size());
 }
 #pragma endregion
 
@@ -499,6 +550,33 @@ VkShaderModule VulkanRenderer::createShaderModule(const std::vector<char> &code)
     }
     return shaderModule;
 }
+void VulkanRenderer::createPipelineCache() {
+    VkPipelineCacheCreateInfo cacheInfo{};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    if (vkCreatePipelineCache(m_device, &cacheInfo, nullptr, &m_pipelineCache) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanRenderer::createPipelineCache()::创建管线缓存失败");
+    }
+}
+void VulkanRenderer::createPostProcessChain() {
+    m_postProcessChain = std::make_unique<PostProcessChain>(*this);
+    m_postProcessChain->init();
+}
+void VulkanRenderer::createMeshRenderer() {
+    m_meshRenderer = std::make_unique<MeshRenderer>(*this);
+    m_meshRenderer->init();
+    m_occlusionCuller = std::make_unique<OcclusionCuller>(*this, *m_meshRenderer);
+    m_occlusionCuller->init();
+    m_meshletRenderer = std::make_unique<MeshletRenderer>(*this, *m_meshRenderer);
+    m_meshletRenderer->init();
+    m_particleSystem = std::make_unique<ParticleSystem>(*this, *m_meshRenderer);
+    m_particleSystem->init();
+    m_tilemapRenderer = std::make_unique<TilemapRenderer>(*this);
+    m_tilemapRenderer->init();
+    m_debugDraw = std::make_unique<DebugDraw>(*this, *m_meshRenderer);
+    m_debugDraw->init();
+    m_textRenderer = std::make_unique<TextRenderer>(*this);
+    m_textRenderer->init();
+}
 void VulkanRenderer::createGraphicsPipeline() {
     auto vertShaderCode             = readFile("assets/shaders/graphics.vert.spv");
     auto fragShaderCode             = readFile("assets/shaders/graphics.frag.spv");
@@ -553,6 +631,12 @@ void VulkanRenderer::createGraphicsPipeline() {
     multisampling.sampleShadingEnable  = VK_FALSE;              // 设置是否启用样本着色
     multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT; // 设置样本数量，这里设置为1
 
+    // 二维三角形和世界区块画在最底层，不参与深度测试
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.sType            = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable  = VK_FALSE; // 设置是否启用深度测试
+    depthStencil.depthWriteEnable = VK_FALSE; // 设置是否写入深度
+
     VkPipelineColorBlendAttachmentState colorBlendAttachment{};
     colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT; // 设置颜色写入掩码
     colorBlendAttachment.blendEnable    = VK_FALSE;                                                                                                  // 设置是否启用混合
@@ -581,7 +665,8 @@ void VulkanRenderer::createGraphicsPipeline() {
     pipelineLayoutInfo.setLayoutCount         = 0; // 设置布局数量
     pipelineLayoutInfo.pushConstantRangeCount = 0; // 设置推送常量范围数量
 
-    if (vkCreatePipelineLayout(m_device, &pipelineLayoutInfo, nullptr, &m_pipelineLayout) != VK_SUCCESS) {
+    VkPipelineLayout pipelineLayout;
+    if (vkCreatePipelineLayout(m_device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
         throw std::runtime_error("VulkanRenderer::createShaderModule()::创建管线布局失败");
     }
 
@@ -594,16 +679,19 @@ void VulkanRenderer::createGraphicsPipeline() {
     pipelineInfo.pViewportState      = &viewportState;   // 设置视口状态
     pipelineInfo.pRasterizationState = &rasterizer;      // 设置光栅化状态
     pipelineInfo.pMultisampleState   = &multisampling;   // 设置多重采样状态
+    pipelineInfo.pDepthStencilState  = &depthStencil;    // 设置深度模板状态
     pipelineInfo.pColorBlendState    = &colorBlending;   // 设置颜色混合状态
     pipelineInfo.pDynamicState       = &dynamicState;    // 设置动态状态
-    pipelineInfo.layout              = m_pipelineLayout; // 设置管线布局
+    pipelineInfo.layout              = pipelineLayout;   // 设置管线布局
     pipelineInfo.renderPass          = m_renderPass;     // 设置渲染通道
     pipelineInfo.subpass             = 0;                // 设置子通道
     pipelineInfo.basePipelineHandle  = VK_NULL_HANDLE;   // 设置基础管线句柄
 
-    if (vkCreateGraphicsPipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_graphicsPipeline) != VK_SUCCESS) {
+    VkPipeline graphicsPipeline;
+    if (vkCreateGraphicsPipelines(m_device, m_pipelineCache, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
         throw std::runtime_error("VulkanRenderer::createGraphicsPipeline()::创建图形管线失败");
     }
+    m_graphicsPipeline = m_resourceRegistry->addPipeline(graphicsPipeline, pipelineLayout, VK_PIPELINE_BIND_POINT_GRAPHICS); // 注册表接管管线和布局
 
     vkDestroyShaderModule(m_device, fragShaderModule, nullptr);
     vkDestroyShaderModule(m_device, vertShaderModule, nullptr);
@@ -611,63 +699,102 @@ void VulkanRenderer::createGraphicsPipeline() {
 }
 #pragma endregion
 
-#pragma region Render Pass and Framebuffers
+#pragma region Render Pass
+VkFormat VulkanRenderer::findDepthFormat() {
+    // 深度附件需要作为采样图像读取，用于构建 Hi-Z 金字塔；只选择纯深度格式
+    const VkFormat candidates[]        = {VK_FORMAT_D32_SFLOAT, VK_FORMAT_X8_D24_UNORM_PACK32, VK_FORMAT_D16_UNORM};
+    const VkFormatFeatureFlags feature = VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+    for (VkFormat format : candidates) {
+        VkFormatProperties properties;
+        vkGetPhysicalDeviceFormatProperties(m_physicalDevice, format, &properties);
+        if ((properties.optimalTilingFeatures & feature) == feature) return format;
+    }
+    throw std::runtime_error("VulkanRenderer::findDepthFormat()::找不到可采样的深度格式");
+}
 void VulkanRenderer::createRenderPass() {
-    VkAttachmentDescription colorAttachment{};
-    colorAttachment.format         = m_swapChainImageFormat;           // 设置颜色附件格式，这里设置为交换链图像格式
-    colorAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;            // 设置颜色附件样本数，这里设置为1
-    colorAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;      // 设置颜色附件加载操作，这里设置为清除操作
-    colorAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;     // 设置颜色附件存储操作，这里设置为存储操作
-    colorAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;  // 设置模板附件加载操作，这里设置为不关心
-    colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE; // 设置模板附件存储操作，这里设置为不关心
-    colorAttachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;        // 设置初始布局，这里设置为未定义
-    colorAttachment.finalLayout    = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;  // 设置最终布局，这里设置为交换链图像源布局
+    m_depthFormat = findDepthFormat();
+
+    std::array<VkAttachmentDescription, 2> attachments{};
+    VkAttachmentDescription &colorAttachment = attachments[0];
+    colorAttachment.format                   = HDR_COLOR_FORMAT;                 // 设置颜色附件格式，这里设置为离屏 HDR 格式
+    colorAttachment.samples                  = VK_SAMPLE_COUNT_1_BIT;            // 设置颜色附件样本数，这里设置为1
+    colorAttachment.loadOp                   = VK_ATTACHMENT_LOAD_OP_CLEAR;      // 设置颜色附件加载操作，这里设置为清除操作
+    colorAttachment.storeOp                  = VK_ATTACHMENT_STORE_OP_STORE;     // 设置颜色附件存储操作，这里设置为存储操作
+    colorAttachment.stencilLoadOp            = VK_ATTACHMENT_LOAD_OP_DONT_CARE;  // 设置模板附件加载操作，这里设置为不关心
+    colorAttachment.stencilStoreOp           = VK_ATTACHMENT_STORE_OP_DONT_CARE; // 设置模板附件存储操作，这里设置为不关心
+    colorAttachment.initialLayout            = VK_IMAGE_LAYOUT_UNDEFINED;        // 设置初始布局，这里设置为未定义
+    colorAttachment.finalLayout              = VK_IMAGE_LAYOUT_GENERAL;          // 设置最终布局，后处理计算着色器以存储图像读取
+
+    VkAttachmentDescription &depthAttachment = attachments[1];
+    depthAttachment.format                   = m_depthFormat;                            // 设置深度附件格式
+    depthAttachment.samples                  = VK_SAMPLE_COUNT_1_BIT;                    // 设置深度附件样本数
+    depthAttachment.loadOp                   = VK_ATTACHMENT_LOAD_OP_CLEAR;              // 设置深度附件加载操作，这里设置为清除操作
+    depthAttachment.storeOp                  = VK_ATTACHMENT_STORE_OP_STORE;             // 设置深度附件存储操作，构建 Hi-Z 时需要读取
+    depthAttachment.stencilLoadOp            = VK_ATTACHMENT_LOAD_OP_DONT_CARE;          // 设置模板附件加载操作，这里设置为不关心
+    depthAttachment.stencilStoreOp           = VK_ATTACHMENT_STORE_OP_DONT_CARE;         // 设置模板附件存储操作，这里设置为不关心
+    depthAttachment.initialLayout            = VK_IMAGE_LAYOUT_UNDEFINED;                // 设置初始布局，这里设置为未定义
+    depthAttachment.finalLayout              = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL; // 设置最终布局，Hi-Z 构建着色器以采样图像读取
 
     VkAttachmentReference colorAttachmentRef{};
     colorAttachmentRef.attachment = 0;                                        // 设置颜色附件引用索引
     colorAttachmentRef.layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL; // 设置颜色附件引用布局，这里设置为颜色附件优化布局
 
+    VkAttachmentReference depthAttachmentRef{};
+    depthAttachmentRef.attachment = 1;                                                // 设置深度附件引用索引
+    depthAttachmentRef.layout     = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL; // 设置深度附件引用布局
+
     VkSubpassDescription subpass{};
-    subpass.pipelineBindPoint    = VK_PIPELINE_BIND_POINT_GRAPHICS; // 设置管线绑定点，这里设置为图形管线
-    subpass.colorAttachmentCount = 1;                               // 设置颜色附件数量
-    subpass.pColorAttachments    = &colorAttachmentRef;             // 设置颜色附件引用
+    subpass.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS; // 设置管线绑定点，这里设置为图形管线
+    subpass.colorAttachmentCount    = 1;                               // 设置颜色附件数量
+    subpass.pColorAttachments       = &colorAttachmentRef;             // 设置颜色附件引用
+    subpass.pDepthStencilAttachment = &depthAttachmentRef;             // 设置深度附件引用
+
+    std::array<VkSubpassDependency, 2> dependencies{};
+    // 上一帧的后处理和 blit 读取完离屏目标、Hi-Z 构建读取完深度后才能再次写入
+    dependencies[0].srcSubpass    = VK_SUBPASS_EXTERNAL;
+    dependencies[0].dstSubpass    = 0;
+    dependencies[0].srcStageMask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+    dependencies[0].srcAccessMask = 0;
+    dependencies[0].dstStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    // 深度写入完成后才能被 Hi-Z 构建读取，第二阶段的渲染通道在此基础上继续读写颜色和深度
+    dependencies[1].srcSubpass    = 0;
+    dependencies[1].dstSubpass    = VK_SUBPASS_EXTERNAL;
+    dependencies[1].srcStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dependencies[1].dstStageMask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
     VkRenderPassCreateInfo renderPassInfo{};
     renderPassInfo.sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    renderPassInfo.attachmentCount = 1;                // 设置附件数量
-    renderPassInfo.pAttachments    = &colorAttachment; // 设置附件
-    renderPassInfo.subpassCount    = 1;                // 设置子通道数量
-    renderPassInfo.pSubpasses      = &subpass;         // 设置子通道
+    renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());  // 设置附件数量
+    renderPassInfo.pAttachments    = attachments.data();                         // 设置附件
+    renderPassInfo.subpassCount    = 1;                                          // 设置子通道数量
+    renderPassInfo.pSubpasses      = &subpass;                                   // 设置子通道
+    renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size()); // 设置子通道依赖数量
+    renderPassInfo.pDependencies   = dependencies.data();                        // 设置子通道依赖
 
     if (vkCreateRenderPass(m_device, &renderPassInfo, nullptr, &m_renderPass) != VK_SUCCESS) {
         throw std::runtime_error("VulkanRenderer::createRenderPass()::创建渲染通道失败");
     }
-    spdlog::trace("VulkanRenderer::createRenderPass()::创建渲染通道成功");
-}
-
-void VulkanRenderer::createFramebuffers() {
-    m_swapChainFramebuffers.resize(m_swapChainImageViews.size());
-    for (size_t i = 0; i < m_swapChainImageViews.size(); i++) {
-        VkImageView attachments[] = {m_swapChainImageViews[i]};
-        VkFramebufferCreateInfo framebufferInfo{};
-        framebufferInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-        framebufferInfo.renderPass      = m_renderPass;             // 设置渲染通道
-        framebufferInfo.attachmentCount = 1;                        // 设置附件数量
-        framebufferInfo.pAttachments    = attachments;              // 设置附件
-        framebufferInfo.width           = m_swapChainExtent.width;  // 设置帧缓冲宽度
-        framebufferInfo.height          = m_swapChainExtent.height; // 设置帧缓冲高度
-        framebufferInfo.layers          = 1;                        // 设置帧缓冲层数量
-        if (vkCreateFramebuffer(m_device, &framebufferInfo, nullptr, &m_swapChainFramebuffers[i]) != VK_SUCCESS) {
-            throw std::runtime_error("VulkanRenderer::createFramebuffers()::创建帧缓冲失败");
-        }
+
+    // 保留版本：只有加载操作和布局不同，与 m_renderPass 兼容，可以使用同一批管线和帧缓冲
+    colorAttachment.loadOp        = VK_ATTACHMENT_LOAD_OP_LOAD;
+    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_GENERAL;
+    depthAttachment.loadOp        = VK_ATTACHMENT_LOAD_OP_LOAD;
+    depthAttachment.initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    if (vkCreateRenderPass(m_device, &renderPassInfo, nullptr, &m_renderPassLoad) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanRenderer::createRenderPass()::创建保留渲染通道失败");
     }
-    spdlog::trace("VulkanRenderer::createFramebuffers()::创建帧缓冲成功，数量：{}", m_swapChainFramebuffers.size());
+    spdlog::trace("VulkanRenderer::createRenderPass()::创建渲染通道成功, 深度格式: {}", static_cast<int>(m_depthFormat));
 }
+
 #pragma endregion
 
 #pragma region Command Buffers and Synchronization
 void VulkanRenderer::createCommandPool() {
-    QueueFamilyIndices queueFamilyIndices = findQueueFamilies(m_physicalDevice);
+    const QueueFamilyIndices &queueFamilyIndices = m_queueFamilyIndices;
     VkCommandPoolCreateInfo poolInfo{};
     poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
     poolInfo.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT; // 设置命令池标志，这里设置为重置命令缓冲标志
@@ -678,42 +805,72 @@ void VulkanRenderer::createCommandPool() {
     spdlog::trace("VulkanRenderer::createCommandPool()::创建命令池成功");
 }
 void VulkanRenderer::createCommandBuffers() {
-    m_commandBuffers.resize(m_swapChainFramebuffers.size());
     VkCommandBufferAllocateInfo allocInfo{};
     allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     allocInfo.commandPool        = m_commandPool;                     // 设置命令池
     allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;   // 设置命令缓冲级别，这里设置为一级命令缓冲
-    allocInfo.commandBufferCount = 1;                                 // 设置命令缓冲数量
-    allocInfo.commandBufferCount = (uint32_t)m_commandBuffers.size(); // 设置命令缓冲数量
+    allocInfo.commandBufferCount = MAX_FRAMES_IN_FLIGHT;              // 设置命令缓冲数量
     if (vkAllocateCommandBuffers(m_device, &allocInfo, m_commandBuffers.data()) != VK_SUCCESS) {
         throw std::runtime_error("VulkanRenderer::createCommandBuffers()::创建命令缓冲失败");
     }
     spdlog::trace("VulkanRenderer::createCommandBuffers()::创建命令缓冲成功，数量：{}", m_commandBuffers.size());
 }
-void VulkanRenderer::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+void VulkanRenderer::recordCommandBuffer(VkCommandBuffer commandBuffer, const std::pmr::vector<RenderSurface *> &surfaces) {
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
         throw std::runtime_error("VulkanRenderer::recordCommandBuffer()::开始记录命令缓冲失败");
     }
+    m_resourceRegistry->recordDefragmentation(commandBuffer);        // 搬移稀疏内存块中的资源，之后的命令经由句柄取得新对象
+    m_postProcessChain->beginFrame(commandBuffer, m_currentFrame);
+    m_worldStreamer->recordUploads(commandBuffer);                   // 流式加载的区块在渲染通道之前复制到几何池
+    m_meshRenderer->recordUploads(commandBuffer);                    // 物体数据有变化时复制到物体缓冲区
+    m_meshRenderer->cullObjects(m_jobSystem);                        // CPU 视锥剔除，所有窗口共用同一个相机
+    m_occlusionCuller->beginFrame(commandBuffer, m_currentFrame);    // 读取该帧上一轮的剔除统计并清零
+    m_meshletRenderer->recordUploads(commandBuffer);                 // 簇物体列表有变化时复制到 GPU
+    m_meshletRenderer->beginFrame(commandBuffer, m_currentFrame);
+    m_meshletRenderer->recordCull(commandBuffer);                    // 所有窗口共用同一个相机，簇剔除每帧只做一次
+    m_particleSystem->recordSimulate(commandBuffer, m_currentFrame); // 粒子的发射、模拟和压缩每帧只做一次
+    m_tilemapRenderer->recordUploads(commandBuffer);                 // 只重新上传图块有变化的区块
+    m_debugDraw->flush();                                            // 合并所有线程本帧提交的调试图形，流式缓冲区的写入在提交前刷新
+    m_textRenderer->flush(commandBuffer);                            // 新字形复制到图集，本帧的字形实例写入流式缓冲区
+    for (RenderSurface *surface : surfaces) {
+        recordSurface(commandBuffer, *surface); // 所有窗口记录到同一个命令缓冲中
+    }
+    m_meshletRenderer->endFrame(commandBuffer);
+    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanRenderer::recordCommandBuffer()::结束记录命令缓冲失败");
+    }
+}
+void VulkanRenderer::recordSurface(VkCommandBuffer commandBuffer, RenderSurface &surface) {
+    VkExtent2D extent                  = surface.getExtent();
+    OcclusionTargets &occlusionTargets = surface.getOcclusionTargets();
+    bool drawMeshes                    = m_meshRenderer->getObjectCount() > 0;
+    bool latePass                      = drawMeshes && m_occlusionCuller->isEnabled(); // 调试图形画在场景的最后一个渲染通道中
+    if (drawMeshes) {
+        m_occlusionCuller->recordCull(commandBuffer, occlusionTargets, CullPhase::Early); // 第一阶段：用上一帧的 Hi-Z 剔除
+    }
+
+    std::array<VkClearValue, 2> clearValues{};
+    clearValues[0].color        = {{0.0f, 0.0f, 0.0f, 1.0f}}; // 设置颜色清除值
+    clearValues[1].depthStencil = {1.0f, 0};                  // 设置深度清除值，深度测试使用 LESS
     VkRenderPassBeginInfo renderPassInfo{};
     renderPassInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    renderPassInfo.renderPass        = m_renderPass;                        // 设置渲染通道
-    renderPassInfo.framebuffer       = m_swapChainFramebuffers[imageIndex]; // 设置帧缓冲
-    renderPassInfo.renderArea.offset = {0, 0};                              // 设置渲染区域偏移
-    renderPassInfo.renderArea.extent = m_swapChainExtent;                   // 设置渲染区域大小
-    VkClearValue clearColor          = {{{0.0f, 0.0f, 0.0f, 1.0f}}};        // 设置清除值
-    renderPassInfo.clearValueCount   = 1;                                   // 设置清除值数量
-    renderPassInfo.pClearValues      = &clearColor;                         // 设置清除值
+    renderPassInfo.renderPass        = m_renderPass;                              // 设置渲染通道
+    renderPassInfo.framebuffer       = surface.getSceneFramebuffer();             // 设置帧缓冲，渲染到离屏 HDR 目标
+    renderPassInfo.renderArea.offset = {0, 0};                                    // 设置渲染区域偏移
+    renderPassInfo.renderArea.extent = extent;                                    // 设置渲染区域大小
+    renderPassInfo.clearValueCount   = static_cast<uint32_t>(clearValues.size()); // 设置清除值数量
+    renderPassInfo.pClearValues      = clearValues.data();                        // 设置清除值
     vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
     {
-        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline);
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_resourceRegistry->getPipeline(m_graphicsPipeline));
 
         // 目标三角形的宽高比
         float targetAspectRatio = 4.0f / 3.0f; // 例如 4.0f / 3.0f
         // 计算目标宽度和高度
-        float width  = static_cast<float>(m_swapChainExtent.width);
-        float height = static_cast<float>(m_swapChainExtent.height);
+        float width  = static_cast<float>(extent.width);
+        float height = static_cast<float>(extent.height);
         // 根据目标宽高比调整视口
         if (width / height > targetAspectRatio) {
             width = height * targetAspectRatio; // 窗口更宽，按高度缩放
@@ -721,8 +878,8 @@ void VulkanRenderer::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t
             height = width / targetAspectRatio; // 窗口更高，按宽度缩放
         }
         // 计算视口的 x 和 y 偏移量以使三角形居中
-        float x = (static_cast<float>(m_swapChainExtent.width) - width) / 2.0f;
-        float y = (static_cast<float>(m_swapChainExtent.height) - height) / 2.0f;
+        float x = (static_cast<float>(extent.width) - width) / 2.0f;
+        float y = (static_cast<float>(extent.height) - height) / 2.0f;
 
         VkViewport viewport{};
         viewport.x        = x;      // 设置视口x坐标
@@ -733,150 +890,344 @@ void VulkanRenderer::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t
         viewport.maxDepth = 1.0f;   // 设置视口最大深度
         vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
         VkRect2D scissor{};
-        scissor.offset = {0, 0};            // 设置剪裁区域偏移
-        scissor.extent = m_swapChainExtent; // 设置剪裁区域大小
+        scissor.offset = {0, 0}; // 设置剪裁区域偏移
+        scissor.extent = extent; // 设置剪裁区域大小
         vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
-        VkBuffer vertexBuffers[] = {m_vertexBuffer}; // 绑定顶点缓冲
-        VkDeviceSize offsets[]   = {0};          // 设置顶点缓冲偏移
+        VkBuffer vertexBuffers[] = {m_resourceRegistry->getBuffer(m_vertexBuffer)}; // 绑定顶点缓冲
+        VkDeviceSize offsets[]   = {0};                                             // 设置顶点缓冲偏移
         vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets); // 绑定顶点缓冲
 
         vkCmdDraw(commandBuffer, static_cast<uint32_t>(vertices.size()), 1, 0, 0); // 绘制三角形
+
+        m_worldStreamer->recordDraws(commandBuffer);           // 绘制常驻的世界区块
+        m_tilemapRenderer->recordDraws(commandBuffer, extent); // 绘制可见的图块地图区块，会切换管线，放在使用图形管线的绘制之后
+
+        if (drawMeshes) {
+            m_meshRenderer->recordDraws(commandBuffer, extent, m_resourceRegistry->getBuffer(occlusionTargets.drawBuffer), m_occlusionCuller->getDrawOffset(CullPhase::Early));
+        }
+        m_meshletRenderer->recordDraws(commandBuffer, extent); // 簇几何不参与 Hi-Z 遮挡剔除，只在第一阶段绘制
+        if (!latePass) {
+            m_particleSystem->recordDraws(commandBuffer, extent); // 透明粒子画在所有不透明几何之后
+            m_debugDraw->recordDraws(commandBuffer, extent);
+            m_textRenderer->recordDraws(commandBuffer, extent); // 文字画在最上层
+        }
     }
     vkCmdEndRenderPass(commandBuffer);
-    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
-        throw std::runtime_error("VulkanRenderer::recordCommandBuffer()::结束记录命令缓冲失败");
+
+    if (latePass) {
+        // 第二阶段：用本帧第一阶段的深度重建 Hi-Z，补画第一阶段被误剔除的物体，避免镜头移动时物体闪现
+        m_occlusionCuller->buildHiZ(commandBuffer, occlusionTargets);
+        m_occlusionCuller->recordCull(commandBuffer, occlusionTargets, CullPhase::Late);
+        renderPassInfo.renderPass      = m_renderPassLoad; // 保留第一阶段的颜色和深度
+        renderPassInfo.clearValueCount = 0;
+        renderPassInfo.pClearValues    = nullptr;
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+        m_meshRenderer->recordDraws(commandBuffer, extent, m_resourceRegistry->getBuffer(occlusionTargets.drawBuffer), m_occlusionCuller->getDrawOffset(CullPhase::Late));
+        m_particleSystem->recordDraws(commandBuffer, extent);
+        m_debugDraw->recordDraws(commandBuffer, extent);
+        m_textRenderer->recordDraws(commandBuffer, extent);
+        vkCmdEndRenderPass(commandBuffer);
     }
+
+    // 离屏 HDR 结果经过后处理链，最后 blit 到交换链图像
+    m_postProcessChain->record(commandBuffer, surface.getPostProcessTargets(), surface.getImage(surface.getImageIndex()), extent);
 }
 void VulkanRenderer::createSyncObjects() {
-    m_imageAvailableSemaphores.resize(m_commandBuffers.size());
-    m_renderFinishedSemaphores.resize(m_commandBuffers.size());
-    m_inFlightFences.resize(m_commandBuffers.size());
     VkSemaphoreCreateInfo semaphoreInfo{};
     semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
     VkFenceCreateInfo fenceInfo{};
     fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
     fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT; // 设置Fence标志，这里设置为已信号标志
 
-    for (size_t i = 0; i < m_commandBuffers.size(); i++) {
-        if (vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &m_imageAvailableSemaphores[i]) != VK_SUCCESS ||
-            vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &m_renderFinishedSemaphores[i]) != VK_SUCCESS ||
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        if (vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &m_renderFinishedSemaphores[i]) != VK_SUCCESS ||
             vkCreateFence(m_device, &fenceInfo, nullptr, &m_inFlightFences[i]) != VK_SUCCESS) {
             throw std::runtime_error("VulkanRenderer::createSyncObjects()::创建同步对象失败");
         }
     }
-    spdlog::trace("VulkanRenderer::createSyncObjects()::创建同步对象成功，数量：{}", m_commandBuffers.size());
+    spdlog::trace("VulkanRenderer::createSyncObjects()::创建同步对象成功，数量：{}", MAX_FRAMES_IN_FLIGHT);
 }
 #pragma endregion
 
-#pragma region Render and Recreate Swap Chain
-void VulkanRenderer::drawFrame() {
+#pragma region Render
+bool VulkanRenderer::drawFrame() {
     vkWaitForFences(m_device, 1, &m_inFlightFences[m_currentFrame], VK_TRUE, UINT64_MAX); // 等待Fence信号
-    uint32_t imageIndex;
-    VkResult result = vkAcquireNextImageKHR(m_device, m_swapChain, UINT64_MAX, m_imageAvailableSemaphores[m_currentFrame], VK_NULL_HANDLE, &imageIndex); // 获取下一个图像
-    if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-        recreateSwapChain();
-        return;
-    } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
-        throw std::runtime_error("VulkanRenderer::drawFrame()::获取下一个交换链图像失败");
+    m_streamingBuffer->beginFrame(m_currentFrame);                                         // 该帧上一轮使用的流式缓冲区空间可以回收了
+    if (m_frameNumber >= MAX_FRAMES_IN_FLIGHT) {
+        m_deletionQueue.flush(m_frameNumber - MAX_FRAMES_IN_FLIGHT); // Fence 按顺序等待，更早的帧都已在 GPU 上完成
+    }
+    m_memoryBudget->update(m_frameNumber); // 读取显存预算，超出时淘汰可流式加载的资源
+    m_frameArenas[m_currentFrame].reset(); // 该帧上一轮的临时容器不再使用
+    std::pmr::memory_resource *arena = &m_frameArenas[m_currentFrame];
+
+    // 为每个窗口获取交换链图像，最小化或交换链过期的窗口本帧跳过
+    std::pmr::vector<RenderSurface *> activeSurfaces(arena);
+    std::pmr::vector<VkSemaphore> waitSemaphores(arena);
+    std::pmr::vector<VkPipelineStageFlags> waitStages(arena);
+    activeSurfaces.reserve(m_surfaces.size());
+    waitSemaphores.reserve(m_surfaces.size());
+    waitStages.reserve(m_surfaces.size());
+    bool presented = true; // 所有未最小化的窗口都呈现了本帧画面
+    for (auto &surface : m_surfaces) {
+        if (!surface->acquireNextImage(m_currentFrame)) {
+            presented = presented && surface->isMinimized(); // 交换链过期被重建，需要再渲染一次
+            continue;
+        }
+        activeSurfaces.push_back(surface.get());
+        waitSemaphores.push_back(surface->getImageAvailableSemaphore(m_currentFrame));
+        waitStages.push_back(VK_PIPELINE_STAGE_TRANSFER_BIT); // 交换链图像第一次被使用是后处理结果的 blit
+    }
+    if (activeSurfaces.empty()) {
+        m_streamingBuffer->endFrame(m_currentFrame); // 本帧写入的数据不会被使用，Fence 已信号，下次等待后即回收
+        return presented;                            // 没有可呈现的窗口，Fence 保持已信号状态
     }
+
     vkResetFences(m_device, 1, &m_inFlightFences[m_currentFrame]);                              // 重置Fence信号
     vkResetCommandBuffer(m_commandBuffers[m_currentFrame], /*VkCommandBufferResetFlagBits*/ 0); // 重置命令缓冲
     // 在记录命令缓冲之前，我们需要确保我们正在渲染的图像已经准备好，并且没有其他操作正在使用它
-    recordCommandBuffer(m_commandBuffers[m_currentFrame], imageIndex); // 记录命令缓冲，并绘制三角形，渲染到帧缓冲
+    m_recording = true;
+    recordCommandBuffer(m_commandBuffers[m_currentFrame], activeSurfaces); // 记录命令缓冲，所有窗口共用一次提交
+    m_recording = false;
     // 在这个时候，我们已经有了一个渲染好的图像，并且已经准备好了命令缓冲，现在我们可以提交命令缓冲并呈现图像了
     VkSubmitInfo submitInfo{};
-    submitInfo.sType                  = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    VkSemaphore waitSemaphores[]      = {m_imageAvailableSemaphores[m_currentFrame]};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount     = 1;                                 // 设置等待信号量的数量
-    submitInfo.pWaitSemaphores        = waitSemaphores;                    // 设置等待信号量
-    submitInfo.pWaitDstStageMask      = waitStages;                        // 设置等待阶段
-    submitInfo.commandBufferCount     = 1;                                 // 设置命令缓冲数量
-    submitInfo.pCommandBuffers        = &m_commandBuffers[m_currentFrame]; // 设置命令缓冲
-    VkSemaphore signalSemaphores[]    = {m_renderFinishedSemaphores[m_currentFrame]};
-    submitInfo.signalSemaphoreCount   = 1;                // 设置信号量的数量
-    submitInfo.pSignalSemaphores      = signalSemaphores; // 设置信号量
+    submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.waitSemaphoreCount   = static_cast<uint32_t>(waitSemaphores.size()); // 设置等待信号量的数量
+    submitInfo.pWaitSemaphores      = waitSemaphores.data();                        // 设置等待信号量
+    submitInfo.pWaitDstStageMask    = waitStages.data();                            // 设置等待阶段
+    submitInfo.commandBufferCount   = 1;                                            // 设置命令缓冲数量
+    submitInfo.pCommandBuffers      = &m_commandBuffers[m_currentFrame];            // 设置命令缓冲
+    VkSemaphore signalSemaphores[]  = {m_renderFinishedSemaphores[m_currentFrame]};
+    submitInfo.signalSemaphoreCount = 1;                // 设置信号量的数量
+    submitInfo.pSignalSemaphores    = signalSemaphores; // 设置信号量
+    m_streamingBuffer->endFrame(m_currentFrame); // 刷新非一致性内存，本帧流式数据随该帧 Fence 回收
     if (vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, m_inFlightFences[m_currentFrame]) != VK_SUCCESS) {
         throw std::runtime_error("VulkanRenderer::drawFrame()::提交命令缓冲失败");
     }
-    // 提交命令缓冲后，我们可以使用present函数将图像呈现到屏幕上，提交到队列后，图像将呈现到屏幕上
+    m_frameNumber++;
+    // 提交命令缓冲后，一次 present 调用呈现所有窗口的交换链图像
+    std::pmr::vector<VkSwapchainKHR> swapChains(arena);
+    std::pmr::vector<uint32_t> imageIndices(arena);
+    std::pmr::vector<VkPresentRegionKHR> presentRegionList(arena);
+    swapChains.reserve(activeSurfaces.size());
+    imageIndices.reserve(activeSurfaces.size());
+    presentRegionList.reserve(activeSurfaces.size());
+    bool hasDamage = false;
+    for (const RenderSurface *surface : activeSurfaces) {
+        swapChains.push_back(surface->getSwapChain());
+        imageIndices.push_back(surface->getImageIndex());
+        // 增量呈现：只告诉呈现引擎本帧变化的矩形区域，没有变化区域的交换链按整帧呈现
+        VkPresentRegionKHR region{};
+        region.rectangleCount = static_cast<uint32_t>(surface->getDamageRects().size());
+        region.pRectangles    = surface->getDamageRects().data();
+        presentRegionList.push_back(region);
+        hasDamage = hasDamage || region.rectangleCount > 0;
+    }
+    std::pmr::vector<VkResult> results(activeSurfaces.size(), arena);
     VkPresentInfoKHR presentInfo{};
     presentInfo.sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;                // 设置等待信号量的数量
-    presentInfo.pWaitSemaphores    = signalSemaphores; // 设置等待信号量
-    VkSwapchainKHR swapChains[]    = {m_swapChain};    // 设置交换链，这里只有一个交换链
-    presentInfo.swapchainCount     = 1;                // 设置交换链数量
-    presentInfo.pSwapchains        = swapChains;       // 设置交换链
-    presentInfo.pImageIndices      = &imageIndex;      // 设置图像索引
-
-    result = vkQueuePresentKHR(m_presentQueue, &presentInfo); // 提交到队列
-    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || m_framebufferResized) {
-        m_framebufferResized = false; // 如果交换链需要重新创建，则将标志设置为false
-        recreateSwapChain();
-    } else if (result != VK_SUCCESS) {
-        throw std::runtime_error("VulkanRenderer::drawFrame()::呈现交换链图像失败");
+    presentInfo.waitSemaphoreCount = 1;                                         // 设置等待信号量的数量
+    presentInfo.pWaitSemaphores    = signalSemaphores;                          // 设置等待信号量
+    presentInfo.swapchainCount     = static_cast<uint32_t>(swapChains.size()); // 设置交换链数量
+    presentInfo.pSwapchains        = swapChains.data();                         // 设置交换链
+    presentInfo.pImageIndices      = imageIndices.data();                       // 设置图像索引
+    presentInfo.pResults           = results.data();                            // 每个交换链各自的呈现结果
+
+    VkPresentRegionsKHR presentRegions{};
+    if (m_incrementalPresentSupported && hasDamage) {
+        presentRegions.sType          = VK_STRUCTURE_TYPE_PRESENT_REGIONS_KHR;
+        presentRegions.swapchainCount = static_cast<uint32_t>(presentRegionList.size());
+        presentRegions.pRegions       = presentRegionList.data();
+        presentInfo.pNext             = &presentRegions;
     }
-    // 现在图像已经呈现到屏幕上了，我们可以开始下一帧了
-    m_currentFrame = (m_currentFrame + 1) % m_commandBuffers.size();
-}
-void VulkanRenderer::cleanupSwapChain() {
-    for (auto framebuffer : m_swapChainFramebuffers) {
-        vkDestroyFramebuffer(m_device, framebuffer, nullptr);
+
+    VkResult result = vkQueuePresentKHR(m_presentQueue, &presentInfo); // 提交到队列
+    if (result != VK_SUCCESS && result != VK_ERROR_OUT_OF_DATE_KHR && result != VK_SUBOPTIMAL_KHR) {
+        throw std::runtime_error("VulkanRenderer::drawFrame()::呈现交换链图像失败");
     }
-    for (auto imageView : m_swapChainImageViews) {
-        vkDestroyImageView(m_device, imageView, nullptr);
+    for (size_t i = 0; i < activeSurfaces.size(); i++) {
+        RenderSurface *surface = activeSurfaces[i];
+        surface->clearDamageRects(); // 变化区域只对本帧有效
+        if (results[i] == VK_ERROR_OUT_OF_DATE_KHR || results[i] == VK_SUBOPTIMAL_KHR || surface->isFramebufferResized()) {
+            surface->recreateSwapChain(); // 如果交换链需要重新创建，重建后标志会被清除
+            presented = false;            // 呈现的图像可能没有显示或尺寸不对，用新的交换链再渲染一次
+        }
     }
-    vkDestroySwapchainKHR(m_device, m_swapChain, nullptr);
-}
-void VulkanRenderer::recreateSwapChain() {
-    vkDeviceWaitIdle(m_device);
-    cleanupSwapChain();
-
-    createSwapChain();
-    createImageViews();
-    createFramebuffers();
-    spdlog::trace("VulkanRenderer::recreateSwapChain()::重新创建交换链成功");
+    // 现在图像已经呈现到屏幕上了，我们可以开始下一帧了
+    m_currentFrame = (m_currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+    return presented;
 }
 #pragma endregion
 
 #pragma region Buffer and Image
 void VulkanRenderer::createVertexBuffer() {
+    VkDeviceSize size     = sizeof(vertices[0]) * vertices.size();                                                          // 设置缓冲区大小
+    m_vertexBuffer        = m_resourceRegistry->createBuffer(size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, MemoryUsage::Upload); // 创建并绑定缓冲区内存
+    VkDeviceMemory memory = m_resourceRegistry->get(m_vertexBuffer)->memory;
+
+    void *data;
+    vkMapMemory(m_device, memory, 0, size, 0, &data);        // 映射内存
+    memcpy(data, vertices.data(), static_cast<size_t>(size)); // 复制数据到内存
+    vkUnmapMemory(m_device, memory);                          // 解除映射
+    spdlog::trace("VulkanRenderer::createVertexBuffer()::创建顶点缓冲成功");
+}
+void VulkanRenderer::createStreamingBuffer() {
+    // 除了直接绑定为顶点/索引缓冲，也作为上传到设备本地缓冲区的暂存区
+    VkBufferUsageFlags usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    m_streamingBuffer        = std::make_unique<StreamingBuffer>(*this, STREAMING_BUFFER_SIZE, usage);
+}
+void VulkanRenderer::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, MemoryUsage memoryUsage, VkBuffer &buffer, VkDeviceMemory &bufferMemory) {
     VkBufferCreateInfo bufferInfo{};
     bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size        = sizeof(vertices[0]) * vertices.size(); // 设置缓冲区大小
-    bufferInfo.usage       = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;     // 设置缓冲区用途
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;             // 设置共享模式
-    if (vkCreateBuffer(m_device, &bufferInfo, nullptr, &m_vertexBuffer) != VK_SUCCESS) {
-        throw std::runtime_error("VulkanRenderer::createVertexBuffer()::创建顶点缓冲失败");
+    bufferInfo.size        = size;                      // 设置缓冲区大小
+    bufferInfo.usage       = usage;                     // 设置缓冲区用途
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE; // 设置共享模式
+    if (vkCreateBuffer(m_device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanRenderer::createBuffer()::创建缓冲区失败");
     }
 
     VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(m_device, m_vertexBuffer, &memRequirements);
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize  = memRequirements.size;                                                                                                       // 设置分配大小
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT); // 设置内存类型
-    if (vkAllocateMemory(m_device, &allocInfo, nullptr, &m_vertexBufferMemory) != VK_SUCCESS) {
-        throw std::runtime_error("VulkanRenderer::createVertexBuffer()::分配顶点缓冲内存失败");
+    vkGetBufferMemoryRequirements(m_device, buffer, &memRequirements);
+    if (allocateMemory(memRequirements, memoryUsage, MemoryBudget::categorizeBuffer(usage), bufferMemory) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanRenderer::createBuffer()::分配缓冲区内存失败");
+    }
+    vkBindBufferMemory(m_device, buffer, bufferMemory, 0); // 绑定缓冲区内存
+}
+void VulkanRenderer::createImage(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage, MemoryUsage memoryUsage, VkImage &image, VkDeviceMemory &imageMemory, uint32_t mipLevels) {
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType     = VK_IMAGE_TYPE_2D;          // 设置图像类型
+    imageInfo.extent        = {width, height, 1};        // 设置图像尺寸
+    imageInfo.mipLevels     = mipLevels;                 // 设置 Mipmap 级别数量
+    imageInfo.arrayLayers   = 1;                         // 设置数组层数
+    imageInfo.format        = format;                    // 设置图像格式
+    imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;   // 设置图像排列方式
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED; // 设置初始布局
+    imageInfo.usage         = usage;                     // 设置图像用途
+    imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;     // 设置样本数量
+    imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE; // 设置共享模式
+    if (vkCreateImage(m_device, &imageInfo, nullptr, &image) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanRenderer::createImage()::创建图像失败");
     }
-    vkBindBufferMemory(m_device, m_vertexBuffer, m_vertexBufferMemory, 0); // 绑定缓冲区内存
 
-    void *data;
-    vkMapMemory(m_device, m_vertexBufferMemory, 0, bufferInfo.size, 0, &data); // 映射内存
-    memcpy(data, vertices.data(), (size_t)bufferInfo.size);                    // 复制数据到内存
-    vkUnmapMemory(m_device, m_vertexBufferMemory);                             // 解除映射
-    spdlog::trace("VulkanRenderer::createVertexBuffer()::创建顶点缓冲成功");
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(m_device, image, &memRequirements);
+    if (allocateMemory(memRequirements, memoryUsage, MemoryBudget::categorizeImage(usage), imageMemory) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanRenderer::createImage()::分配图像内存失败");
+    }
+    vkBindImageMemory(m_device, image, imageMemory, 0); // 绑定图像内存
+}
+VkImageView VulkanRenderer::createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t baseMipLevel, uint32_t levelCount) {
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image                           = image;                 // 设置图像
+    viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D; // 设置图像视图类型
+    viewInfo.format                          = format;                // 设置图像格式
+    viewInfo.subresourceRange.aspectMask     = aspectFlags;           // 设置图像视图的方面掩码
+    viewInfo.subresourceRange.baseMipLevel   = baseMipLevel;          // 设置图像视图的基础Mipmap级别
+    viewInfo.subresourceRange.levelCount     = levelCount;            // 设置图像视图的Mipmap级别数量
+    viewInfo.subresourceRange.baseArrayLayer = 0;                     // 设置图像视图的基础数组层
+    viewInfo.subresourceRange.layerCount     = 1;                     // 设置图像视图的数组层数
+    return m_imageViewCache->acquire(viewInfo);
+}
+void VulkanRenderer::releaseImageView(VkImageView imageView) {
+    m_imageViewCache->release(imageView);
 }
-uint32_t VulkanRenderer::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-    VkPhysicalDeviceMemoryProperties memProperties; // 获取物理设备的内存属性
-    vkGetPhysicalDeviceMemoryProperties(m_physicalDevice, &memProperties);
-    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-            return i;
+VkResult VulkanRenderer::allocateMemory(VkDeviceSize size, uint32_t memoryTypeIndex, MemoryCategory category, VkDeviceMemory &memory) {
+    m_memoryBudget->makeRoom(memoryTypeIndex, size); // 分配后会超出预算时先淘汰，被淘汰的资源在之后的帧里释放
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize  = size;            // 设置分配大小
+    allocInfo.memoryTypeIndex = memoryTypeIndex; // 设置内存类型
+    VkResult result           = vkAllocateMemory(m_device, &allocInfo, nullptr, &memory);
+    if (result == VK_ERROR_OUT_OF_DEVICE_MEMORY || result == VK_ERROR_OUT_OF_HOST_MEMORY) {
+        // 淘汰后等待设备空闲，立即执行 GPU 已经用完的延迟销毁再重试一次；正在记录的帧延迟销毁的资源可能仍被命令缓冲引用
+        spdlog::warn("VulkanRenderer::allocateMemory()::分配 {} 字节失败, 淘汰后重试, 内存类型: {}", size, memoryTypeIndex);
+        m_memoryBudget->evict(m_memoryBudget->getHeapIndex(memoryTypeIndex), size);
+        m_memoryBudget->countAllocationRetry();
+        vkDeviceWaitIdle(m_device);
+        if (!m_recording) {
+            m_deletionQueue.flushAll();
+        } else if (m_frameNumber > 0) {
+            m_deletionQueue.flush(m_frameNumber - 1);
         }
+        result = vkAllocateMemory(m_device, &allocInfo, nullptr, &memory);
     }
-    throw std::runtime_error("VulkanRenderer::findMemoryType()::找不到合适的内存类型");
+    if (result == VK_SUCCESS) m_memoryBudget->trackAllocation(memory, size, memoryTypeIndex, category);
+    return result;
+}
+VkResult VulkanRenderer::allocateMemory(const VkMemoryRequirements &requirements, MemoryUsage memoryUsage, MemoryCategory category, VkDeviceMemory &memory) {
+    uint32_t typeFilter      = requirements.memoryTypeBits;
+    uint32_t memoryTypeIndex = m_memoryTypePolicy->selectMemoryType(typeFilter, memoryUsage);
+    if (memoryTypeIndex == UINT32_MAX) {
+        throw std::runtime_error("VulkanRenderer::allocateMemory()::找不到合适的内存类型");
+    }
+    VkResult result = allocateMemory(requirements.size, memoryTypeIndex, category, memory);
+    // 淘汰后仍然失败说明所在堆已经耗尽，例如显存不足时退到系统内存，慢但仍可用
+    while (result == VK_ERROR_OUT_OF_DEVICE_MEMORY || result == VK_ERROR_OUT_OF_HOST_MEMORY) {
+        typeFilter &= ~(1u << memoryTypeIndex);
+        uint32_t fallbackIndex = m_memoryTypePolicy->selectMemoryType(typeFilter, memoryUsage);
+        if (fallbackIndex == UINT32_MAX) break;
+        spdlog::warn("VulkanRenderer::allocateMemory()::内存类型 {} 分配 {} 字节失败, 改用内存类型 {}", memoryTypeIndex, requirements.size, fallbackIndex);
+        memoryTypeIndex = fallbackIndex;
+        result          = allocateMemory(requirements.size, memoryTypeIndex, category, memory);
+    }
+    return result;
+}
+void VulkanRenderer::freeMemory(VkDeviceMemory memory) {
+    if (memory == VK_NULL_HANDLE) return;
+    m_memoryBudget->trackFree(memory);
+    vkFreeMemory(m_device, memory, nullptr);
+}
+void VulkanRenderer::deferDestroy(std::function<void()> deleter) {
+    m_deletionQueue.push(m_frameNumber, std::move(deleter));
+}
+VkCommandBuffer VulkanRenderer::beginSingleTimeCommands() {
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool        = m_commandPool;                   // 设置命令池
+    allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY; // 设置命令缓冲级别
+    allocInfo.commandBufferCount = 1;                               // 设置命令缓冲数量
+    VkCommandBuffer commandBuffer;
+    if (vkAllocateCommandBuffers(m_device, &allocInfo, &commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanRenderer::beginSingleTimeCommands()::分配一次性命令缓冲失败");
+    }
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT; // 只提交一次
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    return commandBuffer;
+}
+void VulkanRenderer::endSingleTimeCommands(VkCommandBuffer commandBuffer) {
+    vkEndCommandBuffer(commandBuffer);
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;              // 设置命令缓冲数量
+    submitInfo.pCommandBuffers    = &commandBuffer; // 设置命令缓冲
+    if (vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanRenderer::endSingleTimeCommands()::提交一次性命令缓冲失败");
+    }
+    vkQueueWaitIdle(m_graphicsQueue); // 一次性命令只在加载资源时使用，直接等待完成
+    vkFreeCommandBuffers(m_device, m_commandPool, 1, &commandBuffer);
+}
+void VulkanRenderer::recordImageBarrier(VkCommandBuffer commandBuffer, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
+                                        VkPipelineStageFlags srcStage, VkAccessFlags srcAccess, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess,
+                                        VkImageAspectFlags aspectMask) {
+    VkImageMemoryBarrier barrier{};
+    barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout                       = oldLayout;
+    barrier.newLayout                       = newLayout;
+    barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image                           = image;
+    barrier.subresourceRange.aspectMask     = aspectMask;
+    barrier.subresourceRange.baseMipLevel   = 0;
+    barrier.subresourceRange.levelCount     = VK_REMAINING_MIP_LEVELS;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+    barrier.srcAccessMask                   = srcAccess;
+    barrier.dstAccessMask                   = dstAccess;
+    vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
 }
 #pragma endregion
 
@@ -1,8 +1,28 @@
 #pragma once
+#include "../utils/FrameArena.hpp"
 #include "../utils/Math.hpp"
+#include "DebugDraw.hpp"
+#include "DeletionQueue.hpp"
+#include "MemoryBudget.hpp"
+#include "MemoryTypePolicy.hpp"
+#include "MeshRenderer.hpp"
+#include "MeshletRenderer.hpp"
+#include "OcclusionCuller.hpp"
+#include "ParticleSystem.hpp"
+#include "RenderSurface.hpp"
+#include "ResourceCache.hpp"
+#include "ResourceRegistry.hpp"
+#include "StreamingBuffer.hpp"
+#include "TextRenderer.hpp"
+#include "TilemapRenderer.hpp"
+#include "WorldStreamer.hpp"
 
 #include <vulkan/vulkan.h>
 
+#include <array>
+#include <functional>
+#include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
@@ -14,6 +34,9 @@ namespace engine::render {
 #pragma region Constants
 const std::vector<const char *> validationLayers = {"VK_LAYER_KHRONOS_validation"};   // 验证层扩展
 const std::vector<const char *> deviceExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME}; // 设备扩展
+const std::vector<const char *> optionalDeviceExtensions = {
+    VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME,
+    VK_EXT_MEMORY_BUDGET_EXTENSION_NAME}; // 可选设备扩展，支持时才启用
 
 #ifdef NDEBUG
 const bool ENABLE_VALIDATION_LAYER = false;
@@ -43,16 +66,6 @@ struct QueueFamilyIndices {
     }
 };
 
-/**
- * @struct SwapChainSupportDetails
- * @brief 存储交换链支持信息的容器
- */
-struct SwapChainSupportDetails {
-    VkSurfaceCapabilitiesKHR capabilities;
-    std::vector<VkSurfaceFormatKHR> formats;
-    std::vector<VkPresentModeKHR> presentModes;
-};
-
 class VulkanRenderer final {
 public:
     VulkanRenderer(SDL_Window *window);
@@ -64,53 +77,145 @@ public:
     VulkanRenderer &operator=(VulkanRenderer &&)      = delete;
 
     void initVulkan(); // 初始化Vulkan
-    void render();     // 更新渲染
+    bool render();     // 更新渲染，返回 false 表示有未最小化的窗口没有呈现本帧画面（交换链过期被重建等），需要再渲染一次
     void cleanup();    // 清理Vulkan
 
-    void setFramebufferResized(bool resized) { m_framebufferResized = resized; }
+    bool hasPendingWork() const; // 粒子仍然存活、需要的世界区块尚未全部常驻或碎片整理尚未完成，按需渲染模式下需要继续出帧
+
+    void setFramebufferResized(bool resized);                        // 标记所有窗口需要重建交换链
+    void setFramebufferResized(SDL_WindowID windowID, bool resized); // 标记指定窗口需要重建交换链
+    void setMinimized(SDL_WindowID windowID, bool minimized);        // 标记窗口最小化，最小化的窗口不获取图像也不呈现
+    bool areAllWindowsMinimized() const;                             // 没有需要呈现的窗口
+    void addDamageRect(const VkRect2D &rect);                        // 添加主窗口本帧变化的区域，没有添加任何区域时视为整帧变化
+    void addDamageRect(SDL_WindowID windowID, const VkRect2D &rect); // 添加指定窗口本帧变化的区域
+    bool isIncrementalPresentSupported() const { return m_incrementalPresentSupported; }
+    bool isMeshShaderSupported() const { return m_meshShaderSupported; }     // 是否启用了 VK_EXT_mesh_shader 的任务和网格着色器
+    bool isMemoryBudgetSupported() const { return m_memoryBudgetSupported; } // 是否通过 VK_EXT_memory_budget 读取显存预算
+
+    void setJobSystem(engine::core::JobSystem *jobSystem) { m_jobSystem = jobSystem; } // 每帧 CPU 剔除使用的工作线程，为空时在渲染线程执行
+
+    void addWindow(SDL_Window *window);    // 为窗口创建表面和交换链，与主窗口共享同一个逻辑设备
+    void removeWindow(SDL_Window *window); // 销毁窗口的表面和交换链
+    size_t getWindowCount() const { return m_surfaces.size(); }
+
+    std::pmr::memory_resource *getFrameAllocator() { return &m_frameArenas[m_currentFrame]; } // 当前帧的临时容器分配器，只能在渲染线程使用，该帧 Fence 信号后回收
+    void setHeapAllocationCheck(bool enabled);                                                 // 每帧检查 drawFrame() 是否分配了堆内存，需要调试构建
+    uint64_t getFrameHeapAllocations() const { return m_frameHeapAllocations; }               // 上一帧 drawFrame() 中全局 operator new 的调用次数
+
+#pragma region Device Accessors
+    VkInstance getInstance() const { return m_instance; }
+    VkPhysicalDevice getPhysicalDevice() const { return m_physicalDevice; }
+    VkDevice getDevice() const { return m_device; }
+    const QueueFamilyIndices &getQueueFamilyIndices() const { return m_queueFamilyIndices; }
+    VkPipelineCache getPipelineCache() const { return m_pipelineCache; }
+    const VkPhysicalDeviceFeatures &getEnabledFeatures() const { return m_enabledFeatures; }
+    VkRenderPass getSceneRenderPass() const { return m_renderPass; }
+    VkRenderPass getSceneLoadRenderPass() const { return m_renderPassLoad; } // 与场景渲染通道兼容，保留已有颜色和深度
+    VkFormat getDepthFormat() const { return m_depthFormat; }
+    PostProcessChain &getPostProcessChain() { return *m_postProcessChain; }
+    SamplerCache &getSamplerCache() { return *m_samplerCache; }
+    ImageViewCache &getImageViewCache() { return *m_imageViewCache; }
+    ResourceRegistry &getResourceRegistry() { return *m_resourceRegistry; } // 以代数句柄引用的缓冲区、图像、管线和采样器
+    MemoryTypePolicy &getMemoryTypePolicy() { return *m_memoryTypePolicy; } // 按用途选择内存类型，可以覆盖用于实验
+    MemoryBudget &getMemoryBudget() { return *m_memoryBudget; }             // 每个堆和每个分类的显存用量
+    StreamingBuffer &getStreamingBuffer() { return *m_streamingBuffer; }    // 每帧动态顶点/索引数据
+    WorldStreamer &getWorldStreamer() { return *m_worldStreamer; }
+    MeshRenderer &getMeshRenderer() { return *m_meshRenderer; }
+    OcclusionCuller &getOcclusionCuller() { return *m_occlusionCuller; }
+    MeshletRenderer &getMeshletRenderer() { return *m_meshletRenderer; }
+    ParticleSystem &getParticleSystem() { return *m_particleSystem; }
+    TilemapRenderer &getTilemapRenderer() { return *m_tilemapRenderer; }
+    DebugDraw &getDebugDraw() { return *m_debugDraw; }          // 立即模式调试图形，可以在 update() 期间从任意线程调用
+    TextRenderer &getTextRenderer() { return *m_textRenderer; } // 屏幕文字，只能在主线程调用
+    uint64_t getFrameNumber() const { return m_frameNumber; }
+#pragma endregion
+
+#pragma region Resource Helpers
+    static std::vector<char> readFile(const std::string &filename);
+    VkShaderModule createShaderModule(const std::vector<char> &code);
+    void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, MemoryUsage memoryUsage, VkBuffer &buffer, VkDeviceMemory &bufferMemory);
+    void createImage(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage, MemoryUsage memoryUsage, VkImage &image, VkDeviceMemory &imageMemory, uint32_t mipLevels = 1);
+    VkResult allocateMemory(VkDeviceSize size, uint32_t memoryTypeIndex, MemoryCategory category, VkDeviceMemory &memory);                           // 登记到显存预算，超出预算或分配失败时先淘汰
+    VkResult allocateMemory(const VkMemoryRequirements &requirements, MemoryUsage memoryUsage, MemoryCategory category, VkDeviceMemory &memory);     // 按用途选择内存类型，所在堆耗尽时依次尝试下一个候选类型
+    void freeMemory(VkDeviceMemory memory);                                                                                                          // 释放 allocateMemory() 分配的内存，可以传入 VK_NULL_HANDLE
+    VkImageView createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t baseMipLevel = 0, uint32_t levelCount = 1); // 通过图像视图缓存获取，相同参数返回同一视图
+    void releaseImageView(VkImageView imageView);                                                                                                    // 释放 createImageView() 返回的视图
+    void deferDestroy(std::function<void()> deleter);                                                                                                // 等已提交和正在记录的帧在 GPU 上完成后再执行
+    VkCommandBuffer beginSingleTimeCommands();                                                                                                       // 分配并开始记录一次性命令缓冲
+    void endSingleTimeCommands(VkCommandBuffer commandBuffer);                                                                                       // 提交并等待一次性命令缓冲执行完成
+    static void recordImageBarrier(VkCommandBuffer commandBuffer, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
+                                   VkPipelineStageFlags srcStage, VkAccessFlags srcAccess, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess,
+                                   VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT);
+#pragma endregion
 
 private:
 #pragma region Menber Variables
     bool m_initialized = false; // 是否初始化
-    SDL_Window *m_window;       // SDL windows 窗口句柄
+    SDL_Window *m_window;       // SDL windows 主窗口句柄
 
     VkInstance m_instance;                     // Vulkan 实例句柄
     VkDebugUtilsMessengerEXT m_debugMessenger; // Debug 消息句柄
-    VkSurfaceKHR m_surface;                    // Vulkan 窗口句柄
+
+    std::vector<std::unique_ptr<RenderSurface>> m_surfaces; // 每个窗口的表面和交换链，第一个为主窗口
 
     VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE; // 物理设备句柄
     VkDevice m_device;                                  // 逻辑设备句柄
+    QueueFamilyIndices m_queueFamilyIndices;            // 逻辑设备使用的队列族索引
 
     VkQueue m_graphicsQueue; // 图形队列句柄
     VkQueue m_presentQueue;  // 显示队列句柄
 
-    VkSwapchainKHR m_swapChain;                         // 交换链句柄
-    std::vector<VkImage> m_swapChainImages;             // 交换链图像句柄
-    VkFormat m_swapChainImageFormat;                    // 交换链图像格式
-    VkExtent2D m_swapChainExtent;                       // 交换链图像尺寸
-    std::vector<VkImageView> m_swapChainImageViews;     // 交换链图像视图句柄
-    std::vector<VkFramebuffer> m_swapChainFramebuffers; // 交换链帧缓冲区句柄
+    VkRenderPass m_renderPass;         // 场景渲染通道句柄，渲染到离屏 HDR 目标，所有窗口共享
+    VkRenderPass m_renderPassLoad;     // 场景渲染通道的保留版本，遮挡剔除第二阶段在第一阶段的结果上继续绘制
+    VkFormat m_depthFormat;            // 深度附件格式
+    VkPipelineCache m_pipelineCache;   // 管线缓存，所有窗口共享
+    PipelineHandle m_graphicsPipeline; // 渲染管道和管道布局
 
-    VkRenderPass m_renderPass;         // 渲染通道句柄
-    VkPipelineLayout m_pipelineLayout; // 管道布局
-    VkPipeline m_graphicsPipeline;     // 渲染管道
+    std::unique_ptr<PostProcessChain> m_postProcessChain; // 计算着色器后处理链，所有窗口共享
+    std::unique_ptr<SamplerCache> m_samplerCache;         // 采样器去重缓存
+    std::unique_ptr<ImageViewCache> m_imageViewCache;     // 图像视图去重缓存
+    std::unique_ptr<ResourceRegistry> m_resourceRegistry; // 缓冲区、图像、管线和采样器的注册表
+    std::unique_ptr<MemoryTypePolicy> m_memoryTypePolicy; // 按用途选择内存类型
+    std::unique_ptr<MemoryBudget> m_memoryBudget;         // 显存用量跟踪和超出预算时的淘汰
 
     VkCommandPool m_commandPool; // 命令池
 
-    VkBuffer m_vertexBuffer;             // 顶点缓冲区
-    VkDeviceMemory m_vertexBufferMemory; // 顶点缓冲区内存
+    BufferHandle m_vertexBuffer; // 顶点缓冲区
+
+    std::unique_ptr<StreamingBuffer> m_streamingBuffer; // 持久映射的环形缓冲区，用于每帧变化的几何数据
+    std::unique_ptr<WorldStreamer> m_worldStreamer;     // 按区块流式加载的世界几何
+    std::unique_ptr<MeshRenderer> m_meshRenderer;       // 网格物体的间接绘制
+    std::unique_ptr<OcclusionCuller> m_occlusionCuller; // 基于 Hi-Z 的两阶段遮挡剔除
+    std::unique_ptr<MeshletRenderer> m_meshletRenderer; // 以簇为单位剔除和绘制的几何
+    std::unique_ptr<ParticleSystem> m_particleSystem;   // 计算着色器模拟的粒子
+    std::unique_ptr<TilemapRenderer> m_tilemapRenderer; // 按区块缓存的二维图块地图
+    std::unique_ptr<DebugDraw> m_debugDraw;             // 立即模式调试图形
+    std::unique_ptr<TextRenderer> m_textRenderer;       // 字形图集和排版缓存的屏幕文字
+
+    std::array<VkCommandBuffer, MAX_FRAMES_IN_FLIGHT> m_commandBuffers{}; // 命令缓冲区，每帧一个，记录所有窗口
 
-    std::vector<VkCommandBuffer> m_commandBuffers; // 命令缓冲区
+    std::array<VkSemaphore, MAX_FRAMES_IN_FLIGHT> m_renderFinishedSemaphores{}; // 渲染完成信号量，所有窗口的呈现共同等待
+    std::array<VkFence, MAX_FRAMES_IN_FLIGHT> m_inFlightFences{};               // 在飞行中的帧缓冲区
 
-    std::vector<VkSemaphore> m_imageAvailableSemaphores; // 图像可用信号量
-    std::vector<VkSemaphore> m_renderFinishedSemaphores; // 渲染完成信号量
-    std::vector<VkFence> m_inFlightFences;               // 在飞行中的帧缓冲区
+    uint32_t m_currentFrame = 0;     // 当前帧
+    uint64_t m_frameNumber  = 0;     // 已提交的帧数，即正在记录的帧的序号
+    DeletionQueue m_deletionQueue;   // 延迟销毁队列
+    bool m_recording        = false; // 是否正在记录命令缓冲，此时本帧延迟销毁的资源可能仍被引用
 
-    uint32_t m_currentFrame   = 0;     // 当前帧
-    bool m_framebufferResized = false; // 是否调整了窗口大小
+    std::array<engine::utils::FrameArena, MAX_FRAMES_IN_FLIGHT> m_frameArenas; // 每帧一个线性分配器，存放只在该帧使用的临时容器
+    uint64_t m_frameHeapAllocations = 0;                                      // 上一帧 drawFrame() 中的堆分配次数
+    bool m_heapAllocationCheck      = false;                                  // 稳态下出现堆分配时输出警告
+
+    engine::core::JobSystem *m_jobSystem = nullptr; // 由 GameApp 持有
+
+    std::vector<const char *> m_enabledDeviceExtensions; // 实际启用的设备扩展
+    VkPhysicalDeviceFeatures m_enabledFeatures{};        // 实际启用的设备特性
+    bool m_incrementalPresentSupported = false;          // 是否支持 VK_KHR_incremental_present
+    bool m_meshShaderSupported         = false;          // 是否启用 VK_EXT_mesh_shader
+    bool m_memoryBudgetSupported       = false;          // 是否启用 VK_EXT_memory_budget
 #pragma endregion
 
-#pragma region Instance and Validation Layers and Surface
+#pragma region Instance and Validation Layers
     void createInstance();
     static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(
         VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
@@ -130,54 +235,50 @@ private:
     void setupDebugMessenger();
     std::vector<const char *> getRequiredExtensions();
     bool checkValidationLayerSupport();
-    void createSurface();
 #pragma endregion
 
 #pragma region Devices and Queues
     void pickPhysicalDevice();
-    QueueFamilyIndices findQueueFamilies(const VkPhysicalDevice &device);
-    bool isDeviceSuitable(const VkPhysicalDevice &device);
+    QueueFamilyIndices findQueueFamilies(const VkPhysicalDevice &device, VkSurfaceKHR surface);
+    bool isDeviceSuitable(const VkPhysicalDevice &device, VkSurfaceKHR surface);
     bool checkDeviceExtensionSupport(const VkPhysicalDevice &device);
-    SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device);
+    bool isDeviceExtensionAvailable(const VkPhysicalDevice &device, const char *extensionName);
     void printPhysicalDeviceProperties(VkPhysicalDevice &device);
     void createLogicalDevice();
+    void createResourceCaches();
 #pragma endregion
 
-#pragma region Swap Chain and Image Views
-    VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR> &availableFormats);
-    VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR> &availablePresentModes);
-    VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR &capabilities);
-    void createSwapChain();
-    void createImageViews();
+#pragma region Surfaces
+    RenderSurface *findSurface(SDL_WindowID windowID);
 #pragma endregion
 
 #pragma region Shader Modules and Pipelines
-    static std::vector<char> readFile(const std::string &filename);
-    VkShaderModule createShaderModule(const std::vector<char> &code);
+    void createPipelineCache();
+    void createPostProcessChain();
     void createGraphicsPipeline();
+    void createMeshRenderer();
 #pragma endregion
 
-#pragma region Render Pass and Framebuffers
+#pragma region Render Pass
+    VkFormat findDepthFormat();
     void createRenderPass();
-    void createFramebuffers();
 #pragma endregion
 
 #pragma region Command Buffers and Synchronization
     void createCommandPool();
     void createCommandBuffers();
-    void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+    void recordCommandBuffer(VkCommandBuffer commandBuffer, const std::pmr::vector<RenderSurface *> &surfaces);
+    void recordSurface(VkCommandBuffer commandBuffer, RenderSurface &surface);
     void createSyncObjects();
 #pragma endregion
 
-#pragma region Render and Recreate Swap Chain
-    void drawFrame();
-    void cleanupSwapChain();
-    void recreateSwapChain();
+#pragma region Render
+    bool drawFrame();
 #pragma endregion
 
 #pragma region Buffer and Image
     void createVertexBuffer();
-    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+    void createStreamingBuffer();
 #pragma endregion
 };
 } // namespace engine::render
\ No newline at end of file
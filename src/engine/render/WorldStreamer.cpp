@@ -0,0 +1,289 @@
+#include "WorldStreamer.hpp"
+#include "VulkanRenderer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace engine::render {
+
+WorldStreamer::WorldStreamer(VulkanRenderer &renderer) : m_renderer(renderer) {}
+
+WorldStreamer::~WorldStreamer() = default;
+
+void WorldStreamer::start(engine::core::JobSystem &jobSystem, ChunkLoader loader, float chunkSize, float loadRadius) {
+    if (isStarted()) {
+        throw std::runtime_error("WorldStreamer::start()::世界流式加载已经开始");
+    }
+    if (chunkSize <= 0.0f) {
+        throw std::runtime_error("WorldStreamer::start()::区块边长必须大于 0");
+    }
+    m_jobSystem       = &jobSystem;
+    m_loader          = std::move(loader);
+    m_chunkSize       = chunkSize;
+    m_loadRadius      = loadRadius;
+    m_pool            = std::make_unique<GeometryPool>(m_renderer, WORLD_CHUNK_SLOT_SIZE, WORLD_CHUNK_SLOT_COUNT);
+    m_stats.poolSlots = WORLD_CHUNK_SLOT_COUNT;
+    m_evictionHandler = m_renderer.getMemoryBudget().addEvictionHandler([this](uint32_t heapIndex, VkDeviceSize bytes) { return shrinkPool(heapIndex, bytes); });
+    spdlog::info("WorldStreamer::start()::开始世界流式加载, 区块边长: {}, 加载半径: {}", m_chunkSize, m_loadRadius);
+}
+
+void WorldStreamer::cleanup() {
+    if (!isStarted()) return;
+    m_jobSystem->wait(m_jobCounter); // 后台任务持有 this，必须先等它们结束
+    m_renderer.getMemoryBudget().removeEvictionHandler(m_evictionHandler);
+    if (m_pool) {
+        m_pool->cleanup();
+        m_pool.reset();
+    }
+    m_pendingSlotCount = 0;
+    m_resident.clear();
+    m_lru.clear();
+    m_desired.clear();
+    m_visible.clear();
+    m_loading.clear();
+    m_failed.clear();
+    m_ready.clear();
+    m_completed.clear();
+    spdlog::info("WorldStreamer::cleanup()::世界流式加载已停止, 累计未命中: {}, 累计淘汰: {}", m_stats.totalMisses, m_stats.totalEvictions);
+}
+
+ChunkCoord WorldStreamer::toChunkCoord(const glm::vec2 &position) const {
+    return {static_cast<int32_t>(std::floor(position.x / m_chunkSize)), static_cast<int32_t>(std::floor(position.y / m_chunkSize))};
+}
+
+float WorldStreamer::distanceToChunk(const ChunkCoord &coord) const {
+    glm::vec2 center = (glm::vec2(static_cast<float>(coord.x), static_cast<float>(coord.y)) + 0.5f) * m_chunkSize;
+    return glm::length(center - m_viewCenter);
+}
+
+void WorldStreamer::update(const glm::vec2 &viewCenter) {
+    if (!isStarted()) return;
+    if (!m_pool && m_releasingPools == 0) createPendingPool();
+    uint32_t slotCount           = m_pool ? m_pool->getSlotCount() : m_pendingSlotCount;
+    m_viewCenter                 = viewCenter;
+    m_stats.missesThisFrame      = 0;
+    m_stats.uploadBytesThisFrame = 0;
+
+    // 计算加载半径内需要的区块，按距离由近到远排序，近处的区块优先加载
+    std::vector<std::pair<float, ChunkCoord>> desired;
+    ChunkCoord center = toChunkCoord(viewCenter);
+    int32_t range     = static_cast<int32_t>(std::ceil(m_loadRadius / m_chunkSize));
+    for (int32_t y = center.y - range; y <= center.y + range; y++) {
+        for (int32_t x = center.x - range; x <= center.x + range; x++) {
+            ChunkCoord coord{x, y};
+            float distance = distanceToChunk(coord);
+            if (distance <= m_loadRadius + m_chunkSize * 0.5f) desired.emplace_back(distance, coord);
+        }
+    }
+    std::sort(desired.begin(), desired.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+    // 只保留几何池放得下的最近区块：其余区块淘汰不了本帧需要的区块，永远无法常驻
+    if (desired.size() > slotCount) desired.resize(slotCount);
+
+    m_desired.clear();
+    m_visible.clear();
+    for (const auto &[distance, coord] : desired) {
+        m_desired.insert(coord);
+    }
+    std::erase_if(m_failed, [this](const ChunkCoord &coord) { return !m_desired.contains(coord); }); // 离开加载半径后再次需要时重新加载
+    for (const auto &[distance, coord] : desired) {
+        if (auto it = m_resident.find(coord); it != m_resident.end()) {
+            m_lru.splice(m_lru.begin(), m_lru, it->second.lruIt); // 命中，移到 LRU 头部
+            m_visible.push_back(coord);
+            continue;
+        }
+        if (m_loading.contains(coord) || m_failed.contains(coord)) continue;
+        if (m_jobCounter.pending.load(std::memory_order_relaxed) >= MAX_CONCURRENT_CHUNK_LOADS) continue; // 下一帧再按新的距离顺序提交
+        m_stats.missesThisFrame++;
+        m_stats.totalMisses++;
+        m_loading.insert(coord);
+        m_jobSystem->submit(
+            [this, coord]() {
+                // 异常必须在这里处理：任务系统会吞掉异常，区块将永远留在 m_loading 中
+                LoadedChunk chunk{coord, {}};
+                try {
+                    chunk.geometry = m_loader(coord);
+                } catch (const std::exception &e) {
+                    spdlog::error("WorldStreamer::update()::区块 ({}, {}) 加载失败: {}", coord.x, coord.y, e.what());
+                    chunk.failed = true;
+                }
+                std::lock_guard lock(m_completedMutex);
+                m_completed.push_back(std::move(chunk));
+            },
+            &m_jobCounter, engine::core::JobPriority::Background); // 加载可能很慢，不能占满工作线程拖慢帧内的 parallelFor
+    }
+
+    // 收集后台加载结果，已经不需要的区块直接丢弃
+    {
+        std::lock_guard lock(m_completedMutex);
+        for (LoadedChunk &chunk : m_completed) {
+            m_ready.push_back(std::move(chunk));
+        }
+        m_completed.clear();
+    }
+    std::erase_if(m_ready, [this](const LoadedChunk &chunk) {
+        if (m_desired.contains(chunk.coord) && !chunk.failed) return false;
+        m_loading.erase(chunk.coord);
+        if (chunk.failed && m_desired.contains(chunk.coord)) m_failed.insert(chunk.coord);
+        return true;
+    });
+    std::sort(m_ready.begin(), m_ready.end(), [this](const LoadedChunk &a, const LoadedChunk &b) {
+        return distanceToChunk(a.coord) < distanceToChunk(b.coord);
+    });
+    m_stats.pendingLoads = static_cast<uint32_t>(m_loading.size());
+}
+
+bool WorldStreamer::evictLeastRecentlyUsed() {
+    for (auto it = m_lru.rbegin(); it != m_lru.rend(); ++it) {
+        if (m_desired.contains(*it)) continue; // 本帧仍需要的区块不能淘汰
+        ChunkCoord coord       = *it;
+        ResidentChunk resident = m_resident.at(coord);
+        m_lru.erase(resident.lruIt);
+        m_resident.erase(coord);
+        m_stats.residentChunks = static_cast<uint32_t>(m_resident.size());
+        m_stats.residentBytes -= resident.bytes;
+        m_stats.totalEvictions++;
+        // 之前的帧可能仍在 GPU 上读取这个槽，等这些帧完成后再回收
+        m_pendingFreeSlots++;
+        m_renderer.deferDestroy([this, slot = resident.slot, generation = m_poolGeneration]() {
+            if (generation != m_poolGeneration) return; // 几何池已经缩小，旧的槽随旧几何池一起释放
+            m_pool->freeSlot(slot);
+            m_pendingFreeSlots--;
+        });
+        return true;
+    }
+    return false;
+}
+
+VkDeviceSize WorldStreamer::shrinkPool(uint32_t heapIndex, VkDeviceSize bytes) {
+    if (!m_pool || m_pool->getSlotCount() <= WORLD_CHUNK_MIN_SLOT_COUNT) return 0;
+    if (m_renderer.getMemoryBudget().getHeapIndexOf(m_pool->getMemory()) != heapIndex) return 0;
+
+    // 槽数量减半，直到释放足够的字节或到达下限
+    uint32_t slotCount = m_pool->getSlotCount();
+    while (slotCount > WORLD_CHUNK_MIN_SLOT_COUNT && (m_pool->getSlotCount() - slotCount) * m_pool->getSlotSize() < bytes) {
+        slotCount = std::max(slotCount / 2, WORLD_CHUNK_MIN_SLOT_COUNT);
+    }
+    VkDeviceSize released = (m_pool->getSlotCount() - slotCount) * m_pool->getSlotSize();
+
+    // 常驻区块随旧的几何池一起释放，仍需要的区块之后作为未命中按距离重新加载
+    m_stats.totalEvictions += m_resident.size();
+    m_stats.residentChunks = 0;
+    m_stats.residentBytes  = 0;
+    m_pendingFreeSlots     = 0;
+    m_resident.clear();
+    m_lru.clear();
+    m_visible.clear();
+    m_poolGeneration++;
+
+    // 之前的帧可能仍在读取旧的几何池，延迟销毁。新的几何池不在这里分配：旧几何池释放之前会增加显存占用，
+    // 而且这里可能处在分配失败后的淘汰重试路径上，分配失败的异常会从 evict() 中抛出
+    auto oldPool = std::shared_ptr<GeometryPool>(std::move(m_pool));
+    m_releasingPools++;
+    m_renderer.deferDestroy([this, oldPool]() {
+        oldPool->cleanup();
+        m_releasingPools--;
+    });
+    m_pendingSlotCount = slotCount;
+    m_stats.poolSlots  = 0;
+    spdlog::warn("WorldStreamer::shrinkPool()::显存超出预算, 释放几何池 {} 字节, 旧几何池销毁后缩小到 {} 个槽", released, slotCount);
+    return released;
+}
+
+void WorldStreamer::createPendingPool() {
+    try {
+        m_pool = std::make_unique<GeometryPool>(m_renderer, WORLD_CHUNK_SLOT_SIZE, m_pendingSlotCount);
+    } catch (const std::exception &e) {
+        spdlog::error("WorldStreamer::createPendingPool()::创建 {} 个槽的几何池失败, 下一帧重试: {}", m_pendingSlotCount, e.what());
+        return;
+    }
+    m_stats.poolSlots  = m_pendingSlotCount;
+    m_pendingSlotCount = 0;
+}
+
+void WorldStreamer::recordUploads(VkCommandBuffer commandBuffer) {
+    if (!m_pool || m_ready.empty()) return;
+
+    // 空闲槽不够时提前淘汰，淘汰的槽要等 GPU 用完才可用，本帧放不下的区块留到之后的帧上传
+    while (m_pool->getFreeSlotCount() + m_pendingFreeSlots < m_ready.size() && evictLeastRecentlyUsed()) {
+    }
+
+    size_t uploaded = 0;
+    for (LoadedChunk &chunk : m_ready) {
+        VkDeviceSize bytes = chunk.geometry.vertices.size() * sizeof(engine::utils::Vertex) + chunk.geometry.indices.size() * sizeof(uint32_t);
+        if (m_stats.uploadBytesThisFrame + bytes > WORLD_UPLOAD_BUDGET_PER_FRAME && m_stats.uploadBytesThisFrame > 0) break; // 超出本帧上传预算
+        std::optional<uint32_t> slot = m_pool->allocateSlot();
+        if (!slot || !uploadChunk(commandBuffer, chunk, *slot)) break;
+        uploaded++;
+    }
+    if (uploaded == 0) return;
+    m_ready.erase(m_ready.begin(), m_ready.begin() + static_cast<std::ptrdiff_t>(uploaded));
+    m_stats.pendingLoads = static_cast<uint32_t>(m_loading.size());
+
+    // 复制完成后才能作为顶点和索引缓冲读取
+    VkBufferMemoryBarrier barrier{};
+    barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask       = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer              = m_pool->getBuffer();
+    barrier.offset              = 0;
+    barrier.size                = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+}
+
+bool WorldStreamer::uploadChunk(VkCommandBuffer commandBuffer, LoadedChunk &chunk, uint32_t slot) {
+    const ChunkGeometry &geometry = chunk.geometry;
+    VkDeviceSize vertexBytes      = geometry.vertices.size() * sizeof(engine::utils::Vertex);
+    VkDeviceSize indexOffset      = (vertexBytes + 3) & ~VkDeviceSize(3); // 索引缓冲偏移必须按索引大小对齐
+    VkDeviceSize indexBytes       = geometry.indices.size() * sizeof(uint32_t);
+    VkDeviceSize totalBytes       = indexOffset + indexBytes;
+    if (totalBytes > m_pool->getSlotSize() || indexBytes == 0) {
+        spdlog::warn("WorldStreamer::uploadChunk()::区块 ({}, {}) 几何数据为空或超过槽大小: {} 字节", chunk.coord.x, chunk.coord.y, totalBytes);
+        m_pool->freeSlot(slot);
+        m_loading.erase(chunk.coord);
+        if (m_desired.contains(chunk.coord)) m_failed.insert(chunk.coord); // 重新加载得到的还是同样的几何数据
+        return true;                                                       // 丢弃该区块
+    }
+
+    StreamingAllocation staging = m_renderer.getStreamingBuffer().reserve(totalBytes, 4);
+    if (!staging) {
+        m_pool->freeSlot(slot);
+        return false; // 暂存空间不足，留到下一帧上传
+    }
+    m_loading.erase(chunk.coord);
+    memcpy(staging.data, geometry.vertices.data(), static_cast<size_t>(vertexBytes));
+    memcpy(static_cast<char *>(staging.data) + indexOffset, geometry.indices.data(), static_cast<size_t>(indexBytes));
+
+    VkBufferCopy copyRegion{};
+    copyRegion.srcOffset = staging.offset;
+    copyRegion.dstOffset = m_pool->getSlotOffset(slot);
+    copyRegion.size      = totalBytes;
+    vkCmdCopyBuffer(commandBuffer, staging.buffer, m_pool->getBuffer(), 1, &copyRegion);
+
+    m_lru.push_front(chunk.coord);
+    m_resident[chunk.coord] = {slot, indexOffset, static_cast<uint32_t>(geometry.indices.size()), totalBytes, m_lru.begin()};
+    m_stats.residentChunks  = static_cast<uint32_t>(m_resident.size());
+    m_stats.residentBytes += totalBytes;
+    m_stats.uploadBytesThisFrame += totalBytes;
+    if (m_desired.contains(chunk.coord)) m_visible.push_back(chunk.coord);
+    return true;
+}
+
+void WorldStreamer::recordDraws(VkCommandBuffer commandBuffer) {
+    if (!m_pool) return;
+    VkBuffer buffer = m_pool->getBuffer();
+    for (const ChunkCoord &coord : m_visible) {
+        const ResidentChunk &resident = m_resident.at(coord);
+        VkDeviceSize slotOffset       = m_pool->getSlotOffset(resident.slot);
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &buffer, &slotOffset);
+        vkCmdBindIndexBuffer(commandBuffer, buffer, slotOffset + resident.indexOffset, VK_INDEX_TYPE_UINT32);
+        vkCmdDrawIndexed(commandBuffer, resident.indexCount, 1, 0, 0, 0);
+    }
+}
+
+} // namespace engine::render
@@ -0,0 +1,160 @@
+#pragma once
+#include "../core/JobSystem.hpp"
+#include "../utils/Math.hpp"
+#include "GeometryPool.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace engine::render {
+class VulkanRenderer;
+
+#pragma region Constants
+const VkDeviceSize WORLD_CHUNK_SLOT_SIZE         = 256 * 1024;      // 几何池中每个区块槽的字节数（顶点 + 索引）
+const uint32_t WORLD_CHUNK_SLOT_COUNT            = 256;             // 几何池槽数量，即最多常驻的区块数
+const uint32_t WORLD_CHUNK_MIN_SLOT_COUNT        = 32;              // 显存不足时几何池最少缩小到的槽数量
+const VkDeviceSize WORLD_UPLOAD_BUDGET_PER_FRAME = 2 * 1024 * 1024; // 每帧最多上传的字节数，避免加载高峰造成卡顿
+const uint32_t MAX_CONCURRENT_CHUNK_LOADS        = 8;               // 同时在后台加载的区块数量上限
+#pragma endregion
+
+/**
+ * @struct ChunkCoord
+ * @brief 区块在世界网格中的坐标
+ */
+struct ChunkCoord {
+    int32_t x = 0;
+    int32_t y = 0;
+
+    bool operator==(const ChunkCoord &) const = default;
+};
+
+struct ChunkCoordHash {
+    size_t operator()(const ChunkCoord &coord) const {
+        return std::hash<uint64_t>{}((static_cast<uint64_t>(static_cast<uint32_t>(coord.x)) << 32) | static_cast<uint32_t>(coord.y));
+    }
+};
+
+/**
+ * @struct ChunkGeometry
+ * @brief 加载器在后台线程生成的区块几何数据
+ */
+struct ChunkGeometry {
+    std::vector<engine::utils::Vertex> vertices;
+    std::vector<uint32_t> indices;
+};
+
+/**
+ * @struct WorldStreamingStats
+ * @brief 世界流式加载的统计信息，帧相关的字段在每次 update() 时清零
+ */
+struct WorldStreamingStats {
+    uint32_t poolSlots                = 0; // 几何池当前的槽数量，显存不足时减半，等待旧几何池销毁期间为 0
+    uint32_t residentChunks           = 0; // 常驻显存的区块数量
+    VkDeviceSize residentBytes        = 0; // 常驻区块实际使用的字节数
+    uint32_t pendingLoads             = 0; // 正在后台加载或等待上传的区块数量
+    uint64_t totalMisses              = 0; // 累计未命中次数（需要的区块不在显存中，为它提交了加载任务）
+    uint64_t totalEvictions           = 0; // 累计淘汰次数
+    uint32_t missesThisFrame          = 0; // 本帧未命中次数
+    VkDeviceSize uploadBytesThisFrame = 0; // 本帧上传的字节数
+};
+
+/**
+ * @class WorldStreamer
+ * @brief 按区块流式加载世界几何
+ *
+ * update() 根据观察点计算需要的区块并按距离由近到远提交后台加载任务；加载完成的几何在记录命令缓冲时
+ * 经由流式缓冲区复制到固定大小的几何池中。几何池作为 LRU 缓存，空间不足时淘汰最久未使用且不再需要的区块，
+ * 被淘汰区块的槽通过延迟销毁队列在 GPU 用完之后才回收。
+ * 显存超出预算时几何池作为可降级的资源：常驻区块随旧的几何池一起释放，旧几何池销毁之后才按减半的槽数量创建新的几何池，
+ * 仍需要的区块按距离重新加载。
+ */
+class WorldStreamer final {
+public:
+    using ChunkLoader = std::function<ChunkGeometry(ChunkCoord)>; // 在工作线程中调用，必须线程安全
+
+    explicit WorldStreamer(VulkanRenderer &renderer);
+    ~WorldStreamer();
+
+    WorldStreamer(const WorldStreamer &)            = delete;
+    WorldStreamer &operator=(const WorldStreamer &) = delete;
+    WorldStreamer(WorldStreamer &&)                 = delete;
+    WorldStreamer &operator=(WorldStreamer &&)      = delete;
+
+    /**
+     * @brief 开始流式加载，创建几何池
+     * @param chunkSize 区块边长（世界单位）
+     * @param loadRadius 以观察点为中心需要常驻的半径（世界单位）
+     */
+    void start(engine::core::JobSystem &jobSystem, ChunkLoader loader, float chunkSize, float loadRadius);
+    void cleanup(); // 等待后台任务结束并销毁几何池，必须在逻辑设备销毁之前调用
+    bool isStarted() const { return m_pool != nullptr || m_pendingSlotCount > 0; }
+
+    void update(const glm::vec2 &viewCenter); // 每帧调用：更新需要的区块、提交加载任务、收集加载结果
+
+    void recordUploads(VkCommandBuffer commandBuffer); // 在渲染通道之外调用：把加载完成的区块复制到几何池
+    void recordDraws(VkCommandBuffer commandBuffer);   // 在渲染通道之内调用：绘制常驻且需要的区块
+
+    bool hasPendingWork() const { return m_visible.size() + m_failed.size() < m_desired.size(); } // 需要的区块尚未全部常驻，之后的帧还会提交加载或上传（需要的区块数不超过槽数量）
+    const WorldStreamingStats &getStats() const { return m_stats; }
+
+private:
+    struct ResidentChunk {
+        uint32_t slot;
+        VkDeviceSize indexOffset; // 索引数据在槽内的偏移
+        uint32_t indexCount;
+        VkDeviceSize bytes;
+        std::list<ChunkCoord>::iterator lruIt;
+    };
+    struct LoadedChunk {
+        ChunkCoord coord;
+        ChunkGeometry geometry;
+        bool failed = false; // 加载器抛出异常，没有几何数据
+    };
+
+    ChunkCoord toChunkCoord(const glm::vec2 &position) const;
+    float distanceToChunk(const ChunkCoord &coord) const;
+    bool evictLeastRecentlyUsed();                                                      // 淘汰一个不再需要的最久未使用区块，没有可淘汰的返回 false
+    VkDeviceSize shrinkPool(uint32_t heapIndex, VkDeviceSize bytes);                    // 显存预算的淘汰处理函数，只释放不分配，返回将要释放的字节数
+    void createPendingPool();                                                           // 旧几何池销毁之后创建缩小后的几何池，失败时下一帧重试
+    bool uploadChunk(VkCommandBuffer commandBuffer, LoadedChunk &chunk, uint32_t slot); // 返回 false 表示暂存空间不足，区块留待下一帧
+
+#pragma region Menber Variables
+    VulkanRenderer &m_renderer;
+    engine::core::JobSystem *m_jobSystem = nullptr;
+    ChunkLoader m_loader;
+    float m_chunkSize  = 1.0f;
+    float m_loadRadius = 0.0f;
+    glm::vec2 m_viewCenter{0.0f};
+
+    std::unique_ptr<GeometryPool> m_pool; // 固定大小的显存几何池
+    uint32_t m_poolGeneration   = 0;      // 几何池每次缩小后递增，旧几何池的槽不再回收
+    uint32_t m_pendingSlotCount = 0;      // 几何池缩小后待创建的新几何池槽数量，为 0 表示没有待创建的几何池
+    uint32_t m_releasingPools   = 0;      // 等待延迟销毁的旧几何池数量，全部销毁之后才创建新的几何池
+    uint32_t m_evictionHandler  = 0;      // 在显存预算中注册的淘汰处理函数
+
+    std::unordered_map<ChunkCoord, ResidentChunk, ChunkCoordHash> m_resident; // 常驻区块
+    std::list<ChunkCoord> m_lru;                                             // 常驻区块的 LRU 顺序，头部为最近使用
+    std::unordered_set<ChunkCoord, ChunkCoordHash> m_desired;                // 本帧需要的区块，按距离最多保留几何池槽数量个
+    std::vector<ChunkCoord> m_visible;                                       // 本帧需要且常驻的区块，用于绘制
+    uint32_t m_pendingFreeSlots = 0;                                         // 已淘汰、等待 GPU 用完后回收的槽数量
+
+    std::unordered_set<ChunkCoord, ChunkCoordHash> m_loading; // 已提交加载任务、尚未上传的区块
+    std::unordered_set<ChunkCoord, ChunkCoordHash> m_failed;  // 加载失败或几何数据无效的区块，离开加载半径之前不再重试
+    std::vector<LoadedChunk> m_ready;                         // 加载完成、等待上传的区块
+    std::vector<LoadedChunk> m_completed;                     // 工作线程写入的加载结果
+    std::mutex m_completedMutex;                              // 保护 m_completed
+    engine::core::JobCounter m_jobCounter;                    // 正在执行的加载任务
+
+    WorldStreamingStats m_stats;
+#pragma endregion
+};
+
+} // namespace engine::render
@@ -0,0 +1,160 @@
+#include "AllocationCounter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace engine::utils {
+
+#ifndef NDEBUG
+namespace {
+std::atomic<uint64_t> allocationCount{0};        // 所有线程
+thread_local uint64_t threadAllocationCount = 0; // 常量初始化的整数，访问时不会触发分配
+
+void countAllocation() {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    threadAllocationCount++;
+}
+
+// 与默认 operator new 一致：失败时调用 new_handler 后重试，没有 new_handler 时返回空指针由调用方处理
+void *allocate(std::size_t size, std::size_t alignment) {
+    size = std::max<std::size_t>(size, 1);
+    while (true) {
+#ifdef _MSC_VER
+        void *pointer = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? _aligned_malloc(size, alignment) : std::malloc(size);
+#else
+        void *pointer = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1)) : std::malloc(size);
+#endif
+        if (pointer != nullptr) return pointer;
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) return nullptr;
+        handler();
+    }
+}
+
+void deallocate(void *pointer, std::size_t alignment) {
+#ifdef _MSC_VER
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        _aligned_free(pointer);
+        return;
+    }
+#else
+    (void)alignment;
+#endif
+    std::free(pointer);
+}
+
+void *allocateOrThrow(std::size_t size, std::size_t alignment) {
+    countAllocation();
+    void *pointer = allocate(size, alignment);
+    if (pointer == nullptr) throw std::bad_alloc();
+    return pointer;
+}
+
+void *allocateNoThrow(std::size_t size, std::size_t alignment) noexcept {
+    countAllocation();
+    try {
+        return allocate(size, alignment);
+    } catch (...) {
+        return nullptr; // new_handler 可能抛出 std::bad_alloc
+    }
+}
+} // namespace
+
+bool isAllocationCounterEnabled() {
+    return true;
+}
+
+uint64_t getAllocationCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+uint64_t getThreadAllocationCount() {
+    return threadAllocationCount;
+}
+#else
+bool isAllocationCounterEnabled() {
+    return false;
+}
+
+uint64_t getAllocationCount() {
+    return 0;
+}
+
+uint64_t getThreadAllocationCount() {
+    return 0;
+}
+#endif
+
+} // namespace engine::utils
+
+#ifndef NDEBUG
+#pragma region Global Operator New
+namespace {
+const std::size_t DEFAULT_ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+} // namespace
+
+void *operator new(std::size_t size) {
+    return engine::utils::allocateOrThrow(size, DEFAULT_ALIGNMENT);
+}
+void *operator new[](std::size_t size) {
+    return engine::utils::allocateOrThrow(size, DEFAULT_ALIGNMENT);
+}
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return engine::utils::allocateNoThrow(size, DEFAULT_ALIGNMENT);
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return engine::utils::allocateNoThrow(size, DEFAULT_ALIGNMENT);
+}
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    return engine::utils::allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return engine::utils::allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return engine::utils::allocateNoThrow(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return engine::utils::allocateNoThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *pointer) noexcept {
+    engine::utils::deallocate(pointer, DEFAULT_ALIGNMENT);
+}
+void operator delete[](void *pointer) noexcept {
+    engine::utils::deallocate(pointer, DEFAULT_ALIGNMENT);
+}
+void operator delete(void *pointer, std::size_t) noexcept {
+    engine::utils::deallocate(pointer, DEFAULT_ALIGNMENT);
+}
+void operator delete[](void *pointer, std::size_t) noexcept {
+    engine::utils::deallocate(pointer, DEFAULT_ALIGNMENT);
+}
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+    engine::utils::deallocate(pointer, DEFAULT_ALIGNMENT);
+}
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+    engine::utils::deallocate(pointer, DEFAULT_ALIGNMENT);
+}
+void operator delete(void *pointer, std::align_val_t alignment) noexcept {
+    engine::utils::deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void *pointer, std::align_val_t alignment) noexcept {
+    engine::utils::deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+void operator delete(void *pointer, std::size_t, std::align_val_t alignment) noexcept {
+    engine::utils::deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void *pointer, std::size_t, std::align_val_t alignment) noexcept {
+    engine::utils::deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+void operator delete(void *pointer, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    engine::utils::deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void *pointer, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    engine::utils::deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+#pragma endregion
+#endif
@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+
+namespace engine::utils {
+
+/**
+ * @brief 调试构建（未定义 NDEBUG）中替换全局 operator new / delete，统计堆分配次数
+ *
+ * 用于检查每帧的稳定状态是否没有堆分配：记录一段代码前后 getThreadAllocationCount() 的差值即可，
+ * 不受其他线程（音频、工作线程）的分配影响。发布构建不替换，所有计数恒为 0。
+ */
+bool isAllocationCounterEnabled();   // 是否替换了全局 operator new
+uint64_t getAllocationCount();       // 所有线程累计调用全局 operator new 的次数
+uint64_t getThreadAllocationCount(); // 当前线程累计调用全局 operator new 的次数
+
+} // namespace engine::utils
@@ -0,0 +1,68 @@
+#include "FrameArena.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace engine::utils {
+
+namespace {
+// pointer 向上对齐到 alignment（2 的幂）需要跳过的字节数
+size_t alignPadding(const std::byte *pointer, size_t alignment) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+    return (alignment - (address & (alignment - 1))) & (alignment - 1);
+}
+} // namespace
+
+FrameArena::FrameArena(size_t capacity) : m_buffer(new std::byte[capacity]), m_capacity(capacity) {}
+
+FrameArena::~FrameArena() = default;
+
+void FrameArena::reset() {
+    if (!m_overflow.empty()) {
+        // 本帧用到了额外的块：主缓冲区扩大到能容纳整帧，之后同样规模的帧不再分配堆内存
+        size_t capacity = std::bit_ceil(std::max(m_capacity * 2, m_peak));
+        m_buffer.reset(new std::byte[capacity]);
+        m_capacity = capacity;
+        m_overflow.clear();
+        m_growCount++;
+        spdlog::info("FrameArena::reset()::帧分配器容量不足, 扩大到 {} 字节", capacity);
+    }
+    m_offset         = 0;
+    m_overflowCursor = nullptr;
+    m_overflowEnd    = nullptr;
+    m_overflowBytes  = 0;
+}
+
+void *FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    size_t start = m_offset + alignPadding(m_buffer.get() + m_offset, alignment);
+    if (start + bytes <= m_capacity) {
+        m_offset = start + bytes;
+        m_peak   = std::max(m_peak, getUsed());
+        return m_buffer.get() + start;
+    }
+
+    // 主缓冲区不足：从额外的块中分配，块至少与主缓冲区一样大，减少本帧剩余分配的堆分配次数
+    size_t padding = m_overflowCursor ? alignPadding(m_overflowCursor, alignment) : 0;
+    if (m_overflowCursor == nullptr || padding + bytes > static_cast<size_t>(m_overflowEnd - m_overflowCursor)) {
+        size_t blockSize = std::max(bytes + alignment, m_capacity);
+        m_overflow.emplace_back(new std::byte[blockSize]);
+        m_overflowCursor = m_overflow.back().get();
+        m_overflowEnd    = m_overflowCursor + blockSize;
+        padding          = alignPadding(m_overflowCursor, alignment);
+    }
+    std::byte *result = m_overflowCursor + padding;
+    m_overflowBytes += padding + bytes;
+    m_overflowCursor = result + bytes;
+    m_peak           = std::max(m_peak, getUsed());
+    return result;
+}
+
+void FrameArena::do_deallocate(void *, size_t, size_t) {}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
+
+} // namespace engine::utils
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace engine::utils {
+
+#pragma region Constants
+const size_t FRAME_ARENA_DEFAULT_CAPACITY = 256 * 1024; // 每个帧上下文的初始容量（字节）
+#pragma endregion
+
+/**
+ * @class FrameArena
+ * @brief 帧上下文使用的线性分配器，以 std::pmr::memory_resource 的形式提供给临时容器
+ *
+ * 分配只移动偏移，释放不做任何事，帧的 Fence 等待完成后由 reset() 整体回收。
+ * 容量不足时从堆上分配额外的块保证分配成功，下一次 reset() 把主缓冲区扩大到本帧的总用量，
+ * 之后同样规模的帧不再分配堆内存。只能在一个线程中使用。
+ */
+class FrameArena final : public std::pmr::memory_resource {
+public:
+    explicit FrameArena(size_t capacity = FRAME_ARENA_DEFAULT_CAPACITY);
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena &)            = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+    FrameArena(FrameArena &&)                 = delete;
+    FrameArena &operator=(FrameArena &&)      = delete;
+
+    void reset(); // 回收所有分配，之前返回的指针全部失效
+
+    size_t getCapacity() const { return m_capacity; }
+    size_t getUsed() const { return m_offset + m_overflowBytes; } // 本帧已分配的字节数（含对齐填充）
+    size_t getPeak() const { return m_peak; }                     // 历史最大的单帧用量
+    uint32_t getGrowCount() const { return m_growCount; }         // 主缓冲区扩大的次数
+
+private:
+#pragma region Menber Variables
+    std::unique_ptr<std::byte[]> m_buffer;                // 主缓冲区
+    size_t m_capacity           = 0;                      // 主缓冲区的字节数
+    size_t m_offset             = 0;                      // 主缓冲区中下一次分配的位置
+    std::vector<std::unique_ptr<std::byte[]>> m_overflow; // 主缓冲区不足时额外分配的块
+    std::byte *m_overflowCursor = nullptr;                // 当前额外块中下一次分配的位置
+    std::byte *m_overflowEnd    = nullptr;                // 当前额外块的末尾
+    size_t m_overflowBytes      = 0;                      // 从额外块中分配的字节数
+    size_t m_peak               = 0;
+    uint32_t m_growCount        = 0;
+#pragma endregion
+
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *pointer, size_t bytes, size_t alignment) override; // 不做任何事，reset() 时整体回收
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+};
+
+} // namespace engine::utils
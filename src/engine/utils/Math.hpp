@@ -32,4 +32,30 @@ struct Vertex {
     }
 };
 
+struct MeshVertex {
+    glm::vec3 pos;
+    glm::vec3 color;
+
+    static VkVertexInputBindingDescription getBindingDescription() {
+        VkVertexInputBindingDescription bindingDescription{};
+        bindingDescription.binding   = 0;                           // 顶点属性绑定索引
+        bindingDescription.stride    = sizeof(MeshVertex);          // 每个顶点的大小
+        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX; // 输入速率，表示每顶点输入一次数据
+        return bindingDescription;                                  // 返回顶点输入绑定描述
+    }
+
+    static std::array<VkVertexInputAttributeDescription, 2> getAttributeDescriptions() {
+        std::array<VkVertexInputAttributeDescription, 2> attributeDescriptions{};
+        attributeDescriptions[0].binding  = 0;                           // 顶点属性绑定索引
+        attributeDescriptions[0].location = 0;                           // 顶点属性位置索引
+        attributeDescriptions[0].format   = VK_FORMAT_R32G32B32_SFLOAT;  // 顶点属性格式
+        attributeDescriptions[0].offset   = offsetof(MeshVertex, pos);   // 顶点属性在顶点结构体中的偏移量
+        attributeDescriptions[1].binding  = 0;                           // 顶点属性绑定索引
+        attributeDescriptions[1].location = 1;                           // 顶点属性位置索引
+        attributeDescriptions[1].format   = VK_FORMAT_R32G32B32_SFLOAT;  // 顶点属性格式
+        attributeDescriptions[1].offset   = offsetof(MeshVertex, color); // 顶点属性在顶点结构体中的偏移量
+        return attributeDescriptions;
+    }
+};
+
 } // namespace engine::utils
\ No newline at end of file
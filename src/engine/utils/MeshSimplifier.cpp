@@ -0,0 +1,255 @@
+#include "MeshSimplifier.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace engine::utils {
+
+namespace {
+const double BOUNDARY_WEIGHT   = 10.0; // 开放边界约束平面的权重，越大越不容易改变轮廓
+const double MIN_REDUCTION     = 0.9;  // 一级 LOD 的索引数至少减少到上一级的该比例，否则停止生成
+const size_t MIN_LOD_TRIANGLES = 8;    // 三角形少于该数量时不再生成更低的 LOD
+} // namespace
+
+#pragma region Quadric
+void MeshSimplifier::Quadric::addPlane(const glm::dvec3 &normal, double d, double w) {
+    a[0] += w * normal.x * normal.x;
+    a[1] += w * normal.x * normal.y;
+    a[2] += w * normal.x * normal.z;
+    a[3] += w * normal.x * d;
+    a[4] += w * normal.y * normal.y;
+    a[5] += w * normal.y * normal.z;
+    a[6] += w * normal.y * d;
+    a[7] += w * normal.z * normal.z;
+    a[8] += w * normal.z * d;
+    a[9] += w * d * d;
+    weight += w;
+}
+
+void MeshSimplifier::Quadric::add(const Quadric &other) {
+    for (int i = 0; i < 10; i++) {
+        a[i] += other.a[i];
+    }
+    weight += other.weight;
+}
+
+double MeshSimplifier::Quadric::evaluate(const glm::dvec3 &p) const {
+    // v^T Q v，v = (x, y, z, 1)
+    return a[0] * p.x * p.x + 2.0 * a[1] * p.x * p.y + 2.0 * a[2] * p.x * p.z + 2.0 * a[3] * p.x +
+           a[4] * p.y * p.y + 2.0 * a[5] * p.y * p.z + 2.0 * a[6] * p.y +
+           a[7] * p.z * p.z + 2.0 * a[8] * p.z +
+           a[9];
+}
+#pragma endregion
+
+MeshSimplifier::MeshSimplifier(const std::vector<MeshVertex> &vertices, const std::vector<uint32_t> &indices) {
+    if (indices.size() % 3 != 0) {
+        throw std::runtime_error("MeshSimplifier::MeshSimplifier()::索引数量不是 3 的倍数");
+    }
+
+    // 位置完全相同的顶点合并为一个位置，排序后分组
+    std::vector<uint32_t> order(vertices.size());
+    std::iota(order.begin(), order.end(), 0u);
+    auto lessPosition = [&](uint32_t lhs, uint32_t rhs) {
+        const glm::vec3 &a = vertices[lhs].pos;
+        const glm::vec3 &b = vertices[rhs].pos;
+        if (a.x != b.x) return a.x < b.x;
+        if (a.y != b.y) return a.y < b.y;
+        return a.z < b.z;
+    };
+    std::sort(order.begin(), order.end(), lessPosition);
+    m_vertexPositions.resize(vertices.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        if (i == 0 || vertices[order[i - 1]].pos != vertices[order[i]].pos) {
+            m_positions.push_back(glm::dvec3(vertices[order[i]].pos));
+            m_representative.push_back(order[i]);
+        }
+        m_vertexPositions[order[i]] = static_cast<uint32_t>(m_positions.size() - 1);
+    }
+    m_quadrics.resize(m_positions.size());
+    m_versions.resize(m_positions.size(), 0);
+    m_removed.resize(m_positions.size(), false);
+    m_positionTriangles.resize(m_positions.size());
+
+    // 三角形平面的二次型按面积加权累加到三个顶点
+    std::unordered_map<uint64_t, uint32_t> edgeUse; // 无向边 -> 使用次数
+    auto edgeKey = [](uint32_t p0, uint32_t p1) {
+        return (static_cast<uint64_t>(std::min(p0, p1)) << 32) | std::max(p0, p1);
+    };
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        Triangle triangle{};
+        for (int k = 0; k < 3; k++) {
+            if (indices[i + k] >= vertices.size()) {
+                throw std::runtime_error("MeshSimplifier::MeshSimplifier()::索引超出顶点数量");
+            }
+            triangle.corners[k]   = indices[i + k];
+            triangle.positions[k] = m_vertexPositions[indices[i + k]];
+        }
+        const uint32_t *p = triangle.positions;
+        if (p[0] == p[1] || p[1] == p[2] || p[0] == p[2]) continue; // 退化三角形直接丢弃
+        glm::dvec3 cross = glm::cross(m_positions[p[1]] - m_positions[p[0]], m_positions[p[2]] - m_positions[p[0]]);
+        double length    = glm::length(cross);
+        if (length > 0.0) {
+            glm::dvec3 normal = cross / length;
+            double d          = -glm::dot(normal, m_positions[p[0]]);
+            for (int k = 0; k < 3; k++) {
+                m_quadrics[p[k]].addPlane(normal, d, length * 0.5);
+            }
+        }
+        triangle.alive = true;
+        uint32_t index = static_cast<uint32_t>(m_triangles.size());
+        for (int k = 0; k < 3; k++) {
+            m_positionTriangles[p[k]].push_back(index);
+            edgeUse[edgeKey(p[k], p[(k + 1) % 3])]++;
+        }
+        m_triangles.push_back(triangle);
+    }
+    m_aliveTriangles = m_triangles.size();
+
+    // 只被一个三角形使用的边是开放边界，加入过该边且垂直于三角形的约束平面
+    for (const Triangle &triangle : m_triangles) {
+        const uint32_t *p     = triangle.positions;
+        glm::dvec3 faceNormal = glm::cross(m_positions[p[1]] - m_positions[p[0]], m_positions[p[2]] - m_positions[p[0]]);
+        for (int k = 0; k < 3; k++) {
+            uint32_t p0 = p[k];
+            uint32_t p1 = p[(k + 1) % 3];
+            if (edgeUse[edgeKey(p0, p1)] != 1) continue;
+            glm::dvec3 edge   = m_positions[p1] - m_positions[p0];
+            glm::dvec3 normal = glm::cross(edge, faceNormal);
+            double length     = glm::length(normal);
+            if (length <= 0.0) continue;
+            normal /= length;
+            double d = -glm::dot(normal, m_positions[p0]);
+            double w = BOUNDARY_WEIGHT * glm::dot(edge, edge);
+            m_quadrics[p0].addPlane(normal, d, w);
+            m_quadrics[p1].addPlane(normal, d, w);
+        }
+    }
+
+    for (uint32_t position = 0; position < m_positions.size(); position++) {
+        pushCollapses(position);
+    }
+}
+
+void MeshSimplifier::pushCollapses(uint32_t position) {
+    for (uint32_t triangleIndex : m_positionTriangles[position]) {
+        const Triangle &triangle = m_triangles[triangleIndex];
+        if (!triangle.alive) continue;
+        for (uint32_t neighbor : triangle.positions) {
+            if (neighbor == position) continue;
+            // 合并后的二次型分别在两个端点处求值，选择误差较小的方向
+            Quadric combined = m_quadrics[position];
+            combined.add(m_quadrics[neighbor]);
+            double costToNeighbor = combined.evaluate(m_positions[neighbor]);
+            double costToPosition = combined.evaluate(m_positions[position]);
+            Collapse candidate{};
+            candidate.cost        = std::max(std::min(costToNeighbor, costToPosition), 0.0);
+            candidate.error       = combined.weight > 0.0 ? std::sqrt(candidate.cost / combined.weight) : 0.0;
+            candidate.from        = costToNeighbor <= costToPosition ? position : neighbor;
+            candidate.to          = costToNeighbor <= costToPosition ? neighbor : position;
+            candidate.fromVersion = m_versions[candidate.from];
+            candidate.toVersion   = m_versions[candidate.to];
+            m_heap.push_back(candidate);
+            std::push_heap(m_heap.begin(), m_heap.end(), std::greater<>{});
+        }
+    }
+}
+
+bool MeshSimplifier::collapseFlipsTriangle(uint32_t from, uint32_t to) const {
+    for (uint32_t triangleIndex : m_positionTriangles[from]) {
+        const Triangle &triangle = m_triangles[triangleIndex];
+        if (!triangle.alive) continue;
+        const uint32_t *p = triangle.positions;
+        if (p[0] == to || p[1] == to || p[2] == to) continue; // 折叠后退化，会被删除
+        glm::dvec3 before[3];
+        glm::dvec3 after[3];
+        for (int k = 0; k < 3; k++) {
+            before[k] = m_positions[p[k]];
+            after[k]  = p[k] == from ? m_positions[to] : before[k];
+        }
+        glm::dvec3 oldNormal = glm::cross(before[1] - before[0], before[2] - before[0]);
+        glm::dvec3 newNormal = glm::cross(after[1] - after[0], after[2] - after[0]);
+        if (glm::dot(oldNormal, newNormal) <= 0.0) return true;
+    }
+    return false;
+}
+
+void MeshSimplifier::collapse(uint32_t from, uint32_t to) {
+    m_quadrics[to].add(m_quadrics[from]);
+    m_removed[from] = true;
+    m_versions[to]++;
+    for (uint32_t triangleIndex : m_positionTriangles[from]) {
+        Triangle &triangle = m_triangles[triangleIndex];
+        if (!triangle.alive) continue;
+        bool hasTarget = false;
+        for (uint32_t &position : triangle.positions) {
+            if (position == to) hasTarget = true;
+            if (position == from) position = to;
+        }
+        if (hasTarget) {
+            triangle.alive = false; // 折叠的边所在的三角形退化
+            m_aliveTriangles--;
+        } else {
+            m_positionTriangles[to].push_back(triangleIndex);
+        }
+    }
+    m_positionTriangles[from].clear();
+    std::erase_if(m_positionTriangles[to], [&](uint32_t triangleIndex) { return !m_triangles[triangleIndex].alive; });
+    pushCollapses(to);
+}
+
+MeshLodLevel MeshSimplifier::simplify(size_t targetIndexCount) {
+    size_t targetTriangles = targetIndexCount / 3;
+    while (m_aliveTriangles > targetTriangles && !m_heap.empty()) {
+        std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<>{});
+        Collapse candidate = m_heap.back();
+        m_heap.pop_back();
+        // 端点已被折叠或二次型已变化的候选过期
+        if (m_removed[candidate.from] || m_removed[candidate.to]) continue;
+        if (m_versions[candidate.from] != candidate.fromVersion || m_versions[candidate.to] != candidate.toVersion) continue;
+        if (collapseFlipsTriangle(candidate.from, candidate.to)) continue;
+        collapse(candidate.from, candidate.to);
+        m_maxError = std::max(m_maxError, candidate.error);
+    }
+    return buildLevel();
+}
+
+MeshLodLevel MeshSimplifier::buildLevel() const {
+    MeshLodLevel level;
+    level.error = static_cast<float>(m_maxError);
+    level.indices.reserve(m_aliveTriangles * 3);
+    for (const Triangle &triangle : m_triangles) {
+        if (!triangle.alive) continue;
+        for (int k = 0; k < 3; k++) {
+            // 位置未被折叠的角保留原顶点（保留颜色等属性），否则使用目标位置的代表顶点
+            uint32_t vertex = triangle.corners[k];
+            uint32_t target = triangle.positions[k];
+            level.indices.push_back(m_vertexPositions[vertex] == target ? vertex : m_representative[target]);
+        }
+    }
+    return level;
+}
+
+std::vector<MeshLodLevel> MeshSimplifier::buildLodChain(const std::vector<MeshVertex> &vertices, const std::vector<uint32_t> &indices,
+                                                        uint32_t maxLevels, float reduction) {
+    std::vector<MeshLodLevel> levels;
+    levels.push_back({indices, 0.0f});
+    if (maxLevels <= 1) return levels;
+
+    MeshSimplifier simplifier(vertices, indices);
+    while (levels.size() < maxLevels) {
+        size_t previousCount = levels.back().indices.size();
+        if (previousCount / 3 < MIN_LOD_TRIANGLES) break;
+        size_t target      = static_cast<size_t>(static_cast<double>(previousCount / 3) * reduction) * 3;
+        MeshLodLevel level = simplifier.simplify(target);
+        if (level.indices.empty() || static_cast<double>(level.indices.size()) > static_cast<double>(previousCount) * MIN_REDUCTION) break;
+        levels.push_back(std::move(level));
+    }
+    return levels;
+}
+
+} // namespace engine::utils
@@ -0,0 +1,88 @@
+#pragma once
+#include "Math.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::utils {
+
+/**
+ * @struct MeshLodLevel
+ * @brief 简化得到的一级 LOD：索引引用原始顶点数组，不产生新顶点
+ */
+struct MeshLodLevel {
+    std::vector<uint32_t> indices;
+    float error = 0.0f; // 相对原始网格的几何误差（模型空间距离），用于运行时计算屏幕空间误差
+};
+
+/**
+ * @class MeshSimplifier
+ * @brief 基于二次误差度量（QEM）的网格简化
+ *
+ * 只做半边折叠（顶点折叠到相邻顶点的位置），简化结果只引用原始顶点，所有 LOD 可以共用同一段顶点数据。
+ * 位置相同的顶点（颜色接缝）作为一个整体折叠，避免产生裂缝；开放边界额外加入垂直约束平面，保持轮廓。
+ * 每一级从上一级的状态继续简化，误差单调不减。
+ */
+class MeshSimplifier final {
+public:
+    MeshSimplifier(const std::vector<MeshVertex> &vertices, const std::vector<uint32_t> &indices);
+
+    /**
+     * @brief 继续简化到不超过 targetIndexCount 个索引
+     * @return 简化后的一级 LOD；无法继续简化时索引数可能多于目标
+     */
+    MeshLodLevel simplify(size_t targetIndexCount);
+
+    /**
+     * @brief 生成 LOD 链，第 0 级为原始网格，每一级目标三角形数为上一级的 reduction 倍
+     * @param maxLevels 最多生成的级数（包含第 0 级）
+     */
+    static std::vector<MeshLodLevel> buildLodChain(const std::vector<MeshVertex> &vertices, const std::vector<uint32_t> &indices,
+                                                   uint32_t maxLevels, float reduction = 0.5f);
+
+private:
+    struct Quadric {
+        double a[10]  = {}; // 对称 4x4 矩阵的上三角
+        double weight = 0.0;
+
+        void addPlane(const glm::dvec3 &normal, double d, double w);
+        void add(const Quadric &other);
+        double evaluate(const glm::dvec3 &p) const;
+    };
+    struct Triangle {
+        uint32_t corners[3];   // 原始顶点索引
+        uint32_t positions[3]; // 当前位置编号（折叠后更新）
+        bool alive;
+    };
+    struct Collapse {
+        double cost;  // 二次误差，按面积加权
+        double error; // 归一化后的几何误差
+        uint32_t from;
+        uint32_t to;
+        uint32_t fromVersion;
+        uint32_t toVersion;
+
+        bool operator>(const Collapse &other) const { return cost > other.cost; }
+    };
+
+    void pushCollapses(uint32_t position);                        // 为位置 position 的所有相邻边加入折叠候选
+    bool collapseFlipsTriangle(uint32_t from, uint32_t to) const; // 折叠后是否有三角形翻转
+    void collapse(uint32_t from, uint32_t to);
+    MeshLodLevel buildLevel() const;
+
+#pragma region Menber Variables
+    std::vector<glm::dvec3> m_positions;                    // 去重后的位置
+    std::vector<uint32_t> m_vertexPositions;                // 每个原始顶点对应的位置编号
+    std::vector<uint32_t> m_representative;                 // 每个位置对应的一个原始顶点
+    std::vector<Quadric> m_quadrics;                        // 每个位置的误差二次型
+    std::vector<uint32_t> m_versions;                       // 位置每次变化后递增，使过期的候选失效
+    std::vector<bool> m_removed;                            // 位置是否已被折叠
+    std::vector<std::vector<uint32_t>> m_positionTriangles; // 每个位置相邻的三角形（可能包含已删除的）
+    std::vector<Triangle> m_triangles;
+    std::vector<Collapse> m_heap;                           // 最小堆
+    size_t m_aliveTriangles = 0;
+    double m_maxError       = 0.0;                          // 已执行折叠的最大误差
+#pragma endregion
+};
+
+} // namespace engine::utils
@@ -0,0 +1,121 @@
+#include "MeshletBuilder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace engine::utils {
+
+namespace {
+const float MIN_CONE_SPREAD = 0.1f; // 法线与锥轴夹角的余弦最小值低于该值时锥太宽，不做背面剔除
+
+// 计算簇的包围球和法线锥
+void computeBounds(Meshlet &meshlet, const MeshletData &data, const std::vector<MeshVertex> &vertices) {
+    auto position = [&](uint32_t localVertex) -> const glm::vec3 & {
+        return vertices[data.vertices[meshlet.vertexOffset + localVertex]].pos;
+    };
+
+    // 包围球：顶点中心 + 最远距离，比最小包围球略大但足够紧
+    glm::vec3 center(0.0f);
+    for (uint32_t i = 0; i < meshlet.vertexCount; i++) {
+        center += position(i);
+    }
+    center /= static_cast<float>(meshlet.vertexCount);
+    float radius = 0.0f;
+    for (uint32_t i = 0; i < meshlet.vertexCount; i++) {
+        radius = std::max(radius, glm::length(position(i) - center));
+    }
+    meshlet.center = center;
+    meshlet.radius = radius;
+
+    // 法线锥：锥轴为面积加权平均法线，张角由与锥轴夹角最大的三角形决定
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec3> corners;
+    glm::vec3 axis(0.0f);
+    for (uint32_t t = 0; t < meshlet.triangleCount; t++) {
+        uint32_t packed = data.triangles[meshlet.triangleOffset + t];
+        glm::vec3 p0    = position(packed & 0xFF);
+        glm::vec3 p1    = position((packed >> 8) & 0xFF);
+        glm::vec3 p2    = position((packed >> 16) & 0xFF);
+        glm::vec3 cross = glm::cross(p1 - p0, p2 - p0);
+        float area      = glm::length(cross);
+        if (area <= 0.0f) continue; // 退化三角形不影响可见性
+        axis += cross;
+        normals.push_back(cross / area);
+        corners.push_back(p0);
+    }
+    float axisLength = glm::length(axis);
+    if (normals.empty() || axisLength <= 0.0f) return;
+    axis /= axisLength;
+
+    float minDot = 1.0f;
+    for (const glm::vec3 &normal : normals) {
+        minDot = std::min(minDot, glm::dot(normal, axis));
+    }
+    if (minDot <= MIN_CONE_SPREAD) return;
+
+    // 锥顶沿锥轴后退到所有三角形平面之后，保证从锥内任意位置看过去都是背面
+    float maxT = 0.0f;
+    for (size_t i = 0; i < normals.size(); i++) {
+        float dc = glm::dot(center - corners[i], normals[i]);
+        float dn = glm::dot(axis, normals[i]);
+        maxT     = std::max(maxT, dc / dn);
+    }
+    meshlet.coneApex   = center - axis * maxT;
+    meshlet.coneAxis   = axis;
+    meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+}
+} // namespace
+
+MeshletData buildMeshlets(const std::vector<MeshVertex> &vertices, const std::vector<uint32_t> &indices, uint32_t maxVertices, uint32_t maxTriangles) {
+    if (indices.size() % 3 != 0) {
+        throw std::runtime_error("buildMeshlets()::索引数量不是 3 的倍数");
+    }
+    if (maxVertices < 3 || maxVertices > 256 || maxTriangles == 0) {
+        throw std::runtime_error("buildMeshlets()::簇的顶点数必须在 [3, 256] 内，三角形数必须大于 0");
+    }
+
+    MeshletData data;
+    std::vector<uint32_t> localIndex(vertices.size(), UINT32_MAX); // 原始顶点在当前簇中的编号
+    Meshlet current;
+    auto finish = [&]() {
+        if (current.triangleCount == 0) return;
+        computeBounds(current, data, vertices);
+        for (uint32_t i = 0; i < current.vertexCount; i++) {
+            localIndex[data.vertices[current.vertexOffset + i]] = UINT32_MAX;
+        }
+        data.meshlets.push_back(current);
+        current                = Meshlet{};
+        current.vertexOffset   = static_cast<uint32_t>(data.vertices.size());
+        current.triangleOffset = static_cast<uint32_t>(data.triangles.size());
+    };
+
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        uint32_t newVertices = 0;
+        for (int k = 0; k < 3; k++) {
+            if (indices[i + k] >= vertices.size()) {
+                throw std::runtime_error("buildMeshlets()::索引超出顶点数量");
+            }
+            if (localIndex[indices[i + k]] == UINT32_MAX) newVertices++;
+        }
+        if (current.vertexCount + newVertices > maxVertices || current.triangleCount + 1 > maxTriangles) {
+            finish();
+        }
+
+        uint32_t packed = 0;
+        for (int k = 0; k < 3; k++) {
+            uint32_t vertex = indices[i + k];
+            if (localIndex[vertex] == UINT32_MAX) {
+                localIndex[vertex] = current.vertexCount++;
+                data.vertices.push_back(vertex);
+            }
+            packed |= localIndex[vertex] << (8 * k);
+        }
+        data.triangles.push_back(packed);
+        current.triangleCount++;
+    }
+    finish();
+    return data;
+}
+
+} // namespace engine::utils
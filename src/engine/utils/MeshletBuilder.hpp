@@ -0,0 +1,50 @@
+#pragma once
+#include "Math.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::utils {
+
+#pragma region Constants
+const uint32_t MESHLET_MAX_VERTICES  = 64;  // 每个簇最多的顶点数，与网格着色器的 max_vertices 一致
+const uint32_t MESHLET_MAX_TRIANGLES = 124; // 每个簇最多的三角形数，与网格着色器的 max_primitives 一致
+#pragma endregion
+
+/**
+ * @struct Meshlet
+ * @brief 一个几何簇：局部顶点表 + 局部三角形，以及用于剔除的包围球和法线锥
+ *
+ * 背面锥测试：dot(normalize(coneApex - cameraPosition), coneAxis) >= coneCutoff 时簇内所有三角形都背对观察点。
+ * 正面按模型空间逆时针绕序计算；coneCutoff 为 1 表示法线过于分散，不做背面剔除。
+ */
+struct Meshlet {
+    uint32_t vertexOffset   = 0; // 在 MeshletData::vertices 中的起始位置
+    uint32_t vertexCount    = 0;
+    uint32_t triangleOffset = 0; // 在 MeshletData::triangles 中的起始位置（以三角形为单位）
+    uint32_t triangleCount  = 0;
+    glm::vec3 center{0.0f};      // 包围球
+    float radius = 0.0f;
+    glm::vec3 coneApex{0.0f};    // 法线锥
+    glm::vec3 coneAxis{0.0f, 0.0f, 1.0f};
+    float coneCutoff = 1.0f;
+};
+
+/**
+ * @struct MeshletData
+ * @brief 一个网格的所有簇
+ */
+struct MeshletData {
+    std::vector<Meshlet> meshlets;
+    std::vector<uint32_t> vertices;  // 簇的局部顶点 -> 原始顶点索引
+    std::vector<uint32_t> triangles; // 每个三角形的三个局部顶点编号，按 8 位打包：i0 | i1 << 8 | i2 << 16
+};
+
+/**
+ * @brief 按索引顺序贪心地把三角形划分为簇，簇的顶点数或三角形数达到上限时开始新簇
+ * @note 索引顺序决定簇的空间紧凑程度，导入时应先做顶点缓存优化或按空间排序
+ */
+MeshletData buildMeshlets(const std::vector<MeshVertex> &vertices, const std::vector<uint32_t> &indices,
+                          uint32_t maxVertices = MESHLET_MAX_VERTICES, uint32_t maxTriangles = MESHLET_MAX_TRIANGLES);
+
+} // namespace engine::utils
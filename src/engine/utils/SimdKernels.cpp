@@ -0,0 +1,261 @@
+#include "SimdKernelsImpl.hpp"
+
+#include <SDL3/SDL_cpuinfo.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace engine::utils {
+
+namespace {
+// 标量参考实现：逐元素计算，与 SIMD 路径的运算顺序相同；
+// 本文件按 -ffp-contract=off 编译（见 CMakeLists.txt），乘加不会被合并成 FMA，结果与 SIMD 路径逐位相同
+void transformPointsScalar(const float *m, const ConstVec3Soa &points, const Vec3Soa &out, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        const float x = points.x[i], y = points.y[i], z = points.z[i];
+        out.x[i]      = m[0] * x + (m[4] * y + (m[8] * z + m[12]));
+        out.y[i]      = m[1] * x + (m[5] * y + (m[9] * z + m[13]));
+        out.z[i]      = m[2] * x + (m[6] * y + (m[10] * z + m[14]));
+    }
+}
+
+void composeTrsScalar(const ConstVec3Soa &positions, const ConstQuatSoa &rotations, const ConstVec3Soa &scales, float *out, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        const float qx = rotations.x[i], qy = rotations.y[i], qz = rotations.z[i], qw = rotations.w[i];
+        const float sx = scales.x[i], sy = scales.y[i], sz = scales.z[i];
+        const float xx = qx * qx, yy = qy * qy, zz = qz * qz;
+        const float xy = qx * qy, xz = qx * qz, yz = qy * qz;
+        const float wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+        float *matrix = out + i * 16;
+        matrix[0]     = (1.0f - 2.0f * (yy + zz)) * sx;
+        matrix[1]     = 2.0f * (xy + wz) * sx;
+        matrix[2]     = 2.0f * (xz - wy) * sx;
+        matrix[3]     = 0.0f;
+        matrix[4]     = 2.0f * (xy - wz) * sy;
+        matrix[5]     = (1.0f - 2.0f * (xx + zz)) * sy;
+        matrix[6]     = 2.0f * (yz + wx) * sy;
+        matrix[7]     = 0.0f;
+        matrix[8]     = 2.0f * (xz + wy) * sz;
+        matrix[9]     = 2.0f * (yz - wx) * sz;
+        matrix[10]    = (1.0f - 2.0f * (xx + yy)) * sz;
+        matrix[11]    = 0.0f;
+        matrix[12]    = positions.x[i];
+        matrix[13]    = positions.y[i];
+        matrix[14]    = positions.z[i];
+        matrix[15]    = 1.0f;
+    }
+}
+
+void transformAabbsScalar(const float *m, const ConstAabbSoa &boxes, const AabbSoa &out, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        const float cx = (boxes.min.x[i] + boxes.max.x[i]) * 0.5f;
+        const float cy = (boxes.min.y[i] + boxes.max.y[i]) * 0.5f;
+        const float cz = (boxes.min.z[i] + boxes.max.z[i]) * 0.5f;
+        const float ex = (boxes.max.x[i] - boxes.min.x[i]) * 0.5f;
+        const float ey = (boxes.max.y[i] - boxes.min.y[i]) * 0.5f;
+        const float ez = (boxes.max.z[i] - boxes.min.z[i]) * 0.5f;
+        const float centerX = m[0] * cx + (m[4] * cy + (m[8] * cz + m[12]));
+        const float centerY = m[1] * cx + (m[5] * cy + (m[9] * cz + m[13]));
+        const float centerZ = m[2] * cx + (m[6] * cy + (m[10] * cz + m[14]));
+        const float extentX = std::fabs(m[0]) * ex + (std::fabs(m[4]) * ey + std::fabs(m[8]) * ez);
+        const float extentY = std::fabs(m[1]) * ex + (std::fabs(m[5]) * ey + std::fabs(m[9]) * ez);
+        const float extentZ = std::fabs(m[2]) * ex + (std::fabs(m[6]) * ey + std::fabs(m[10]) * ez);
+        out.min.x[i]        = centerX - extentX;
+        out.min.y[i]        = centerY - extentY;
+        out.min.z[i]        = centerZ - extentZ;
+        out.max.x[i]        = centerX + extentX;
+        out.max.y[i]        = centerY + extentY;
+        out.max.z[i]        = centerZ + extentZ;
+    }
+}
+
+void mergeAabbsScalar(const ConstAabbSoa &boxes, uint32_t count, float *bounds) {
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+    const float *sources[6]  = {boxes.min.x, boxes.min.y, boxes.min.z, boxes.max.x, boxes.max.y, boxes.max.z};
+    for (uint32_t k = 0; k < 6; k++) {
+        float value = k < 3 ? infinity : -infinity;
+        for (uint32_t i = 0; i < count; i++) {
+            value = k < 3 ? std::min(value, sources[k][i]) : std::max(value, sources[k][i]);
+        }
+        bounds[k] = value;
+    }
+}
+
+void cullSpheresScalar(const float *planes, const ConstVec3Soa &centers, const float *radii, uint8_t *visible, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        bool inside = true;
+        for (uint32_t p = 0; p < 6 && inside; p++) {
+            const float *plane = planes + p * 4;
+            float distance     = plane[0] * centers.x[i] + (plane[1] * centers.y[i] + (plane[2] * centers.z[i] + plane[3]));
+            inside             = distance >= -radii[i];
+        }
+        visible[i] = inside ? 1 : 0;
+    }
+}
+
+void cullAabbsScalar(const float *planes, const ConstAabbSoa &boxes, uint8_t *visible, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        const float cx = (boxes.min.x[i] + boxes.max.x[i]) * 0.5f;
+        const float cy = (boxes.min.y[i] + boxes.max.y[i]) * 0.5f;
+        const float cz = (boxes.min.z[i] + boxes.max.z[i]) * 0.5f;
+        const float ex = (boxes.max.x[i] - boxes.min.x[i]) * 0.5f;
+        const float ey = (boxes.max.y[i] - boxes.min.y[i]) * 0.5f;
+        const float ez = (boxes.max.z[i] - boxes.min.z[i]) * 0.5f;
+        bool inside    = true;
+        for (uint32_t p = 0; p < 6 && inside; p++) {
+            const float *plane = planes + p * 4;
+            float distance     = plane[0] * cx + (plane[1] * cy + (plane[2] * cz + plane[3]));
+            float radius       = std::fabs(plane[0]) * ex + (std::fabs(plane[1]) * ey + std::fabs(plane[2]) * ez);
+            inside             = distance >= -radius;
+        }
+        visible[i] = inside ? 1 : 0;
+    }
+}
+
+const SimdKernelTable &getScalarKernels() {
+    static const SimdKernelTable table = {
+        SimdIsa::Scalar,
+        &transformPointsScalar,
+        &composeTrsScalar,
+        &transformAabbsScalar,
+        &mergeAabbsScalar,
+        &cullSpheresScalar,
+        &cullAabbsScalar,
+    };
+    return table;
+}
+
+const SimdKernelTable &getKernelTable(SimdIsa isa) {
+    switch (isa) {
+#if defined(SIMD_KERNELS_X86)
+    case SimdIsa::Sse2:
+        return getSse2Kernels();
+    case SimdIsa::Avx2:
+        return getAvx2Kernels();
+#elif defined(SIMD_KERNELS_NEON)
+    case SimdIsa::Neon:
+        return getNeonKernels();
+#endif
+    default:
+        return getScalarKernels();
+    }
+}
+
+std::atomic<const SimdKernelTable *> &activeKernels() {
+    static std::atomic<const SimdKernelTable *> active{nullptr};
+    return active;
+}
+
+const SimdKernelTable &kernels() {
+    const SimdKernelTable *table = activeKernels().load(std::memory_order_acquire);
+    if (table) return *table;
+
+    // 第一次调用时选择当前 CPU 支持的最快路径
+    SimdIsa best = SimdIsa::Scalar;
+    for (SimdIsa isa : {SimdIsa::Avx2, SimdIsa::Sse2, SimdIsa::Neon}) {
+        if (isSimdIsaSupported(isa)) {
+            best = isa;
+            break;
+        }
+    }
+    table = &getKernelTable(best);
+    activeKernels().store(table, std::memory_order_release);
+    spdlog::info("SimdKernels::kernels()::批量数学内核使用 {} 路径", getSimdIsaName(best));
+    return *table;
+}
+} // namespace
+
+FrustumPlanes extractFrustumPlanes(const glm::mat4 &viewProjection) {
+    const glm::vec4 row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+    const glm::vec4 row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+    const glm::vec4 row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+    const glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+    // 左 右 下 上 近 远，深度范围 [0, 1] 时近平面就是第三行
+    FrustumPlanes planes = {row3 + row0, row3 - row0, row3 + row1, row3 - row1, row2, row3 - row2};
+    for (glm::vec4 &plane : planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) plane /= length;
+    }
+    return planes;
+}
+
+bool isSimdIsaSupported(SimdIsa isa) {
+    switch (isa) {
+    case SimdIsa::Scalar:
+        return true;
+#if defined(SIMD_KERNELS_X86)
+    case SimdIsa::Sse2:
+        return SDL_HasSSE2();
+    case SimdIsa::Avx2:
+        return SDL_HasAVX2();
+#elif defined(SIMD_KERNELS_NEON)
+    case SimdIsa::Neon:
+        return SDL_HasNEON();
+#endif
+    default:
+        return false;
+    }
+}
+
+SimdIsa getSimdIsa() {
+    return kernels().isa;
+}
+
+void setSimdIsa(SimdIsa isa) {
+    if (!isSimdIsaSupported(isa)) {
+        throw std::runtime_error(std::string("setSimdIsa()::当前 CPU 或编译目标不支持 ") + getSimdIsaName(isa));
+    }
+    activeKernels().store(&getKernelTable(isa), std::memory_order_release);
+    spdlog::info("setSimdIsa()::批量数学内核切换到 {} 路径", getSimdIsaName(isa));
+}
+
+const char *getSimdIsaName(SimdIsa isa) {
+    switch (isa) {
+    case SimdIsa::Scalar:
+        return "Scalar";
+    case SimdIsa::Sse2:
+        return "SSE2";
+    case SimdIsa::Avx2:
+        return "AVX2";
+    case SimdIsa::Neon:
+        return "NEON";
+    }
+    return "Unknown";
+}
+
+void transformPoints(const glm::mat4 &matrix, const ConstVec3Soa &points, const Vec3Soa &out, uint32_t count) {
+    kernels().transformPoints(&matrix[0][0], points, out, count);
+}
+
+void composeTrs(const ConstVec3Soa &positions, const ConstQuatSoa &rotations, const ConstVec3Soa &scales, glm::mat4 *out, uint32_t count) {
+    kernels().composeTrs(positions, rotations, scales, reinterpret_cast<float *>(out), count);
+}
+
+void transformAabbs(const glm::mat4 &matrix, const ConstAabbSoa &boxes, const AabbSoa &out, uint32_t count) {
+    kernels().transformAabbs(&matrix[0][0], boxes, out, count);
+}
+
+Aabb mergeAabbs(const ConstAabbSoa &boxes, uint32_t count) {
+    float bounds[6];
+    kernels().mergeAabbs(boxes, count, bounds);
+    Aabb result;
+    result.min = glm::vec3(bounds[0], bounds[1], bounds[2]);
+    result.max = glm::vec3(bounds[3], bounds[4], bounds[5]);
+    return result;
+}
+
+void cullSpheres(const FrustumPlanes &planes, const ConstVec3Soa &centers, const float *radii, uint8_t *visible, uint32_t count) {
+    kernels().cullSpheres(&planes[0][0], centers, radii, visible, count);
+}
+
+void cullAabbs(const FrustumPlanes &planes, const ConstAabbSoa &boxes, uint8_t *visible, uint32_t count) {
+    kernels().cullAabbs(&planes[0][0], boxes, visible, count);
+}
+
+} // namespace engine::utils
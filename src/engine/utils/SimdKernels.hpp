@@ -0,0 +1,94 @@
+#pragma once
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace engine::utils {
+
+/**
+ * @enum SimdIsa
+ * @brief 批量数学内核使用的指令集
+ */
+enum class SimdIsa : uint8_t {
+    Scalar, // 标量参考实现，用于校验其他路径
+    Sse2,   // x86 基础指令集，不需要额外的编译选项
+    Avx2,
+    Neon,
+};
+
+// 结构体数组（SoA）形式的输入输出，每个分量是一个连续的 float 数组
+struct Vec3Soa {
+    float *x = nullptr;
+    float *y = nullptr;
+    float *z = nullptr;
+};
+
+struct ConstVec3Soa {
+    const float *x = nullptr;
+    const float *y = nullptr;
+    const float *z = nullptr;
+};
+
+struct ConstQuatSoa {
+    const float *x = nullptr;
+    const float *y = nullptr;
+    const float *z = nullptr;
+    const float *w = nullptr;
+};
+
+struct AabbSoa {
+    Vec3Soa min;
+    Vec3Soa max;
+};
+
+struct ConstAabbSoa {
+    ConstVec3Soa min;
+    ConstVec3Soa max;
+};
+
+struct Aabb {
+    glm::vec3 min{0.0f};
+    glm::vec3 max{0.0f};
+};
+
+using FrustumPlanes = std::array<glm::vec4, 6>; // xyz 为单位法线，点在平面内侧时 dot(n, p) + w >= 0
+
+FrustumPlanes extractFrustumPlanes(const glm::mat4 &viewProjection); // Vulkan [0, 1] 深度范围，与剔除着色器一致
+
+bool isSimdIsaSupported(SimdIsa isa); // 编译目标和当前 CPU 都支持时返回 true
+SimdIsa getSimdIsa();                 // 当前使用的指令集，第一次调用内核时选择支持的最快路径
+void setSimdIsa(SimdIsa isa);         // 强制使用某个指令集（测试和性能对比），不支持时抛出异常
+const char *getSimdIsaName(SimdIsa isa);
+
+/**
+ * @brief 批量变换点：out = matrix * (p, 1)，只使用矩阵的前三行
+ */
+void transformPoints(const glm::mat4 &matrix, const ConstVec3Soa &points, const Vec3Soa &out, uint32_t count);
+
+/**
+ * @brief 批量由平移、旋转（单位四元数）、缩放组成模型矩阵 T * R * S
+ */
+void composeTrs(const ConstVec3Soa &positions, const ConstQuatSoa &rotations, const ConstVec3Soa &scales, glm::mat4 *out, uint32_t count);
+
+/**
+ * @brief 批量变换包围盒，结果是变换后包围盒的轴对齐包围盒
+ */
+void transformAabbs(const glm::mat4 &matrix, const ConstAabbSoa &boxes, const AabbSoa &out, uint32_t count);
+
+/**
+ * @brief 合并所有包围盒，count 为 0 时 min 为 +inf、max 为 -inf
+ */
+Aabb mergeAabbs(const ConstAabbSoa &boxes, uint32_t count);
+
+/**
+ * @brief 包围球视锥测试，visible[i] 为 1 表示与视锥相交
+ */
+void cullSpheres(const FrustumPlanes &planes, const ConstVec3Soa &centers, const float *radii, uint8_t *visible, uint32_t count);
+
+/**
+ * @brief 包围盒视锥测试，visible[i] 为 1 表示与视锥相交
+ */
+void cullAabbs(const FrustumPlanes &planes, const ConstAabbSoa &boxes, uint8_t *visible, uint32_t count);
+
+} // namespace engine::utils
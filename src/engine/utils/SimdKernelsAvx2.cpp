@@ -0,0 +1,38 @@
+#include "SimdKernelsImpl.hpp"
+
+#if defined(SIMD_KERNELS_X86)
+#include <immintrin.h>
+
+namespace engine::utils {
+
+namespace {
+struct Ops {
+    using Float = __m256;
+    using Mask  = __m256;
+
+    static constexpr uint32_t WIDTH = 8;
+
+    static Float load(const float *p) { return _mm256_loadu_ps(p); }
+    static void store(float *p, Float v) { _mm256_storeu_ps(p, v); }
+    static Float set1(float v) { return _mm256_set1_ps(v); }
+    static Float add(Float a, Float b) { return _mm256_add_ps(a, b); }
+    static Float sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+    static Float mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+    static Float mulAdd(Float a, Float b, Float c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); } // 不要求 FMA，结果与其他路径一致
+    static Float min(Float a, Float b) { return _mm256_min_ps(a, b); }
+    static Float max(Float a, Float b) { return _mm256_max_ps(a, b); }
+    static Float abs(Float a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static Mask greaterEqual(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static Mask maskAnd(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+    static Mask allTrue() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+    static uint32_t bits(Mask m) { return static_cast<uint32_t>(_mm256_movemask_ps(m)); }
+};
+} // namespace
+
+const SimdKernelTable &getAvx2Kernels() {
+    static const SimdKernelTable table = simd::makeKernelTable<Ops>(SimdIsa::Avx2);
+    return table;
+}
+
+} // namespace engine::utils
+#endif
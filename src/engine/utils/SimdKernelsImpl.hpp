@@ -0,0 +1,373 @@
+#pragma once
+#include "SimdKernels.hpp"
+
+#include <limits>
+
+// 只在 SimdKernels*.cpp 中使用。
+// 每个指令集的内核放在单独的编译单元中，按各自的编译选项编译（见 CMakeLists.txt），
+// 调用前必须先确认 CPU 支持。各编译单元中的 Ops 类型定义在匿名命名空间里，
+// 因此下面的模板实例只在本单元内可见，不会与用其他指令集编译的同名实例混用。
+// 同样的原因，内核中不调用 glm 和标准库的内联函数，矩阵和平面以 float 数组传入。
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_KERNELS_X86 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SIMD_KERNELS_NEON 1
+#endif
+
+namespace engine::utils {
+
+/**
+ * @struct SimdKernelTable
+ * @brief 一个指令集的全部内核
+ */
+struct SimdKernelTable {
+    SimdIsa isa = SimdIsa::Scalar;
+    void (*transformPoints)(const float *matrix, const ConstVec3Soa &points, const Vec3Soa &out, uint32_t count);
+    void (*composeTrs)(const ConstVec3Soa &positions, const ConstQuatSoa &rotations, const ConstVec3Soa &scales, float *out, uint32_t count);
+    void (*transformAabbs)(const float *matrix, const ConstAabbSoa &boxes, const AabbSoa &out, uint32_t count);
+    void (*mergeAabbs)(const ConstAabbSoa &boxes, uint32_t count, float *bounds); // bounds: minX minY minZ maxX maxY maxZ
+    void (*cullSpheres)(const float *planes, const ConstVec3Soa &centers, const float *radii, uint8_t *visible, uint32_t count);
+    void (*cullAabbs)(const float *planes, const ConstAabbSoa &boxes, uint8_t *visible, uint32_t count);
+};
+
+#if defined(SIMD_KERNELS_X86)
+const SimdKernelTable &getSse2Kernels();
+const SimdKernelTable &getAvx2Kernels();
+#elif defined(SIMD_KERNELS_NEON)
+const SimdKernelTable &getNeonKernels();
+#endif
+
+namespace simd {
+
+/**
+ * 以下内核按 Ops::WIDTH 个元素一组处理，Ops 提供：
+ * Float / Mask 类型，load / store / set1 / add / sub / mul / mulAdd(a, b, c) = a * b + c / min / max / abs，
+ * greaterEqual / maskAnd / allTrue，以及 bits(mask)（第 i 位为第 i 个通道）。
+ * 不足一组的尾部复制到补齐的临时数组中再执行一次，写回时只取有效部分。
+ */
+
+template <typename Ops>
+void transformPoints(const float *m, const ConstVec3Soa &points, const Vec3Soa &out, uint32_t count) {
+    using Float          = typename Ops::Float;
+    constexpr uint32_t W = Ops::WIDTH;
+
+    const Float m00 = Ops::set1(m[0]), m01 = Ops::set1(m[1]), m02 = Ops::set1(m[2]);
+    const Float m10 = Ops::set1(m[4]), m11 = Ops::set1(m[5]), m12 = Ops::set1(m[6]);
+    const Float m20 = Ops::set1(m[8]), m21 = Ops::set1(m[9]), m22 = Ops::set1(m[10]);
+    const Float m30 = Ops::set1(m[12]), m31 = Ops::set1(m[13]), m32 = Ops::set1(m[14]);
+    auto kernel = [&](const float *x, const float *y, const float *z, float *ox, float *oy, float *oz) {
+        const Float px = Ops::load(x), py = Ops::load(y), pz = Ops::load(z);
+        Ops::store(ox, Ops::mulAdd(m00, px, Ops::mulAdd(m10, py, Ops::mulAdd(m20, pz, m30))));
+        Ops::store(oy, Ops::mulAdd(m01, px, Ops::mulAdd(m11, py, Ops::mulAdd(m21, pz, m31))));
+        Ops::store(oz, Ops::mulAdd(m02, px, Ops::mulAdd(m12, py, Ops::mulAdd(m22, pz, m32))));
+    };
+
+    uint32_t i = 0;
+    for (; i + W <= count; i += W) {
+        kernel(points.x + i, points.y + i, points.z + i, out.x + i, out.y + i, out.z + i);
+    }
+    if (i < count) {
+        float in[3][W]  = {};
+        float res[3][W] = {};
+        for (uint32_t j = 0; i + j < count; j++) {
+            in[0][j] = points.x[i + j];
+            in[1][j] = points.y[i + j];
+            in[2][j] = points.z[i + j];
+        }
+        kernel(in[0], in[1], in[2], res[0], res[1], res[2]);
+        for (uint32_t j = 0; i + j < count; j++) {
+            out.x[i + j] = res[0][j];
+            out.y[i + j] = res[1][j];
+            out.z[i + j] = res[2][j];
+        }
+    }
+}
+
+template <typename Ops>
+void composeTrs(const ConstVec3Soa &positions, const ConstQuatSoa &rotations, const ConstVec3Soa &scales, float *out, uint32_t count) {
+    using Float          = typename Ops::Float;
+    constexpr uint32_t W = Ops::WIDTH;
+
+    const Float one = Ops::set1(1.0f);
+    const Float two = Ops::set1(2.0f);
+
+    // 输入为 10 个分量数组，输出为 12 个矩阵元素（第四行固定为 0 0 0 1），按通道写回列主序矩阵
+    auto kernel = [&](const float *const *in, float *base, uint32_t lanes) {
+        const Float qx = Ops::load(in[3]), qy = Ops::load(in[4]), qz = Ops::load(in[5]), qw = Ops::load(in[6]);
+        const Float sx = Ops::load(in[7]), sy = Ops::load(in[8]), sz = Ops::load(in[9]);
+        const Float xx = Ops::mul(qx, qx), yy = Ops::mul(qy, qy), zz = Ops::mul(qz, qz);
+        const Float xy = Ops::mul(qx, qy), xz = Ops::mul(qx, qz), yz = Ops::mul(qy, qz);
+        const Float wx = Ops::mul(qw, qx), wy = Ops::mul(qw, qy), wz = Ops::mul(qw, qz);
+
+        float elements[12][W];
+        Ops::store(elements[0], Ops::mul(Ops::sub(one, Ops::mul(two, Ops::add(yy, zz))), sx));
+        Ops::store(elements[1], Ops::mul(Ops::mul(two, Ops::add(xy, wz)), sx));
+        Ops::store(elements[2], Ops::mul(Ops::mul(two, Ops::sub(xz, wy)), sx));
+        Ops::store(elements[3], Ops::mul(Ops::mul(two, Ops::sub(xy, wz)), sy));
+        Ops::store(elements[4], Ops::mul(Ops::sub(one, Ops::mul(two, Ops::add(xx, zz))), sy));
+        Ops::store(elements[5], Ops::mul(Ops::mul(two, Ops::add(yz, wx)), sy));
+        Ops::store(elements[6], Ops::mul(Ops::mul(two, Ops::add(xz, wy)), sz));
+        Ops::store(elements[7], Ops::mul(Ops::mul(two, Ops::sub(yz, wx)), sz));
+        Ops::store(elements[8], Ops::mul(Ops::sub(one, Ops::mul(two, Ops::add(xx, yy))), sz));
+        Ops::store(elements[9], Ops::load(in[0]));
+        Ops::store(elements[10], Ops::load(in[1]));
+        Ops::store(elements[11], Ops::load(in[2]));
+        for (uint32_t lane = 0; lane < lanes; lane++) {
+            float *matrix = base + lane * 16;
+            for (uint32_t column = 0; column < 4; column++) {
+                matrix[column * 4 + 0] = elements[column * 3 + 0][lane];
+                matrix[column * 4 + 1] = elements[column * 3 + 1][lane];
+                matrix[column * 4 + 2] = elements[column * 3 + 2][lane];
+                matrix[column * 4 + 3] = column == 3 ? 1.0f : 0.0f;
+            }
+        }
+    };
+
+    uint32_t i = 0;
+    for (; i + W <= count; i += W) {
+        const float *in[10] = {positions.x + i, positions.y + i, positions.z + i, rotations.x + i, rotations.y + i,
+                               rotations.z + i, rotations.w + i, scales.x + i, scales.y + i, scales.z + i};
+        kernel(in, out + i * 16, W);
+    }
+    if (i < count) {
+        const float *sources[10] = {positions.x, positions.y, positions.z, rotations.x, rotations.y,
+                                    rotations.z, rotations.w, scales.x, scales.y, scales.z};
+        float padded[10][W] = {};
+        const float *in[10];
+        for (uint32_t k = 0; k < 10; k++) {
+            for (uint32_t j = 0; i + j < count; j++) {
+                padded[k][j] = sources[k][i + j];
+            }
+            in[k] = padded[k];
+        }
+        kernel(in, out + i * 16, count - i);
+    }
+}
+
+template <typename Ops>
+void transformAabbs(const float *m, const ConstAabbSoa &boxes, const AabbSoa &out, uint32_t count) {
+    using Float          = typename Ops::Float;
+    constexpr uint32_t W = Ops::WIDTH;
+
+    const Float half = Ops::set1(0.5f);
+
+    const Float m00 = Ops::set1(m[0]), m01 = Ops::set1(m[1]), m02 = Ops::set1(m[2]);
+    const Float m10 = Ops::set1(m[4]), m11 = Ops::set1(m[5]), m12 = Ops::set1(m[6]);
+    const Float m20 = Ops::set1(m[8]), m21 = Ops::set1(m[9]), m22 = Ops::set1(m[10]);
+    const Float m30 = Ops::set1(m[12]), m31 = Ops::set1(m[13]), m32 = Ops::set1(m[14]);
+    const Float a00 = Ops::abs(m00), a01 = Ops::abs(m01), a02 = Ops::abs(m02);
+    const Float a10 = Ops::abs(m10), a11 = Ops::abs(m11), a12 = Ops::abs(m12);
+    const Float a20 = Ops::abs(m20), a21 = Ops::abs(m21), a22 = Ops::abs(m22);
+    // 中心按点变换，半长按矩阵元素的绝对值变换
+    auto kernel = [&](const float *const *in, float *const *res) {
+        const Float minX = Ops::load(in[0]), minY = Ops::load(in[1]), minZ = Ops::load(in[2]);
+        const Float maxX = Ops::load(in[3]), maxY = Ops::load(in[4]), maxZ = Ops::load(in[5]);
+        const Float cx = Ops::mul(Ops::add(minX, maxX), half), cy = Ops::mul(Ops::add(minY, maxY), half), cz = Ops::mul(Ops::add(minZ, maxZ), half);
+        const Float ex = Ops::mul(Ops::sub(maxX, minX), half), ey = Ops::mul(Ops::sub(maxY, minY), half), ez = Ops::mul(Ops::sub(maxZ, minZ), half);
+        const Float centerX = Ops::mulAdd(m00, cx, Ops::mulAdd(m10, cy, Ops::mulAdd(m20, cz, m30)));
+        const Float centerY = Ops::mulAdd(m01, cx, Ops::mulAdd(m11, cy, Ops::mulAdd(m21, cz, m31)));
+        const Float centerZ = Ops::mulAdd(m02, cx, Ops::mulAdd(m12, cy, Ops::mulAdd(m22, cz, m32)));
+        const Float extentX = Ops::mulAdd(a00, ex, Ops::mulAdd(a10, ey, Ops::mul(a20, ez)));
+        const Float extentY = Ops::mulAdd(a01, ex, Ops::mulAdd(a11, ey, Ops::mul(a21, ez)));
+        const Float extentZ = Ops::mulAdd(a02, ex, Ops::mulAdd(a12, ey, Ops::mul(a22, ez)));
+        Ops::store(res[0], Ops::sub(centerX, extentX));
+        Ops::store(res[1], Ops::sub(centerY, extentY));
+        Ops::store(res[2], Ops::sub(centerZ, extentZ));
+        Ops::store(res[3], Ops::add(centerX, extentX));
+        Ops::store(res[4], Ops::add(centerY, extentY));
+        Ops::store(res[5], Ops::add(centerZ, extentZ));
+    };
+
+    const float *sources[6] = {boxes.min.x, boxes.min.y, boxes.min.z, boxes.max.x, boxes.max.y, boxes.max.z};
+    float *targets[6]       = {out.min.x, out.min.y, out.min.z, out.max.x, out.max.y, out.max.z};
+
+    uint32_t i = 0;
+    for (; i + W <= count; i += W) {
+        const float *in[6] = {sources[0] + i, sources[1] + i, sources[2] + i, sources[3] + i, sources[4] + i, sources[5] + i};
+        float *res[6]      = {targets[0] + i, targets[1] + i, targets[2] + i, targets[3] + i, targets[4] + i, targets[5] + i};
+        kernel(in, res);
+    }
+    if (i < count) {
+        float padded[6][W] = {};
+        float result[6][W] = {};
+        const float *in[6];
+        float *res[6];
+        for (uint32_t k = 0; k < 6; k++) {
+            for (uint32_t j = 0; i + j < count; j++) {
+                padded[k][j] = sources[k][i + j];
+            }
+            in[k]  = padded[k];
+            res[k] = result[k];
+        }
+        kernel(in, res);
+        for (uint32_t k = 0; k < 6; k++) {
+            for (uint32_t j = 0; i + j < count; j++) {
+                targets[k][i + j] = result[k][j];
+            }
+        }
+    }
+}
+
+template <typename Ops>
+void mergeAabbs(const ConstAabbSoa &boxes, uint32_t count, float *bounds) {
+    using Float          = typename Ops::Float;
+    constexpr uint32_t W = Ops::WIDTH;
+
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+    const float *sources[6]  = {boxes.min.x, boxes.min.y, boxes.min.z, boxes.max.x, boxes.max.y, boxes.max.z};
+    Float accumulators[6];
+    for (uint32_t k = 0; k < 6; k++) {
+        accumulators[k] = Ops::set1(k < 3 ? infinity : -infinity);
+    }
+
+    uint32_t i = 0;
+    for (; i + W <= count; i += W) {
+        for (uint32_t k = 0; k < 3; k++) {
+            accumulators[k]     = Ops::min(accumulators[k], Ops::load(sources[k] + i));
+            accumulators[k + 3] = Ops::max(accumulators[k + 3], Ops::load(sources[k + 3] + i));
+        }
+    }
+    if (i < count) {
+        // 补齐部分用 +inf / -inf 填充，不影响结果
+        for (uint32_t k = 0; k < 6; k++) {
+            float padded[W];
+            for (uint32_t j = 0; j < W; j++) {
+                padded[j] = i + j < count ? sources[k][i + j] : (k < 3 ? infinity : -infinity);
+            }
+            accumulators[k] = k < 3 ? Ops::min(accumulators[k], Ops::load(padded)) : Ops::max(accumulators[k], Ops::load(padded));
+        }
+    }
+    for (uint32_t k = 0; k < 6; k++) {
+        float lanes[W];
+        Ops::store(lanes, accumulators[k]);
+        float value = lanes[0];
+        for (uint32_t j = 1; j < W; j++) {
+            value = k < 3 ? (lanes[j] < value ? lanes[j] : value) : (lanes[j] > value ? lanes[j] : value);
+        }
+        bounds[k] = value;
+    }
+}
+
+template <typename Ops>
+void cullSpheres(const float *planes, const ConstVec3Soa &centers, const float *radii, uint8_t *visible, uint32_t count) {
+    using Float          = typename Ops::Float;
+    using Mask           = typename Ops::Mask;
+    constexpr uint32_t W = Ops::WIDTH;
+
+    Float normals[6][4];
+    for (uint32_t p = 0; p < 6; p++) {
+        for (uint32_t k = 0; k < 4; k++) {
+            normals[p][k] = Ops::set1(planes[p * 4 + k]);
+        }
+    }
+    const Float zero = Ops::set1(0.0f);
+
+    auto kernel = [&](const float *x, const float *y, const float *z, const float *r) {
+        const Float cx = Ops::load(x), cy = Ops::load(y), cz = Ops::load(z);
+        const Float negRadius = Ops::sub(zero, Ops::load(r));
+        Mask inside           = Ops::allTrue();
+        for (uint32_t p = 0; p < 6; p++) {
+            Float distance = Ops::mulAdd(normals[p][0], cx, Ops::mulAdd(normals[p][1], cy, Ops::mulAdd(normals[p][2], cz, normals[p][3])));
+            inside         = Ops::maskAnd(inside, Ops::greaterEqual(distance, negRadius));
+        }
+        return Ops::bits(inside);
+    };
+
+    uint32_t i = 0;
+    for (; i + W <= count; i += W) {
+        uint32_t bits = kernel(centers.x + i, centers.y + i, centers.z + i, radii + i);
+        for (uint32_t j = 0; j < W; j++) {
+            visible[i + j] = static_cast<uint8_t>((bits >> j) & 1);
+        }
+    }
+    if (i < count) {
+        float padded[4][W] = {};
+        for (uint32_t j = 0; i + j < count; j++) {
+            padded[0][j] = centers.x[i + j];
+            padded[1][j] = centers.y[i + j];
+            padded[2][j] = centers.z[i + j];
+            padded[3][j] = radii[i + j];
+        }
+        uint32_t bits = kernel(padded[0], padded[1], padded[2], padded[3]);
+        for (uint32_t j = 0; i + j < count; j++) {
+            visible[i + j] = static_cast<uint8_t>((bits >> j) & 1);
+        }
+    }
+}
+
+template <typename Ops>
+void cullAabbs(const float *planes, const ConstAabbSoa &boxes, uint8_t *visible, uint32_t count) {
+    using Float          = typename Ops::Float;
+    using Mask           = typename Ops::Mask;
+    constexpr uint32_t W = Ops::WIDTH;
+
+    Float normals[6][4];
+    Float absNormals[6][3];
+    for (uint32_t p = 0; p < 6; p++) {
+        for (uint32_t k = 0; k < 4; k++) {
+            normals[p][k] = Ops::set1(planes[p * 4 + k]);
+        }
+        for (uint32_t k = 0; k < 3; k++) {
+            absNormals[p][k] = Ops::abs(normals[p][k]);
+        }
+    }
+    const Float half = Ops::set1(0.5f);
+    const Float zero = Ops::set1(0.0f);
+    // 中心到平面的距离不小于 -|n|·半长 时，包围盒至少有一个角在平面内侧
+    auto kernel = [&](const float *const *in) {
+        const Float minX = Ops::load(in[0]), minY = Ops::load(in[1]), minZ = Ops::load(in[2]);
+        const Float maxX = Ops::load(in[3]), maxY = Ops::load(in[4]), maxZ = Ops::load(in[5]);
+        const Float cx = Ops::mul(Ops::add(minX, maxX), half), cy = Ops::mul(Ops::add(minY, maxY), half), cz = Ops::mul(Ops::add(minZ, maxZ), half);
+        const Float ex = Ops::mul(Ops::sub(maxX, minX), half), ey = Ops::mul(Ops::sub(maxY, minY), half), ez = Ops::mul(Ops::sub(maxZ, minZ), half);
+        Mask inside = Ops::allTrue();
+        for (uint32_t p = 0; p < 6; p++) {
+            Float distance = Ops::mulAdd(normals[p][0], cx, Ops::mulAdd(normals[p][1], cy, Ops::mulAdd(normals[p][2], cz, normals[p][3])));
+            Float radius   = Ops::mulAdd(absNormals[p][0], ex, Ops::mulAdd(absNormals[p][1], ey, Ops::mul(absNormals[p][2], ez)));
+            inside         = Ops::maskAnd(inside, Ops::greaterEqual(distance, Ops::sub(zero, radius)));
+        }
+        return Ops::bits(inside);
+    };
+
+    const float *sources[6] = {boxes.min.x, boxes.min.y, boxes.min.z, boxes.max.x, boxes.max.y, boxes.max.z};
+
+    uint32_t i = 0;
+    for (; i + W <= count; i += W) {
+        const float *in[6] = {sources[0] + i, sources[1] + i, sources[2] + i, sources[3] + i, sources[4] + i, sources[5] + i};
+        uint32_t bits      = kernel(in);
+        for (uint32_t j = 0; j < W; j++) {
+            visible[i + j] = static_cast<uint8_t>((bits >> j) & 1);
+        }
+    }
+    if (i < count) {
+        float padded[6][W] = {};
+        const float *in[6];
+        for (uint32_t k = 0; k < 6; k++) {
+            for (uint32_t j = 0; i + j < count; j++) {
+                padded[k][j] = sources[k][i + j];
+            }
+            in[k] = padded[k];
+        }
+        uint32_t bits = kernel(in);
+        for (uint32_t j = 0; i + j < count; j++) {
+            visible[i + j] = static_cast<uint8_t>((bits >> j) & 1);
+        }
+    }
+}
+
+template <typename Ops>
+SimdKernelTable makeKernelTable(SimdIsa isa) {
+    SimdKernelTable table;
+    table.isa             = isa;
+    table.transformPoints = &transformPoints<Ops>;
+    table.composeTrs      = &composeTrs<Ops>;
+    table.transformAabbs  = &transformAabbs<Ops>;
+    table.mergeAabbs      = &mergeAabbs<Ops>;
+    table.cullSpheres     = &cullSpheres<Ops>;
+    table.cullAabbs       = &cullAabbs<Ops>;
+    return table;
+}
+
+} // namespace simd
+
+} // namespace engine::utils
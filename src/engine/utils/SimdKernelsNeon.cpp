@@ -0,0 +1,41 @@
+#include "SimdKernelsImpl.hpp"
+
+#if defined(SIMD_KERNELS_NEON)
+#include <arm_neon.h>
+
+namespace engine::utils {
+
+namespace {
+struct Ops {
+    using Float = float32x4_t;
+    using Mask  = uint32x4_t;
+
+    static constexpr uint32_t WIDTH = 4;
+
+    static Float load(const float *p) { return vld1q_f32(p); }
+    static void store(float *p, Float v) { vst1q_f32(p, v); }
+    static Float set1(float v) { return vdupq_n_f32(v); }
+    static Float add(Float a, Float b) { return vaddq_f32(a, b); }
+    static Float sub(Float a, Float b) { return vsubq_f32(a, b); }
+    static Float mul(Float a, Float b) { return vmulq_f32(a, b); }
+    static Float mulAdd(Float a, Float b, Float c) { return vaddq_f32(vmulq_f32(a, b), c); } // 不用 vfmaq，结果与其他路径一致
+    static Float min(Float a, Float b) { return vminq_f32(a, b); }
+    static Float max(Float a, Float b) { return vmaxq_f32(a, b); }
+    static Float abs(Float a) { return vabsq_f32(a); }
+    static Mask greaterEqual(Float a, Float b) { return vcgeq_f32(a, b); }
+    static Mask maskAnd(Mask a, Mask b) { return vandq_u32(a, b); }
+    static Mask allTrue() { return vdupq_n_u32(0xFFFFFFFFu); }
+    static uint32_t bits(Mask m) {
+        const uint32_t weights[4] = {1, 2, 4, 8};
+        return vaddvq_u32(vandq_u32(m, vld1q_u32(weights)));
+    }
+};
+} // namespace
+
+const SimdKernelTable &getNeonKernels() {
+    static const SimdKernelTable table = simd::makeKernelTable<Ops>(SimdIsa::Neon);
+    return table;
+}
+
+} // namespace engine::utils
+#endif
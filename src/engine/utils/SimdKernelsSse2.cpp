@@ -0,0 +1,38 @@
+#include "SimdKernelsImpl.hpp"
+
+#if defined(SIMD_KERNELS_X86)
+#include <emmintrin.h>
+
+namespace engine::utils {
+
+namespace {
+struct Ops {
+    using Float = __m128;
+    using Mask  = __m128;
+
+    static constexpr uint32_t WIDTH = 4;
+
+    static Float load(const float *p) { return _mm_loadu_ps(p); }
+    static void store(float *p, Float v) { _mm_storeu_ps(p, v); }
+    static Float set1(float v) { return _mm_set1_ps(v); }
+    static Float add(Float a, Float b) { return _mm_add_ps(a, b); }
+    static Float sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+    static Float mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+    static Float mulAdd(Float a, Float b, Float c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static Float min(Float a, Float b) { return _mm_min_ps(a, b); }
+    static Float max(Float a, Float b) { return _mm_max_ps(a, b); }
+    static Float abs(Float a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static Mask greaterEqual(Float a, Float b) { return _mm_cmpge_ps(a, b); }
+    static Mask maskAnd(Mask a, Mask b) { return _mm_and_ps(a, b); }
+    static Mask allTrue() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+    static uint32_t bits(Mask m) { return static_cast<uint32_t>(_mm_movemask_ps(m)); }
+};
+} // namespace
+
+const SimdKernelTable &getSse2Kernels() {
+    static const SimdKernelTable table = simd::makeKernelTable<Ops>(SimdIsa::Sse2);
+    return table;
+}
+
+} // namespace engine::utils
+#endif
@@ -0,0 +1,64 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define ENGINE_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define ENGINE_SIMD_NEON 1
+#endif
+
+namespace engine::utils {
+
+/**
+ * @brief out = a * b（glm 列主序），每列用 4 次广播乘加完成
+ *
+ * out 可以与 a 或 b 是同一个矩阵。
+ */
+inline void multiplyMat4(const glm::mat4 &a, const glm::mat4 &b, glm::mat4 &out) {
+#if defined(ENGINE_SIMD_SSE2)
+    const __m128 a0 = _mm_loadu_ps(&a[0][0]);
+    const __m128 a1 = _mm_loadu_ps(&a[1][0]);
+    const __m128 a2 = _mm_loadu_ps(&a[2][0]);
+    const __m128 a3 = _mm_loadu_ps(&a[3][0]);
+    for (int column = 0; column < 4; column++) {
+        const __m128 b0 = _mm_set1_ps(b[column][0]);
+        const __m128 b1 = _mm_set1_ps(b[column][1]);
+        const __m128 b2 = _mm_set1_ps(b[column][2]);
+        const __m128 b3 = _mm_set1_ps(b[column][3]);
+        __m128 result   = _mm_add_ps(_mm_mul_ps(a0, b0), _mm_mul_ps(a1, b1));
+        result          = _mm_add_ps(result, _mm_add_ps(_mm_mul_ps(a2, b2), _mm_mul_ps(a3, b3)));
+        _mm_storeu_ps(&out[column][0], result);
+    }
+#elif defined(ENGINE_SIMD_NEON)
+    const float32x4_t a0 = vld1q_f32(&a[0][0]);
+    const float32x4_t a1 = vld1q_f32(&a[1][0]);
+    const float32x4_t a2 = vld1q_f32(&a[2][0]);
+    const float32x4_t a3 = vld1q_f32(&a[3][0]);
+    for (int column = 0; column < 4; column++) {
+        const float32x4_t bColumn = vld1q_f32(&b[column][0]);
+        float32x4_t result        = vmulq_lane_f32(a0, vget_low_f32(bColumn), 0);
+        result                    = vmlaq_lane_f32(result, a1, vget_low_f32(bColumn), 1);
+        result                    = vmlaq_lane_f32(result, a2, vget_high_f32(bColumn), 0);
+        result                    = vmlaq_lane_f32(result, a3, vget_high_f32(bColumn), 1);
+        vst1q_f32(&out[column][0], result);
+    }
+#else
+    out = a * b;
+#endif
+}
+
+/**
+ * @brief 由平移、旋转、缩放组成模型矩阵：T * R * S
+ */
+inline void composeTransform(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale, glm::mat4 &out) {
+    const glm::mat3 basis = glm::mat3_cast(rotation);
+    out[0]                = glm::vec4(basis[0] * scale.x, 0.0f);
+    out[1]                = glm::vec4(basis[1] * scale.y, 0.0f);
+    out[2]                = glm::vec4(basis[2] * scale.z, 0.0f);
+    out[3]                = glm::vec4(position, 1.0f);
+}
+
+} // namespace engine::utils
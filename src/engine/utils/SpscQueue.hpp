@@ -0,0 +1,51 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace engine::utils {
+
+/**
+ * @class SpscQueue
+ * @brief 固定容量的单生产者单消费者无锁队列
+ *
+ * 只有一个线程调用 push()、另一个线程调用 pop() 时是安全的；两端都不分配内存、不加锁，适合实时线程（例如音频回调）。
+ * 读写位置分别放在独立的缓存行上，避免生产者和消费者互相使对方的缓存行失效。
+ */
+template <typename T, size_t Capacity>
+class SpscQueue final {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue 的容量必须是 2 的幂");
+
+public:
+    SpscQueue() = default;
+
+    SpscQueue(const SpscQueue &)            = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+    SpscQueue(SpscQueue &&)                 = delete;
+    SpscQueue &operator=(SpscQueue &&)      = delete;
+
+    bool push(const T &item) { // 队列已满时返回 false
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == Capacity) return false;
+        m_items[head & (Capacity - 1)] = item;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &item) { // 队列为空时返回 false
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) return false;
+        item = m_items[tail & (Capacity - 1)];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+#pragma region Menber Variables
+    alignas(64) std::atomic<size_t> m_head{0}; // 下一个写入位置，只由生产者修改
+    alignas(64) std::atomic<size_t> m_tail{0}; // 下一个读取位置，只由消费者修改
+    std::array<T, Capacity> m_items{};
+#pragma endregion
+};
+
+} // namespace engine::utils